@@ -107,6 +107,11 @@ ESCARGOT_LDFLAGS_LTO += -flto
 #######################################################
 ESCARGOT_CXXFLAGS_VENDORTEST += -DESCARGOT_ENABLE_VENDORTEST
 
+#######################################################
+# flags for JIT (x64 only)
+#######################################################
+ESCARGOT_CXXFLAGS_JIT += -DESCARGOT_ENABLE_JIT
+
 #######################################################
 # flags for $(THIRD_PARTY)
 #######################################################
@@ -9,6 +9,10 @@ x64.interpreter.debug.shared.cctest: x64.interpreter.debug.shared $(EXE_TC)
 x64.interpreter.release.shared.cctest: x64.interpreter.release.shared $(EXE_TC)
 x64.interpreter.debug.shared.cctest.run: x64.interpreter.debug.shared.cctest
 	for f in $(EXE_TC); do LD_LIBRARY_PATH=. $$f; done;
+x64.jit.debug.shared.cctest: x64.jit.debug.shared $(EXE_TC)
+x64.jit.release.shared.cctest: x64.jit.release.shared $(EXE_TC)
+x64.jit.debug.shared.cctest.run: x64.jit.debug.shared.cctest
+	for f in $(EXE_TC); do LD_LIBRARY_PATH=. $$f; done;
 
 $(OUTDIR)/%.exe: %.cpp $(DEPENDENCY_MAKEFILE) $(OUTDIR)/libescargot.so install_header_to_include
 	mkdir -p $(OUTDIR)/test/cctest
@@ -380,3 +380,10 @@ SET (ESCARGOT_LDFLAGS_LTO "${ESCARGOT_LDFLAGS_LTO} -flto")
 #######################################################
 SET (ESCARGOT_CXXFLAGS_VENDORTEST)
 SET (ESCARGOT_CXXFLAGS_VENDORTEST "${ESCARGOT_CXXFLAGS_VENDORTEST} -DESCARGOT_ENABLE_VENDORTEST")
+
+
+#######################################################
+# FLAGS FOR JIT (x64 only)
+#######################################################
+SET (ESCARGOT_CXXFLAGS_JIT)
+SET (ESCARGOT_CXXFLAGS_JIT "${ESCARGOT_CXXFLAGS_JIT} -DESCARGOT_ENABLE_JIT")
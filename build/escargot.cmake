@@ -83,6 +83,13 @@ IF ("${VENDORTEST}" EQUAL 1)
     SET (ESCARGOT_CXXFLAGS "${ESCARGOT_CXXFLAGS} ${ESCARGOT_CXXFLAGS_VENDORTEST}")
 ENDIF()
 
+IF (${ESCARGOT_TYPE} STREQUAL "jit")
+    IF (NOT ${ESCARGOT_ARCH} STREQUAL "x64" AND NOT ${ESCARGOT_ARCH} STREQUAL "x86_64")
+        MESSAGE (FATAL_ERROR "JIT is supported on x64 only")
+    ENDIF()
+    SET (ESCARGOT_CXXFLAGS "${ESCARGOT_CXXFLAGS} ${ESCARGOT_CXXFLAGS_JIT}")
+ENDIF()
+
 
 # SOURCE FILES
 FILE (GLOB_RECURSE ESCARGOT_SRC ${ESCARGOT_ROOT}/src/*.cpp)
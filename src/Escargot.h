@@ -315,6 +315,11 @@ typedef uint16_t ByteCodeRegisterIndex;
 #define STACK_LIMIT_FROM_BASE (1024 * 1024 * 3) // 3MB
 #endif
 
+// interpreted functions called from the interpreter get their frames from a stack of this size instead of the native stack
+#ifndef INTERPRETER_FRAME_STACK_SIZE
+#define INTERPRETER_FRAME_STACK_SIZE (1024 * 1024 * 2) // 2MB
+#endif
+
 #ifndef STRING_MAXIMUM_LENGTH
 #define STRING_MAXIMUM_LENGTH 1024 * 1024 * 512 // 512MB
 #endif
@@ -331,6 +336,35 @@ typedef uint16_t ByteCodeRegisterIndex;
 #define FUNCTION_OBJECT_BYTECODE_SIZE_MAX 1024 * 1024 * 2
 #endif
 
+// when the byte code size budget is exceeded, cold ByteCodeBlocks are evicted until this percentage of the budget is used
+#ifndef FUNCTION_OBJECT_BYTECODE_SIZE_LOW_WATER_MARK_PERCENT
+#define FUNCTION_OBJECT_BYTECODE_SIZE_LOW_WATER_MARK_PERCENT 50
+#endif
+
+// objects created by a constructor reserve property storage for what earlier objects got, up to this many properties
+#ifndef OBJECT_CONSTRUCTOR_SLACK_PROPERTY_COUNT_MAX
+#define OBJECT_CONSTRUCTOR_SLACK_PROPERTY_COUNT_MAX 64
+#endif
+
+// default number of compiled regexps kept in the cache of VMInstance
+#ifndef REGEXP_CACHE_SIZE_MAX
+#define REGEXP_CACHE_SIZE_MAX 256
+#endif
+
+#if defined(ESCARGOT_ENABLE_JIT)
+#if !defined(ESCARGOT_64) || !defined(OS_POSIX) || !defined(__x86_64__)
+#error "JIT is supported on x64 only"
+#endif
+// a ByteCodeBlock is compiled into native code after this many calls and loop iterations in the interpreter
+#ifndef ESCARGOT_JIT_HOT_COUNT
+#define ESCARGOT_JIT_HOT_COUNT 1000
+#endif
+// a regexp pattern is compiled into native code after this many executions in the interpreter of Yarr
+#ifndef ESCARGOT_REGEXP_JIT_HOT_COUNT
+#define ESCARGOT_REGEXP_JIT_HOT_COUNT 100
+#endif
+#endif
+
 
 #ifndef ROPE_STRING_MIN_LENGTH
 #define ROPE_STRING_MIN_LENGTH 24
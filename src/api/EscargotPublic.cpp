@@ -38,6 +38,7 @@
 #include "runtime/ErrorObject.h"
 #include "runtime/DateObject.h"
 #include "runtime/StringObject.h"
+#include "runtime/ExternalString.h"
 #include "runtime/NumberObject.h"
 #include "runtime/BooleanObject.h"
 #include "runtime/RegExpObject.h"
@@ -172,6 +173,28 @@ StringRef* StringRef::fromUTF16(const char16_t* s, size_t len)
     return toRef(new UTF16String(s, len));
 }
 
+StringRef* StringRef::fromExternalLatin1(const unsigned char* s, size_t len, ExternalStringReleaseCallback release, void* data)
+{
+    if (len == 0) {
+        if (release) {
+            release(s, len, data);
+        }
+        return toRef(String::emptyString);
+    }
+    return toRef(new ExternalString(s, len, release, data));
+}
+
+StringRef* StringRef::fromExternalUTF8(const char* s, size_t len, ExternalStringReleaseCallback release, void* data)
+{
+    return toRef(ExternalString::createFromUTF8(s, len, release, data));
+}
+
+StringRef* StringRef::fromFile(const char* fileName)
+{
+    String* str = ExternalString::createFromFile(fileName);
+    return str ? toRef(str) : nullptr;
+}
+
 StringRef* StringRef::emptyString()
 {
     return toRef(String::emptyString);
@@ -423,6 +446,7 @@ void VMInstanceRef::destroy()
 void VMInstanceRef::clearCachesRelatedWithContext()
 {
     VMInstance* imp = toImpl(this);
+    imp->clearMegamorphicPropertyCache();
     imp->m_compiledCodeBlocks.clear();
     imp->m_regexpCache.clear();
     imp->m_cachedUTC = nullptr;
@@ -465,6 +489,61 @@ SymbolRef* VMInstanceRef::unscopablesSymbol()
     return toRef(toImpl(this)->globalSymbols().unscopables);
 }
 
+size_t VMInstanceRef::megamorphicPropertyCacheHitCount()
+{
+    return toImpl(this)->megamorphicPropertyCacheHitCount();
+}
+
+size_t VMInstanceRef::megamorphicPropertyCacheMissCount()
+{
+    return toImpl(this)->megamorphicPropertyCacheMissCount();
+}
+
+size_t VMInstanceRef::byteCodeSizeBudget()
+{
+    return toImpl(this)->byteCodeSizeBudget();
+}
+
+void VMInstanceRef::setByteCodeSizeBudget(size_t budget)
+{
+    toImpl(this)->setByteCodeSizeBudget(budget);
+}
+
+size_t VMInstanceRef::byteCodeBlockEvictionCount()
+{
+    return toImpl(this)->byteCodeBlockEvictionCount();
+}
+
+size_t VMInstanceRef::byteCodeBlockRegenerationCount()
+{
+    return toImpl(this)->byteCodeBlockRegenerationCount();
+}
+
+size_t VMInstanceRef::regExpCacheBudget()
+{
+    return toImpl(this)->regexpCache()->budget();
+}
+
+void VMInstanceRef::setRegExpCacheBudget(size_t budget)
+{
+    toImpl(this)->regexpCache()->setBudget(budget);
+}
+
+size_t VMInstanceRef::regExpCacheHitCount()
+{
+    return toImpl(this)->regexpCache()->hitCount();
+}
+
+size_t VMInstanceRef::regExpCacheMissCount()
+{
+    return toImpl(this)->regexpCache()->missCount();
+}
+
+size_t VMInstanceRef::regExpCacheEvictionCount()
+{
+    return toImpl(this)->regexpCache()->evictionCount();
+}
+
 #ifdef ESCARGOT_ENABLE_PROMISE
 ValueRef* VMInstanceRef::drainJobQueue()
 {
@@ -1940,6 +2019,34 @@ ScriptParserRef::ScriptParserResult ScriptParserRef::parse(StringRef* script, St
     return ScriptParserRef::ScriptParserResult(toRef(result.m_script), StringRef::emptyString());
 }
 
+ScriptParserRef::ScriptParserResult ScriptParserRef::parseFile(const char* fileName)
+{
+    StringRef* src = StringRef::fromFile(fileName);
+    if (!src) {
+        std::string msg = std::string("cannot open file ") + fileName;
+        return ScriptParserRef::ScriptParserResult(nullptr, StringRef::fromUTF8(msg.data(), msg.length()));
+    }
+    return parse(src, StringRef::fromUTF8(fileName, strlen(fileName)));
+}
+
+bool ScriptParserRef::produceCodeCache(StringRef* script, StringRef* fileName, std::vector<uint8_t>& cache)
+{
+    return toImpl(this)->produceCodeCache(toImpl(script), toImpl(fileName), cache);
+}
+
+ScriptParserRef::ScriptParserResult ScriptParserRef::parseWithCodeCache(StringRef* script, StringRef* fileName, const uint8_t* cache, size_t cacheLength, bool* cacheRejected)
+{
+    bool rejected;
+    auto result = toImpl(this)->parseWithCodeCache(toImpl(script), toImpl(fileName), cache, cacheLength, rejected);
+    if (cacheRejected) {
+        *cacheRejected = rejected;
+    }
+    if (result.m_error) {
+        return ScriptParserRef::ScriptParserResult(nullptr, toRef(result.m_error->message));
+    }
+    return ScriptParserRef::ScriptParserResult(toRef(result.m_script), StringRef::emptyString());
+}
+
 ValueRef* ScriptRef::execute(ExecutionStateRef* state)
 {
     return toRef(toImpl(this)->execute(*toImpl(state)));
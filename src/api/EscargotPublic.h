@@ -143,6 +143,14 @@ public:
     static StringRef* fromASCII(const char* s, size_t len);
     static StringRef* fromUTF8(const char* s, size_t len);
     static StringRef* fromUTF16(const char16_t* s, size_t len);
+    // External strings use the buffer of the embedder without copying it into the GC heap.
+    // The buffer must stay alive and unchanged until |release| is called with it.
+    typedef void (*ExternalStringReleaseCallback)(const void* buffer, size_t length, void* data);
+    static StringRef* fromExternalLatin1(const unsigned char* s, size_t len, ExternalStringReleaseCallback release = nullptr, void* data = nullptr);
+    // ASCII content is used as is; other content is decoded once and |release| is called immediately.
+    static StringRef* fromExternalUTF8(const char* s, size_t len, ExternalStringReleaseCallback release = nullptr, void* data = nullptr);
+    // Maps a UTF-8 file read-only (where mmap is available). returns nullptr if the file cannot be read
+    static StringRef* fromFile(const char* fileName);
     static StringRef* emptyString();
 
     char16_t charAt(size_t idx);
@@ -205,6 +213,24 @@ public:
     SymbolRef* iteratorSymbol();
     SymbolRef* unscopablesSymbol();
 
+    // statistics of the cache for property accesses which see too many object shapes to be inline cached
+    size_t megamorphicPropertyCacheHitCount();
+    size_t megamorphicPropertyCacheMissCount();
+
+    // byte code of cold functions is evicted when total byte code size exceeds the budget
+    size_t byteCodeSizeBudget();
+    void setByteCodeSizeBudget(size_t budget);
+    size_t byteCodeBlockEvictionCount();
+    size_t byteCodeBlockRegenerationCount();
+
+    // compiled regexps are cached by source and flags. the least recently used one is evicted
+    // when the cache has more entries than the budget
+    size_t regExpCacheBudget();
+    void setRegExpCacheBudget(size_t budget);
+    size_t regExpCacheHitCount();
+    size_t regExpCacheMissCount();
+    size_t regExpCacheEvictionCount();
+
 #ifdef ESCARGOT_ENABLE_PROMISE
     // if there is an error, executing will be stopped and returns ErrorValue
     // if thres is no job or no error, returns EmptyValue
@@ -865,6 +891,16 @@ public:
     };
 
     ScriptParserResult parse(StringRef* script, StringRef* fileName);
+    // Parses a file through StringRef::fromFile, so the source is not copied into the GC heap.
+    ScriptParserResult parseFile(const char* fileName);
+
+    // Parses |script| and serializes the parsed code into |cache|, which can be stored on disk
+    // and passed to parseWithCodeCache by later processes running the same build of escargot.
+    // Returns false if |script| has an error or contains code which cannot be cached.
+    bool produceCodeCache(StringRef* script, StringRef* fileName, std::vector<uint8_t>& cache);
+    // Restores |script| from |cache| without parsing it. If |cache| was produced from another source
+    // or by another build, or is damaged, it is ignored and |script| is parsed as usual.
+    ScriptParserResult parseWithCodeCache(StringRef* script, StringRef* fileName, const uint8_t* cache, size_t cacheLength, bool* cacheRejected = nullptr);
 };
 
 class EXPORT ScriptRef {
@@ -114,6 +114,29 @@ int getValidValueInInterpretedCodeBlock(void* ptr, GC_mark_custom_result* arr)
     return 0;
 }
 
+// the first word of the frame stack points to its live top
+static const size_t interpreterFrameStackHeaderSize = (sizeof(char**) + sizeof(double) - 1) & ~(sizeof(double) - 1);
+
+GC_ms_entry* markAndPushInterpreterFrameStack(GC_word* addr,
+                                              struct GC_ms_entry* mark_stack_ptr,
+                                              struct GC_ms_entry* mark_stack_limit,
+                                              GC_word env)
+{
+    char** liveTop = *(char***)addr;
+    char* begin = (char*)addr + interpreterFrameStackHeaderSize;
+    if (!liveTop || *liveTop <= begin) {
+        return mark_stack_ptr;
+    }
+
+    // frames are scanned conservatively, like the native stack
+    mark_stack_ptr++;
+    if ((GC_word)mark_stack_ptr >= (GC_word)mark_stack_limit) {
+        mark_stack_ptr = GC_signal_mark_stack_overflow(mark_stack_ptr);
+    }
+    mark_stack_ptr->mse_start = (GC_word*)begin;
+    mark_stack_ptr->mse_descr.w = (GC_word)(*liveTop - begin) | GC_DS_LENGTH;
+    return mark_stack_ptr;
+}
 
 void initializeCustomAllocators()
 {
@@ -149,6 +172,11 @@ void initializeCustomAllocators()
                                                                                  FALSE,
                                                                                  TRUE);
 
+    s_gcKinds[HeapObjectKind::InterpreterFrameStackKind] = GC_new_kind(GC_new_free_list(),
+                                                                       GC_MAKE_PROC(GC_new_proc(markAndPushInterpreterFrameStack), 0),
+                                                                       FALSE,
+                                                                       TRUE);
+
 #ifdef PROFILE_MASSIF
     GC_is_valid_displacement_print_proc = [](void* ptr) {
         g_freeList.push_back(ptr);
@@ -198,6 +226,15 @@ void iterateSpecificKindOfObject(ExecutionState& state, HeapObjectKind kind, Hea
     GC_enable();
 }
 
+void* allocateInterpreterFrameStack(char** liveTop, size_t size)
+{
+    int kind = s_gcKinds[HeapObjectKind::InterpreterFrameStackKind];
+    char* stack = (char*)GC_GENERIC_MALLOC_IGNORE_OFF_PAGE(interpreterFrameStackHeaderSize + size, kind);
+    *(char***)stack = liveTop;
+    *liveTop = stack + interpreterFrameStackHeaderSize;
+    return stack;
+}
+
 template <>
 Value* CustomAllocator<Value>::allocate(size_type GC_n, const void*)
 {
@@ -52,11 +52,16 @@ enum HeapObjectKind : unsigned {
     ArrayObjectKind,
     CodeBlockKind,
     InterpretedCodeBlockKind,
+    InterpreterFrameStackKind,
     NumberOfKind,
 };
 
 void initializeCustomAllocators();
 
+// allocates the frame stack of ByteCodeInterpreter and points liveTop to its first frame.
+// GC scans the stack only below *liveTop, so values of popped frames are never seen
+void* allocateInterpreterFrameStack(char** liveTop, size_t size);
+
 typedef std::function<void(ExecutionState& state, void* obj)> HeapObjectIteratorCallback;
 
 /*
@@ -38,6 +38,11 @@ OpcodeTable::OpcodeTable()
 #if defined(COMPILER_GCC)
     size_t* addr = (size_t*)(block.m_code.data() + offsetof(FillOpcodeTable, m_opcodeInAddress));
     ByteCodeInterpreter::interpret(state, &block, 0, nullptr, addr);
+
+    for (size_t i = 0; i < OpcodeKindEnd; i++) {
+        m_reverseTable[i] = std::make_pair(m_table[i], (Opcode)i);
+    }
+    std::sort(m_reverseTable, m_reverseTable + OpcodeKindEnd);
 #endif
 }
 
@@ -79,6 +84,25 @@ void ByteCodeBlock::fillLocDataIfNeeded(Context* c)
     m_locData->push_back(std::make_pair(SIZE_MAX, SIZE_MAX));
 }
 
+void ByteCodeBlock::sortExceptionRegions()
+{
+    // an enclosing region sorts before the regions it contains
+    std::sort(m_exceptionRegions.data(), m_exceptionRegions.data() + m_exceptionRegions.size(), [](const ByteCodeExceptionRegion& a, const ByteCodeExceptionRegion& b) -> bool {
+        return a.m_start < b.m_start || (a.m_start == b.m_start && a.m_end > b.m_end);
+    });
+
+    std::vector<size_t> enclosing;
+    for (size_t i = 0; i < m_exceptionRegions.size(); i++) {
+        ByteCodeExceptionRegion& region = m_exceptionRegions[i];
+        while (enclosing.size() && m_exceptionRegions[enclosing.back()].m_end < region.m_end) {
+            enclosing.pop_back();
+        }
+        ASSERT(!enclosing.size() || m_exceptionRegions[enclosing.back()].m_start <= region.m_start);
+        region.m_parent = enclosing.size() ? enclosing.back() : SIZE_MAX;
+        enclosing.push_back(i);
+    }
+}
+
 ExtendedNodeLOC ByteCodeBlock::computeNodeLOCFromByteCode(Context* c, size_t codePosition, CodeBlock* cb)
 {
     if (codePosition == SIZE_MAX) {
@@ -133,8 +157,9 @@ void* SetObjectInlineCache::operator new(size_t size)
     static GC_descr descr;
     if (!typeInited) {
         GC_word obj_bitmap[GC_BITMAP_SIZE(SetObjectInlineCache)] = { 0 };
-        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(SetObjectInlineCache, m_cachedhiddenClassChain));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(SetObjectInlineCache, m_cachedStructure));
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(SetObjectInlineCache, m_hiddenClassWillBe));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(SetObjectInlineCache, m_cachedPrototype));
         descr = GC_make_descriptor(obj_bitmap, GC_WORD_LEN(SetObjectInlineCache));
         typeInited = true;
     }
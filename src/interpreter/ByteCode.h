@@ -26,6 +26,9 @@
 #include "runtime/SmallValue.h"
 #include "runtime/String.h"
 #include "runtime/Value.h"
+#if defined(ESCARGOT_ENABLE_JIT)
+#include "jit/JIT.h"
+#endif
 
 namespace Escargot {
 class ObjectStructure;
@@ -38,6 +41,8 @@ class Node;
     F(StoreByName, 0, 0)                              \
     F(LoadByHeapIndex, 1, 0)                          \
     F(StoreByHeapIndex, 0, 0)                         \
+    F(LoadByClosureIndex, 1, 0)                       \
+    F(StoreByClosureIndex, 0, 0)                      \
     F(DeclareFunctionDeclarations, 1, 0)              \
     F(NewOperation, 1, 0)                             \
     F(BinaryPlus, 1, 2)                               \
@@ -70,6 +75,8 @@ class Node;
     F(GetObject, 1, 2)                                \
     F(SetObjectOperation, 0, 2)                       \
     F(GetObjectPreComputedCase, 1, 1)                 \
+    F(GetArgumentsLength, 1, 1)                       \
+    F(GetArgumentsElement, 1, 2)                      \
     F(SetObjectPreComputedCase, 0, 1)                 \
     F(GetGlobalObject, 1, 1)                          \
     F(SetGlobalObject, 0, 1)                          \
@@ -106,6 +113,17 @@ class Node;
     F(ObjectDefineSetter, 0, 0)                       \
     F(CallEvalFunction, 0, 0)                         \
     F(CallFunctionInWithScope, 0, 0)                  \
+    F(BinaryEqualAndJumpIfFalse, 1, 2)                \
+    F(BinaryNotEqualAndJumpIfFalse, 1, 2)             \
+    F(BinaryStrictEqualAndJumpIfFalse, 1, 2)          \
+    F(BinaryNotStrictEqualAndJumpIfFalse, 1, 2)       \
+    F(BinaryLessThanAndJumpIfFalse, 1, 2)             \
+    F(BinaryLessThanOrEqualAndJumpIfFalse, 1, 2)      \
+    F(BinaryGreaterThanAndJumpIfFalse, 1, 2)          \
+    F(BinaryGreaterThanOrEqualAndJumpIfFalse, 1, 2)   \
+    F(IncrementAndJump, 1, 1)                         \
+    F(DecrementAndJump, 1, 1)                         \
+    F(GetObjectPreComputedCaseAndCall, -1, 1)         \
     F(FillOpcodeTable, 0, 0)                          \
     F(End, 0, 0)
 
@@ -125,6 +143,19 @@ enum Opcode {
 
 struct OpcodeTable {
     void* m_table[OpcodeKindEnd];
+#if defined(COMPILER_GCC)
+    // (label address, Opcode) sorted by address, to find the Opcode of a relocated ByteCode
+    std::pair<void*, Opcode> m_reverseTable[OpcodeKindEnd];
+
+    Opcode opcodeOf(void* address) const
+    {
+        auto iter = std::lower_bound(m_reverseTable, m_reverseTable + OpcodeKindEnd, std::make_pair(address, (Opcode)0));
+        if (iter == m_reverseTable + OpcodeKindEnd || iter->first != address) {
+            return OpcodeKindEnd;
+        }
+        return iter->second;
+    }
+#endif
     OpcodeTable();
 };
 
@@ -197,6 +228,19 @@ public:
 #endif
     }
 
+    // used by ByteCodeGenerator::fuseByteCode to turn a ByteCode into a superinstruction before relocation
+    void changeOpcode(Opcode code)
+    {
+#if defined(COMPILER_GCC)
+        m_opcodeInAddress = (void*)code;
+#else
+        m_opcode = code;
+#endif
+#ifndef NDEBUG
+        m_orgOpcode = code;
+#endif
+    }
+
 #if defined(COMPILER_GCC)
     void* m_opcodeInAddress;
 #else
@@ -334,6 +378,50 @@ public:
 #endif
 };
 
+// access to a variable of an upper function through the closure display of the running function.
+// m_displayIndex is the upper index minus one, see FunctionObject::closureDisplay
+class LoadByClosureIndex : public ByteCode {
+public:
+    LoadByClosureIndex(const ByteCodeLOC& loc, const size_t& registerIndex, const size_t& displayIndex, const size_t& index)
+        : ByteCode(Opcode::LoadByClosureIndexOpcode, loc)
+        , m_registerIndex(registerIndex)
+        , m_displayIndex(displayIndex)
+        , m_index(index)
+    {
+    }
+    ByteCodeRegisterIndex m_registerIndex;
+    ByteCodeRegisterIndex m_displayIndex;
+    ByteCodeRegisterIndex m_index;
+
+#ifndef NDEBUG
+    virtual void dump()
+    {
+        printf("load r%d <- closure[%d][%d]", (int)m_registerIndex, (int)m_displayIndex, (int)m_index);
+    }
+#endif
+};
+
+class StoreByClosureIndex : public ByteCode {
+public:
+    StoreByClosureIndex(const ByteCodeLOC& loc, const size_t& registerIndex, const size_t& displayIndex, const size_t& index)
+        : ByteCode(Opcode::StoreByClosureIndexOpcode, loc)
+        , m_registerIndex(registerIndex)
+        , m_displayIndex(displayIndex)
+        , m_index(index)
+    {
+    }
+    ByteCodeRegisterIndex m_registerIndex;
+    ByteCodeRegisterIndex m_displayIndex;
+    ByteCodeRegisterIndex m_index;
+
+#ifndef NDEBUG
+    virtual void dump()
+    {
+        printf("store closure[%d][%d] <- r%d", (int)m_displayIndex, (int)m_index, (int)m_registerIndex);
+    }
+#endif
+};
+
 class DeclareFunctionDeclarations : public ByteCode {
 public:
     DeclareFunctionDeclarations(InterpretedCodeBlock* cb)
@@ -421,18 +509,21 @@ DEFINE_BINARY_OPERATION(InstanceOfOperation, "instance of");
 
 class CreateObject : public ByteCode {
 public:
-    CreateObject(const ByteCodeLOC& loc, const size_t& registerIndex)
+    CreateObject(const ByteCodeLOC& loc, const size_t& registerIndex, const size_t& propertyCount = 0)
         : ByteCode(Opcode::CreateObjectOpcode, loc)
         , m_registerIndex(registerIndex)
+        , m_propertyCount(propertyCount)
     {
     }
 
     ByteCodeRegisterIndex m_registerIndex;
+    // number of properties of the object literal. the storage is reserved at once
+    size_t m_propertyCount;
 
 #ifndef NDEBUG
     virtual void dump()
     {
-        printf("createobject -> r%d", (int)m_registerIndex);
+        printf("createobject (%d properties) -> r%d", (int)m_propertyCount, (int)m_registerIndex);
     }
 #endif
 };
@@ -479,6 +570,56 @@ public:
 #endif
 };
 
+// arguments.length and arguments[property] of a function which does not need its arguments object.
+// they read argc and argv of the call until the object is created by a read of another property.
+// m_argumentsRegisterIndex is the variable of the object, m_catchScopeCount is the number of catch
+// contexts between the running context and the one of the function
+class GetArgumentsLength : public ByteCode {
+public:
+    GetArgumentsLength(const ByteCodeLOC& loc, const size_t& argumentsRegisterIndex, const size_t& storeRegisterIndex, const size_t& catchScopeCount)
+        : ByteCode(Opcode::GetArgumentsLengthOpcode, loc)
+        , m_argumentsRegisterIndex(argumentsRegisterIndex)
+        , m_storeRegisterIndex(storeRegisterIndex)
+        , m_catchScopeCount(catchScopeCount)
+    {
+    }
+
+    ByteCodeRegisterIndex m_argumentsRegisterIndex;
+    ByteCodeRegisterIndex m_storeRegisterIndex;
+    ByteCodeRegisterIndex m_catchScopeCount;
+
+#ifndef NDEBUG
+    virtual void dump()
+    {
+        printf("get arguments length r%d <- r%d", (int)m_storeRegisterIndex, (int)m_argumentsRegisterIndex);
+    }
+#endif
+};
+
+class GetArgumentsElement : public ByteCode {
+public:
+    GetArgumentsElement(const ByteCodeLOC& loc, const size_t& argumentsRegisterIndex, const size_t& propertyRegisterIndex, const size_t& storeRegisterIndex, const size_t& catchScopeCount)
+        : ByteCode(Opcode::GetArgumentsElementOpcode, loc)
+        , m_argumentsRegisterIndex(argumentsRegisterIndex)
+        , m_propertyRegisterIndex(propertyRegisterIndex)
+        , m_storeRegisterIndex(storeRegisterIndex)
+        , m_catchScopeCount(catchScopeCount)
+    {
+    }
+
+    ByteCodeRegisterIndex m_argumentsRegisterIndex;
+    ByteCodeRegisterIndex m_propertyRegisterIndex;
+    ByteCodeRegisterIndex m_storeRegisterIndex;
+    ByteCodeRegisterIndex m_catchScopeCount;
+
+#ifndef NDEBUG
+    virtual void dump()
+    {
+        printf("get arguments element r%d <- r%d[r%d]", (int)m_storeRegisterIndex, (int)m_argumentsRegisterIndex, (int)m_propertyRegisterIndex);
+    }
+#endif
+};
+
 class SetObjectOperation : public ByteCode {
 public:
     SetObjectOperation(const ByteCodeLOC& loc, const size_t& objectRegisterIndex, const size_t& propertyRegisterIndex, const size_t& loadRegisterIndex)
@@ -583,52 +724,59 @@ struct ObjectStructureChainItem : public gc {
     }
 };
 
-typedef std::vector<ObjectStructureChainItem, std::allocator<ObjectStructureChainItem>> ObjectStructureChain;
-typedef std::vector<ObjectStructureChainItem, GCUtil::gc_malloc_atomic_ignore_off_page_allocator<ObjectStructureChainItem>> ObjectStructureChainGC;
 typedef Vector<ObjectStructureChainItem, GCUtil::gc_malloc_ignore_off_page_allocator<ObjectStructureChainItem>, 200> ObjectStructureChainWithGC;
 
+// Entries which depend on the prototype chain of the receiver (m_cachedPrototypeEpoch != 0)
+// are valid while the receiver's [[Prototype]] is m_cachedPrototype and VMInstance::prototypeEpoch() is unchanged.
+// Every object on the cached chain is marked as a prototype object, so any change of them bumps the epoch.
 struct GetObjectInlineCacheData {
-    GetObjectInlineCacheData()
-    {
-        m_cachedIndex = SIZE_MAX;
-    }
-
-    GetObjectInlineCacheData(const GetObjectInlineCacheData& src)
-    {
-        m_cachedhiddenClassChain = src.m_cachedhiddenClassChain;
-        m_cachedIndex = src.m_cachedIndex;
-    }
-
-    GetObjectInlineCacheData(GetObjectInlineCacheData&& src)
-    {
-        m_cachedhiddenClassChain = std::move(src.m_cachedhiddenClassChain);
-        m_cachedIndex = src.m_cachedIndex;
-    }
-
-    GetObjectInlineCacheData& operator=(const GetObjectInlineCacheData& src)
-    {
-        m_cachedhiddenClassChain = src.m_cachedhiddenClassChain;
-        m_cachedIndex = src.m_cachedIndex;
-        return *this;
-    }
-
-    ObjectStructureChain m_cachedhiddenClassChain;
+    ObjectStructure* m_cachedStructure;
+    Object* m_cachedPrototype;
+    // object that has the property, or nullptr for own properties and missing properties
+    Object* m_cachedHolder;
+    // SIZE_MAX means the property does not exist on the prototype chain
     size_t m_cachedIndex;
+    size_t m_cachedPrototypeEpoch;
 };
 
-typedef std::vector<GetObjectInlineCacheData, std::allocator<GetObjectInlineCacheData>> GetObjectInlineCacheDataVector;
-
 struct GetObjectInlineCache {
-    GetObjectInlineCache()
-    {
-        m_cacheMissCount = m_executeCount = 0;
-    }
+    static const size_t polymorphicCacheSize = 4;
 
-    GetObjectInlineCacheDataVector m_cache;
+    GetObjectInlineCache()
+        : m_monomorphicStructure(nullptr)
+        , m_monomorphicIndex(SIZE_MAX)
+        , m_polymorphicCache(nullptr)
+        , m_polymorphicCacheFillCount(0)
+        , m_polymorphicCacheNextIndex(0)
+        , m_executeCount(0)
+        , m_cacheMissCount(0)
+    {
+    }
+
+    // own property of the receiver
+    ObjectStructure* m_monomorphicStructure;
+    size_t m_monomorphicIndex;
+    // allocated on the first polymorphic miss and kept alive by ByteCodeBlock::m_literalData
+    GetObjectInlineCacheData* m_polymorphicCache;
+    uint8_t m_polymorphicCacheFillCount;
+    uint8_t m_polymorphicCacheNextIndex;
     uint16_t m_executeCount;
     uint16_t m_cacheMissCount;
 };
 
+#ifndef ESCARGOT_MEGAMORPHIC_PROPERTY_CACHE_SIZE
+#define ESCARGOT_MEGAMORPHIC_PROPERTY_CACHE_SIZE 512
+#endif
+
+// VMInstance-wide direct mapped cache used by megamorphic GetObjectPreComputedCase sites.
+// keyed by (m_data.m_cachedStructure, atomic string of property name)
+struct GetObjectMegamorphicCacheEntry {
+    String* m_propertyName;
+    GetObjectInlineCacheData m_data;
+};
+// the cache is indexed by hash & (ESCARGOT_MEGAMORPHIC_PROPERTY_CACHE_SIZE - 1)
+COMPILE_ASSERT(ESCARGOT_MEGAMORPHIC_PROPERTY_CACHE_SIZE && (ESCARGOT_MEGAMORPHIC_PROPERTY_CACHE_SIZE & (ESCARGOT_MEGAMORPHIC_PROPERTY_CACHE_SIZE - 1)) == 0, ESCARGOT_MEGAMORPHIC_PROPERTY_CACHE_SIZE_must_be_power_of_two);
+
 class GetObjectPreComputedCase : public ByteCode {
 public:
     // [object] -> [value]
@@ -653,22 +801,31 @@ public:
 };
 
 struct SetObjectInlineCache {
-    ObjectStructureChainGC m_cachedhiddenClassChain;
+    ObjectStructure* m_cachedStructure;
+    // own property case
     size_t m_cachedIndex;
+    // adding property case. valid with same m_cachedPrototype and m_cachedPrototypeEpoch (see GetObjectInlineCacheData)
     ObjectStructure* m_hiddenClassWillBe;
+    Object* m_cachedPrototype;
+    size_t m_cachedPrototypeEpoch;
     size_t m_cacheMissCount;
     SetObjectInlineCache()
     {
+        m_cachedStructure = nullptr;
         m_cachedIndex = SIZE_MAX;
         m_hiddenClassWillBe = nullptr;
+        m_cachedPrototype = nullptr;
+        m_cachedPrototypeEpoch = 0;
         m_cacheMissCount = 0;
     }
 
     void invalidateCache()
     {
+        m_cachedStructure = nullptr;
         m_cachedIndex = SIZE_MAX;
         m_hiddenClassWillBe = nullptr;
-        m_cachedhiddenClassChain.clear();
+        m_cachedPrototype = nullptr;
+        m_cachedPrototypeEpoch = 0;
     }
 
     void* operator new(size_t size);
@@ -1121,6 +1278,47 @@ public:
 #endif
 };
 
+// what FunctionObject::initializeInterpretedCallFrame computes from the callee on every call.
+// filled by FunctionObject::fillInterpretedCallFrameLayout
+struct InterpretedCallFrameLayout {
+    enum ReceiverMode : uint8_t {
+        ReceiverAsIs, // strict mode
+        ReceiverToObject, // undefined and null become the global object
+        ReceiverGlobalObject, // arrow function
+    };
+
+    // size of the frame without InterpretedCallFrame
+    uint32_t m_frameSize;
+    ByteCodeRegisterIndex m_registerSize;
+    ByteCodeRegisterIndex m_stackStorageSize;
+    ByteCodeRegisterIndex m_literalStorageSize;
+    uint16_t m_parameterCount;
+    bool m_isStrict;
+    // environment on the frame, parameters copied in order, no arguments object and no binding of the function name.
+    // FunctionObject::initializeSimpleInterpretedCallFrame builds these frames
+    bool m_isSimple;
+    ReceiverMode m_receiverMode;
+};
+
+// interpreted function called by a call site, filled by its first call of one.
+// other callees take the generic path, so m_codeBlock is kept alive by ByteCodeBlock::m_literalData once
+struct CallFunctionCache {
+    CallFunctionCache()
+        : m_codeBlock(nullptr)
+        , m_byteCodeBlock(nullptr)
+        , m_byteCodeBlockGeneration(0)
+    {
+    }
+
+    InterpretedCodeBlock* m_codeBlock;
+    // m_layout is valid while this is the ByteCodeBlock of m_codeBlock.
+    // the cache lives in ByteCodeBlock::m_code which GC does not scan, so m_byteCodeBlock may be freed
+    // and another block allocated at its address. the generation tells them apart
+    ByteCodeBlock* m_byteCodeBlock;
+    uint32_t m_byteCodeBlockGeneration;
+    InterpretedCallFrameLayout m_layout;
+};
+
 class CallFunction : public ByteCode {
 public:
     CallFunction(const ByteCodeLOC& loc, const size_t& calleeIndex, const size_t& argumentsStartIndex, const size_t& argumentCount, const size_t& resultIndex)
@@ -1135,6 +1333,7 @@ public:
     ByteCodeRegisterIndex m_argumentsStartIndex;
     uint16_t m_argumentCount;
     ByteCodeRegisterIndex m_resultIndex;
+    CallFunctionCache m_callCache;
 
 #ifndef NDEBUG
     virtual void dump()
@@ -1161,6 +1360,7 @@ public:
     ByteCodeRegisterIndex m_argumentsStartIndex;
     uint16_t m_argumentCount;
     ByteCodeRegisterIndex m_resultIndex;
+    CallFunctionCache m_callCache;
 
 #ifndef NDEBUG
     virtual void dump()
@@ -1170,6 +1370,49 @@ public:
 #endif
 };
 
+// Superinstructions
+// ByteCodeGenerator::fuseByteCode rewrites a pair of adjacent ByteCodes into one of these in place.
+// The first ByteCode keeps its operands under the new opcode and the second one is kept as a member,
+// so the pair occupies the same bytes as before and no jump position or LOC data has to be moved.
+#ifdef NDEBUG
+#define DEFINE_SUPERINSTRUCTION_DUMP(second)
+#else
+#define DEFINE_SUPERINSTRUCTION_DUMP(second) \
+    virtual void dump()                      \
+    {                                        \
+        First::dump();                       \
+        printf(" & ");                       \
+        second.dump();                       \
+    }
+#endif
+
+#define DEFINE_SUPERINSTRUCTION(CodeName, FirstCodeName, SecondCodeName, second) \
+    class CodeName : public FirstCodeName {                                        \
+    public:                                                                        \
+        typedef FirstCodeName First;                                               \
+        CodeName(const FirstCodeName& first, const SecondCodeName& secondCode)     \
+            : FirstCodeName(first)                                                 \
+            , second(secondCode)                                                   \
+        {                                                                          \
+            changeOpcode(Opcode::CodeName##Opcode);                                \
+        }                                                                          \
+        SecondCodeName second;                                                     \
+        DEFINE_SUPERINSTRUCTION_DUMP(second)                                       \
+    };                                                                             \
+    COMPILE_ASSERT(sizeof(CodeName) == sizeof(FirstCodeName) + sizeof(SecondCodeName), "");
+
+DEFINE_SUPERINSTRUCTION(BinaryEqualAndJumpIfFalse, BinaryEqual, JumpIfFalse, m_jumpIfFalse);
+DEFINE_SUPERINSTRUCTION(BinaryNotEqualAndJumpIfFalse, BinaryNotEqual, JumpIfFalse, m_jumpIfFalse);
+DEFINE_SUPERINSTRUCTION(BinaryStrictEqualAndJumpIfFalse, BinaryStrictEqual, JumpIfFalse, m_jumpIfFalse);
+DEFINE_SUPERINSTRUCTION(BinaryNotStrictEqualAndJumpIfFalse, BinaryNotStrictEqual, JumpIfFalse, m_jumpIfFalse);
+DEFINE_SUPERINSTRUCTION(BinaryLessThanAndJumpIfFalse, BinaryLessThan, JumpIfFalse, m_jumpIfFalse);
+DEFINE_SUPERINSTRUCTION(BinaryLessThanOrEqualAndJumpIfFalse, BinaryLessThanOrEqual, JumpIfFalse, m_jumpIfFalse);
+DEFINE_SUPERINSTRUCTION(BinaryGreaterThanAndJumpIfFalse, BinaryGreaterThan, JumpIfFalse, m_jumpIfFalse);
+DEFINE_SUPERINSTRUCTION(BinaryGreaterThanOrEqualAndJumpIfFalse, BinaryGreaterThanOrEqual, JumpIfFalse, m_jumpIfFalse);
+DEFINE_SUPERINSTRUCTION(IncrementAndJump, Increment, Jump, m_jump);
+DEFINE_SUPERINSTRUCTION(DecrementAndJump, Decrement, Jump, m_jump);
+DEFINE_SUPERINSTRUCTION(GetObjectPreComputedCaseAndCall, GetObjectPreComputedCase, CallFunctionWithReceiver, m_call);
+
 class CallEvalFunction : public ByteCode {
 public:
     CallEvalFunction(const ByteCodeLOC& loc, const size_t& evalIndex, const size_t& argumentsStartIndex, size_t argumentCount, const size_t& resultIndex, bool inWithScope)
@@ -1380,19 +1623,36 @@ public:
 #endif
 };
 
+// keys of for-in enumeration
+// a key list stored on ObjectStructure::enumerationCache() is shared between enumerations, so it is never modified.
+// it is valid while the receiver's [[Prototype]] is m_prototype and VMInstance::prototypeEpoch() is m_prototypeEpoch
+struct EnumerateObjectKeys : public gc {
+    EnumerateObjectKeys()
+    {
+        m_prototype = nullptr;
+        m_prototypeEpoch = 0;
+    }
+
+    Object* m_prototype;
+    size_t m_prototypeEpoch;
+    SmallValueVector m_names;
+};
+
 struct EnumerateObjectData : public PointerValue {
     EnumerateObjectData()
     {
         m_object = nullptr;
         m_originalLength = 0;
         m_idx = 0;
+        m_keys = nullptr;
     }
 
+    // empty when m_keys came from the enumeration cache of the structure of m_object
     ObjectStructureChainWithGC m_hiddenClassChain;
     Object* m_object;
     uint64_t m_originalLength;
     size_t m_idx;
-    SmallValueVector m_keys;
+    EnumerateObjectKeys* m_keys;
 
     void* operator new(size_t size);
     void* operator new[](size_t size) = delete;
@@ -1559,10 +1819,35 @@ public:
 };
 
 
+// returns 0 for an invalid opcode
+inline size_t byteCodeSize(Opcode opcode)
+{
+    switch (opcode) {
+#define RETURN_BYTECODE_SIZE(name, pushCount, popCount) \
+    case name##Opcode:                                  \
+        return sizeof(name);
+        FOR_EACH_BYTECODE_OP(RETURN_BYTECODE_SIZE)
+#undef RETURN_BYTECODE_SIZE
+    default:
+        return 0;
+    }
+}
+
 typedef Vector<char, std::allocator<char>, 200> ByteCodeBlockData;
 typedef std::vector<std::pair<size_t, size_t>, std::allocator<std::pair<size_t, size_t>>> ByteCodeLOCData;
 typedef Vector<void*, GCUtil::gc_malloc_ignore_off_page_allocator<void*>> ByteCodeLiteralData;
 typedef Vector<Value, std::allocator<Value>> ByteCodeNumeralLiteralData;
+
+// ByteCodes of a try body, catch body or with body, which the interpreter runs in a nested activation
+struct ByteCodeExceptionRegion {
+    size_t m_start;
+    size_t m_end;
+    // index of the innermost region containing this one, or SIZE_MAX
+    size_t m_parent;
+    // only throws in a try body are caught by the activation which runs the region
+    bool m_isTryBody;
+};
+typedef Vector<ByteCodeExceptionRegion, std::allocator<ByteCodeExceptionRegion>> ByteCodeExceptionRegionData;
 typedef std::unordered_set<ObjectStructure*, std::hash<ObjectStructure*>, std::equal_to<ObjectStructure*>,
                            GCUtil::gc_malloc_ignore_off_page_allocator<ObjectStructure*>>
     ObjectStructuresInUse;
@@ -1570,17 +1855,27 @@ class ByteCodeBlock : public gc {
     friend struct OpcodeTable;
     ByteCodeBlock()
     {
+#if defined(ESCARGOT_ENABLE_JIT)
+        m_executionCount = 0;
+        m_jitCode = nullptr;
+#endif
     }
 
 public:
     ByteCodeBlock(InterpretedCodeBlock* codeBlock)
     {
         m_requiredRegisterFileSizeInValueSize = 2;
+        m_closureDisplaySize = 0;
+        m_needsArgumentsObject = true;
         m_codeBlock = codeBlock;
         m_isEvalMode = false;
         m_isOnGlobal = false;
         m_shouldClearStack = false;
         m_locData = nullptr;
+#if defined(ESCARGOT_ENABLE_JIT)
+        m_executionCount = 0;
+        m_jitCode = nullptr;
+#endif
 
         if (!codeBlock->hasCallNativeFunctionCode()) {
             m_objectStructuresInUse = new (GC) ObjectStructuresInUse();
@@ -1590,15 +1885,14 @@ public:
 
         GC_REGISTER_FINALIZER_NO_ORDER(this, [](void* obj, void*) {
             ByteCodeBlock* self = (ByteCodeBlock*)obj;
-            for (size_t i = 0; i < self->m_getObjectCodePositions.size(); i++) {
-                GetObjectInlineCacheDataVector().swap(((GetObjectPreComputedCase*)((size_t)self->m_code.data() + self->m_getObjectCodePositions[i]))->m_inlineCache.m_cache);
-            }
-            std::vector<size_t>().swap(self->m_getObjectCodePositions);
-
             self->m_numeralLiteralData.clear();
+            self->m_exceptionRegions.clear();
             self->m_code.clear();
             if (self->m_locData)
                 delete self->m_locData;
+#if defined(ESCARGOT_ENABLE_JIT)
+            delete self->m_jitCode;
+#endif
         },
                                        nullptr, nullptr, nullptr);
     }
@@ -1636,6 +1930,15 @@ public:
         // TODO throw exception
         RELEASE_ASSERT(m_requiredRegisterFileSizeInValueSize < std::numeric_limits<ByteCodeRegisterIndex>::max());
     }
+
+    // display index of the function environment upperIndex levels above the running function
+    size_t closureDisplayIndex(size_t upperIndex)
+    {
+        ASSERT(upperIndex > 0);
+        m_closureDisplaySize = std::max(m_closureDisplaySize, (ByteCodeRegisterIndex)upperIndex);
+        return upperIndex - 1;
+    }
+
     template <typename CodeType>
     CodeType* peekCode(size_t position)
     {
@@ -1661,10 +1964,47 @@ public:
         siz += m_locData ? (m_locData->size() * sizeof(std::pair<size_t, size_t>)) : 0;
         siz += m_literalData.size() * sizeof(size_t);
         siz += m_objectStructuresInUse->size() * sizeof(size_t);
-        siz += m_getObjectCodePositions.size() * sizeof(size_t);
+#if defined(ESCARGOT_ENABLE_JIT)
+        siz += m_jitCode ? m_jitCode->codeSize() : 0;
+#endif
         return siz;
     }
 
+    void pushExceptionRegion(size_t start, size_t end, bool isTryBody)
+    {
+        ByteCodeExceptionRegion region;
+        region.m_start = start;
+        region.m_end = end;
+        region.m_parent = SIZE_MAX;
+        region.m_isTryBody = isTryBody;
+        m_exceptionRegions.pushBack(region);
+    }
+
+    // sorts the regions by start position and links each one to its enclosing region.
+    // called once after generation, so isInTryBody can binary search the table
+    void sortExceptionRegions();
+
+    // returns true if the innermost region containing the ByteCode is a try body.
+    // then a throw there is handled by the tryOperation which runs the current activation
+    bool isInTryBody(size_t codePosition)
+    {
+        ByteCodeExceptionRegion* begin = m_exceptionRegions.data();
+        ByteCodeExceptionRegion* end = begin + m_exceptionRegions.size();
+        ByteCodeExceptionRegion* last = std::upper_bound(begin, end, codePosition, [](size_t pos, const ByteCodeExceptionRegion& region) -> bool {
+            return pos < region.m_start;
+        });
+        if (last == begin) {
+            return false;
+        }
+        // regions are nested, so the innermost region containing the ByteCode
+        // is the last one starting before it or one of its enclosing regions
+        size_t index = last - begin - 1;
+        while (index != SIZE_MAX && m_exceptionRegions[index].m_end <= codePosition) {
+            index = m_exceptionRegions[index].m_parent;
+        }
+        return index != SIZE_MAX && m_exceptionRegions[index].m_isTryBody;
+    }
+
     ExtendedNodeLOC computeNodeLOCFromByteCode(Context* c, size_t codePosition, CodeBlock* cb);
     ExtendedNodeLOC computeNodeLOC(StringView src, ExtendedNodeLOC sourceElementStart, size_t index);
     void fillLocDataIfNeeded(Context* c);
@@ -1672,17 +2012,26 @@ public:
     bool m_isEvalMode : 1;
     bool m_isOnGlobal : 1;
     bool m_shouldClearStack : 1;
+    // false if the arguments object is only read by GetArgumentsLength and GetArgumentsElement,
+    // then calls do not create it
+    bool m_needsArgumentsObject : 1;
     ByteCodeRegisterIndex m_requiredRegisterFileSizeInValueSize : REGISTER_INDEX_IN_BIT;
+    // display entries which LoadByClosureIndex and StoreByClosureIndex of this block need
+    ByteCodeRegisterIndex m_closureDisplaySize;
 
     ByteCodeBlockData m_code;
     ByteCodeNumeralLiteralData m_numeralLiteralData;
     ByteCodeLiteralData m_literalData;
     ObjectStructuresInUse* m_objectStructuresInUse;
+    ByteCodeExceptionRegionData m_exceptionRegions;
 
     ByteCodeLOCData* m_locData;
     InterpretedCodeBlock* m_codeBlock;
-
-    std::vector<size_t> m_getObjectCodePositions;
+#if defined(ESCARGOT_ENABLE_JIT)
+    // calls and loop iterations in the interpreter, m_jitCode is generated when it reaches ESCARGOT_JIT_HOT_COUNT
+    uint32_t m_executionCount;
+    JITCode* m_jitCode;
+#endif
 
     void* operator new(size_t size);
 };
@@ -131,14 +131,43 @@ void ByteCodeGenerator::generateLoadThisValueByteCode(ByteCodeBlock* block, Byte
             block->pushCode(LoadByName(ByteCodeLOC(SIZE_MAX), REGULAR_REGISTER_LIMIT, codeBlock->context()->staticStrings().stringThis), context, nullptr);
         } else {
             ASSERT(info.m_isResultSaved && info.m_upperIndex == 1 && !context->m_catchScopeCount);
-            block->pushCode(LoadByHeapIndex(ByteCodeLOC(SIZE_MAX), REGULAR_REGISTER_LIMIT, info.m_upperIndex, info.m_index), context, nullptr);
+            block->pushCode(LoadByClosureIndex(ByteCodeLOC(SIZE_MAX), REGULAR_REGISTER_LIMIT, block->closureDisplayIndex(info.m_upperIndex), info.m_index), context, nullptr);
         }
     } else {
         block->pushCode(LoadByName(ByteCodeLOC(SIZE_MAX), REGULAR_REGISTER_LIMIT, codeBlock->context()->staticStrings().stringThis), context, nullptr);
     }
 }
 
-ByteCodeBlock* ByteCodeGenerator::generateByteCode(Context* c, InterpretedCodeBlock* codeBlock, Node* ast, ASTScopeContext* scopeCtx, bool isEvalMode, bool isOnGlobal, bool shouldGenerateLOCData)
+bool ByteCodeGenerator::canReadArgumentsDirectly(InterpretedCodeBlock* codeBlock)
+{
+    if (!codeBlock->usesArgumentsObject() || !codeBlock->canUseIndexedVariableStorage() || codeBlock->hasWith()) {
+        return false;
+    }
+
+    // the object is kept in a stack variable once it is created
+    AtomicString arguments = codeBlock->context()->staticStrings().arguments;
+    InterpretedCodeBlock::IndexedIdentifierInfo info = codeBlock->indexedIdentifierInfo(arguments);
+    if (!info.m_isResultSaved || info.m_upperIndex || !info.m_isStackAllocated) {
+        return false;
+    }
+    const InterpretedCodeBlock::IdentifierInfoVector& identifiers = codeBlock->identifierInfos();
+    for (size_t i = 0; i < identifiers.size(); i++) {
+        if (identifiers[i].m_name == arguments && identifiers[i].m_isExplicitlyDeclaredOrParameterName) {
+            return false;
+        }
+    }
+
+    // mapped elements are read from the storage of their parameter
+    const InterpretedCodeBlock::FunctionParametersInfoVector& parameters = codeBlock->parametersInfomation();
+    for (size_t i = 0; i < parameters.size(); i++) {
+        if (parameters[i].m_isDuplicated) {
+            return false;
+        }
+    }
+    return true;
+}
+
+ByteCodeBlock* ByteCodeGenerator::generateByteCode(Context* c, InterpretedCodeBlock* codeBlock, Node* ast, ASTScopeContext* scopeCtx, bool isEvalMode, bool isOnGlobal, bool shouldGenerateLOCData, bool shouldRelocate)
 {
     ByteCodeBlock* block = new ByteCodeBlock(codeBlock);
     block->m_isEvalMode = isEvalMode;
@@ -160,6 +189,10 @@ ByteCodeBlock* ByteCodeGenerator::generateByteCode(Context* c, InterpretedCodeBl
 
     ByteCodeGenerateContext ctx(codeBlock, block, info, nData);
     ctx.m_shouldGenerateLOCData = shouldGenerateLOCData;
+    // other uses of arguments set it again, see IdentifierNode
+    if (!isEvalMode && canReadArgumentsDirectly(codeBlock)) {
+        block->m_needsArgumentsObject = false;
+    }
     if (shouldGenerateLOCData) {
         block->m_locData = new ByteCodeLOCData();
     }
@@ -202,6 +235,7 @@ ByteCodeBlock* ByteCodeGenerator::generateByteCode(Context* c, InterpretedCodeBl
         }
     } catch (const ByteCodeGenerateError& err) {
         block->m_code.clear();
+        block->m_exceptionRegions.clear();
         char* data = (char*)GC_MALLOC_ATOMIC(err.m_message.size());
         memcpy(data, err.m_message.data(), err.m_message.size());
         data[err.m_message.size()] = 0;
@@ -225,310 +259,15 @@ ByteCodeBlock* ByteCodeGenerator::generateByteCode(Context* c, InterpretedCodeBl
     }
 
     block->m_code.shrinkToFit();
+    block->sortExceptionRegions();
 
-    block->m_getObjectCodePositions = std::move(ctx.m_getObjectCodePositions);
-
-    {
-        ByteCodeRegisterIndex stackBase = REGULAR_REGISTER_LIMIT;
-        ByteCodeRegisterIndex stackBaseWillBe = block->m_requiredRegisterFileSizeInValueSize;
-        ByteCodeRegisterIndex stackVariableSize = codeBlock->identifierOnStackCount();
-        size_t idx = 0;
-        size_t bytecodeCounter = 0;
-
-        char* code = block->m_code.data();
-        size_t codeBase = (size_t)code;
-        char* end = &block->m_code.data()[block->m_code.size()];
-        while (&code[idx] < end) {
-            ByteCode* currentCode = (ByteCode*)(&code[idx]);
-#if defined(COMPILER_GCC)
-            Opcode opcode = (Opcode)(size_t)currentCode->m_opcodeInAddress;
-#else
-            Opcode opcode = currentCode->m_opcode;
-#endif
-            currentCode->assignOpcodeInAddress();
-
-            switch (opcode) {
-            case LoadLiteralOpcode: {
-                LoadLiteral* cd = (LoadLiteral*)currentCode;
-                assignStackIndexIfNeeded(cd->m_registerIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                break;
-            }
-            case LoadRegexpOpcode: {
-                LoadRegexp* cd = (LoadRegexp*)currentCode;
-                assignStackIndexIfNeeded(cd->m_registerIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                break;
-            }
-            case LoadByNameOpcode: {
-                LoadByName* cd = (LoadByName*)currentCode;
-                assignStackIndexIfNeeded(cd->m_registerIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                break;
-            }
-            case StoreByNameOpcode: {
-                StoreByName* cd = (StoreByName*)currentCode;
-                assignStackIndexIfNeeded(cd->m_registerIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                break;
-            }
-            case LoadByHeapIndexOpcode: {
-                LoadByHeapIndex* cd = (LoadByHeapIndex*)currentCode;
-                assignStackIndexIfNeeded(cd->m_registerIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                break;
-            }
-            case StoreByHeapIndexOpcode: {
-                StoreByHeapIndex* cd = (StoreByHeapIndex*)currentCode;
-                assignStackIndexIfNeeded(cd->m_registerIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                break;
-            }
-            case CreateFunctionOpcode: {
-                CreateFunction* cd = (CreateFunction*)currentCode;
-                assignStackIndexIfNeeded(cd->m_registerIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                break;
-            }
-            case CreateObjectOpcode: {
-                CreateObject* cd = (CreateObject*)currentCode;
-                assignStackIndexIfNeeded(cd->m_registerIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                break;
-            }
-            case CreateArrayOpcode: {
-                CreateArray* cd = (CreateArray*)currentCode;
-                assignStackIndexIfNeeded(cd->m_registerIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                break;
-            }
-            case GetObjectOpcode: {
-                GetObject* cd = (GetObject*)currentCode;
-                assignStackIndexIfNeeded(cd->m_storeRegisterIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                assignStackIndexIfNeeded(cd->m_objectRegisterIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                assignStackIndexIfNeeded(cd->m_propertyRegisterIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                break;
-            }
-            case SetObjectOperationOpcode: {
-                SetObjectOperation* cd = (SetObjectOperation*)currentCode;
-                assignStackIndexIfNeeded(cd->m_objectRegisterIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                assignStackIndexIfNeeded(cd->m_propertyRegisterIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                assignStackIndexIfNeeded(cd->m_loadRegisterIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                break;
-            }
-            case ObjectDefineOwnPropertyOperationOpcode: {
-                ObjectDefineOwnPropertyOperation* cd = (ObjectDefineOwnPropertyOperation*)currentCode;
-                assignStackIndexIfNeeded(cd->m_objectRegisterIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                assignStackIndexIfNeeded(cd->m_propertyRegisterIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                assignStackIndexIfNeeded(cd->m_loadRegisterIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                break;
-            }
-            case ObjectDefineOwnPropertyWithNameOperationOpcode: {
-                ObjectDefineOwnPropertyWithNameOperation* cd = (ObjectDefineOwnPropertyWithNameOperation*)currentCode;
-                assignStackIndexIfNeeded(cd->m_objectRegisterIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                assignStackIndexIfNeeded(cd->m_loadRegisterIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                assignStackIndexIfNeeded(cd->m_loadRegisterIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                break;
-            }
-            case ArrayDefineOwnPropertyOperationOpcode: {
-                ArrayDefineOwnPropertyOperation* cd = (ArrayDefineOwnPropertyOperation*)currentCode;
-                assignStackIndexIfNeeded(cd->m_objectRegisterIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                for (size_t i = 0; i < cd->m_count; i++)
-                    assignStackIndexIfNeeded(cd->m_loadRegisterIndexs[i], stackBase, stackBaseWillBe, stackVariableSize);
-                break;
-            }
-            case GetObjectPreComputedCaseOpcode: {
-                GetObjectPreComputedCase* cd = (GetObjectPreComputedCase*)currentCode;
-                assignStackIndexIfNeeded(cd->m_objectRegisterIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                assignStackIndexIfNeeded(cd->m_storeRegisterIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                break;
-            }
-            case SetObjectPreComputedCaseOpcode: {
-                SetObjectPreComputedCase* cd = (SetObjectPreComputedCase*)currentCode;
-                assignStackIndexIfNeeded(cd->m_objectRegisterIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                assignStackIndexIfNeeded(cd->m_loadRegisterIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                break;
-            }
-            case ReturnFunctionWithValueOpcode: {
-                ReturnFunctionWithValue* cd = (ReturnFunctionWithValue*)currentCode;
-                assignStackIndexIfNeeded(cd->m_registerIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                break;
-            }
-            case ReturnFunctionSlowCaseOpcode: {
-                ReturnFunctionSlowCase* cd = (ReturnFunctionSlowCase*)currentCode;
-                assignStackIndexIfNeeded(cd->m_registerIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                break;
-            }
-            case MoveOpcode: {
-                Move* cd = (Move*)currentCode;
-                assignStackIndexIfNeeded(cd->m_registerIndex0, stackBase, stackBaseWillBe, stackVariableSize);
-                assignStackIndexIfNeeded(cd->m_registerIndex1, stackBase, stackBaseWillBe, stackVariableSize);
-                break;
-            }
-            case ObjectDefineGetterOpcode: {
-                ObjectDefineGetter* cd = (ObjectDefineGetter*)currentCode;
-                assignStackIndexIfNeeded(cd->m_objectRegisterIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                assignStackIndexIfNeeded(cd->m_objectPropertyNameRegisterIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                assignStackIndexIfNeeded(cd->m_objectPropertyValueRegisterIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                break;
-            }
-            case ObjectDefineSetterOpcode: {
-                ObjectDefineSetter* cd = (ObjectDefineSetter*)currentCode;
-                assignStackIndexIfNeeded(cd->m_objectRegisterIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                assignStackIndexIfNeeded(cd->m_objectPropertyNameRegisterIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                assignStackIndexIfNeeded(cd->m_objectPropertyValueRegisterIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                break;
-            }
-            case GetGlobalObjectOpcode: {
-                GetGlobalObject* cd = (GetGlobalObject*)currentCode;
-                assignStackIndexIfNeeded(cd->m_registerIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                break;
-            }
-            case SetGlobalObjectOpcode: {
-                SetGlobalObject* cd = (SetGlobalObject*)currentCode;
-                assignStackIndexIfNeeded(cd->m_registerIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                break;
-            }
-            case ToNumberOpcode:
-            case IncrementOpcode:
-            case DecrementOpcode:
-            case UnaryMinusOpcode:
-            case UnaryNotOpcode:
-            case UnaryBitwiseNotOpcode: {
-                ToNumber* cd = (ToNumber*)currentCode;
-                assignStackIndexIfNeeded(cd->m_srcIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                assignStackIndexIfNeeded(cd->m_dstIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                break;
-            }
-            case UnaryTypeofOpcode: {
-                UnaryTypeof* cd = (UnaryTypeof*)currentCode;
-                assignStackIndexIfNeeded(cd->m_srcIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                assignStackIndexIfNeeded(cd->m_dstIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                break;
-            }
-            case UnaryDeleteOpcode: {
-                UnaryDelete* cd = (UnaryDelete*)currentCode;
-                assignStackIndexIfNeeded(cd->m_srcIndex0, stackBase, stackBaseWillBe, stackVariableSize);
-                assignStackIndexIfNeeded(cd->m_srcIndex1, stackBase, stackBaseWillBe, stackVariableSize);
-                assignStackIndexIfNeeded(cd->m_dstIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                break;
-            }
-            case TemplateOperationOpcode: {
-                TemplateOperation* cd = (TemplateOperation*)currentCode;
-                assignStackIndexIfNeeded(cd->m_src0Index, stackBase, stackBaseWillBe, stackVariableSize);
-                assignStackIndexIfNeeded(cd->m_src1Index, stackBase, stackBaseWillBe, stackVariableSize);
-                assignStackIndexIfNeeded(cd->m_dstIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                break;
-            }
-            case CallFunctionOpcode: {
-                CallFunction* cd = (CallFunction*)currentCode;
-                assignStackIndexIfNeeded(cd->m_calleeIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                assignStackIndexIfNeeded(cd->m_argumentsStartIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                assignStackIndexIfNeeded(cd->m_resultIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                break;
-            }
-            case CallFunctionWithReceiverOpcode: {
-                CallFunctionWithReceiver* cd = (CallFunctionWithReceiver*)currentCode;
-                assignStackIndexIfNeeded(cd->m_receiverIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                assignStackIndexIfNeeded(cd->m_calleeIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                assignStackIndexIfNeeded(cd->m_argumentsStartIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                assignStackIndexIfNeeded(cd->m_resultIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                break;
-            }
-            case CallEvalFunctionOpcode: {
-                CallEvalFunction* cd = (CallEvalFunction*)currentCode;
-                assignStackIndexIfNeeded(cd->m_argumentsStartIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                assignStackIndexIfNeeded(cd->m_resultIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                break;
-            }
-            case CallFunctionInWithScopeOpcode: {
-                CallFunctionInWithScope* cd = (CallFunctionInWithScope*)currentCode;
-                assignStackIndexIfNeeded(cd->m_argumentsStartIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                assignStackIndexIfNeeded(cd->m_resultIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                break;
-            }
-            case NewOperationOpcode: {
-                NewOperation* cd = (NewOperation*)currentCode;
-                assignStackIndexIfNeeded(cd->m_calleeIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                assignStackIndexIfNeeded(cd->m_argumentsStartIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                assignStackIndexIfNeeded(cd->m_resultIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                break;
-            }
-            case JumpOpcode: {
-                Jump* cd = (Jump*)currentCode;
-                cd->m_jumpPosition = cd->m_jumpPosition + codeBase;
-                break;
-            }
-            case JumpComplexCaseOpcode: {
-                JumpComplexCase* cd = (JumpComplexCase*)currentCode;
-                break;
-            }
-            case JumpIfTrueOpcode: {
-                JumpIfTrue* cd = (JumpIfTrue*)currentCode;
-                cd->m_jumpPosition = cd->m_jumpPosition + codeBase;
-                assignStackIndexIfNeeded(cd->m_registerIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                break;
-            }
-            case JumpIfFalseOpcode: {
-                JumpIfFalse* cd = (JumpIfFalse*)currentCode;
-                cd->m_jumpPosition = cd->m_jumpPosition + codeBase;
-                assignStackIndexIfNeeded(cd->m_registerIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                break;
-            }
-            case ThrowOperationOpcode: {
-                ThrowOperation* cd = (ThrowOperation*)currentCode;
-                assignStackIndexIfNeeded(cd->m_registerIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                break;
-            }
-            case EnumerateObjectOpcode: {
-                EnumerateObject* cd = (EnumerateObject*)currentCode;
-                assignStackIndexIfNeeded(cd->m_objectRegisterIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                break;
-            }
-            case WithOperationOpcode: {
-                WithOperation* cd = (WithOperation*)currentCode;
-                assignStackIndexIfNeeded(cd->m_registerIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                break;
-            }
-            case BinaryPlusOpcode:
-            case BinaryMinusOpcode:
-            case BinaryMultiplyOpcode:
-            case BinaryDivisionOpcode:
-            case BinaryModOpcode:
-            case BinaryEqualOpcode:
-            case BinaryNotEqualOpcode:
-            case BinaryLessThanOpcode:
-            case BinaryLessThanOrEqualOpcode:
-            case BinaryGreaterThanOpcode:
-            case BinaryGreaterThanOrEqualOpcode:
-            case BinaryStrictEqualOpcode:
-            case BinaryNotStrictEqualOpcode:
-            case BinaryBitwiseAndOpcode:
-            case BinaryBitwiseOrOpcode:
-            case BinaryBitwiseXorOpcode:
-            case BinaryLeftShiftOpcode:
-            case BinarySignedRightShiftOpcode:
-            case BinaryUnsignedRightShiftOpcode:
-            case BinaryInOperationOpcode:
-            case BinaryInstanceOfOperationOpcode: {
-                BinaryPlus* plus = (BinaryPlus*)currentCode;
-                assignStackIndexIfNeeded(plus->m_srcIndex0, stackBase, stackBaseWillBe, stackVariableSize);
-                assignStackIndexIfNeeded(plus->m_srcIndex1, stackBase, stackBaseWillBe, stackVariableSize);
-                assignStackIndexIfNeeded(plus->m_dstIndex, stackBase, stackBaseWillBe, stackVariableSize);
-                break;
-            }
-            default:
-                break;
-            }
-
-            switch (opcode) {
-#define ITER_BYTE_CODE(code, pushCount, popCount) \
-    case code##Opcode:                            \
-        idx += sizeof(code);                      \
-        continue;
-
-                FOR_EACH_BYTECODE_OP(ITER_BYTE_CODE)
-#undef ITER_BYTE_CODE
-            default:
-                RELEASE_ASSERT_NOT_REACHED();
-                break;
-            };
-        }
+    if (shouldRelocate) {
+        bool isValid = relocateByteCode(block);
+        ASSERT(isValid);
     }
 
 #ifndef NDEBUG
-    if (!shouldGenerateLOCData && getenv("DUMP_BYTECODE") && strlen(getenv("DUMP_BYTECODE"))) {
+    if (shouldRelocate && !shouldGenerateLOCData && getenv("DUMP_BYTECODE") && strlen(getenv("DUMP_BYTECODE"))) {
         printf("dumpBytecode %s (%d:%d)>>>>>>>>>>>>>>>>>>>>>>\n", codeBlock->m_functionName.string()->toUTF8StringData().data(), (int)codeBlock->sourceElementStart().line, (int)codeBlock->sourceElementStart().column);
         printf("register info.. (stack variable size(%d)) [", (int)codeBlock->identifierOnStackCount());
         for (size_t i = 0; i < block->m_requiredRegisterFileSizeInValueSize; i++) {
@@ -584,4 +323,528 @@ ByteCodeBlock* ByteCodeGenerator::generateByteCode(Context* c, InterpretedCodeBl
 
     return block;
 }
+
+template <typename Fused, typename First, typename Second>
+static void fuseByteCodePair(ByteCode* code)
+{
+    First first(*(First*)code);
+    Second second(*(Second*)((char*)code + sizeof(First)));
+    new (code) Fused(first, second);
+}
+
+static Opcode unrelocatedOpcode(ByteCode* code)
+{
+#if defined(COMPILER_GCC)
+    return (Opcode)(size_t)code->m_opcodeInAddress;
+#else
+    return code->m_opcode;
+#endif
+}
+
+// Peephole pass which merges frequent pairs of ByteCodes into superinstructions to save a dispatch.
+// It runs on ByteCode which is not relocated yet, so positions are still offsets into m_code.
+// A pair is not merged if any control flow can land on its second ByteCode.
+void ByteCodeGenerator::fuseByteCode(ByteCodeBlock* block)
+{
+    char* code = block->m_code.data();
+    size_t codeSize = block->m_code.size();
+
+    std::vector<bool> isJumpTarget(codeSize + 1);
+    auto markJumpTarget = [&](size_t position) {
+        if (position <= codeSize) {
+            isJumpTarget[position] = true;
+        }
+    };
+
+    size_t idx = 0;
+    while (idx < codeSize) {
+        ByteCode* currentCode = (ByteCode*)&code[idx];
+        Opcode opcode = unrelocatedOpcode(currentCode);
+        switch (opcode) {
+        case JumpOpcode:
+            markJumpTarget(((Jump*)currentCode)->m_jumpPosition);
+            break;
+        case JumpIfTrueOpcode:
+            markJumpTarget(((JumpIfTrue*)currentCode)->m_jumpPosition);
+            break;
+        case JumpIfFalseOpcode:
+            markJumpTarget(((JumpIfFalse*)currentCode)->m_jumpPosition);
+            break;
+        case JumpComplexCaseOpcode: {
+            ControlFlowRecord* record = ((JumpComplexCase*)currentCode)->m_controlFlowRecord;
+            if (record->reason() == ControlFlowRecord::NeedsJump) {
+                markJumpTarget(record->wordValue());
+            }
+            break;
+        }
+        case TryOperationOpcode:
+            markJumpTarget(((TryOperation*)currentCode)->m_catchPosition);
+            markJumpTarget(((TryOperation*)currentCode)->m_tryCatchEndPosition);
+            break;
+        case CheckIfKeyIsLastOpcode:
+            markJumpTarget(((CheckIfKeyIsLast*)currentCode)->m_forInEndPosition);
+            break;
+        case WithOperationOpcode:
+            markJumpTarget(((WithOperation*)currentCode)->m_withEndPostion);
+            break;
+        default:
+            break;
+        }
+        idx += byteCodeSize(opcode);
+    }
+
+    idx = 0;
+    while (idx < codeSize) {
+        ByteCode* currentCode = (ByteCode*)&code[idx];
+        Opcode opcode = unrelocatedOpcode(currentCode);
+        size_t nextIdx = idx + byteCodeSize(opcode);
+        if (nextIdx >= codeSize || isJumpTarget[nextIdx]) {
+            idx = nextIdx;
+            continue;
+        }
+
+        ByteCode* nextCode = (ByteCode*)&code[nextIdx];
+        Opcode nextOpcode = unrelocatedOpcode(nextCode);
+        bool fused = false;
+        switch (opcode) {
+#define FUSE_COMPARE_AND_JUMP_IF_FALSE(CodeName)                                                                                         \
+    case Binary##CodeName##Opcode:                                                                                                       \
+        if (nextOpcode == JumpIfFalseOpcode && ((Binary##CodeName*)currentCode)->m_dstIndex == ((JumpIfFalse*)nextCode)->m_registerIndex) { \
+            fuseByteCodePair<Binary##CodeName##AndJumpIfFalse, Binary##CodeName, JumpIfFalse>(currentCode);                             \
+            fused = true;                                                                                                                \
+        }                                                                                                                                \
+        break;
+            FUSE_COMPARE_AND_JUMP_IF_FALSE(Equal)
+            FUSE_COMPARE_AND_JUMP_IF_FALSE(NotEqual)
+            FUSE_COMPARE_AND_JUMP_IF_FALSE(StrictEqual)
+            FUSE_COMPARE_AND_JUMP_IF_FALSE(NotStrictEqual)
+            FUSE_COMPARE_AND_JUMP_IF_FALSE(LessThan)
+            FUSE_COMPARE_AND_JUMP_IF_FALSE(LessThanOrEqual)
+            FUSE_COMPARE_AND_JUMP_IF_FALSE(GreaterThan)
+            FUSE_COMPARE_AND_JUMP_IF_FALSE(GreaterThanOrEqual)
+#undef FUSE_COMPARE_AND_JUMP_IF_FALSE
+        case IncrementOpcode:
+            if (nextOpcode == JumpOpcode) {
+                fuseByteCodePair<IncrementAndJump, Increment, Jump>(currentCode);
+                fused = true;
+            }
+            break;
+        case DecrementOpcode:
+            if (nextOpcode == JumpOpcode) {
+                fuseByteCodePair<DecrementAndJump, Decrement, Jump>(currentCode);
+                fused = true;
+            }
+            break;
+        case GetObjectPreComputedCaseOpcode:
+            if (nextOpcode == CallFunctionWithReceiverOpcode) {
+                GetObjectPreComputedCase* get = (GetObjectPreComputedCase*)currentCode;
+                CallFunctionWithReceiver* call = (CallFunctionWithReceiver*)nextCode;
+                if (get->m_storeRegisterIndex == call->m_calleeIndex && get->m_objectRegisterIndex == call->m_receiverIndex) {
+                    fuseByteCodePair<GetObjectPreComputedCaseAndCall, GetObjectPreComputedCase, CallFunctionWithReceiver>(currentCode);
+                    fused = true;
+                }
+            }
+            break;
+        default:
+            break;
+        }
+
+        idx = fused ? nextIdx + byteCodeSize(nextOpcode) : nextIdx;
+    }
+}
+
+bool ByteCodeGenerator::relocateByteCode(ByteCodeBlock* block)
+{
+    fuseByteCode(block);
+
+    ByteCodeRegisterIndex stackBase = REGULAR_REGISTER_LIMIT;
+    ByteCodeRegisterIndex stackBaseWillBe = block->m_requiredRegisterFileSizeInValueSize;
+    ByteCodeRegisterIndex stackVariableSize = block->m_codeBlock->identifierOnStackCount();
+    size_t numeralLiteralSize = block->m_numeralLiteralData.size();
+    size_t registerFileSize = stackBaseWillBe + stackVariableSize + numeralLiteralSize;
+    bool isValid = true;
+    auto relocateRegister = [&](ByteCodeRegisterIndex& registerIndex) {
+        if (registerIndex == std::numeric_limits<ByteCodeRegisterIndex>::max()) {
+            return;
+        }
+        if (registerIndex >= stackBase + VARIABLE_LIMIT) {
+            isValid &= (size_t)(registerIndex - (stackBase + VARIABLE_LIMIT)) < numeralLiteralSize;
+        } else if (registerIndex >= stackBase) {
+            isValid &= (size_t)(registerIndex - stackBase) < stackVariableSize;
+        } else {
+            isValid &= registerIndex < stackBaseWillBe;
+        }
+        assignStackIndexIfNeeded(registerIndex, stackBase, stackBaseWillBe, stackVariableSize);
+    };
+    // arguments of a call are consecutive registers. the start of an empty range is not used
+    auto relocateRegisterRange = [&](ByteCodeRegisterIndex& startIndex, size_t count) {
+        if (!count) {
+            assignStackIndexIfNeeded(startIndex, stackBase, stackBaseWillBe, stackVariableSize);
+            return;
+        }
+        relocateRegister(startIndex);
+        isValid &= (size_t)startIndex + count <= registerFileSize;
+    };
+    size_t idx = 0;
+
+    char* code = block->m_code.data();
+    size_t codeBase = (size_t)code;
+    char* end = &block->m_code.data()[block->m_code.size()];
+    while (&code[idx] < end) {
+        ByteCode* currentCode = (ByteCode*)(&code[idx]);
+#if defined(COMPILER_GCC)
+        Opcode opcode = (Opcode)(size_t)currentCode->m_opcodeInAddress;
+#else
+        Opcode opcode = currentCode->m_opcode;
+#endif
+        currentCode->assignOpcodeInAddress();
+
+        switch (opcode) {
+        case LoadLiteralOpcode: {
+            LoadLiteral* cd = (LoadLiteral*)currentCode;
+            relocateRegister(cd->m_registerIndex);
+            break;
+        }
+        case LoadRegexpOpcode: {
+            LoadRegexp* cd = (LoadRegexp*)currentCode;
+            relocateRegister(cd->m_registerIndex);
+            break;
+        }
+        case LoadByNameOpcode: {
+            LoadByName* cd = (LoadByName*)currentCode;
+            relocateRegister(cd->m_registerIndex);
+            break;
+        }
+        case StoreByNameOpcode: {
+            StoreByName* cd = (StoreByName*)currentCode;
+            relocateRegister(cd->m_registerIndex);
+            break;
+        }
+        case LoadByHeapIndexOpcode: {
+            LoadByHeapIndex* cd = (LoadByHeapIndex*)currentCode;
+            relocateRegister(cd->m_registerIndex);
+            break;
+        }
+        case StoreByHeapIndexOpcode: {
+            StoreByHeapIndex* cd = (StoreByHeapIndex*)currentCode;
+            relocateRegister(cd->m_registerIndex);
+            break;
+        }
+        case GetArgumentsLengthOpcode: {
+            GetArgumentsLength* cd = (GetArgumentsLength*)currentCode;
+            relocateRegister(cd->m_argumentsRegisterIndex);
+            relocateRegister(cd->m_storeRegisterIndex);
+            break;
+        }
+        case GetArgumentsElementOpcode: {
+            GetArgumentsElement* cd = (GetArgumentsElement*)currentCode;
+            relocateRegister(cd->m_argumentsRegisterIndex);
+            relocateRegister(cd->m_propertyRegisterIndex);
+            relocateRegister(cd->m_storeRegisterIndex);
+            break;
+        }
+        case LoadByClosureIndexOpcode: {
+            LoadByClosureIndex* cd = (LoadByClosureIndex*)currentCode;
+            relocateRegister(cd->m_registerIndex);
+            break;
+        }
+        case StoreByClosureIndexOpcode: {
+            StoreByClosureIndex* cd = (StoreByClosureIndex*)currentCode;
+            relocateRegister(cd->m_registerIndex);
+            break;
+        }
+        case CreateFunctionOpcode: {
+            CreateFunction* cd = (CreateFunction*)currentCode;
+            relocateRegister(cd->m_registerIndex);
+            break;
+        }
+        case CreateObjectOpcode: {
+            CreateObject* cd = (CreateObject*)currentCode;
+            relocateRegister(cd->m_registerIndex);
+            break;
+        }
+        case CreateArrayOpcode: {
+            CreateArray* cd = (CreateArray*)currentCode;
+            relocateRegister(cd->m_registerIndex);
+            break;
+        }
+        case GetObjectOpcode: {
+            GetObject* cd = (GetObject*)currentCode;
+            relocateRegister(cd->m_storeRegisterIndex);
+            relocateRegister(cd->m_objectRegisterIndex);
+            relocateRegister(cd->m_propertyRegisterIndex);
+            break;
+        }
+        case SetObjectOperationOpcode: {
+            SetObjectOperation* cd = (SetObjectOperation*)currentCode;
+            relocateRegister(cd->m_objectRegisterIndex);
+            relocateRegister(cd->m_propertyRegisterIndex);
+            relocateRegister(cd->m_loadRegisterIndex);
+            break;
+        }
+        case ObjectDefineOwnPropertyOperationOpcode: {
+            ObjectDefineOwnPropertyOperation* cd = (ObjectDefineOwnPropertyOperation*)currentCode;
+            relocateRegister(cd->m_objectRegisterIndex);
+            relocateRegister(cd->m_propertyRegisterIndex);
+            relocateRegister(cd->m_loadRegisterIndex);
+            break;
+        }
+        case ObjectDefineOwnPropertyWithNameOperationOpcode: {
+            ObjectDefineOwnPropertyWithNameOperation* cd = (ObjectDefineOwnPropertyWithNameOperation*)currentCode;
+            relocateRegister(cd->m_objectRegisterIndex);
+            relocateRegister(cd->m_loadRegisterIndex);
+            break;
+        }
+        case ArrayDefineOwnPropertyOperationOpcode: {
+            ArrayDefineOwnPropertyOperation* cd = (ArrayDefineOwnPropertyOperation*)currentCode;
+            relocateRegister(cd->m_objectRegisterIndex);
+            isValid &= cd->m_count <= ARRAY_DEFINE_OPERATION_MERGE_COUNT;
+            for (size_t i = 0; i < cd->m_count; i++)
+                relocateRegister(cd->m_loadRegisterIndexs[i]);
+            break;
+        }
+        case GetObjectPreComputedCaseOpcode: {
+            GetObjectPreComputedCase* cd = (GetObjectPreComputedCase*)currentCode;
+            relocateRegister(cd->m_objectRegisterIndex);
+            relocateRegister(cd->m_storeRegisterIndex);
+            break;
+        }
+        case SetObjectPreComputedCaseOpcode: {
+            SetObjectPreComputedCase* cd = (SetObjectPreComputedCase*)currentCode;
+            relocateRegister(cd->m_objectRegisterIndex);
+            relocateRegister(cd->m_loadRegisterIndex);
+            break;
+        }
+        case ReturnFunctionWithValueOpcode: {
+            ReturnFunctionWithValue* cd = (ReturnFunctionWithValue*)currentCode;
+            relocateRegister(cd->m_registerIndex);
+            break;
+        }
+        case ReturnFunctionSlowCaseOpcode: {
+            ReturnFunctionSlowCase* cd = (ReturnFunctionSlowCase*)currentCode;
+            relocateRegister(cd->m_registerIndex);
+            break;
+        }
+        case MoveOpcode: {
+            Move* cd = (Move*)currentCode;
+            relocateRegister(cd->m_registerIndex0);
+            relocateRegister(cd->m_registerIndex1);
+            break;
+        }
+        case ObjectDefineGetterOpcode: {
+            ObjectDefineGetter* cd = (ObjectDefineGetter*)currentCode;
+            relocateRegister(cd->m_objectRegisterIndex);
+            relocateRegister(cd->m_objectPropertyNameRegisterIndex);
+            relocateRegister(cd->m_objectPropertyValueRegisterIndex);
+            break;
+        }
+        case ObjectDefineSetterOpcode: {
+            ObjectDefineSetter* cd = (ObjectDefineSetter*)currentCode;
+            relocateRegister(cd->m_objectRegisterIndex);
+            relocateRegister(cd->m_objectPropertyNameRegisterIndex);
+            relocateRegister(cd->m_objectPropertyValueRegisterIndex);
+            break;
+        }
+        case GetGlobalObjectOpcode: {
+            GetGlobalObject* cd = (GetGlobalObject*)currentCode;
+            relocateRegister(cd->m_registerIndex);
+            break;
+        }
+        case SetGlobalObjectOpcode: {
+            SetGlobalObject* cd = (SetGlobalObject*)currentCode;
+            relocateRegister(cd->m_registerIndex);
+            break;
+        }
+        case ToNumberOpcode:
+        case IncrementOpcode:
+        case DecrementOpcode:
+        case UnaryMinusOpcode:
+        case UnaryNotOpcode:
+        case UnaryBitwiseNotOpcode: {
+            ToNumber* cd = (ToNumber*)currentCode;
+            relocateRegister(cd->m_srcIndex);
+            relocateRegister(cd->m_dstIndex);
+            break;
+        }
+        case UnaryTypeofOpcode: {
+            UnaryTypeof* cd = (UnaryTypeof*)currentCode;
+            relocateRegister(cd->m_srcIndex);
+            relocateRegister(cd->m_dstIndex);
+            break;
+        }
+        case UnaryDeleteOpcode: {
+            UnaryDelete* cd = (UnaryDelete*)currentCode;
+            relocateRegister(cd->m_srcIndex0);
+            relocateRegister(cd->m_srcIndex1);
+            relocateRegister(cd->m_dstIndex);
+            break;
+        }
+        case TemplateOperationOpcode: {
+            TemplateOperation* cd = (TemplateOperation*)currentCode;
+            relocateRegister(cd->m_src0Index);
+            relocateRegister(cd->m_src1Index);
+            relocateRegister(cd->m_dstIndex);
+            break;
+        }
+        case CallFunctionOpcode: {
+            CallFunction* cd = (CallFunction*)currentCode;
+            relocateRegister(cd->m_calleeIndex);
+            relocateRegisterRange(cd->m_argumentsStartIndex, cd->m_argumentCount);
+            relocateRegister(cd->m_resultIndex);
+            break;
+        }
+        case CallFunctionWithReceiverOpcode: {
+            CallFunctionWithReceiver* cd = (CallFunctionWithReceiver*)currentCode;
+            relocateRegister(cd->m_receiverIndex);
+            relocateRegister(cd->m_calleeIndex);
+            relocateRegisterRange(cd->m_argumentsStartIndex, cd->m_argumentCount);
+            relocateRegister(cd->m_resultIndex);
+            break;
+        }
+        case CallEvalFunctionOpcode: {
+            CallEvalFunction* cd = (CallEvalFunction*)currentCode;
+            relocateRegisterRange(cd->m_argumentsStartIndex, cd->m_argumentCount);
+            relocateRegister(cd->m_resultIndex);
+            break;
+        }
+        case CallFunctionInWithScopeOpcode: {
+            CallFunctionInWithScope* cd = (CallFunctionInWithScope*)currentCode;
+            relocateRegisterRange(cd->m_argumentsStartIndex, cd->m_argumentCount);
+            relocateRegister(cd->m_resultIndex);
+            break;
+        }
+        case NewOperationOpcode: {
+            NewOperation* cd = (NewOperation*)currentCode;
+            relocateRegister(cd->m_calleeIndex);
+            relocateRegisterRange(cd->m_argumentsStartIndex, cd->m_argumentCount);
+            relocateRegister(cd->m_resultIndex);
+            break;
+        }
+        case JumpOpcode: {
+            Jump* cd = (Jump*)currentCode;
+            cd->m_jumpPosition = cd->m_jumpPosition + codeBase;
+            break;
+        }
+        case JumpComplexCaseOpcode: {
+            JumpComplexCase* cd = (JumpComplexCase*)currentCode;
+            break;
+        }
+        case JumpIfTrueOpcode: {
+            JumpIfTrue* cd = (JumpIfTrue*)currentCode;
+            cd->m_jumpPosition = cd->m_jumpPosition + codeBase;
+            relocateRegister(cd->m_registerIndex);
+            break;
+        }
+        case JumpIfFalseOpcode: {
+            JumpIfFalse* cd = (JumpIfFalse*)currentCode;
+            cd->m_jumpPosition = cd->m_jumpPosition + codeBase;
+            relocateRegister(cd->m_registerIndex);
+            break;
+        }
+        case BinaryEqualAndJumpIfFalseOpcode:
+        case BinaryNotEqualAndJumpIfFalseOpcode:
+        case BinaryStrictEqualAndJumpIfFalseOpcode:
+        case BinaryNotStrictEqualAndJumpIfFalseOpcode:
+        case BinaryLessThanAndJumpIfFalseOpcode:
+        case BinaryLessThanOrEqualAndJumpIfFalseOpcode:
+        case BinaryGreaterThanAndJumpIfFalseOpcode:
+        case BinaryGreaterThanOrEqualAndJumpIfFalseOpcode: {
+            BinaryLessThanAndJumpIfFalse* cd = (BinaryLessThanAndJumpIfFalse*)currentCode;
+            relocateRegister(cd->m_srcIndex0);
+            relocateRegister(cd->m_srcIndex1);
+            relocateRegister(cd->m_dstIndex);
+            cd->m_jumpIfFalse.m_jumpPosition = cd->m_jumpIfFalse.m_jumpPosition + codeBase;
+            relocateRegister(cd->m_jumpIfFalse.m_registerIndex);
+            break;
+        }
+        case IncrementAndJumpOpcode:
+        case DecrementAndJumpOpcode: {
+            IncrementAndJump* cd = (IncrementAndJump*)currentCode;
+            relocateRegister(cd->m_srcIndex);
+            relocateRegister(cd->m_dstIndex);
+            cd->m_jump.m_jumpPosition = cd->m_jump.m_jumpPosition + codeBase;
+            break;
+        }
+        case GetObjectPreComputedCaseAndCallOpcode: {
+            GetObjectPreComputedCaseAndCall* cd = (GetObjectPreComputedCaseAndCall*)currentCode;
+            relocateRegister(cd->m_objectRegisterIndex);
+            relocateRegister(cd->m_storeRegisterIndex);
+            relocateRegister(cd->m_call.m_receiverIndex);
+            relocateRegister(cd->m_call.m_calleeIndex);
+            relocateRegisterRange(cd->m_call.m_argumentsStartIndex, cd->m_call.m_argumentCount);
+            relocateRegister(cd->m_call.m_resultIndex);
+            break;
+        }
+        case EnumerateObjectKeyOpcode: {
+            EnumerateObjectKey* cd = (EnumerateObjectKey*)currentCode;
+            relocateRegister(cd->m_registerIndex);
+            relocateRegister(cd->m_dataRegisterIndex);
+            break;
+        }
+        case CheckIfKeyIsLastOpcode: {
+            CheckIfKeyIsLast* cd = (CheckIfKeyIsLast*)currentCode;
+            relocateRegister(cd->m_registerIndex);
+            break;
+        }
+        case ThrowOperationOpcode: {
+            ThrowOperation* cd = (ThrowOperation*)currentCode;
+            relocateRegister(cd->m_registerIndex);
+            break;
+        }
+        case EnumerateObjectOpcode: {
+            EnumerateObject* cd = (EnumerateObject*)currentCode;
+            relocateRegister(cd->m_objectRegisterIndex);
+            break;
+        }
+        case WithOperationOpcode: {
+            WithOperation* cd = (WithOperation*)currentCode;
+            relocateRegister(cd->m_registerIndex);
+            break;
+        }
+        case BinaryPlusOpcode:
+        case BinaryMinusOpcode:
+        case BinaryMultiplyOpcode:
+        case BinaryDivisionOpcode:
+        case BinaryModOpcode:
+        case BinaryEqualOpcode:
+        case BinaryNotEqualOpcode:
+        case BinaryLessThanOpcode:
+        case BinaryLessThanOrEqualOpcode:
+        case BinaryGreaterThanOpcode:
+        case BinaryGreaterThanOrEqualOpcode:
+        case BinaryStrictEqualOpcode:
+        case BinaryNotStrictEqualOpcode:
+        case BinaryBitwiseAndOpcode:
+        case BinaryBitwiseOrOpcode:
+        case BinaryBitwiseXorOpcode:
+        case BinaryLeftShiftOpcode:
+        case BinarySignedRightShiftOpcode:
+        case BinaryUnsignedRightShiftOpcode:
+        case BinaryInOperationOpcode:
+        case BinaryInstanceOfOperationOpcode: {
+            BinaryPlus* plus = (BinaryPlus*)currentCode;
+            relocateRegister(plus->m_srcIndex0);
+            relocateRegister(plus->m_srcIndex1);
+            relocateRegister(plus->m_dstIndex);
+            break;
+        }
+        default:
+            break;
+        }
+
+        switch (opcode) {
+#define ITER_BYTE_CODE(code, pushCount, popCount) \
+    case code##Opcode:                            \
+        idx += sizeof(code);                      \
+        continue;
+
+            FOR_EACH_BYTECODE_OP(ITER_BYTE_CODE)
+#undef ITER_BYTE_CODE
+        default:
+            RELEASE_ASSERT_NOT_REACHED();
+            break;
+        };
+    }
+    return isValid;
+}
 }
@@ -115,7 +115,6 @@ struct ByteCodeGenerateContext {
         ctx.m_labeledBreakStatmentPositions.insert(ctx.m_labeledBreakStatmentPositions.end(), m_labeledBreakStatmentPositions.begin(), m_labeledBreakStatmentPositions.end());
         ctx.m_labeledContinueStatmentPositions.insert(ctx.m_labeledContinueStatmentPositions.end(), m_labeledContinueStatmentPositions.begin(), m_labeledContinueStatmentPositions.end());
         ctx.m_complexCaseStatementPositions.insert(m_complexCaseStatementPositions.begin(), m_complexCaseStatementPositions.end());
-        ctx.m_getObjectCodePositions.insert(ctx.m_getObjectCodePositions.end(), m_getObjectCodePositions.begin(), m_getObjectCodePositions.end());
         ctx.m_offsetToBasePointer = m_offsetToBasePointer;
         ctx.m_positionToContinue = m_positionToContinue;
         ctx.m_feCounter = m_feCounter;
@@ -258,7 +257,6 @@ struct ByteCodeGenerateContext {
     std::shared_ptr<std::vector<std::pair<String*, size_t>>> m_currentLabels;
     std::vector<std::pair<String*, size_t>> m_labeledBreakStatmentPositions;
     std::vector<std::pair<String*, size_t>> m_labeledContinueStatmentPositions;
-    std::vector<size_t> m_getObjectCodePositions;
     // For For In Statement
     size_t m_offsetToBasePointer;
     // For Label Statement
@@ -281,7 +279,14 @@ public:
     void generateStoreThisValueByteCode(ByteCodeBlock* block, ByteCodeGenerateContext* context);
     void generateLoadThisValueByteCode(ByteCodeBlock* block, ByteCodeGenerateContext* context);
 
-    ByteCodeBlock* generateByteCode(Context* c, InterpretedCodeBlock* codeBlock, Node* ast, ASTScopeContext* scopeCtx, bool isEvalMode = false, bool isOnGlobal = false, bool shouldGenerateLOCData = false);
+    // when shouldRelocate is false, the result keeps opcode numbers, relative jump positions and
+    // unassigned stack registers so that it can be written into a code cache (see CodeCache.h)
+    ByteCodeBlock* generateByteCode(Context* c, InterpretedCodeBlock* codeBlock, Node* ast, ASTScopeContext* scopeCtx, bool isEvalMode = false, bool isOnGlobal = false, bool shouldGenerateLOCData = false, bool shouldRelocate = true);
+    // returns false if an operand is out of the register file of the block, which only a corrupted code cache can make
+    static bool relocateByteCode(ByteCodeBlock* block);
+    static void fuseByteCode(ByteCodeBlock* block);
+    // true if arguments.length and arguments[property] of the function can be read without its arguments object
+    static bool canReadArgumentsDirectly(InterpretedCodeBlock* codeBlock);
 };
 }
 
@@ -20,10 +20,12 @@
 #include "Escargot.h"
 #include "ByteCode.h"
 #include "ByteCodeInterpreter.h"
+#include "ByteCodeInterpreterInlines.h"
 #include "runtime/Environment.h"
 #include "runtime/EnvironmentRecord.h"
 #include "runtime/FunctionObject.h"
 #include "runtime/Context.h"
+#include "runtime/VMInstance.h"
 #include "runtime/SandBox.h"
 #include "runtime/GlobalObject.h"
 #include "runtime/StringObject.h"
@@ -48,19 +50,129 @@ ALWAYS_INLINE size_t resolveProgramCounter(char* codeBuffer, const size_t progra
     return programCounter - (size_t)codeBuffer;
 }
 
-Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteCodeBlock, size_t programCounter, Value* registerFile, void* initAddressFiller)
+#if defined(ESCARGOT_ENABLE_JIT)
+// runs native code of |byteCodeBlock| from |programCounter| (compiles it first if needed),
+// and moves |programCounter| onto the ByteCode where compiled code stopped.
+// an exception raised in compiled code is thrown again here, so it is processed at that ByteCode.
+NEVER_INLINE void runJITCode(ExecutionState& state, ByteCodeBlock* byteCodeBlock, char* codeBuffer, size_t& programCounter, Value* registerFile)
+{
+    JITCode* jitCode = byteCodeBlock->m_jitCode;
+    if (!jitCode) {
+        jitCode = byteCodeBlock->m_jitCode = JITCode::compile(byteCodeBlock);
+        if (!jitCode) {
+            return;
+        }
+    }
+
+    void* entry = jitCode->entry(resolveProgramCounter(codeBuffer, programCounter));
+    if (!entry) {
+        return;
+    }
+
+    JITFrame frame(&state, byteCodeBlock, registerFile);
+    programCounter = jumpTo(codeBuffer, jitCode->run(&frame, entry));
+    if (UNLIKELY(frame.m_hasException)) {
+        throw frame.m_exception;
+    }
+}
+
+// called on entry and on backward jumps
+#define RUN_JIT_CODE_IF_HOT()                                                                                            \
+    if (UNLIKELY(byteCodeBlock->m_jitCode != nullptr || ++byteCodeBlock->m_executionCount == ESCARGOT_JIT_HOT_COUNT)) { \
+        runJITCode(state, byteCodeBlock, codeBuffer, programCounter, registerFile);                                      \
+    }
+#endif
+
+// keeps the register file of the callee aligned
+static const size_t interpretedCallFrameHeaderSize = (sizeof(InterpretedCallFrame) + sizeof(double) - 1) & ~(sizeof(double) - 1);
+
+ALWAYS_INLINE InterpretedCallFrame* ByteCodeInterpreter::pushCachedCallFrame(ExecutionState& state, FunctionObject* callee, const Value& receiver, size_t argc, Value* argv, CallFunctionCache& cache)
+{
+    VMInstance* vmInstance = state.context()->vmInstance();
+    cache.m_codeBlock->m_byteCodeBlockLastUsedEpoch = vmInstance->byteCodeBlockEpoch();
+    InterpretedCallFrame* frame = (InterpretedCallFrame*)vmInstance->allocateInterpreterFrame(interpretedCallFrameHeaderSize + cache.m_layout.m_frameSize);
+    if (UNLIKELY(frame == nullptr)) {
+        return nullptr;
+    }
+
+    void* calleeFrame = (char*)frame + interpretedCallFrameHeaderSize;
+    if (LIKELY(cache.m_layout.m_isSimple)) {
+        frame->m_state = callee->initializeSimpleInterpretedCallFrame(state, cache.m_byteCodeBlock, cache.m_layout, calleeFrame, receiver, argc, argv);
+    } else {
+        try {
+            frame->m_state = callee->initializeInterpretedCallFrame(state, cache.m_byteCodeBlock, calleeFrame, receiver, argc, argv);
+        } catch (const Value& v) {
+            vmInstance->freeInterpreterFrame(frame);
+            throw;
+        }
+    }
+    frame->m_byteCodeBlock = cache.m_byteCodeBlock;
+    return frame;
+}
+
+// calls an interpreted function on a frame of the frame stack, and continues with its code in this activation
+#define CALL_WITHOUT_RECURSION_IF_POSSIBLE(code, CodeType, callee, receiver)                                                                                                  \
+    if (LIKELY(callee.isObject() && callee.asPointerValue()->hasTag(g_functionObjectTag))) {                                                                                 \
+        FunctionObject* fn = callee.asFunction();                                                                                                                            \
+        CallFunctionCache& cache = code->m_callCache;                                                                                                                        \
+        InterpretedCallFrame* frame = nullptr;                                                                                                                               \
+        if (LIKELY(fn->codeBlock() == cache.m_codeBlock && cache.m_codeBlock->byteCodeBlock() == cache.m_byteCodeBlock                                                       \
+                   && cache.m_codeBlock->m_byteCodeBlockGeneration == cache.m_byteCodeBlockGeneration)) {                                                                    \
+            frame = pushCachedCallFrame(state, fn, receiver, code->m_argumentCount, &registerFile[code->m_argumentsStartIndex], cache);                                      \
+        } else if (fn->codeBlock()->isInterpretedCodeBlock()) {                                                                                                             \
+            frame = pushCallFrame(state, fn, receiver, code->m_argumentCount, &registerFile[code->m_argumentsStartIndex], cache, byteCodeBlock);                          \
+        }                                                                                                                                                                    \
+        if (LIKELY(frame != nullptr)) {                                                                                                                                      \
+            frame->m_returnProgramCounter = programCounter + sizeof(CodeType);                                                                                               \
+            frame->m_resultIndex = code->m_resultIndex;                                                                                                                     \
+            frame->m_previous = inlineFrame;                                                                                                                                 \
+            inlineFrame = frame;                                                                                                                                             \
+            goto EnterCallFrame;                                                                                                                                             \
+        }                                                                                                                                                                    \
+    }
+
+// returns from the function of the current frame
+#define RETURN_FROM_FRAME(value)       \
+    {                                  \
+        returnValue = value;           \
+        if (inlineFrame == nullptr) {  \
+            return returnValue;        \
+        }                              \
+        goto ReturnFromCallFrame;      \
+    }
+
+Value ByteCodeInterpreter::interpret(ExecutionState& entryState, ByteCodeBlock* byteCodeBlock, size_t programCounter, Value* registerFile, void* initAddressFiller)
 {
 #if defined(COMPILER_GCC)
     *((size_t*)initAddressFiller) = ((size_t) && FillOpcodeTableOpcodeLbl);
 #endif
+    // interpreted functions called from here run in this activation on frames of the frame stack of VMInstance.
+    // inlineFrame is the innermost of them, or nullptr while the code of entryState runs
+    ExecutionState* currentState = &entryState;
+    InterpretedCallFrame* inlineFrame = nullptr;
+    Value returnValue;
+    programCounter = (size_t)(&byteCodeBlock->m_code.data()[programCounter]);
+#if defined(ESCARGOT_ENABLE_JIT)
+    // set when a frame returned to its caller, which is not an entry of the caller
+    bool resumesCaller = false;
+#endif
+
+SwitchFrame:
     {
+        ExecutionState& state = *currentState;
         ExecutionContext* ec = state.executionContext();
         char* codeBuffer = byteCodeBlock->m_code.data();
-        programCounter = (size_t)(&codeBuffer[programCounter]);
 
         try {
 #define NEXT_INSTRUCTION() goto NextInstruction;
 
+#if defined(ESCARGOT_ENABLE_JIT)
+            if (LIKELY(!resumesCaller)) {
+                RUN_JIT_CODE_IF_HOT();
+            }
+            resumesCaller = false;
+#endif
+
         NextInstruction:
 #if defined(COMPILER_GCC)
             goto*(((ByteCode*)programCounter)->m_opcodeInAddress);
@@ -99,14 +211,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                 :
             {
                 GetGlobalObject* code = (GetGlobalObject*)programCounter;
-                GlobalObject* globalObject = state.context()->globalObject();
-                if (LIKELY(globalObject->structure() == code->m_cachedStructure)) {
-                    ASSERT(globalObject->m_values.data() <= code->m_cachedAddress);
-                    ASSERT(code->m_cachedAddress < (globalObject->m_values.data() + globalObject->structure()->propertyCount()));
-                    registerFile[code->m_registerIndex] = *((SmallValue*)code->m_cachedAddress);
-                } else {
-                    registerFile[code->m_registerIndex] = getGlobalObjectSlowCase(state, globalObject, code, byteCodeBlock);
-                }
+                registerFile[code->m_registerIndex] = getGlobalObjectOperation(state, code, byteCodeBlock);
                 ADD_PROGRAM_COUNTER(GetGlobalObject);
                 NEXT_INSTRUCTION();
             }
@@ -115,14 +220,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                 :
             {
                 SetGlobalObject* code = (SetGlobalObject*)programCounter;
-                GlobalObject* globalObject = state.context()->globalObject();
-                if (LIKELY(globalObject->structure() == code->m_cachedStructure)) {
-                    ASSERT(globalObject->m_values.data() <= code->m_cachedAddress);
-                    ASSERT(code->m_cachedAddress < (globalObject->m_values.data() + globalObject->structure()->propertyCount()));
-                    *((SmallValue*)code->m_cachedAddress) = registerFile[code->m_registerIndex];
-                } else {
-                    setGlobalObjectSlowCase(state, globalObject, code, registerFile[code->m_registerIndex], byteCodeBlock);
-                }
+                setGlobalObjectOperation(state, code, registerFile[code->m_registerIndex], byteCodeBlock);
                 ADD_PROGRAM_COUNTER(SetGlobalObject);
                 NEXT_INSTRUCTION();
             }
@@ -131,25 +229,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                 :
             {
                 BinaryPlus* code = (BinaryPlus*)programCounter;
-                const Value& v0 = registerFile[code->m_srcIndex0];
-                const Value& v1 = registerFile[code->m_srcIndex1];
-                Value ret(Value::ForceUninitialized);
-                if (v0.isInt32() && v1.isInt32()) {
-                    int32_t a = v0.asInt32();
-                    int32_t b = v1.asInt32();
-                    int32_t c;
-                    bool result = ArithmeticOperations<int32_t, int32_t, int32_t>::add(a, b, c);
-                    if (LIKELY(result)) {
-                        ret = Value(c);
-                    } else {
-                        ret = Value(Value::EncodeAsDouble, (double)a + (double)b);
-                    }
-                } else if (v0.isNumber() && v1.isNumber()) {
-                    ret = Value(v0.asNumber() + v1.asNumber());
-                } else {
-                    ret = plusSlowCase(state, v0, v1);
-                }
-                registerFile[code->m_dstIndex] = ret;
+                registerFile[code->m_dstIndex] = binaryPlusOperation(state, registerFile[code->m_srcIndex0], registerFile[code->m_srcIndex1]);
                 ADD_PROGRAM_COUNTER(BinaryPlus);
                 NEXT_INSTRUCTION();
             }
@@ -158,23 +238,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                 :
             {
                 BinaryMinus* code = (BinaryMinus*)programCounter;
-                const Value& left = registerFile[code->m_srcIndex0];
-                const Value& right = registerFile[code->m_srcIndex1];
-                Value ret(Value::ForceUninitialized);
-                if (left.isInt32() && right.isInt32()) {
-                    int32_t a = left.asInt32();
-                    int32_t b = right.asInt32();
-                    int32_t c;
-                    bool result = ArithmeticOperations<int32_t, int32_t, int32_t>::sub(a, b, c);
-                    if (LIKELY(result)) {
-                        ret = Value(c);
-                    } else {
-                        ret = Value(Value::EncodeAsDouble, (double)a - (double)b);
-                    }
-                } else {
-                    ret = Value(left.toNumber(state) - right.toNumber(state));
-                }
-                registerFile[code->m_dstIndex] = ret;
+                registerFile[code->m_dstIndex] = binaryMinusOperation(state, registerFile[code->m_srcIndex0], registerFile[code->m_srcIndex1]);
                 ADD_PROGRAM_COUNTER(BinaryMinus);
                 NEXT_INSTRUCTION();
             }
@@ -183,29 +247,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                 :
             {
                 BinaryMultiply* code = (BinaryMultiply*)programCounter;
-                const Value& left = registerFile[code->m_srcIndex0];
-                const Value& right = registerFile[code->m_srcIndex1];
-                Value ret(Value::ForceUninitialized);
-                if (left.isInt32() && right.isInt32()) {
-                    int32_t a = left.asInt32();
-                    int32_t b = right.asInt32();
-                    if (UNLIKELY((!a || !b) && (a >> 31 || b >> 31))) { // -1 * 0 should be treated as -0, not +0
-                        ret = Value(left.asNumber() * right.asNumber());
-                    } else {
-                        int32_t c = right.asInt32();
-                        bool result = ArithmeticOperations<int32_t, int32_t, int32_t>::multiply(a, b, c);
-                        if (LIKELY(result)) {
-                            ret = Value(c);
-                        } else {
-                            ret = Value(Value::EncodeAsDouble, a * (double)b);
-                        }
-                    }
-                } else {
-                    auto first = left.toNumber(state);
-                    auto second = right.toNumber(state);
-                    ret = Value(Value::EncodeAsDouble, first * second);
-                }
-                registerFile[code->m_dstIndex] = ret;
+                registerFile[code->m_dstIndex] = binaryMultiplyOperation(state, registerFile[code->m_srcIndex0], registerFile[code->m_srcIndex1]);
                 ADD_PROGRAM_COUNTER(BinaryMultiply);
                 NEXT_INSTRUCTION();
             }
@@ -309,50 +351,79 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                 NEXT_INSTRUCTION();
             }
 
+#define DEFINE_COMPARE_AND_JUMP_IF_FALSE_OPCODE(CodeName, compareExpression)                 \
+    DEFINE_OPCODE(Binary##CodeName##AndJumpIfFalse)                                          \
+        :                                                                                    \
+    {                                                                                        \
+        Binary##CodeName##AndJumpIfFalse* code = (Binary##CodeName##AndJumpIfFalse*)programCounter; \
+        const Value& left = registerFile[code->m_srcIndex0];                                 \
+        const Value& right = registerFile[code->m_srcIndex1];                                \
+        bool result = compareExpression;                                                     \
+        registerFile[code->m_dstIndex] = Value(result);                                      \
+        if (result) {                                                                        \
+            ADD_PROGRAM_COUNTER(Binary##CodeName##AndJumpIfFalse);                           \
+        } else {                                                                             \
+            programCounter = code->m_jumpIfFalse.m_jumpPosition;                             \
+        }                                                                                    \
+        NEXT_INSTRUCTION();                                                                  \
+    }
+
+            DEFINE_COMPARE_AND_JUMP_IF_FALSE_OPCODE(Equal, left.abstractEqualsTo(state, right))
+            DEFINE_COMPARE_AND_JUMP_IF_FALSE_OPCODE(NotEqual, !left.abstractEqualsTo(state, right))
+            DEFINE_COMPARE_AND_JUMP_IF_FALSE_OPCODE(StrictEqual, left.equalsTo(state, right))
+            DEFINE_COMPARE_AND_JUMP_IF_FALSE_OPCODE(NotStrictEqual, !left.equalsTo(state, right))
+            DEFINE_COMPARE_AND_JUMP_IF_FALSE_OPCODE(LessThan, abstractRelationalComparison(state, left, right, true))
+            DEFINE_COMPARE_AND_JUMP_IF_FALSE_OPCODE(LessThanOrEqual, abstractRelationalComparisonOrEqual(state, left, right, true))
+            DEFINE_COMPARE_AND_JUMP_IF_FALSE_OPCODE(GreaterThan, abstractRelationalComparison(state, right, left, false))
+            DEFINE_COMPARE_AND_JUMP_IF_FALSE_OPCODE(GreaterThanOrEqual, abstractRelationalComparisonOrEqual(state, right, left, false))
+#undef DEFINE_COMPARE_AND_JUMP_IF_FALSE_OPCODE
+
             DEFINE_OPCODE(Increment)
                 :
             {
                 Increment* code = (Increment*)programCounter;
-                const Value& val = registerFile[code->m_srcIndex];
-                if (LIKELY(val.isInt32())) {
-                    int32_t a = val.asInt32();
-                    int32_t b = 1;
-                    int32_t c;
-                    bool result = ArithmeticOperations<int32_t, int32_t, int32_t>::add(a, b, c);
-                    if (LIKELY(result)) {
-                        registerFile[code->m_dstIndex] = Value(c);
-                    } else {
-                        registerFile[code->m_dstIndex] = Value(Value::EncodeAsDouble, (double)a + (double)b);
-                    }
-                } else {
-                    registerFile[code->m_dstIndex] = plusSlowCase(state, Value(val.toNumber(state)), Value(1));
-                }
+                registerFile[code->m_dstIndex] = incrementOperation(state, registerFile[code->m_srcIndex]);
                 ADD_PROGRAM_COUNTER(Increment);
                 NEXT_INSTRUCTION();
             }
 
+            DEFINE_OPCODE(IncrementAndJump)
+                :
+            {
+                IncrementAndJump* code = (IncrementAndJump*)programCounter;
+                registerFile[code->m_dstIndex] = incrementOperation(state, registerFile[code->m_srcIndex]);
+                programCounter = code->m_jump.m_jumpPosition;
+#if defined(ESCARGOT_ENABLE_JIT)
+                if (programCounter < (size_t)code) {
+                    RUN_JIT_CODE_IF_HOT();
+                }
+#endif
+                NEXT_INSTRUCTION();
+            }
+
             DEFINE_OPCODE(Decrement)
                 :
             {
                 Decrement* code = (Decrement*)programCounter;
-                const Value& val = registerFile[code->m_srcIndex];
-                if (LIKELY(val.isInt32())) {
-                    int32_t a = val.asInt32();
-                    int32_t b = -1;
-                    int32_t c;
-                    bool result = ArithmeticOperations<int32_t, int32_t, int32_t>::add(a, b, c);
-                    if (LIKELY(result)) {
-                        registerFile[code->m_dstIndex] = Value(c);
-                    } else {
-                        registerFile[code->m_dstIndex] = Value(Value::EncodeAsDouble, (double)a + (double)b);
-                    }
-                } else {
-                    registerFile[code->m_dstIndex] = Value(val.toNumber(state) - 1);
-                }
+                registerFile[code->m_dstIndex] = decrementOperation(state, registerFile[code->m_srcIndex]);
                 ADD_PROGRAM_COUNTER(Decrement);
                 NEXT_INSTRUCTION();
             }
 
+            DEFINE_OPCODE(DecrementAndJump)
+                :
+            {
+                DecrementAndJump* code = (DecrementAndJump*)programCounter;
+                registerFile[code->m_dstIndex] = decrementOperation(state, registerFile[code->m_srcIndex]);
+                programCounter = code->m_jump.m_jumpPosition;
+#if defined(ESCARGOT_ENABLE_JIT)
+                if (programCounter < (size_t)code) {
+                    RUN_JIT_CODE_IF_HOT();
+                }
+#endif
+                NEXT_INSTRUCTION();
+            }
+
             DEFINE_OPCODE(UnaryMinus)
                 :
             {
@@ -377,24 +448,9 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                 :
             {
                 GetObject* code = (GetObject*)programCounter;
-                const Value& willBeObject = registerFile[code->m_objectRegisterIndex];
-                const Value& property = registerFile[code->m_propertyRegisterIndex];
-                PointerValue* v;
-                if (LIKELY(willBeObject.isObject() && (v = willBeObject.asPointerValue())->hasTag(g_arrayObjectTag))) {
-                    ArrayObject* arr = (ArrayObject*)v;
-                    if (LIKELY(arr->isFastModeArray())) {
-                        uint32_t idx = property.tryToUseAsArrayIndex(state);
-                        if (LIKELY(idx != Value::InvalidArrayIndexValue)) {
-                            if (LIKELY(idx < arr->getArrayLength(state))) {
-                                const Value& v = arr->m_fastModeData[idx];
-                                if (LIKELY(!v.isEmpty())) {
-                                    registerFile[code->m_storeRegisterIndex] = v;
-                                    ADD_PROGRAM_COUNTER(GetObject);
-                                    NEXT_INSTRUCTION();
-                                }
-                            }
-                        }
-                    }
+                if (LIKELY(getObjectFromFastModeArray(state, registerFile[code->m_objectRegisterIndex], registerFile[code->m_propertyRegisterIndex], registerFile[code->m_storeRegisterIndex]))) {
+                    ADD_PROGRAM_COUNTER(GetObject);
+                    NEXT_INSTRUCTION();
                 }
 #if defined(COMPILER_GCC)
                 goto GetObjectOpcodeSlowCaseOpcodeLbl;
@@ -408,37 +464,9 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                 :
             {
                 SetObjectOperation* code = (SetObjectOperation*)programCounter;
-                const Value& willBeObject = registerFile[code->m_objectRegisterIndex];
-                const Value& property = registerFile[code->m_propertyRegisterIndex];
-                if (LIKELY(willBeObject.isObject() && (willBeObject.asPointerValue())->hasTag(g_arrayObjectTag))) {
-                    ArrayObject* arr = willBeObject.asObject()->asArrayObject();
-                    if (LIKELY(arr->isFastModeArray())) {
-                        uint32_t idx = property.tryToUseAsArrayIndex(state);
-                        if (LIKELY(idx != Value::InvalidArrayIndexValue)) {
-                            uint32_t len = arr->getArrayLength(state);
-                            if (UNLIKELY(len <= idx)) {
-                                if (UNLIKELY(!arr->isExtensible())) {
-#if defined(COMPILER_GCC)
-                                    goto SetObjectOpcodeSlowCaseOpcodeLbl;
-#else
-                                        currentOpcode = SetObjectOpcodeSlowCaseOpcode;
-                                        goto NextInstructionWithoutFetchOpcode;
-#endif
-                                }
-                                if (UNLIKELY(!arr->setArrayLength(state, idx + 1)) || UNLIKELY(!arr->isFastModeArray())) {
-#if defined(COMPILER_GCC)
-                                    goto SetObjectOpcodeSlowCaseOpcodeLbl;
-#else
-                                        currentOpcode = SetObjectOpcodeSlowCaseOpcode;
-                                        goto NextInstructionWithoutFetchOpcode;
-#endif
-                                }
-                            }
-                            arr->m_fastModeData[idx] = registerFile[code->m_loadRegisterIndex];
-                            ADD_PROGRAM_COUNTER(SetObjectOperation);
-                            NEXT_INSTRUCTION();
-                        }
-                    }
+                if (LIKELY(setObjectToFastModeArray(state, registerFile[code->m_objectRegisterIndex], registerFile[code->m_propertyRegisterIndex], registerFile[code->m_loadRegisterIndex]))) {
+                    ADD_PROGRAM_COUNTER(SetObjectOperation);
+                    NEXT_INSTRUCTION();
                 }
 #if defined(COMPILER_GCC)
                 goto SetObjectOpcodeSlowCaseOpcodeLbl;
@@ -464,6 +492,33 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                 NEXT_INSTRUCTION();
             }
 
+            DEFINE_OPCODE(GetArgumentsLength)
+                :
+            {
+                GetArgumentsLength* code = (GetArgumentsLength*)programCounter;
+                if (LIKELY(!byteCodeBlock->m_needsArgumentsObject && registerFile[code->m_argumentsRegisterIndex].isUndefined())) {
+                    registerFile[code->m_storeRegisterIndex] = Value(argumentsRecord(ec, code->m_catchScopeCount)->m_argc);
+                } else {
+                    registerFile[code->m_storeRegisterIndex] = getArgumentsLengthOperation(state, code, ec, registerFile, byteCodeBlock);
+                }
+                ADD_PROGRAM_COUNTER(GetArgumentsLength);
+                NEXT_INSTRUCTION();
+            }
+
+            DEFINE_OPCODE(GetArgumentsElement)
+                :
+            {
+                GetArgumentsElement* code = (GetArgumentsElement*)programCounter;
+                if (LIKELY(!byteCodeBlock->m_needsArgumentsObject && registerFile[code->m_argumentsRegisterIndex].isUndefined())
+                    && getArgumentsElementDirectly(argumentsRecord(ec, code->m_catchScopeCount), byteCodeBlock, registerFile[code->m_propertyRegisterIndex], registerFile[code->m_storeRegisterIndex])) {
+                    ADD_PROGRAM_COUNTER(GetArgumentsElement);
+                    NEXT_INSTRUCTION();
+                }
+                registerFile[code->m_storeRegisterIndex] = getArgumentsElementOperation(state, code, ec, registerFile, byteCodeBlock);
+                ADD_PROGRAM_COUNTER(GetArgumentsElement);
+                NEXT_INSTRUCTION();
+            }
+
             DEFINE_OPCODE(SetObjectPreComputedCase)
                 :
             {
@@ -479,6 +534,11 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                 Jump* code = (Jump*)programCounter;
                 ASSERT(code->m_jumpPosition != SIZE_MAX);
                 programCounter = code->m_jumpPosition;
+#if defined(ESCARGOT_ENABLE_JIT)
+                if (programCounter < (size_t)code) {
+                    RUN_JIT_CODE_IF_HOT();
+                }
+#endif
                 NEXT_INSTRUCTION();
             }
 
@@ -489,6 +549,11 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                 ASSERT(code->m_jumpPosition != SIZE_MAX);
                 if (registerFile[code->m_registerIndex].toBoolean(state)) {
                     programCounter = code->m_jumpPosition;
+#if defined(ESCARGOT_ENABLE_JIT)
+                    if (programCounter < (size_t)code) {
+                        RUN_JIT_CODE_IF_HOT();
+                    }
+#endif
                 } else {
                     ADD_PROGRAM_COUNTER(JumpIfTrue);
                 }
@@ -513,6 +578,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
             {
                 CallFunction* code = (CallFunction*)programCounter;
                 const Value& callee = registerFile[code->m_calleeIndex];
+                CALL_WITHOUT_RECURSION_IF_POSSIBLE(code, CallFunction, callee, Value());
                 registerFile[code->m_resultIndex] = FunctionObject::call(state, callee, Value(), code->m_argumentCount, &registerFile[code->m_argumentsStartIndex]);
                 ADD_PROGRAM_COUNTER(CallFunction);
                 NEXT_INSTRUCTION();
@@ -524,22 +590,40 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                 CallFunctionWithReceiver* code = (CallFunctionWithReceiver*)programCounter;
                 const Value& callee = registerFile[code->m_calleeIndex];
                 const Value& receiver = registerFile[code->m_receiverIndex];
+                CALL_WITHOUT_RECURSION_IF_POSSIBLE(code, CallFunctionWithReceiver, callee, receiver);
                 registerFile[code->m_resultIndex] = FunctionObject::call(state, callee, receiver, code->m_argumentCount, &registerFile[code->m_argumentsStartIndex]);
                 ADD_PROGRAM_COUNTER(CallFunctionWithReceiver);
                 NEXT_INSTRUCTION();
             }
 
+            DEFINE_OPCODE(GetObjectPreComputedCaseAndCall)
+                :
+            {
+                GetObjectPreComputedCaseAndCall* code = (GetObjectPreComputedCaseAndCall*)programCounter;
+                const Value& willBeObject = registerFile[code->m_objectRegisterIndex];
+                Object* obj;
+                if (LIKELY(willBeObject.isObject())) {
+                    obj = willBeObject.asObject();
+                } else {
+                    obj = fastToObject(state, willBeObject);
+                }
+                registerFile[code->m_storeRegisterIndex] = getObjectPrecomputedCaseOperation(state, obj, willBeObject, code->m_propertyName, code->m_inlineCache, byteCodeBlock);
+                // move onto the call part first, so that an exception from the callee is reported at the call
+                ADD_PROGRAM_COUNTER(GetObjectPreComputedCase);
+                CallFunctionWithReceiver* call = &code->m_call;
+                const Value& callee = registerFile[call->m_calleeIndex];
+                const Value& receiver = registerFile[call->m_receiverIndex];
+                CALL_WITHOUT_RECURSION_IF_POSSIBLE(call, CallFunctionWithReceiver, callee, receiver);
+                registerFile[call->m_resultIndex] = FunctionObject::call(state, callee, receiver, call->m_argumentCount, &registerFile[call->m_argumentsStartIndex]);
+                ADD_PROGRAM_COUNTER(CallFunctionWithReceiver);
+                NEXT_INSTRUCTION();
+            }
+
             DEFINE_OPCODE(LoadByHeapIndex)
                 :
             {
                 LoadByHeapIndex* code = (LoadByHeapIndex*)programCounter;
-                LexicalEnvironment* upperEnv = ec->lexicalEnvironment();
-                for (size_t i = 0; i < code->m_upperIndex; i++) {
-                    upperEnv = upperEnv->outerEnvironment();
-                }
-                FunctionEnvironmentRecord* record = upperEnv->record()->asDeclarativeEnvironmentRecord()->asFunctionEnvironmentRecord();
-                ASSERT(record->isFunctionEnvironmentRecordOnHeap() || record->isFunctionEnvironmentRecordNotIndexed());
-                registerFile[code->m_registerIndex] = ((FunctionEnvironmentRecordOnHeap*)record)->m_heapStorage[code->m_index];
+                registerFile[code->m_registerIndex] = heapStorageRecord(ec, code->m_upperIndex)->m_heapStorage[code->m_index];
                 ADD_PROGRAM_COUNTER(LoadByHeapIndex);
                 NEXT_INSTRUCTION();
             }
@@ -548,17 +632,29 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                 :
             {
                 StoreByHeapIndex* code = (StoreByHeapIndex*)programCounter;
-                LexicalEnvironment* upperEnv = ec->lexicalEnvironment();
-                for (size_t i = 0; i < code->m_upperIndex; i++) {
-                    upperEnv = upperEnv->outerEnvironment();
-                }
-                FunctionEnvironmentRecord* record = upperEnv->record()->asDeclarativeEnvironmentRecord()->asFunctionEnvironmentRecord();
-                ASSERT(record->isFunctionEnvironmentRecordOnHeap() || record->isFunctionEnvironmentRecordNotIndexed());
-                ((FunctionEnvironmentRecordOnHeap*)record)->m_heapStorage[code->m_index] = registerFile[code->m_registerIndex];
+                heapStorageRecord(ec, code->m_upperIndex)->m_heapStorage[code->m_index] = registerFile[code->m_registerIndex];
                 ADD_PROGRAM_COUNTER(StoreByHeapIndex);
                 NEXT_INSTRUCTION();
             }
 
+            DEFINE_OPCODE(LoadByClosureIndex)
+                :
+            {
+                LoadByClosureIndex* code = (LoadByClosureIndex*)programCounter;
+                registerFile[code->m_registerIndex] = ec->m_closureDisplay[code->m_displayIndex][code->m_index];
+                ADD_PROGRAM_COUNTER(LoadByClosureIndex);
+                NEXT_INSTRUCTION();
+            }
+
+            DEFINE_OPCODE(StoreByClosureIndex)
+                :
+            {
+                StoreByClosureIndex* code = (StoreByClosureIndex*)programCounter;
+                ec->m_closureDisplay[code->m_displayIndex][code->m_index] = registerFile[code->m_registerIndex];
+                ADD_PROGRAM_COUNTER(StoreByClosureIndex);
+                NEXT_INSTRUCTION();
+            }
+
             DEFINE_OPCODE(BinaryMod)
                 :
             {
@@ -607,12 +703,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                 :
             {
                 BinaryLeftShift* code = (BinaryLeftShift*)programCounter;
-                const Value& left = registerFile[code->m_srcIndex0];
-                const Value& right = registerFile[code->m_srcIndex1];
-                int32_t lnum = left.toInt32(state);
-                int32_t rnum = right.toInt32(state);
-                lnum <<= ((unsigned int)rnum) & 0x1F;
-                registerFile[code->m_dstIndex] = Value(lnum);
+                registerFile[code->m_dstIndex] = binaryLeftShiftOperation(state, registerFile[code->m_srcIndex0], registerFile[code->m_srcIndex1]);
                 ADD_PROGRAM_COUNTER(BinaryLeftShift);
                 NEXT_INSTRUCTION();
             }
@@ -621,12 +712,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                 :
             {
                 BinarySignedRightShift* code = (BinarySignedRightShift*)programCounter;
-                const Value& left = registerFile[code->m_srcIndex0];
-                const Value& right = registerFile[code->m_srcIndex1];
-                int32_t lnum = left.toInt32(state);
-                int32_t rnum = right.toInt32(state);
-                lnum >>= ((unsigned int)rnum) & 0x1F;
-                registerFile[code->m_dstIndex] = Value(lnum);
+                registerFile[code->m_dstIndex] = binarySignedRightShiftOperation(state, registerFile[code->m_srcIndex0], registerFile[code->m_srcIndex1]);
                 ADD_PROGRAM_COUNTER(BinarySignedRightShift);
                 NEXT_INSTRUCTION();
             }
@@ -635,12 +721,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                 :
             {
                 BinaryUnsignedRightShift* code = (BinaryUnsignedRightShift*)programCounter;
-                const Value& left = registerFile[code->m_srcIndex0];
-                const Value& right = registerFile[code->m_srcIndex1];
-                uint32_t lnum = left.toUint32(state);
-                uint32_t rnum = right.toUint32(state);
-                lnum = (lnum) >> ((rnum)&0x1F);
-                registerFile[code->m_dstIndex] = Value(lnum);
+                registerFile[code->m_dstIndex] = binaryUnsignedRightShiftOperation(state, registerFile[code->m_srcIndex0], registerFile[code->m_srcIndex1]);
                 ADD_PROGRAM_COUNTER(BinaryUnsignedRightShift);
                 NEXT_INSTRUCTION();
             }
@@ -659,13 +740,13 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                 :
             {
                 ReturnFunctionWithValue* code = (ReturnFunctionWithValue*)programCounter;
-                return registerFile[code->m_registerIndex];
+                RETURN_FROM_FRAME(registerFile[code->m_registerIndex]);
             }
 
             DEFINE_OPCODE(ReturnFunction)
                 :
             {
-                return Value();
+                RETURN_FROM_FRAME(Value());
             }
 
             DEFINE_OPCODE(ToNumber)
@@ -682,7 +763,9 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                 :
             {
                 CreateObject* code = (CreateObject*)programCounter;
-                registerFile[code->m_registerIndex] = new Object(state);
+                Object* obj = new Object(state);
+                obj->reservePropertyStorage(code->m_propertyCount);
+                registerFile[code->m_registerIndex] = obj;
                 ADD_PROGRAM_COUNTER(CreateObject);
                 NEXT_INSTRUCTION();
             }
@@ -692,7 +775,8 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
             {
                 CreateArray* code = (CreateArray*)programCounter;
                 ArrayObject* arr = new ArrayObject(state);
-                arr->setArrayLength(state, code->m_length);
+                // elements are stored by ArrayDefineOwnPropertyOperation, which marks elisions as holes
+                arr->setArrayLength(state, code->m_length, true);
                 registerFile[code->m_registerIndex] = arr;
                 ADD_PROGRAM_COUNTER(CreateArray);
                 NEXT_INSTRUCTION();
@@ -719,13 +803,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                 :
             {
                 ObjectDefineOwnPropertyWithNameOperation* code = (ObjectDefineOwnPropertyWithNameOperation*)programCounter;
-                const Value& willBeObject = registerFile[code->m_objectRegisterIndex];
-                // http://www.ecma-international.org/ecma-262/6.0/#sec-__proto__-property-names-in-object-initializers
-                if (code->m_propertyName == state.context()->staticStrings().__proto__) {
-                    willBeObject.asObject()->setPrototype(state, registerFile[code->m_loadRegisterIndex]);
-                } else {
-                    willBeObject.asObject()->defineOwnProperty(state, ObjectPropertyName(code->m_propertyName), ObjectPropertyDescriptor(registerFile[code->m_loadRegisterIndex], ObjectPropertyDescriptor::AllPresent));
-                }
+                objectDefineOwnPropertyWithNameOperation(state, code, registerFile);
                 ADD_PROGRAM_COUNTER(ObjectDefineOwnPropertyWithNameOperation);
                 NEXT_INSTRUCTION();
             }
@@ -734,21 +812,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                 :
             {
                 ArrayDefineOwnPropertyOperation* code = (ArrayDefineOwnPropertyOperation*)programCounter;
-                ArrayObject* arr = registerFile[code->m_objectRegisterIndex].asObject()->asArrayObject();
-                if (LIKELY(arr->isFastModeArray())) {
-                    size_t end = code->m_count + code->m_baseIndex;
-                    for (size_t i = 0; i < code->m_count; i++) {
-                        if (LIKELY(code->m_loadRegisterIndexs[i] != std::numeric_limits<ByteCodeRegisterIndex>::max())) {
-                            arr->m_fastModeData[i + code->m_baseIndex] = registerFile[code->m_loadRegisterIndexs[i]];
-                        }
-                    }
-                } else {
-                    for (size_t i = 0; i < code->m_count; i++) {
-                        if (LIKELY(code->m_loadRegisterIndexs[i] != std::numeric_limits<ByteCodeRegisterIndex>::max())) {
-                            arr->defineOwnProperty(state, ObjectPropertyName(state, Value(i + code->m_baseIndex)), ObjectPropertyDescriptor(registerFile[code->m_loadRegisterIndexs[i]], ObjectPropertyDescriptor::AllPresent));
-                        }
-                    }
-                }
+                arrayDefineOwnPropertyOperation(state, code, registerFile);
                 ADD_PROGRAM_COUNTER(ArrayDefineOwnPropertyOperation);
                 NEXT_INSTRUCTION();
             }
@@ -803,15 +867,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                 :
             {
                 GetObject* code = (GetObject*)programCounter;
-                const Value& willBeObject = registerFile[code->m_objectRegisterIndex];
-                const Value& property = registerFile[code->m_propertyRegisterIndex];
-                Object* obj;
-                if (LIKELY(willBeObject.isObject())) {
-                    obj = willBeObject.asObject();
-                } else {
-                    obj = fastToObject(state, willBeObject);
-                }
-                registerFile[code->m_storeRegisterIndex] = obj->getIndexedProperty(state, property).value(state, willBeObject);
+                registerFile[code->m_storeRegisterIndex] = getObjectOperationSlowCase(state, registerFile[code->m_objectRegisterIndex], registerFile[code->m_propertyRegisterIndex]);
                 ADD_PROGRAM_COUNTER(GetObject);
                 NEXT_INSTRUCTION();
             }
@@ -820,19 +876,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                 :
             {
                 SetObjectOperation* code = (SetObjectOperation*)programCounter;
-                const Value& willBeObject = registerFile[code->m_objectRegisterIndex];
-                const Value& property = registerFile[code->m_propertyRegisterIndex];
-                Object* obj = willBeObject.toObject(state);
-                if (willBeObject.isPrimitive()) {
-                    obj->preventExtensions();
-                }
-
-                bool result = obj->setIndexedProperty(state, property, registerFile[code->m_loadRegisterIndex]);
-                if (UNLIKELY(!result)) {
-                    if (state.inStrictMode()) {
-                        Object::throwCannotWriteError(state, PropertyName(state, property.toString(state)));
-                    }
-                }
+                setObjectOperationSlowCase(state, registerFile[code->m_objectRegisterIndex], registerFile[code->m_propertyRegisterIndex], registerFile[code->m_loadRegisterIndex]);
                 ADD_PROGRAM_COUNTER(SetObjectOperation);
                 NEXT_INSTRUCTION();
             }
@@ -885,7 +929,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                 :
             {
                 (*(state.rareData()->m_controlFlowRecord))[state.rareData()->m_controlFlowRecord->size() - 1] = nullptr;
-                return Value();
+                RETURN_FROM_FRAME(Value());
             }
 
             DEFINE_OPCODE(FinallyEnd)
@@ -900,7 +944,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                         record->m_count--;
                         if (record->count() && (record->outerLimitCount() < record->count())) {
                             state.rareData()->m_controlFlowRecord->back() = record;
-                            return Value();
+                            RETURN_FROM_FRAME(Value());
                         } else {
                             programCounter = jumpTo(codeBuffer, pos);
                         }
@@ -910,9 +954,9 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                         record->m_count--;
                         if (record->count()) {
                             state.rareData()->m_controlFlowRecord->back() = record;
-                            return Value();
+                            RETURN_FROM_FRAME(Value());
                         } else {
-                            return record->value();
+                            RETURN_FROM_FRAME(record->value());
                         }
                     }
                 } else {
@@ -925,6 +969,10 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                 :
             {
                 ThrowOperation* code = (ThrowOperation*)programCounter;
+                if (byteCodeBlock->isInTryBody(programCounter - (size_t)codeBuffer)) {
+                    setPendingException(state, registerFile[code->m_registerIndex], byteCodeBlock, ec, programCounter);
+                    RETURN_FROM_FRAME(Value());
+                }
                 state.context()->throwException(state, registerFile[code->m_registerIndex]);
             }
 
@@ -936,10 +984,10 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                 Value* stackStorage = registerFile + byteCodeBlock->m_requiredRegisterFileSizeInValueSize;
                 Value v = withOperation(state, code, registerFile[code->m_registerIndex].toObject(state), ec, ec->lexicalEnvironment(), newPc, byteCodeBlock, registerFile, stackStorage);
                 if (!v.isEmpty()) {
-                    return v;
+                    RETURN_FROM_FRAME(v);
                 }
                 if (programCounter == newPc) {
-                    return Value();
+                    RETURN_FROM_FRAME(Value());
                 }
                 programCounter = newPc;
                 NEXT_INSTRUCTION();
@@ -950,7 +998,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
             {
                 JumpComplexCase* code = (JumpComplexCase*)programCounter;
                 state.ensureRareData()->m_controlFlowRecord->back() = code->m_controlFlowRecord->clone();
-                return Value();
+                RETURN_FROM_FRAME(Value());
             }
 
             DEFINE_OPCODE(EnumerateObject)
@@ -970,6 +1018,13 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                 EnumerateObjectData* data = (EnumerateObjectData*)registerFile[code->m_registerIndex].asPointerValue();
                 bool shouldUpdateEnumerateObjectData = false;
                 Object* obj = data->m_object;
+                if (data->m_hiddenClassChain.size() == 0) {
+                    // keys came from the enumeration cache of the structure
+                    EnumerateObjectKeys* keys = data->m_keys;
+                    if (UNLIKELY(obj->structure()->enumerationCache() != keys || keys->m_prototypeEpoch != state.context()->vmInstance()->prototypeEpoch() || keys->m_prototype != obj->getPrototypeObject())) {
+                        shouldUpdateEnumerateObjectData = true;
+                    }
+                }
                 for (size_t i = 0; i < data->m_hiddenClassChain.size(); i++) {
                     auto hc = data->m_hiddenClassChain[i];
                     ObjectStructureChainItem testItem;
@@ -998,7 +1053,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                     data = (EnumerateObjectData*)registerFile[code->m_registerIndex].asPointerValue();
                 }
 
-                if (data->m_keys.size() <= data->m_idx) {
+                if (data->m_keys->m_names.size() <= data->m_idx) {
                     programCounter = jumpTo(codeBuffer, code->m_forInEndPosition);
                 } else {
                     ADD_PROGRAM_COUNTER(CheckIfKeyIsLast);
@@ -1012,7 +1067,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                 EnumerateObjectKey* code = (EnumerateObjectKey*)programCounter;
                 EnumerateObjectData* data = (EnumerateObjectData*)registerFile[code->m_dataRegisterIndex].asPointerValue();
                 data->m_idx++;
-                registerFile[code->m_registerIndex] = Value(data->m_keys[data->m_idx - 1]).toString(state);
+                registerFile[code->m_registerIndex] = Value(data->m_keys->m_names[data->m_idx - 1]).toString(state);
                 ADD_PROGRAM_COUNTER(EnumerateObjectKey);
                 NEXT_INSTRUCTION();
             }
@@ -1116,7 +1171,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                         state.rareData()->m_controlFlowRecord->back() = new ControlFlowRecord(ControlFlowRecord::NeedsReturn, ret, state.rareData()->m_controlFlowRecord->size());
                     }
                 }
-                return ret;
+                RETURN_FROM_FRAME(ret);
             }
 
             DEFINE_OPCODE(ThrowStaticErrorOperation)
@@ -1126,7 +1181,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                 ErrorObject::throwBuiltinError(state, (ErrorObject::Code)code->m_errorKind, code->m_errorMessage);
             }
             DEFINE_OPCODE(End)
-                : return registerFile[0];
+                : RETURN_FROM_FRAME(registerFile[0]);
 
 #if !defined(COMPILER_GCC)
         default:
@@ -1136,12 +1191,56 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
     }
     catch (const Value& v)
     {
-        if (byteCodeBlock->m_codeBlock->isInterpretedCodeBlock() && byteCodeBlock->m_codeBlock->asInterpretedCodeBlock()->byteCodeBlock() == nullptr) {
-            byteCodeBlock->m_codeBlock->asInterpretedCodeBlock()->m_byteCodeBlock = byteCodeBlock;
+        // the frames pushed by this activation are unwound here, as their own activations would do
+        while (true) {
+            if (byteCodeBlock->m_codeBlock->isInterpretedCodeBlock() && byteCodeBlock->m_codeBlock->asInterpretedCodeBlock()->byteCodeBlock() == nullptr) {
+                byteCodeBlock->m_codeBlock->asInterpretedCodeBlock()->m_byteCodeBlock = byteCodeBlock;
+            }
+            if (inlineFrame == nullptr) {
+                break;
+            }
+            recordStackTraceData(*currentState, ec, programCounter);
+
+            InterpretedCallFrame* frame = inlineFrame;
+            inlineFrame = frame->m_previous;
+            currentState = frame->m_callerState;
+            byteCodeBlock = frame->m_callerByteCodeBlock;
+            registerFile = frame->m_callerRegisterFile;
+            programCounter = frame->m_callerProgramCounter;
+            ec = currentState->executionContext();
+            currentState->context()->vmInstance()->freeInterpreterFrame(frame);
         }
-        processException(state, v, ec, programCounter);
+        processException(*currentState, v, ec, programCounter);
     }
 }
+
+EnterCallFrame:
+    inlineFrame->m_callerState = currentState;
+    inlineFrame->m_callerByteCodeBlock = byteCodeBlock;
+    inlineFrame->m_callerRegisterFile = registerFile;
+    inlineFrame->m_callerProgramCounter = programCounter;
+    currentState = inlineFrame->m_state;
+    byteCodeBlock = inlineFrame->m_byteCodeBlock;
+    registerFile = currentState->registerFile();
+    programCounter = (size_t)byteCodeBlock->m_code.data();
+    goto SwitchFrame;
+
+ReturnFromCallFrame:
+{
+    InterpretedCallFrame* frame = inlineFrame;
+    inlineFrame = frame->m_previous;
+    currentState = frame->m_callerState;
+    byteCodeBlock = frame->m_callerByteCodeBlock;
+    registerFile = frame->m_callerRegisterFile;
+    programCounter = frame->m_returnProgramCounter;
+    registerFile[frame->m_resultIndex] = returnValue;
+    currentState->context()->vmInstance()->freeInterpreterFrame(frame);
+#if defined(ESCARGOT_ENABLE_JIT)
+    resumesCaller = true;
+#endif
+    goto SwitchFrame;
+}
+
 #if defined(COMPILER_GCC)
 FillOpcodeTableOpcodeLbl:
 {
@@ -1279,6 +1378,32 @@ NEVER_INLINE Value ByteCodeInterpreter::modOperation(ExecutionState& state, cons
     return ret;
 }
 
+NEVER_INLINE Value ByteCodeInterpreter::getObjectOperationSlowCase(ExecutionState& state, const Value& willBeObject, const Value& property)
+{
+    Object* obj;
+    if (LIKELY(willBeObject.isObject())) {
+        obj = willBeObject.asObject();
+    } else {
+        obj = fastToObject(state, willBeObject);
+    }
+    return obj->getIndexedProperty(state, property).value(state, willBeObject);
+}
+
+NEVER_INLINE void ByteCodeInterpreter::setObjectOperationSlowCase(ExecutionState& state, const Value& willBeObject, const Value& property, const Value& value)
+{
+    Object* obj = willBeObject.toObject(state);
+    if (willBeObject.isPrimitive()) {
+        obj->preventExtensions();
+    }
+
+    bool result = obj->setIndexedProperty(state, property, value);
+    if (UNLIKELY(!result)) {
+        if (state.inStrictMode()) {
+            Object::throwCannotWriteError(state, PropertyName(state, property.toString(state)));
+        }
+    }
+}
+
 NEVER_INLINE Object* ByteCodeInterpreter::newOperation(ExecutionState& state, const Value& callee, size_t argc, Value* argv)
 {
     if (UNLIKELY(!callee.isFunction())) {
@@ -1333,34 +1458,6 @@ NEVER_INLINE void ByteCodeInterpreter::deleteOperation(ExecutionState& state, Le
     }
 }
 
-ALWAYS_INLINE bool ByteCodeInterpreter::abstractRelationalComparison(ExecutionState& state, const Value& left, const Value& right, bool leftFirst)
-{
-    // consume very fast case
-    if (LIKELY(left.isInt32() && right.isInt32())) {
-        return left.asInt32() < right.asInt32();
-    }
-
-    if (LIKELY(left.isNumber() && right.isNumber())) {
-        return left.asNumber() < right.asNumber();
-    }
-
-    return abstractRelationalComparisonSlowCase(state, left, right, leftFirst);
-}
-
-ALWAYS_INLINE bool ByteCodeInterpreter::abstractRelationalComparisonOrEqual(ExecutionState& state, const Value& left, const Value& right, bool leftFirst)
-{
-    // consume very fast case
-    if (LIKELY(left.isInt32() && right.isInt32())) {
-        return left.asInt32() <= right.asInt32();
-    }
-
-    if (LIKELY(left.isNumber() && right.isNumber())) {
-        return left.asNumber() <= right.asNumber();
-    }
-
-    return abstractRelationalComparisonOrEqualSlowCase(state, left, right, leftFirst);
-}
-
 NEVER_INLINE bool ByteCodeInterpreter::abstractRelationalComparisonSlowCase(ExecutionState& state, const Value& left, const Value& right, bool leftFirst)
 {
     Value lval(Value::ForceUninitialized);
@@ -1410,94 +1507,153 @@ NEVER_INLINE bool ByteCodeInterpreter::abstractRelationalComparisonOrEqualSlowCa
 
 ALWAYS_INLINE Value ByteCodeInterpreter::getObjectPrecomputedCaseOperation(ExecutionState& state, Object* obj, const Value& receiver, const PropertyName& name, GetObjectInlineCache& inlineCache, ByteCodeBlock* block)
 {
-    Object* orgObj = obj;
-    const size_t cacheFillCount = inlineCache.m_cache.size();
-    GetObjectInlineCacheData* cacheData = inlineCache.m_cache.data();
-    unsigned currentCacheIndex = 0;
-TestCache:
-    for (; currentCacheIndex < cacheFillCount; currentCacheIndex++) {
-        obj = orgObj;
-        GetObjectInlineCacheData& data = cacheData[currentCacheIndex];
-        const size_t cSiz = data.m_cachedhiddenClassChain.size() - 1;
-        ObjectStructureChainItem* cachedHiddenClassChain = data.m_cachedhiddenClassChain.data();
-        size_t cachedIndex = data.m_cachedIndex;
-        size_t i;
-        for (i = 0; i < cSiz; i++) {
-            if (cachedHiddenClassChain[i].m_objectStructure != obj->structure()) {
-                currentCacheIndex++;
-                goto TestCache;
-            }
-            Object* protoObject = obj->getPrototypeObject();
-            if (protoObject != nullptr) {
-                obj = protoObject;
-            } else {
-                currentCacheIndex++;
-                goto TestCache;
-            }
-        }
+    ObjectStructure* structure = obj->structure();
+    if (LIKELY(inlineCache.m_monomorphicStructure == structure)) {
+        return obj->getOwnPropertyUtilForObject(state, inlineCache.m_monomorphicIndex, receiver);
+    }
 
-        if (LIKELY(cachedHiddenClassChain[cSiz].m_objectStructure == obj->structure())) {
-            if (LIKELY(data.m_cachedIndex != SIZE_MAX)) {
-                return obj->getOwnPropertyUtilForObject(state, data.m_cachedIndex, receiver);
-            } else {
-                return Value();
-            }
+    const size_t cacheFillCount = inlineCache.m_polymorphicCacheFillCount;
+    GetObjectInlineCacheData* cacheData = inlineCache.m_polymorphicCache;
+    for (size_t i = 0; i < cacheFillCount; i++) {
+        GetObjectInlineCacheData& data = cacheData[i];
+        if (data.m_cachedStructure != structure) {
+            continue;
+        }
+        if (!data.m_cachedPrototypeEpoch) {
+            return obj->getOwnPropertyUtilForObject(state, data.m_cachedIndex, receiver);
+        }
+        if (LIKELY(data.m_cachedPrototypeEpoch == state.context()->vmInstance()->prototypeEpoch() && data.m_cachedPrototype == obj->getPrototypeObject())) {
+            return getObjectWithInlineCacheData(state, obj, receiver, data);
         }
     }
 
-    return getObjectPrecomputedCaseOperationCacheMiss(state, orgObj, receiver, name, inlineCache, block);
+    return getObjectPrecomputedCaseOperationCacheMiss(state, obj, receiver, name, inlineCache, block);
 }
 
 NEVER_INLINE Value ByteCodeInterpreter::getObjectPrecomputedCaseOperationCacheMiss(ExecutionState& state, Object* obj, const Value& receiver, const PropertyName& name, GetObjectInlineCache& inlineCache, ByteCodeBlock* block)
 {
     const int maxCacheMissCount = 16;
     const int minCacheFillCount = 3;
-    const size_t maxCacheCount = 10;
     // cache miss.
     inlineCache.m_executeCount++;
     if (inlineCache.m_executeCount <= minCacheFillCount) {
         return obj->get(state, ObjectPropertyName(state, name)).value(state, receiver);
     }
 
-    if (inlineCache.m_cache.size())
+    if (inlineCache.m_monomorphicStructure || inlineCache.m_polymorphicCacheFillCount)
         inlineCache.m_cacheMissCount++;
 
-    if (inlineCache.m_cache.size() > maxCacheCount) {
+    if (inlineCache.m_cacheMissCount > maxCacheMissCount) {
+        return getObjectPrecomputedCaseOperationMegamorphic(state, obj, receiver, name);
+    }
+
+    GetObjectInlineCacheData newData;
+    if (UNLIKELY(!lookupPropertyForInlineCache(state, obj, name, newData))) {
         return obj->get(state, ObjectPropertyName(state, name)).value(state, receiver);
     }
 
-    if (UNLIKELY(!obj->isInlineCacheable())) {
+    ObjectStructure* structure = obj->structure();
+    if (!structure->isProtectedByTransitionTable()) {
+        block->m_objectStructuresInUse->insert(structure);
+    }
+
+    if (!newData.m_cachedPrototypeEpoch && !inlineCache.m_monomorphicStructure) {
+        inlineCache.m_monomorphicStructure = structure;
+        inlineCache.m_monomorphicIndex = newData.m_cachedIndex;
+        return obj->getOwnPropertyUtilForObject(state, newData.m_cachedIndex, receiver);
+    }
+
+    if (!inlineCache.m_polymorphicCache) {
+        inlineCache.m_polymorphicCache = GCUtil::gc_malloc_allocator<GetObjectInlineCacheData>().allocate(GetObjectInlineCache::polymorphicCacheSize);
+        block->m_literalData.pushBack(inlineCache.m_polymorphicCache);
+    }
+
+    size_t slot;
+    if (inlineCache.m_polymorphicCacheFillCount < GetObjectInlineCache::polymorphicCacheSize) {
+        slot = inlineCache.m_polymorphicCacheFillCount++;
+    } else {
+        slot = inlineCache.m_polymorphicCacheNextIndex;
+        inlineCache.m_polymorphicCacheNextIndex = (slot + 1) % GetObjectInlineCache::polymorphicCacheSize;
+    }
+    inlineCache.m_polymorphicCache[slot] = newData;
+
+    return getObjectWithInlineCacheData(state, obj, receiver, newData);
+}
+
+NEVER_INLINE Value ByteCodeInterpreter::getObjectPrecomputedCaseOperationMegamorphic(ExecutionState& state, Object* obj, const Value& receiver, const PropertyName& name)
+{
+    if (UNLIKELY(!name.hasAtomicString())) {
         return obj->get(state, ObjectPropertyName(state, name)).value(state, receiver);
     }
 
-    Object* orgObj = obj;
-    inlineCache.m_cache.insert(inlineCache.m_cache.begin(), GetObjectInlineCacheData());
+    VMInstance* vmInstance = state.context()->vmInstance();
+    ObjectStructure* structure = obj->structure();
+    String* atomicName = name.plainString();
+    size_t hash = ((size_t)structure >> 4) ^ ((size_t)atomicName >> 3) * 31;
+    GetObjectMegamorphicCacheEntry& entry = vmInstance->megamorphicPropertyCache()[hash & (ESCARGOT_MEGAMORPHIC_PROPERTY_CACHE_SIZE - 1)];
+    GetObjectInlineCacheData& data = entry.m_data;
+
+    if (entry.m_propertyName == atomicName && data.m_cachedStructure == structure
+        && (!data.m_cachedPrototypeEpoch || (data.m_cachedPrototypeEpoch == vmInstance->prototypeEpoch() && data.m_cachedPrototype == obj->getPrototypeObject()))) {
+        vmInstance->megamorphicPropertyCacheHitCount()++;
+        return getObjectWithInlineCacheData(state, obj, receiver, data);
+    }
 
-    ObjectStructureChain* cachedHiddenClassChain = &inlineCache.m_cache[0].m_cachedhiddenClassChain;
+    vmInstance->megamorphicPropertyCacheMissCount()++;
+    GetObjectInlineCacheData newData;
+    if (UNLIKELY(!lookupPropertyForInlineCache(state, obj, name, newData))) {
+        return obj->get(state, ObjectPropertyName(state, name)).value(state, receiver);
+    }
+    entry.m_propertyName = atomicName;
+    data = newData;
 
-    ObjectStructureChainItem newItem;
-    while (true) {
-        newItem.m_objectStructure = obj->structure();
+    return getObjectWithInlineCacheData(state, obj, receiver, newData);
+}
 
-        cachedHiddenClassChain->push_back(newItem);
-        size_t idx = obj->structure()->findProperty(state, name);
+bool ByteCodeInterpreter::lookupPropertyForInlineCache(ExecutionState& state, Object* obj, const PropertyName& name, GetObjectInlineCacheData& result)
+{
+    if (UNLIKELY(!obj->isInlineCacheable())) {
+        return false;
+    }
 
-        if (!obj->structure()->isProtectedByTransitionTable()) {
-            block->m_objectStructuresInUse->insert(obj->structure());
-        }
+    ObjectStructure* structure = obj->structure();
+    result.m_cachedStructure = structure;
+    result.m_cachedPrototype = nullptr;
+    result.m_cachedHolder = nullptr;
+    result.m_cachedIndex = structure->findProperty(state, name);
+    result.m_cachedPrototypeEpoch = 0;
 
-        if (idx != SIZE_MAX) {
-            inlineCache.m_cache[0].m_cachedIndex = idx;
-            break;
+    if (result.m_cachedIndex != SIZE_MAX) {
+        return true;
+    }
+
+    result.m_cachedPrototype = obj->getPrototypeObject();
+    Object* holder = result.m_cachedPrototype;
+    while (holder) {
+        if (UNLIKELY(!holder->isInlineCacheable())) {
+            return false;
+        }
+        if (!holder->isEverSetAsPrototypeObject()) {
+            holder->markAsPrototypeObject(state);
         }
-        obj = obj->getPrototypeObject();
-        if (!obj) {
+        size_t idx = holder->structure()->findProperty(state, name);
+        if (idx != SIZE_MAX) {
+            result.m_cachedHolder = holder;
+            result.m_cachedIndex = idx;
             break;
         }
+        holder = holder->getPrototypeObject();
     }
+    result.m_cachedPrototypeEpoch = state.context()->vmInstance()->prototypeEpoch();
+    return true;
+}
 
-    if (inlineCache.m_cache[0].m_cachedIndex != SIZE_MAX) {
-        return obj->getOwnPropertyUtilForObject(state, inlineCache.m_cache[0].m_cachedIndex, receiver);
+ALWAYS_INLINE Value ByteCodeInterpreter::getObjectWithInlineCacheData(ExecutionState& state, Object* obj, const Value& receiver, const GetObjectInlineCacheData& data)
+{
+    if (data.m_cachedHolder) {
+        return data.m_cachedHolder->getOwnPropertyUtilForObject(state, data.m_cachedIndex, receiver);
+    } else if (data.m_cachedIndex != SIZE_MAX) {
+        return obj->getOwnPropertyUtilForObject(state, data.m_cachedIndex, receiver);
     } else {
         return Value();
     }
@@ -1514,47 +1670,25 @@ ALWAYS_INLINE void ByteCodeInterpreter::setObjectPreComputedCaseOperation(Execut
     } else {
         obj = willBeObject.asObject();
     }
-    Object* originalObject = obj;
-    ASSERT(originalObject != nullptr);
-
-    ObjectStructureChainItem testItem;
-    testItem.m_objectStructure = obj->structure();
+    ASSERT(obj != nullptr);
 
-    if (inlineCache.m_cachedIndex != SIZE_MAX && inlineCache.m_cachedhiddenClassChain[0] == testItem) {
-        ASSERT(inlineCache.m_cachedhiddenClassChain.size() == 1);
-        // cache hit!
-        obj->m_values[inlineCache.m_cachedIndex] = value;
-        return;
-    } else if (inlineCache.m_hiddenClassWillBe) {
-        int cSiz = inlineCache.m_cachedhiddenClassChain.size();
-        bool miss = false;
-        for (int i = 0; i < cSiz - 1; i++) {
-            testItem.m_objectStructure = obj->structure();
-            if (UNLIKELY(inlineCache.m_cachedhiddenClassChain[i] != testItem)) {
-                miss = true;
-                break;
-            } else {
-                Object* o = obj->getPrototypeObject();
-                if (UNLIKELY(!o)) {
-                    miss = true;
-                    break;
-                }
-                obj = o;
-            }
-        }
-        if (LIKELY(!miss)) {
-            if (inlineCache.m_cachedhiddenClassChain[cSiz - 1].m_objectStructure == obj->structure()) {
-                // cache hit!
-                obj = originalObject;
-                ASSERT(!obj->structure()->isStructureWithFastAccess());
-                obj->m_values.push_back(value, inlineCache.m_hiddenClassWillBe->propertyCount());
-                obj->m_structure = inlineCache.m_hiddenClassWillBe;
-                return;
-            }
+    if (LIKELY(inlineCache.m_cachedStructure == obj->structure())) {
+        if (inlineCache.m_cachedIndex != SIZE_MAX) {
+            // cache hit!
+            obj->m_values[inlineCache.m_cachedIndex] = value;
+            return;
+        } else if (inlineCache.m_cachedPrototypeEpoch == state.context()->vmInstance()->prototypeEpoch() && inlineCache.m_cachedPrototype == obj->getPrototypeObject()) {
+            // cache hit!
+            ASSERT(inlineCache.m_hiddenClassWillBe);
+            ASSERT(!obj->structure()->isStructureWithFastAccess());
+            obj->m_values.push_back(value, inlineCache.m_hiddenClassWillBe->propertyCount());
+            obj->m_structure = inlineCache.m_hiddenClassWillBe;
+            obj->invalidatePrototypeChainCachesIfNeeded(state);
+            return;
         }
     }
 
-    setObjectPreComputedCaseOperationCacheMiss(state, originalObject, willBeObject, name, value, inlineCache, block);
+    setObjectPreComputedCaseOperationCacheMiss(state, obj, willBeObject, name, value, inlineCache, block);
 }
 
 NEVER_INLINE void ByteCodeInterpreter::setObjectPreComputedCaseOperationCacheMiss(ExecutionState& state, Object* originalObject, const Value& willBeObject, const PropertyName& name, const Value& value, SetObjectInlineCache& inlineCache, ByteCodeBlock* block)
@@ -1579,14 +1713,13 @@ NEVER_INLINE void ByteCodeInterpreter::setObjectPreComputedCaseOperationCacheMis
     size_t idx = obj->structure()->findProperty(state, name);
     if (idx != SIZE_MAX) {
         // own property
-        ObjectStructureChainItem newItem;
-        newItem.m_objectStructure = obj->structure();
+        ObjectStructure* structure = obj->structure();
 
         obj->setOwnPropertyThrowsExceptionWhenStrictMode(state, idx, value, willBeObject);
         auto desc = obj->structure()->readProperty(state, idx).m_descriptor;
-        if (desc.isPlainDataProperty() && desc.isWritable()) {
+        if (desc.isPlainDataProperty() && desc.isWritable() && structure == obj->structure()) {
+            inlineCache.m_cachedStructure = structure;
             inlineCache.m_cachedIndex = idx;
-            inlineCache.m_cachedhiddenClassChain.push_back(newItem);
         }
     } else {
         Object* orgObject = obj;
@@ -1596,16 +1729,19 @@ NEVER_INLINE void ByteCodeInterpreter::setObjectPreComputedCaseOperationCacheMis
             return;
         }
 
-        ObjectStructureChainItem newItem;
-        newItem.m_objectStructure = obj->structure();
-        inlineCache.m_cachedhiddenClassChain.push_back(newItem);
-        Value proto = obj->getPrototype(state);
-        while (proto.isObject()) {
-            obj = proto.asObject();
-            newItem.m_objectStructure = obj->structure();
-            inlineCache.m_cachedhiddenClassChain.push_back(newItem);
-            proto = obj->getPrototype(state);
+        ObjectStructure* structure = obj->structure();
+        Object* prototype = obj->getPrototypeObject();
+        bool cacheable = true;
+        for (Object* proto = prototype; proto; proto = proto->getPrototypeObject()) {
+            if (UNLIKELY(!proto->isInlineCacheable())) {
+                cacheable = false;
+                break;
+            }
+            if (!proto->isEverSetAsPrototypeObject()) {
+                proto->markAsPrototypeObject(state);
+            }
         }
+
         bool s = orgObject->set(state, ObjectPropertyName(state, name), value, willBeObject);
         if (UNLIKELY(!s)) {
             if (state.inStrictMode())
@@ -1614,7 +1750,7 @@ NEVER_INLINE void ByteCodeInterpreter::setObjectPreComputedCaseOperationCacheMis
             inlineCache.invalidateCache();
             return;
         }
-        if (orgObject->structure()->isStructureWithFastAccess()) {
+        if (!cacheable || orgObject->structure()->isStructureWithFastAccess()) {
             inlineCache.invalidateCache();
             return;
         }
@@ -1625,17 +1761,58 @@ NEVER_INLINE void ByteCodeInterpreter::setObjectPreComputedCaseOperationCacheMis
             return;
         }
 
+        if (!structure->isProtectedByTransitionTable()) {
+            block->m_objectStructuresInUse->insert(structure);
+        }
+        inlineCache.m_cachedStructure = structure;
+        inlineCache.m_cachedPrototype = prototype;
+        inlineCache.m_cachedPrototypeEpoch = state.context()->vmInstance()->prototypeEpoch();
         inlineCache.m_hiddenClassWillBe = orgObject->structure();
     }
 }
 
-NEVER_INLINE EnumerateObjectData* ByteCodeInterpreter::executeEnumerateObject(ExecutionState& state, Object* obj)
+#if defined(ESCARGOT_ENABLE_JIT)
+NEVER_INLINE Value ByteCodeInterpreter::getObjectPrecomputedCaseOperationOutOfLine(ExecutionState& state, const Value& willBeObject, GetObjectPreComputedCase* code, ByteCodeBlock* block)
+{
+    Object* obj;
+    if (LIKELY(willBeObject.isObject())) {
+        obj = willBeObject.asObject();
+    } else {
+        obj = fastToObject(state, willBeObject);
+    }
+    return getObjectPrecomputedCaseOperation(state, obj, willBeObject, code->m_propertyName, code->m_inlineCache, block);
+}
+
+NEVER_INLINE void ByteCodeInterpreter::setObjectPreComputedCaseOperationOutOfLine(ExecutionState& state, const Value& willBeObject, SetObjectPreComputedCase* code, const Value& value, ByteCodeBlock* block)
+{
+    setObjectPreComputedCaseOperation(state, willBeObject, code->m_propertyName, value, *code->m_inlineCache, block);
+}
+#endif
+
+NEVER_INLINE EnumerateObjectData* ByteCodeInterpreter::executeEnumerateObject(ExecutionState& state, Object* obj, bool useEnumerationCache)
 {
     EnumerateObjectData* data = new EnumerateObjectData();
     data->m_object = obj;
     data->m_originalLength = 0;
     if (obj->isArrayObject())
         data->m_originalLength = obj->length(state);
+
+    VMInstance* vmInstance = state.context()->vmInstance();
+    bool isCacheable = obj->isEnumerationCacheable();
+    if (isCacheable && useEnumerationCache) {
+        EnumerateObjectKeys* cachedKeys = obj->structure()->enumerationCache();
+        if (cachedKeys && cachedKeys->m_prototypeEpoch == vmInstance->prototypeEpoch() && cachedKeys->m_prototype == obj->getPrototypeObject()) {
+            data->m_keys = cachedKeys;
+            // a flag left by an earlier loop would make CheckIfKeyIsLast enumerate again
+            if (obj->rareData()) {
+                obj->rareData()->m_shouldUpdateEnumerateObjectData = false;
+            }
+            return data;
+        }
+    }
+
+    EnumerateObjectKeys* keys = new EnumerateObjectKeys();
+    data->m_keys = keys;
     Value target = data->m_object;
 
     size_t ownKeyCount = 0;
@@ -1658,6 +1835,7 @@ NEVER_INLINE EnumerateObjectData* ByteCodeInterpreter::executeEnumerateObject(Ex
 
     target = target.asObject()->getPrototype(state);
     while (target.isObject()) {
+        isCacheable = isCacheable && target.asObject()->isEnumerationCacheable();
         if (!shouldSearchProto) {
             target.asObject()->enumeration(state, [](ExecutionState& state, Object* self, const ObjectPropertyName& name, const ObjectStructurePropertyDescriptor& desc, void* data) -> bool {
                 if (desc.isEnumerable()) {
@@ -1695,7 +1873,7 @@ NEVER_INLINE EnumerateObjectData* ByteCodeInterpreter::executeEnumerateObject(Ex
                     auto iter = eData->keyStringSet->find(key);
                     if (iter == eData->keyStringSet->end()) {
                         eData->keyStringSet->insert(key);
-                        eData->data->m_keys.pushBack(name.toPlainValue(state));
+                        eData->data->m_keys->m_names.pushBack(name.toPlainValue(state));
                     }
                 } else if (self == eData->obj) {
                     // 12.6.4 The values of [[Enumerable]] attributes are not considered
@@ -1712,11 +1890,11 @@ NEVER_INLINE EnumerateObjectData* ByteCodeInterpreter::executeEnumerateObject(Ex
     } else {
         size_t idx = 0;
         eData.idx = &idx;
-        data->m_keys.resizeWithUninitializedValues(ownKeyCount);
+        keys->m_names.resizeWithUninitializedValues(ownKeyCount);
         target.asObject()->enumeration(state, [](ExecutionState& state, Object* self, const ObjectPropertyName& name, const ObjectStructurePropertyDescriptor& desc, void* data) -> bool {
             if (desc.isEnumerable()) {
                 EData* eData = (EData*)data;
-                eData->data->m_keys[(*eData->idx)++] = name.toPlainValue(state);
+                eData->data->m_keys->m_names[(*eData->idx)++] = name.toPlainValue(state);
             }
             return true;
         },
@@ -1727,49 +1905,128 @@ NEVER_INLINE EnumerateObjectData* ByteCodeInterpreter::executeEnumerateObject(Ex
     if (obj->rareData()) {
         obj->rareData()->m_shouldUpdateEnumerateObjectData = false;
     }
+
+    if (isCacheable) {
+        // objects on the prototype chain are marked as prototype objects,
+        // so any change of them invalidates the cached keys through the prototype epoch
+        Object* proto = obj->getPrototypeObject();
+        keys->m_prototype = proto;
+        while (proto) {
+            if (!proto->isEverSetAsPrototypeObject()) {
+                proto->markAsPrototypeObject(state);
+            }
+            proto = proto->getPrototypeObject();
+        }
+        keys->m_prototypeEpoch = vmInstance->prototypeEpoch();
+        obj->structure()->setEnumerationCache(keys);
+    }
     return data;
 }
 
 NEVER_INLINE EnumerateObjectData* ByteCodeInterpreter::updateEnumerateObjectData(ExecutionState& state, EnumerateObjectData* data)
 {
-    EnumerateObjectData* newData = executeEnumerateObject(state, data->m_object);
-    std::vector<Value, GCUtil::gc_malloc_ignore_off_page_allocator<Value>> oldKeys;
-    if (data->m_keys.size()) {
-        oldKeys.insert(oldKeys.end(), &data->m_keys[0], &data->m_keys[data->m_keys.size() - 1] + 1);
+    // the chain of the new data is always recorded, because its keys are not the cached ones
+    EnumerateObjectData* newData = executeEnumerateObject(state, data->m_object, false);
+
+    // keys are compared by their raw representation like Value::operator==
+    const SmallValueVector& oldKeys = data->m_keys->m_names;
+    std::unordered_set<uint64_t> visitedKeys;
+    std::unordered_set<uint64_t> remainingKeys;
+    for (size_t i = 0; i < oldKeys.size(); i++) {
+        uint64_t key = Value(oldKeys[i]).asRawData();
+        if (i < data->m_idx) {
+            visitedKeys.insert(key);
+        } else {
+            remainingKeys.insert(key);
+        }
     }
+
+    const SmallValueVector& newKeys = newData->m_keys->m_names;
     std::vector<Value, GCUtil::gc_malloc_ignore_off_page_allocator<Value>> differenceKeys;
-    for (size_t i = 0; i < newData->m_keys.size(); i++) {
-        const Value& key = newData->m_keys[i];
-        if (std::find(oldKeys.begin(), oldKeys.begin() + data->m_idx, key) == oldKeys.begin() + data->m_idx) {
+    for (size_t i = 0; i < newKeys.size(); i++) {
+        Value key = newKeys[i];
+        uint64_t rawKey = key.asRawData();
+        if (visitedKeys.find(rawKey) == visitedKeys.end()) {
             // If a property that has not yet been visited during enumeration is deleted, then it will not be visited.
-            if (std::find(oldKeys.begin() + data->m_idx, oldKeys.end(), key) != oldKeys.end()) {
+            if (remainingKeys.find(rawKey) != remainingKeys.end()) {
                 // If new properties are added to the object being enumerated during enumeration,
                 // the newly added properties are not guaranteed to be visited in the active enumeration.
                 differenceKeys.push_back(key);
             }
         }
     }
-    data = newData;
-    data->m_keys.clear();
-    data->m_keys.resizeWithUninitializedValues(differenceKeys.size());
+
+    // keys of newData may be shared through the enumeration cache, so they are replaced instead of modified
+    EnumerateObjectKeys* keys = new EnumerateObjectKeys();
+    keys->m_names.resizeWithUninitializedValues(differenceKeys.size());
     for (size_t i = 0; i < differenceKeys.size(); i++) {
-        data->m_keys[i] = differenceKeys[i];
+        keys->m_names[i] = differenceKeys[i];
     }
-    return data;
+    newData->m_keys = keys;
+    return newData;
+}
+
+ALWAYS_INLINE FunctionEnvironmentRecordOnHeap* ByteCodeInterpreter::argumentsRecord(ExecutionContext* ec, size_t catchScopeCount)
+{
+    // catch scopes have their own context
+    while (catchScopeCount--) {
+        ec = ec->parent();
+    }
+    FunctionEnvironmentRecord* record = ec->lexicalEnvironment()->record()->asDeclarativeEnvironmentRecord()->asFunctionEnvironmentRecord();
+    ASSERT(record->isFunctionEnvironmentRecordOnHeap());
+    return (FunctionEnvironmentRecordOnHeap*)record;
+}
+
+ALWAYS_INLINE bool ByteCodeInterpreter::getArgumentsElementDirectly(FunctionEnvironmentRecordOnHeap* record, ByteCodeBlock* block, const Value& property, Value& result)
+{
+    if (LIKELY(property.isUInt32())) {
+        uint32_t idx = property.asUInt32();
+        if (LIKELY(idx < record->m_argc)) {
+            InterpretedCodeBlock* codeBlock = block->m_codeBlock;
+            if (codeBlock->isStrict() || idx >= codeBlock->parametersInfomation().size()) {
+                result = record->m_argv[idx];
+                return true;
+            }
+            // mapped to its parameter
+            const InterpretedCodeBlock::FunctionParametersInfo& info = codeBlock->parametersInfomation()[idx];
+            if (LIKELY(info.m_isHeapAllocated)) {
+                result = record->m_heapStorage[info.m_index];
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+NEVER_INLINE Value ByteCodeInterpreter::getArgumentsLengthOperation(ExecutionState& state, GetArgumentsLength* code, ExecutionContext* ec, Value* registerFile, ByteCodeBlock* block)
+{
+    Value& arguments = registerFile[code->m_argumentsRegisterIndex];
+    if (!block->m_needsArgumentsObject && arguments.isUndefined()) {
+        return Value(argumentsRecord(ec, code->m_catchScopeCount)->m_argc);
+    }
+    Object* obj = fastToObject(state, arguments);
+    return obj->get(state, ObjectPropertyName(state.context()->staticStrings().length)).value(state, arguments);
 }
 
-ALWAYS_INLINE Object* ByteCodeInterpreter::fastToObject(ExecutionState& state, const Value& obj)
+NEVER_INLINE Value ByteCodeInterpreter::getArgumentsElementOperation(ExecutionState& state, GetArgumentsElement* code, ExecutionContext* ec, Value* registerFile, ByteCodeBlock* block)
 {
-    if (LIKELY(obj.isString())) {
-        StringObject* o = state.context()->globalObject()->stringProxyObject();
-        o->setPrimitiveValue(state, obj.asString());
-        return o;
-    } else if (obj.isNumber()) {
-        NumberObject* o = state.context()->globalObject()->numberProxyObject();
-        o->setPrimitiveValue(state, obj.asNumber());
-        return o;
-    }
-    return obj.toObject(state);
+    Value& arguments = registerFile[code->m_argumentsRegisterIndex];
+    const Value& property = registerFile[code->m_propertyRegisterIndex];
+    if (!block->m_needsArgumentsObject && arguments.isUndefined()) {
+        ExecutionContext* functionContext = ec;
+        for (size_t i = 0; i < code->m_catchScopeCount; i++) {
+            functionContext = functionContext->parent();
+        }
+        FunctionEnvironmentRecordOnHeap* record = argumentsRecord(functionContext, 0);
+        Value result;
+        if (getArgumentsElementDirectly(record, block, property, result)) {
+            return result;
+        }
+        // other properties are read from the arguments object
+        arguments = record->createArgumentsObject(state, functionContext);
+    }
+    Object* obj = fastToObject(state, arguments);
+    return obj->getIndexedProperty(state, property).value(state, arguments);
 }
 
 NEVER_INLINE Value ByteCodeInterpreter::getGlobalObjectSlowCase(ExecutionState& state, Object* go, GetGlobalObject* code, ByteCodeBlock* block)
@@ -1855,6 +2112,7 @@ NEVER_INLINE void ByteCodeInterpreter::setGlobalObjectSlowCase(ExecutionState& s
 NEVER_INLINE size_t ByteCodeInterpreter::tryOperation(ExecutionState& state, TryOperation* code, ExecutionContext* ec, LexicalEnvironment* env, size_t programCounter, ByteCodeBlock* byteCodeBlock, Value* registerFile)
 {
     char* codeBuffer = byteCodeBlock->m_code.data();
+    Value val(Value::EmptyValue);
     try {
         if (!state.ensureRareData()->m_controlFlowRecord) {
             state.ensureRareData()->m_controlFlowRecord = new ControlFlowRecordVector();
@@ -1864,42 +2122,50 @@ NEVER_INLINE size_t ByteCodeInterpreter::tryOperation(ExecutionState& state, Try
         clearStack<386>();
         size_t unused;
         interpret(state, byteCodeBlock, resolveProgramCounter(codeBuffer, newPc), registerFile, &unused);
-        programCounter = jumpTo(codeBuffer, code->m_tryCatchEndPosition);
-    } catch (const Value& val) {
-        state.context()->m_sandBoxStack.back()->fillStackDataIntoErrorObject(val);
+        if (LIKELY(!state.rareData()->m_hasPendingException)) {
+            return jumpTo(codeBuffer, code->m_tryCatchEndPosition);
+        }
+        // thrown by the try body itself
+        state.rareData()->m_hasPendingException = false;
+        val = state.context()->m_sandBoxStack.back()->m_exception;
+    } catch (const Value& thrownValue) {
+        val = thrownValue;
+    }
+
+    state.context()->m_sandBoxStack.back()->fillStackDataIntoErrorObject(val);
 
 #ifndef NDEBUG
-        if (getenv("DUMP_ERROR_IN_TRY_CATCH") && strlen(getenv("DUMP_ERROR_IN_TRY_CATCH"))) {
-            ErrorObject::StackTraceData* data = ErrorObject::StackTraceData::create(state.context()->m_sandBoxStack.back());
-            StringBuilder builder;
-            builder.appendString("Caught error in try-catch block\n");
-            data->buildStackTrace(state.context(), builder);
-            ESCARGOT_LOG_ERROR("%s\n", builder.finalize()->toUTF8StringData().data());
-        }
+    if (getenv("DUMP_ERROR_IN_TRY_CATCH") && strlen(getenv("DUMP_ERROR_IN_TRY_CATCH"))) {
+        ErrorObject::StackTraceData* data = ErrorObject::StackTraceData::create(state.context()->m_sandBoxStack.back());
+        StringBuilder builder;
+        builder.appendString("Caught error in try-catch block\n");
+        data->buildStackTrace(state.context(), builder);
+        ESCARGOT_LOG_ERROR("%s\n", builder.finalize()->toUTF8StringData().data());
+    }
 #endif
 
-        state.context()->m_sandBoxStack.back()->m_stackTraceData.clear();
-        if (code->m_hasCatch == false) {
+    state.context()->m_sandBoxStack.back()->m_stackTraceData.clear();
+    if (code->m_hasCatch == false) {
+        state.rareData()->m_controlFlowRecord->back() = new ControlFlowRecord(ControlFlowRecord::NeedsThrow, val);
+        programCounter = jumpTo(codeBuffer, code->m_tryCatchEndPosition);
+    } else {
+        // setup new env
+        EnvironmentRecord* newRecord = new DeclarativeEnvironmentRecordNotIndexedForCatch();
+        newRecord->createBinding(state, code->m_catchVariableName);
+        newRecord->setMutableBinding(state, code->m_catchVariableName, val);
+        LexicalEnvironment* newEnv = new LexicalEnvironment(newRecord, env);
+        ExecutionContext* newEc = new ExecutionContext(state.context(), state.executionContext(), newEnv, state.inStrictMode());
+        newEc->m_closureDisplay = state.executionContext()->m_closureDisplay;
+        try {
+            ExecutionState newState(&state, newEc);
+            newState.ensureRareData()->m_controlFlowRecord = state.rareData()->m_controlFlowRecord;
+            clearStack<386>();
+            size_t unused;
+            interpret(newState, byteCodeBlock, code->m_catchPosition, registerFile, &unused);
+            programCounter = jumpTo(codeBuffer, code->m_tryCatchEndPosition);
+        } catch (const Value& val) {
             state.rareData()->m_controlFlowRecord->back() = new ControlFlowRecord(ControlFlowRecord::NeedsThrow, val);
             programCounter = jumpTo(codeBuffer, code->m_tryCatchEndPosition);
-        } else {
-            // setup new env
-            EnvironmentRecord* newRecord = new DeclarativeEnvironmentRecordNotIndexedForCatch();
-            newRecord->createBinding(state, code->m_catchVariableName);
-            newRecord->setMutableBinding(state, code->m_catchVariableName, val);
-            LexicalEnvironment* newEnv = new LexicalEnvironment(newRecord, env);
-            ExecutionContext* newEc = new ExecutionContext(state.context(), state.executionContext(), newEnv, state.inStrictMode());
-            try {
-                ExecutionState newState(&state, newEc);
-                newState.ensureRareData()->m_controlFlowRecord = state.rareData()->m_controlFlowRecord;
-                clearStack<386>();
-                size_t unused;
-                interpret(newState, byteCodeBlock, code->m_catchPosition, registerFile, &unused);
-                programCounter = jumpTo(codeBuffer, code->m_tryCatchEndPosition);
-            } catch (const Value& val) {
-                state.rareData()->m_controlFlowRecord->back() = new ControlFlowRecord(ControlFlowRecord::NeedsThrow, val);
-                programCounter = jumpTo(codeBuffer, code->m_tryCatchEndPosition);
-            }
         }
     }
     return programCounter;
@@ -1972,6 +2238,7 @@ NEVER_INLINE Value ByteCodeInterpreter::withOperation(ExecutionState& state, Wit
     EnvironmentRecord* newRecord = new ObjectEnvironmentRecord(obj);
     LexicalEnvironment* newEnv = new LexicalEnvironment(newRecord, env);
     ExecutionContext* newEc = new ExecutionContext(state.context(), state.executionContext(), newEnv, state.inStrictMode());
+    newEc->m_closureDisplay = state.executionContext()->m_closureDisplay;
     ExecutionState newState(&state, newEc);
     newState.ensureRareData()->m_controlFlowRecord = state.rareData()->m_controlFlowRecord;
 
@@ -2109,7 +2376,56 @@ NEVER_INLINE void ByteCodeInterpreter::defineObjectSetter(ExecutionState& state,
     registerFile[code->m_objectRegisterIndex].toObject(state)->defineOwnPropertyThrowsExceptionWhenStrictMode(state, ObjectPropertyName(state, pName), desc);
 }
 
-NEVER_INLINE void ByteCodeInterpreter::processException(ExecutionState& state, const Value& value, ExecutionContext* ecInput, size_t programCounter)
+NEVER_INLINE InterpretedCallFrame* ByteCodeInterpreter::pushCallFrame(ExecutionState& state, FunctionObject* callee, const Value& receiver, size_t argc, Value* argv, CallFunctionCache& cache, ByteCodeBlock* callerBlock)
+{
+    InterpretedCodeBlock* codeBlock = callee->codeBlock()->asInterpretedCodeBlock();
+    ByteCodeBlock* blk = callee->prepareByteCodeBlock(state);
+    // the call site keeps its first callee. its ByteCodeBlock may be generated again after eviction
+    if (cache.m_codeBlock == nullptr || cache.m_codeBlock == codeBlock) {
+        if (cache.m_codeBlock == nullptr) {
+            callerBlock->m_literalData.pushBack(codeBlock);
+        }
+        cache.m_codeBlock = codeBlock;
+        cache.m_byteCodeBlock = blk;
+        cache.m_byteCodeBlockGeneration = codeBlock->m_byteCodeBlockGeneration;
+        FunctionObject::fillInterpretedCallFrameLayout(codeBlock, blk, cache.m_layout);
+        return pushCachedCallFrame(state, callee, receiver, argc, argv, cache);
+    }
+
+    VMInstance* vmInstance = state.context()->vmInstance();
+    InterpretedCallFrame* frame = (InterpretedCallFrame*)vmInstance->allocateInterpreterFrame(interpretedCallFrameHeaderSize + FunctionObject::interpretedCallFrameSize(codeBlock, blk));
+    if (UNLIKELY(frame == nullptr)) {
+        return nullptr;
+    }
+
+    try {
+        frame->m_state = callee->initializeInterpretedCallFrame(state, blk, (char*)frame + interpretedCallFrameHeaderSize, receiver, argc, argv);
+    } catch (const Value& v) {
+        vmInstance->freeInterpreterFrame(frame);
+        throw;
+    }
+    frame->m_byteCodeBlock = blk;
+    return frame;
+}
+
+NEVER_INLINE void ByteCodeInterpreter::processException(ExecutionState& state, const Value& value, ExecutionContext* ec, size_t programCounter)
+{
+    recordStackTraceData(state, ec, programCounter);
+    state.context()->m_sandBoxStack.back()->throwException(state, value);
+}
+
+NEVER_INLINE void ByteCodeInterpreter::setPendingException(ExecutionState& state, const Value& value, ByteCodeBlock* byteCodeBlock, ExecutionContext* ec, size_t programCounter)
+{
+    // same as what throwException and the handler of interpret do, without unwinding
+    if (byteCodeBlock->m_codeBlock->isInterpretedCodeBlock() && byteCodeBlock->m_codeBlock->asInterpretedCodeBlock()->byteCodeBlock() == nullptr) {
+        byteCodeBlock->m_codeBlock->asInterpretedCodeBlock()->m_byteCodeBlock = byteCodeBlock;
+    }
+    state.context()->m_sandBoxStack.back()->m_exception = value;
+    recordStackTraceData(state, ec, programCounter);
+    state.rareData()->m_hasPendingException = true;
+}
+
+NEVER_INLINE void ByteCodeInterpreter::recordStackTraceData(ExecutionState& state, ExecutionContext* ecInput, size_t programCounter)
 {
     ASSERT(state.context()->m_sandBoxStack.size());
     SandBox* sb = state.context()->m_sandBoxStack.back();
@@ -2180,6 +2496,5 @@ NEVER_INLINE void ByteCodeInterpreter::processException(ExecutionState& state, c
             sb->m_stackTraceData.pushBack(std::make_pair(ec, data));
         }
     }
-    sb->throwException(state, value);
 }
 }
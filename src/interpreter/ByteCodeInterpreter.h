@@ -31,7 +31,13 @@ class Context;
 class ByteCodeBlock;
 class LexicalEnvironment;
 struct GetObjectInlineCache;
+struct GetObjectInlineCacheData;
 struct SetObjectInlineCache;
+class GetObjectPreComputedCase;
+class SetObjectPreComputedCase;
+class GetArgumentsLength;
+class GetArgumentsElement;
+class FunctionEnvironmentRecordOnHeap;
 struct EnumerateObjectData;
 class GetGlobalObject;
 class SetGlobalObject;
@@ -44,7 +50,27 @@ class TemplateOperation;
 class DeclareFunctionDeclarations;
 class ObjectDefineGetter;
 class ObjectDefineSetter;
+class ObjectDefineOwnPropertyWithNameOperation;
+class ArrayDefineOwnPropertyOperation;
 class GlobalObject;
+class FunctionObject;
+struct CallFunctionCache;
+
+// frame of an interpreted function called by the interpreter without recursion.
+// it is on the frame stack of VMInstance, followed by the frame made by FunctionObject::initializeInterpretedCallFrame
+struct InterpretedCallFrame {
+    // frame pushed before by the same activation of ByteCodeInterpreter::interpret, or nullptr
+    InterpretedCallFrame* m_previous;
+    ExecutionState* m_state;
+    ByteCodeBlock* m_byteCodeBlock;
+    // where the caller continues
+    ExecutionState* m_callerState;
+    ByteCodeBlock* m_callerByteCodeBlock;
+    Value* m_callerRegisterFile;
+    size_t m_callerProgramCounter;
+    size_t m_returnProgramCounter;
+    ByteCodeRegisterIndex m_resultIndex;
+};
 
 class ByteCodeInterpreter {
 public:
@@ -59,6 +85,25 @@ public:
     static void deleteOperation(ExecutionState& state, LexicalEnvironment* env, UnaryDelete* code, Value* registerFile);
     static void templateOperation(ExecutionState& state, LexicalEnvironment* env, TemplateOperation* code, Value* registerFile);
 
+    // operations shared by the interpreter and helpers of JIT compiled code. inline ones are in ByteCodeInterpreterInlines.h
+    static Value binaryPlusOperation(ExecutionState& state, const Value& left, const Value& right);
+    static Value binaryMinusOperation(ExecutionState& state, const Value& left, const Value& right);
+    static Value binaryMultiplyOperation(ExecutionState& state, const Value& left, const Value& right);
+    static Value binaryLeftShiftOperation(ExecutionState& state, const Value& left, const Value& right);
+    static Value binarySignedRightShiftOperation(ExecutionState& state, const Value& left, const Value& right);
+    static Value binaryUnsignedRightShiftOperation(ExecutionState& state, const Value& left, const Value& right);
+    static Value incrementOperation(ExecutionState& state, const Value& val);
+    static Value decrementOperation(ExecutionState& state, const Value& val);
+    static Value getGlobalObjectOperation(ExecutionState& state, GetGlobalObject* code, ByteCodeBlock* block);
+    static void setGlobalObjectOperation(ExecutionState& state, SetGlobalObject* code, const Value& value, ByteCodeBlock* block);
+    static bool getObjectFromFastModeArray(ExecutionState& state, const Value& willBeObject, const Value& property, Value& result);
+    static bool setObjectToFastModeArray(ExecutionState& state, const Value& willBeObject, const Value& property, const Value& value);
+    static Value getObjectOperationSlowCase(ExecutionState& state, const Value& willBeObject, const Value& property);
+    static void setObjectOperationSlowCase(ExecutionState& state, const Value& willBeObject, const Value& property, const Value& value);
+    static FunctionEnvironmentRecordOnHeap* heapStorageRecord(ExecutionContext* ec, size_t upperIndex);
+    static void objectDefineOwnPropertyWithNameOperation(ExecutionState& state, ObjectDefineOwnPropertyWithNameOperation* code, Value* registerFile);
+    static void arrayDefineOwnPropertyOperation(ExecutionState& state, ArrayDefineOwnPropertyOperation* code, Value* registerFile);
+
     // http://www.ecma-international.org/ecma-262/5.1/#sec-11.8.5
     static bool abstractRelationalComparisonSlowCase(ExecutionState& state, const Value& left, const Value& right, bool leftFirst);
     static bool abstractRelationalComparison(ExecutionState& state, const Value& left, const Value& right, bool leftFirst);
@@ -67,10 +112,24 @@ public:
 
     static Value getObjectPrecomputedCaseOperation(ExecutionState& state, Object* obj, const Value& receiver, const PropertyName& name, GetObjectInlineCache& inlineCache, ByteCodeBlock* block);
     static Value getObjectPrecomputedCaseOperationCacheMiss(ExecutionState& state, Object* obj, const Value& receiver, const PropertyName& name, GetObjectInlineCache& inlineCache, ByteCodeBlock* block);
+    static Value getObjectPrecomputedCaseOperationMegamorphic(ExecutionState& state, Object* obj, const Value& receiver, const PropertyName& name);
+    static bool lookupPropertyForInlineCache(ExecutionState& state, Object* obj, const PropertyName& name, GetObjectInlineCacheData& result);
+    static Value getObjectWithInlineCacheData(ExecutionState& state, Object* obj, const Value& receiver, const GetObjectInlineCacheData& data);
     static void setObjectPreComputedCaseOperation(ExecutionState& state, const Value& willBeObject, const PropertyName& name, const Value& value, SetObjectInlineCache& inlineCache, ByteCodeBlock* block);
     static void setObjectPreComputedCaseOperationCacheMiss(ExecutionState& state, Object* obj, const Value& willBeObject, const PropertyName& name, const Value& value, SetObjectInlineCache& inlineCache, ByteCodeBlock* block);
+#if defined(ESCARGOT_ENABLE_JIT)
+    // inline caches above as called by JIT compiled code
+    static Value getObjectPrecomputedCaseOperationOutOfLine(ExecutionState& state, const Value& willBeObject, GetObjectPreComputedCase* code, ByteCodeBlock* block);
+    static void setObjectPreComputedCaseOperationOutOfLine(ExecutionState& state, const Value& willBeObject, SetObjectPreComputedCase* code, const Value& value, ByteCodeBlock* block);
+#endif
+
+    // arguments.length and arguments[property] of a function which creates its arguments object only when needed
+    static FunctionEnvironmentRecordOnHeap* argumentsRecord(ExecutionContext* ec, size_t catchScopeCount);
+    static bool getArgumentsElementDirectly(FunctionEnvironmentRecordOnHeap* record, ByteCodeBlock* block, const Value& property, Value& result);
+    static Value getArgumentsLengthOperation(ExecutionState& state, GetArgumentsLength* code, ExecutionContext* ec, Value* registerFile, ByteCodeBlock* block);
+    static Value getArgumentsElementOperation(ExecutionState& state, GetArgumentsElement* code, ExecutionContext* ec, Value* registerFile, ByteCodeBlock* block);
 
-    static EnumerateObjectData* executeEnumerateObject(ExecutionState& state, Object* obj);
+    static EnumerateObjectData* executeEnumerateObject(ExecutionState& state, Object* obj, bool useEnumerationCache = true);
     static EnumerateObjectData* updateEnumerateObjectData(ExecutionState& state, EnumerateObjectData* data);
 
     static Object* fastToObject(ExecutionState& state, const Value& obj);
@@ -89,7 +148,12 @@ public:
     static void defineObjectGetter(ExecutionState& state, ObjectDefineGetter* code, Value* registerFile);
     static void defineObjectSetter(ExecutionState& state, ObjectDefineSetter* code, Value* registerFile);
 
+    static InterpretedCallFrame* pushCallFrame(ExecutionState& state, FunctionObject* callee, const Value& receiver, size_t argc, Value* argv, CallFunctionCache& cache, ByteCodeBlock* callerBlock);
+    static InterpretedCallFrame* pushCachedCallFrame(ExecutionState& state, FunctionObject* callee, const Value& receiver, size_t argc, Value* argv, CallFunctionCache& cache);
+
     static void processException(ExecutionState& state, const Value& value, ExecutionContext* ec, size_t programCounter);
+    static void setPendingException(ExecutionState& state, const Value& value, ByteCodeBlock* byteCodeBlock, ExecutionContext* ec, size_t programCounter);
+    static void recordStackTraceData(ExecutionState& state, ExecutionContext* ec, size_t programCounter);
 };
 }
 
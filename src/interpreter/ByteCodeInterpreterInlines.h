@@ -0,0 +1,307 @@
+/*
+ * Copyright (c) 2016-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotByteCodeInterpreterInlines__
+#define __EscargotByteCodeInterpreterInlines__
+
+#include "interpreter/ByteCode.h"
+#include "interpreter/ByteCodeInterpreter.h"
+#include "runtime/Context.h"
+#include "runtime/GlobalObject.h"
+#include "runtime/ArrayObject.h"
+#include "runtime/StringObject.h"
+#include "runtime/NumberObject.h"
+#include "runtime/Environment.h"
+#include "runtime/EnvironmentRecord.h"
+
+namespace Escargot {
+
+// operations of ByteCodes which are done by both of the interpreter and helpers of JIT compiled code
+
+ALWAYS_INLINE Value ByteCodeInterpreter::binaryPlusOperation(ExecutionState& state, const Value& left, const Value& right)
+{
+    if (left.isInt32() && right.isInt32()) {
+        int32_t a = left.asInt32();
+        int32_t b = right.asInt32();
+        int32_t c;
+        bool result = ArithmeticOperations<int32_t, int32_t, int32_t>::add(a, b, c);
+        if (LIKELY(result)) {
+            return Value(c);
+        } else {
+            return Value(Value::EncodeAsDouble, (double)a + (double)b);
+        }
+    } else if (left.isNumber() && right.isNumber()) {
+        return Value(left.asNumber() + right.asNumber());
+    }
+    return plusSlowCase(state, left, right);
+}
+
+ALWAYS_INLINE Value ByteCodeInterpreter::binaryMinusOperation(ExecutionState& state, const Value& left, const Value& right)
+{
+    if (left.isInt32() && right.isInt32()) {
+        int32_t a = left.asInt32();
+        int32_t b = right.asInt32();
+        int32_t c;
+        bool result = ArithmeticOperations<int32_t, int32_t, int32_t>::sub(a, b, c);
+        if (LIKELY(result)) {
+            return Value(c);
+        } else {
+            return Value(Value::EncodeAsDouble, (double)a - (double)b);
+        }
+    }
+    return Value(left.toNumber(state) - right.toNumber(state));
+}
+
+ALWAYS_INLINE Value ByteCodeInterpreter::binaryMultiplyOperation(ExecutionState& state, const Value& left, const Value& right)
+{
+    if (left.isInt32() && right.isInt32()) {
+        int32_t a = left.asInt32();
+        int32_t b = right.asInt32();
+        if (UNLIKELY((!a || !b) && (a >> 31 || b >> 31))) { // -1 * 0 should be treated as -0, not +0
+            return Value(left.asNumber() * right.asNumber());
+        } else {
+            int32_t c = right.asInt32();
+            bool result = ArithmeticOperations<int32_t, int32_t, int32_t>::multiply(a, b, c);
+            if (LIKELY(result)) {
+                return Value(c);
+            } else {
+                return Value(Value::EncodeAsDouble, a * (double)b);
+            }
+        }
+    }
+    auto first = left.toNumber(state);
+    auto second = right.toNumber(state);
+    return Value(Value::EncodeAsDouble, first * second);
+}
+
+ALWAYS_INLINE Value ByteCodeInterpreter::binaryLeftShiftOperation(ExecutionState& state, const Value& left, const Value& right)
+{
+    int32_t lnum = left.toInt32(state);
+    int32_t rnum = right.toInt32(state);
+    lnum <<= ((unsigned int)rnum) & 0x1F;
+    return Value(lnum);
+}
+
+ALWAYS_INLINE Value ByteCodeInterpreter::binarySignedRightShiftOperation(ExecutionState& state, const Value& left, const Value& right)
+{
+    int32_t lnum = left.toInt32(state);
+    int32_t rnum = right.toInt32(state);
+    lnum >>= ((unsigned int)rnum) & 0x1F;
+    return Value(lnum);
+}
+
+ALWAYS_INLINE Value ByteCodeInterpreter::binaryUnsignedRightShiftOperation(ExecutionState& state, const Value& left, const Value& right)
+{
+    uint32_t lnum = left.toUint32(state);
+    uint32_t rnum = right.toUint32(state);
+    lnum = (lnum) >> ((rnum)&0x1F);
+    return Value(lnum);
+}
+
+ALWAYS_INLINE Value ByteCodeInterpreter::incrementOperation(ExecutionState& state, const Value& val)
+{
+    if (LIKELY(val.isInt32())) {
+        int32_t a = val.asInt32();
+        int32_t b = 1;
+        int32_t c;
+        bool result = ArithmeticOperations<int32_t, int32_t, int32_t>::add(a, b, c);
+        if (LIKELY(result)) {
+            return Value(c);
+        } else {
+            return Value(Value::EncodeAsDouble, (double)a + (double)b);
+        }
+    } else {
+        return plusSlowCase(state, Value(val.toNumber(state)), Value(1));
+    }
+}
+
+ALWAYS_INLINE Value ByteCodeInterpreter::decrementOperation(ExecutionState& state, const Value& val)
+{
+    if (LIKELY(val.isInt32())) {
+        int32_t a = val.asInt32();
+        int32_t b = -1;
+        int32_t c;
+        bool result = ArithmeticOperations<int32_t, int32_t, int32_t>::add(a, b, c);
+        if (LIKELY(result)) {
+            return Value(c);
+        } else {
+            return Value(Value::EncodeAsDouble, (double)a + (double)b);
+        }
+    } else {
+        return Value(val.toNumber(state) - 1);
+    }
+}
+
+ALWAYS_INLINE bool ByteCodeInterpreter::abstractRelationalComparison(ExecutionState& state, const Value& left, const Value& right, bool leftFirst)
+{
+    // consume very fast case
+    if (LIKELY(left.isInt32() && right.isInt32())) {
+        return left.asInt32() < right.asInt32();
+    }
+
+    if (LIKELY(left.isNumber() && right.isNumber())) {
+        return left.asNumber() < right.asNumber();
+    }
+
+    return abstractRelationalComparisonSlowCase(state, left, right, leftFirst);
+}
+
+ALWAYS_INLINE bool ByteCodeInterpreter::abstractRelationalComparisonOrEqual(ExecutionState& state, const Value& left, const Value& right, bool leftFirst)
+{
+    // consume very fast case
+    if (LIKELY(left.isInt32() && right.isInt32())) {
+        return left.asInt32() <= right.asInt32();
+    }
+
+    if (LIKELY(left.isNumber() && right.isNumber())) {
+        return left.asNumber() <= right.asNumber();
+    }
+
+    return abstractRelationalComparisonOrEqualSlowCase(state, left, right, leftFirst);
+}
+
+ALWAYS_INLINE Object* ByteCodeInterpreter::fastToObject(ExecutionState& state, const Value& obj)
+{
+    if (LIKELY(obj.isString())) {
+        StringObject* o = state.context()->globalObject()->stringProxyObject();
+        o->setPrimitiveValue(state, obj.asString());
+        return o;
+    } else if (obj.isNumber()) {
+        NumberObject* o = state.context()->globalObject()->numberProxyObject();
+        o->setPrimitiveValue(state, obj.asNumber());
+        return o;
+    }
+    return obj.toObject(state);
+}
+
+ALWAYS_INLINE Value ByteCodeInterpreter::getGlobalObjectOperation(ExecutionState& state, GetGlobalObject* code, ByteCodeBlock* block)
+{
+    GlobalObject* globalObject = state.context()->globalObject();
+    if (LIKELY(globalObject->structure() == code->m_cachedStructure)) {
+        ASSERT(globalObject->m_values.data() <= code->m_cachedAddress);
+        ASSERT(code->m_cachedAddress < (globalObject->m_values.data() + globalObject->structure()->propertyCount()));
+        return *((SmallValue*)code->m_cachedAddress);
+    }
+    return getGlobalObjectSlowCase(state, globalObject, code, block);
+}
+
+ALWAYS_INLINE void ByteCodeInterpreter::setGlobalObjectOperation(ExecutionState& state, SetGlobalObject* code, const Value& value, ByteCodeBlock* block)
+{
+    GlobalObject* globalObject = state.context()->globalObject();
+    if (LIKELY(globalObject->structure() == code->m_cachedStructure)) {
+        ASSERT(globalObject->m_values.data() <= code->m_cachedAddress);
+        ASSERT(code->m_cachedAddress < (globalObject->m_values.data() + globalObject->structure()->propertyCount()));
+        *((SmallValue*)code->m_cachedAddress) = value;
+    } else {
+        setGlobalObjectSlowCase(state, globalObject, code, value, block);
+    }
+}
+
+// returns false if |willBeObject|[|property|] is not an element of a fast mode array
+ALWAYS_INLINE bool ByteCodeInterpreter::getObjectFromFastModeArray(ExecutionState& state, const Value& willBeObject, const Value& property, Value& result)
+{
+    PointerValue* v;
+    if (LIKELY(willBeObject.isObject() && (v = willBeObject.asPointerValue())->hasTag(g_arrayObjectTag))) {
+        ArrayObject* arr = (ArrayObject*)v;
+        if (LIKELY(arr->isFastModeArray())) {
+            uint32_t idx = property.tryToUseAsArrayIndex(state);
+            if (LIKELY(idx != Value::InvalidArrayIndexValue)) {
+                if (LIKELY(idx < arr->getArrayLength(state))) {
+                    const Value& element = arr->m_fastModeData[idx];
+                    if (LIKELY(!element.isEmpty())) {
+                        result = element;
+                        return true;
+                    }
+                }
+            }
+        }
+    }
+    return false;
+}
+
+// returns false if |value| cannot be stored as an element of a fast mode array
+ALWAYS_INLINE bool ByteCodeInterpreter::setObjectToFastModeArray(ExecutionState& state, const Value& willBeObject, const Value& property, const Value& value)
+{
+    if (LIKELY(willBeObject.isObject() && (willBeObject.asPointerValue())->hasTag(g_arrayObjectTag))) {
+        ArrayObject* arr = willBeObject.asObject()->asArrayObject();
+        if (LIKELY(arr->isFastModeArray())) {
+            uint32_t idx = property.tryToUseAsArrayIndex(state);
+            if (LIKELY(idx != Value::InvalidArrayIndexValue)) {
+                uint32_t len = arr->getArrayLength(state);
+                if (UNLIKELY(len <= idx)) {
+                    if (UNLIKELY(!arr->isExtensible())) {
+                        return false;
+                    }
+                    if (UNLIKELY(!arr->setArrayLength(state, idx + 1, idx == len)) || UNLIKELY(!arr->isFastModeArray())) {
+                        return false;
+                    }
+                }
+                arr->setFastModeElement(idx, value);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// record of a function |upperIndex| levels above, which keeps its variables on the heap
+ALWAYS_INLINE FunctionEnvironmentRecordOnHeap* ByteCodeInterpreter::heapStorageRecord(ExecutionContext* ec, size_t upperIndex)
+{
+    LexicalEnvironment* upperEnv = ec->lexicalEnvironment();
+    for (size_t i = 0; i < upperIndex; i++) {
+        upperEnv = upperEnv->outerEnvironment();
+    }
+    FunctionEnvironmentRecord* record = upperEnv->record()->asDeclarativeEnvironmentRecord()->asFunctionEnvironmentRecord();
+    ASSERT(record->isFunctionEnvironmentRecordOnHeap() || record->isFunctionEnvironmentRecordNotIndexed());
+    return (FunctionEnvironmentRecordOnHeap*)record;
+}
+
+ALWAYS_INLINE void ByteCodeInterpreter::objectDefineOwnPropertyWithNameOperation(ExecutionState& state, ObjectDefineOwnPropertyWithNameOperation* code, Value* registerFile)
+{
+    const Value& willBeObject = registerFile[code->m_objectRegisterIndex];
+    // http://www.ecma-international.org/ecma-262/6.0/#sec-__proto__-property-names-in-object-initializers
+    if (code->m_propertyName == state.context()->staticStrings().__proto__) {
+        willBeObject.asObject()->setPrototype(state, registerFile[code->m_loadRegisterIndex]);
+    } else {
+        willBeObject.asObject()->defineOwnProperty(state, ObjectPropertyName(code->m_propertyName), ObjectPropertyDescriptor(registerFile[code->m_loadRegisterIndex], ObjectPropertyDescriptor::AllPresent));
+    }
+}
+
+ALWAYS_INLINE void ByteCodeInterpreter::arrayDefineOwnPropertyOperation(ExecutionState& state, ArrayDefineOwnPropertyOperation* code, Value* registerFile)
+{
+    ArrayObject* arr = registerFile[code->m_objectRegisterIndex].asObject()->asArrayObject();
+    if (LIKELY(arr->isFastModeArray())) {
+        for (size_t i = 0; i < code->m_count; i++) {
+            if (LIKELY(code->m_loadRegisterIndexs[i] != std::numeric_limits<ByteCodeRegisterIndex>::max())) {
+                arr->setFastModeElement(i + code->m_baseIndex, registerFile[code->m_loadRegisterIndexs[i]]);
+            } else {
+                arr->markElementKindHoley();
+            }
+        }
+    } else {
+        for (size_t i = 0; i < code->m_count; i++) {
+            if (LIKELY(code->m_loadRegisterIndexs[i] != std::numeric_limits<ByteCodeRegisterIndex>::max())) {
+                arr->defineOwnProperty(state, ObjectPropertyName(state, Value(i + code->m_baseIndex)), ObjectPropertyDescriptor(registerFile[code->m_loadRegisterIndexs[i]], ObjectPropertyDescriptor::AllPresent));
+            }
+        }
+    }
+}
+}
+
+#endif
@@ -0,0 +1,1060 @@
+/*
+ * Copyright (c) 2018-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#include "Escargot.h"
+
+#if defined(ESCARGOT_ENABLE_JIT)
+
+#include "JIT.h"
+#include "X64Assembler.h"
+#include "interpreter/ByteCode.h"
+#include "interpreter/ByteCodeInterpreter.h"
+#include "interpreter/ByteCodeInterpreterInlines.h"
+#include "runtime/Context.h"
+#include "runtime/GlobalObject.h"
+#include "runtime/FunctionObject.h"
+#include "runtime/ArrayObject.h"
+#include "runtime/Environment.h"
+#include "runtime/EnvironmentRecord.h"
+#include "runtime/ErrorObject.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace Escargot {
+
+static Opcode relocatedOpcode(ByteCode* code)
+{
+#if defined(COMPILER_GCC)
+    // relocated ByteCode holds the label address of the interpreter
+    return g_opcodeTable.opcodeOf(code->m_opcodeInAddress);
+#else
+    return code->m_opcode;
+#endif
+}
+
+// Register usage of compiled code
+// rbx: JITFrame*, r12: register file, r13: TagTypeNumber
+// rax, rcx, rdx, rsi, rdi: scratch
+class JITCompiler {
+public:
+    explicit JITCompiler(ByteCodeBlock* block)
+        : m_block(block)
+        , m_codeBuffer(block->m_code.data())
+        , m_epilogue(0)
+    {
+    }
+
+    JITCode* compile();
+
+private:
+    // helpers called from compiled code. they return false when an exception is raised
+    template <typename CodeType>
+    static bool executeHelper(JITFrame* frame, CodeType* code)
+    {
+        try {
+            execute(*frame->m_state, code, frame->m_registerFile, frame->m_byteCodeBlock);
+            return true;
+        } catch (const Value& v) {
+            frame->m_exception = v;
+            frame->m_hasException = true;
+            return false;
+        }
+    }
+
+    static bool getObjectPreComputedCaseHelper(JITFrame* frame, GetObjectPreComputedCase* code, JITGetObjectCache* cache);
+    static bool toBooleanHelper(JITFrame* frame, size_t registerIndex);
+
+    static void execute(ExecutionState& state, BinaryPlus* code, Value* registerFile, ByteCodeBlock* block);
+    static void execute(ExecutionState& state, BinaryMinus* code, Value* registerFile, ByteCodeBlock* block);
+    static void execute(ExecutionState& state, BinaryMultiply* code, Value* registerFile, ByteCodeBlock* block);
+    static void execute(ExecutionState& state, BinaryDivision* code, Value* registerFile, ByteCodeBlock* block);
+    static void execute(ExecutionState& state, BinaryMod* code, Value* registerFile, ByteCodeBlock* block);
+    static void execute(ExecutionState& state, BinaryEqual* code, Value* registerFile, ByteCodeBlock* block);
+    static void execute(ExecutionState& state, BinaryNotEqual* code, Value* registerFile, ByteCodeBlock* block);
+    static void execute(ExecutionState& state, BinaryStrictEqual* code, Value* registerFile, ByteCodeBlock* block);
+    static void execute(ExecutionState& state, BinaryNotStrictEqual* code, Value* registerFile, ByteCodeBlock* block);
+    static void execute(ExecutionState& state, BinaryLessThan* code, Value* registerFile, ByteCodeBlock* block);
+    static void execute(ExecutionState& state, BinaryLessThanOrEqual* code, Value* registerFile, ByteCodeBlock* block);
+    static void execute(ExecutionState& state, BinaryGreaterThan* code, Value* registerFile, ByteCodeBlock* block);
+    static void execute(ExecutionState& state, BinaryGreaterThanOrEqual* code, Value* registerFile, ByteCodeBlock* block);
+    static void execute(ExecutionState& state, BinaryBitwiseAnd* code, Value* registerFile, ByteCodeBlock* block);
+    static void execute(ExecutionState& state, BinaryBitwiseOr* code, Value* registerFile, ByteCodeBlock* block);
+    static void execute(ExecutionState& state, BinaryBitwiseXor* code, Value* registerFile, ByteCodeBlock* block);
+    static void execute(ExecutionState& state, BinaryLeftShift* code, Value* registerFile, ByteCodeBlock* block);
+    static void execute(ExecutionState& state, BinarySignedRightShift* code, Value* registerFile, ByteCodeBlock* block);
+    static void execute(ExecutionState& state, BinaryUnsignedRightShift* code, Value* registerFile, ByteCodeBlock* block);
+    static void execute(ExecutionState& state, Increment* code, Value* registerFile, ByteCodeBlock* block);
+    static void execute(ExecutionState& state, Decrement* code, Value* registerFile, ByteCodeBlock* block);
+    static void execute(ExecutionState& state, ToNumber* code, Value* registerFile, ByteCodeBlock* block);
+    static void execute(ExecutionState& state, UnaryMinus* code, Value* registerFile, ByteCodeBlock* block);
+    static void execute(ExecutionState& state, UnaryNot* code, Value* registerFile, ByteCodeBlock* block);
+    static void execute(ExecutionState& state, UnaryBitwiseNot* code, Value* registerFile, ByteCodeBlock* block);
+    static void execute(ExecutionState& state, GetGlobalObject* code, Value* registerFile, ByteCodeBlock* block);
+    static void execute(ExecutionState& state, SetGlobalObject* code, Value* registerFile, ByteCodeBlock* block);
+    static void execute(ExecutionState& state, SetObjectPreComputedCase* code, Value* registerFile, ByteCodeBlock* block);
+    static void execute(ExecutionState& state, GetObject* code, Value* registerFile, ByteCodeBlock* block);
+    static void execute(ExecutionState& state, GetArgumentsLength* code, Value* registerFile, ByteCodeBlock* block);
+    static void execute(ExecutionState& state, GetArgumentsElement* code, Value* registerFile, ByteCodeBlock* block);
+    static void execute(ExecutionState& state, SetObjectOperation* code, Value* registerFile, ByteCodeBlock* block);
+    static void execute(ExecutionState& state, LoadByName* code, Value* registerFile, ByteCodeBlock* block);
+    static void execute(ExecutionState& state, StoreByName* code, Value* registerFile, ByteCodeBlock* block);
+    static void execute(ExecutionState& state, LoadByHeapIndex* code, Value* registerFile, ByteCodeBlock* block);
+    static void execute(ExecutionState& state, StoreByHeapIndex* code, Value* registerFile, ByteCodeBlock* block);
+    static void execute(ExecutionState& state, LoadByClosureIndex* code, Value* registerFile, ByteCodeBlock* block);
+    static void execute(ExecutionState& state, StoreByClosureIndex* code, Value* registerFile, ByteCodeBlock* block);
+    static void execute(ExecutionState& state, CreateObject* code, Value* registerFile, ByteCodeBlock* block);
+    static void execute(ExecutionState& state, CreateArray* code, Value* registerFile, ByteCodeBlock* block);
+    static void execute(ExecutionState& state, CreateFunction* code, Value* registerFile, ByteCodeBlock* block);
+    static void execute(ExecutionState& state, ObjectDefineOwnPropertyWithNameOperation* code, Value* registerFile, ByteCodeBlock* block);
+    static void execute(ExecutionState& state, ArrayDefineOwnPropertyOperation* code, Value* registerFile, ByteCodeBlock* block);
+    static void execute(ExecutionState& state, CallFunction* code, Value* registerFile, ByteCodeBlock* block);
+    static void execute(ExecutionState& state, CallFunctionWithReceiver* code, Value* registerFile, ByteCodeBlock* block);
+    static void execute(ExecutionState& state, NewOperation* code, Value* registerFile, ByteCodeBlock* block);
+
+    static int32_t registerOffset(size_t index)
+    {
+        return (int32_t)(index * sizeof(Value));
+    }
+
+    size_t positionOf(ByteCode* code)
+    {
+        return (size_t)code - (size_t)m_codeBuffer;
+    }
+
+    void loadRegister(X64Register dst, size_t index)
+    {
+        m_asm.load(dst, R12, registerOffset(index));
+    }
+
+    void storeRegister(size_t index, X64Register src)
+    {
+        m_asm.store(R12, registerOffset(index), src);
+    }
+
+    void exitTo(size_t position);
+    void exitIfHelperFailed(size_t position);
+    void jumpToByteCode(size_t jumpPosition);
+    void jumpToByteCodeIf(X64Condition cond, size_t jumpPosition);
+
+    template <typename CodeType>
+    void callHelper(CodeType* code, size_t position)
+    {
+        bool (*helper)(JITFrame*, CodeType*) = executeHelper<CodeType>;
+        m_asm.mov(RDI, RBX);
+        m_asm.movImm(RSI, (size_t)code);
+        m_asm.movImm(RAX, (size_t)helper);
+        m_asm.call(RAX);
+        exitIfHelperFailed(position);
+    }
+
+    // jumps to |slowCases| unless both of rax and rcx are int32
+    void checkBothInt32(std::vector<size_t>& slowCases);
+    // jumps to |slowCases| unless |r| is a PointerValue
+    void checkPointerValue(X64Register r, std::vector<size_t>& slowCases);
+    // SmallValue in rax -> Value in rax. uses rcx
+    void decodeSmallValue(std::vector<size_t>& slowCases);
+    // Value in rax -> SmallValue in rax. uses rcx
+    void encodeSmallValue(std::vector<size_t>& slowCases);
+
+    enum Int32Operation {
+        Int32Add,
+        Int32Sub,
+        Int32Multiply,
+        Int32And,
+        Int32Or,
+        Int32Xor
+    };
+
+    template <typename CodeType>
+    void compileBinaryArithmetic(CodeType* code, Int32Operation operation);
+    // |code| is the comparison a fused ByteCode starts with
+    template <typename CodeType>
+    void compileCompare(CodeType* code, X64Condition cond, size_t jumpIfFalsePosition);
+    void compileIncrementOrDecrement(ByteCode* code, bool isIncrement, size_t src, size_t dst, size_t jumpPosition);
+    void compileGetObjectPreComputedCase(GetObjectPreComputedCase* code);
+    void compileSetObjectPreComputedCase(SetObjectPreComputedCase* code);
+    void compileGetGlobalObject(GetGlobalObject* code);
+    void compileSetGlobalObject(SetGlobalObject* code);
+    void compileJumpIfBoolean(ByteCode* code, bool jumpIfTrue, size_t registerIndex, size_t jumpPosition);
+
+    // returns false if |code| is not compiled, and compiled code returns to the interpreter at it
+    bool compileByteCode(ByteCode* code, Opcode opcode);
+
+    ByteCodeBlock* m_block;
+    char* m_codeBuffer;
+    JITCode* m_jitCode;
+    X64Assembler m_asm;
+    size_t m_epilogue;
+    // (ByteCode position, native offset) of every ByteCode
+    std::vector<std::pair<uint32_t, uint32_t>> m_labels;
+    // (offset of rel32, ByteCode position of jump target)
+    std::vector<std::pair<size_t, size_t>> m_pendingJumps;
+    size_t m_nextGetObjectCache;
+};
+
+void JITCompiler::exitTo(size_t position)
+{
+    m_asm.movImm(RAX, position);
+    m_asm.link(m_asm.jump(), m_epilogue);
+}
+
+void JITCompiler::exitIfHelperFailed(size_t position)
+{
+    // helpers return bool in al
+    m_asm.movzx8(RAX, RAX);
+    m_asm.arith32(ArithmeticTest, RAX, RAX);
+    size_t succeeded = m_asm.jumpIf(ConditionNotEqual);
+    exitTo(position);
+    m_asm.linkToHere(succeeded);
+}
+
+void JITCompiler::jumpToByteCode(size_t jumpPosition)
+{
+    m_pendingJumps.push_back(std::make_pair(m_asm.jump(), jumpPosition - (size_t)m_codeBuffer));
+}
+
+void JITCompiler::jumpToByteCodeIf(X64Condition cond, size_t jumpPosition)
+{
+    m_pendingJumps.push_back(std::make_pair(m_asm.jumpIf(cond), jumpPosition - (size_t)m_codeBuffer));
+}
+
+void JITCompiler::checkBothInt32(std::vector<size_t>& slowCases)
+{
+    // int32 values have all bits of TagTypeNumber
+    m_asm.mov(RDX, RAX);
+    m_asm.arith(ArithmeticAnd, RDX, RCX);
+    m_asm.arith(ArithmeticCmp, RDX, R13);
+    slowCases.push_back(m_asm.jumpIf(ConditionBelow));
+}
+
+void JITCompiler::checkPointerValue(X64Register r, std::vector<size_t>& slowCases)
+{
+    m_asm.arith(ArithmeticTest, r, R13);
+    slowCases.push_back(m_asm.jumpIf(ConditionNotEqual));
+    m_asm.testImm(r, TagBitTypeOther);
+    slowCases.push_back(m_asm.jumpIf(ConditionNotEqual));
+    m_asm.arith(ArithmeticTest, r, r);
+    slowCases.push_back(m_asm.jumpIf(ConditionEqual));
+}
+
+void JITCompiler::decodeSmallValue(std::vector<size_t>& slowCases)
+{
+    // unboxed double (HAS_DOUBLE_TAG): bits 63..47 are neither all zero nor all one.
+    // the helper turns integral ones into int32 like SmallValue does
+    m_asm.mov(RCX, RAX);
+    m_asm.sarImm(RCX, 47);
+    m_asm.arithImm(ArithmeticAdd, RCX, 1);
+    m_asm.arithImm(ArithmeticCmp, RCX, 1);
+    slowCases.push_back(m_asm.jumpIf(ConditionAbove));
+
+    // small integer: sign extended (value << 1) | 1
+    m_asm.testImm(RAX, SmallValueImpl::kSmiTagMask);
+    size_t notSmi = m_asm.jumpIf(ConditionEqual);
+    m_asm.sar1(RAX);
+    m_asm.mov32(RAX, RAX);
+    m_asm.arith(ArithmeticOr, RAX, R13);
+    size_t done = m_asm.jump();
+
+    // undefined, null, true, false and empty are left to the helper
+    m_asm.linkToHere(notSmi);
+    m_asm.arithImm(ArithmeticCmp, RAX, smallValueEmpty);
+    slowCases.push_back(m_asm.jumpIf(ConditionBelowOrEqual));
+    m_asm.linkToHere(done);
+}
+
+void JITCompiler::encodeSmallValue(std::vector<size_t>& slowCases)
+{
+    m_asm.arith(ArithmeticCmp, RAX, R13);
+    size_t notInt32 = m_asm.jumpIf(ConditionBelow);
+    // SmallValueImpl::PlatformSmiTagging::IsValidSmi
+    m_asm.mov32(RCX, RAX);
+    m_asm.arithImm32(ArithmeticAdd, RCX, 0x40000000);
+    slowCases.push_back(m_asm.jumpIf(ConditionSign));
+    m_asm.movsxd(RAX, RAX);
+    m_asm.arith(ArithmeticAdd, RAX, RAX);
+    m_asm.arithImm(ArithmeticOr, RAX, SmallValueImpl::kSmiTag);
+    size_t done = m_asm.jump();
+
+    // doubles have the same encoding in Value and SmallValue, and PointerValue is stored as is.
+    // other values are left to the helper
+    m_asm.linkToHere(notInt32);
+    m_asm.arith(ArithmeticTest, RAX, R13);
+    size_t isDouble = m_asm.jumpIf(ConditionNotEqual);
+    checkPointerValue(RAX, slowCases);
+    m_asm.linkToHere(done);
+    m_asm.linkToHere(isDouble);
+}
+
+template <typename CodeType>
+void JITCompiler::compileBinaryArithmetic(CodeType* code, Int32Operation operation)
+{
+    std::vector<size_t> slowCases;
+    loadRegister(RAX, code->m_srcIndex0);
+    loadRegister(RCX, code->m_srcIndex1);
+    checkBothInt32(slowCases);
+    switch (operation) {
+    case Int32Add:
+        m_asm.arith32(ArithmeticAdd, RAX, RCX);
+        slowCases.push_back(m_asm.jumpIf(ConditionOverflow));
+        break;
+    case Int32Sub:
+        m_asm.arith32(ArithmeticSub, RAX, RCX);
+        slowCases.push_back(m_asm.jumpIf(ConditionOverflow));
+        break;
+    case Int32Multiply: {
+        // -1 * 0 should be treated as -0, not +0
+        m_asm.mov32(RDX, RAX);
+        m_asm.arith32(ArithmeticOr, RDX, RCX);
+        m_asm.imul32(RAX, RCX);
+        slowCases.push_back(m_asm.jumpIf(ConditionOverflow));
+        m_asm.arith32(ArithmeticTest, RAX, RAX);
+        size_t nonZero = m_asm.jumpIf(ConditionNotEqual);
+        m_asm.arith32(ArithmeticTest, RDX, RDX);
+        slowCases.push_back(m_asm.jumpIf(ConditionSign));
+        m_asm.linkToHere(nonZero);
+        break;
+    }
+    case Int32And:
+        m_asm.arith32(ArithmeticAnd, RAX, RCX);
+        break;
+    case Int32Or:
+        m_asm.arith32(ArithmeticOr, RAX, RCX);
+        break;
+    default:
+        ASSERT(operation == Int32Xor);
+        m_asm.arith32(ArithmeticXor, RAX, RCX);
+        break;
+    }
+    m_asm.arith(ArithmeticOr, RAX, R13);
+    storeRegister(code->m_dstIndex, RAX);
+    size_t done = m_asm.jump();
+
+    for (size_t i = 0; i < slowCases.size(); i++) {
+        m_asm.linkToHere(slowCases[i]);
+    }
+    callHelper(code, positionOf(code));
+    m_asm.linkToHere(done);
+}
+
+template <typename CodeType>
+void JITCompiler::compileCompare(CodeType* code, X64Condition cond, size_t jumpIfFalsePosition)
+{
+    std::vector<size_t> slowCases;
+    loadRegister(RAX, code->m_srcIndex0);
+    loadRegister(RCX, code->m_srcIndex1);
+    checkBothInt32(slowCases);
+    m_asm.arith32(ArithmeticCmp, RAX, RCX);
+    m_asm.setcc(cond, RAX);
+    m_asm.movzx8(RAX, RAX);
+    m_asm.arithImm32(ArithmeticOr, RAX, ValueFalse);
+    storeRegister(code->m_dstIndex, RAX);
+    size_t done = m_asm.jump();
+
+    for (size_t i = 0; i < slowCases.size(); i++) {
+        m_asm.linkToHere(slowCases[i]);
+    }
+    callHelper(code, positionOf(code));
+    if (jumpIfFalsePosition != SIZE_MAX) {
+        loadRegister(RAX, code->m_dstIndex);
+    }
+    m_asm.linkToHere(done);
+
+    if (jumpIfFalsePosition != SIZE_MAX) {
+        m_asm.arithImm(ArithmeticCmp, RAX, ValueFalse);
+        jumpToByteCodeIf(ConditionEqual, jumpIfFalsePosition);
+    }
+}
+
+void JITCompiler::compileIncrementOrDecrement(ByteCode* code, bool isIncrement, size_t src, size_t dst, size_t jumpPosition)
+{
+    std::vector<size_t> slowCases;
+    loadRegister(RAX, src);
+    m_asm.arith(ArithmeticCmp, RAX, R13);
+    slowCases.push_back(m_asm.jumpIf(ConditionBelow));
+    m_asm.arithImm32(isIncrement ? ArithmeticAdd : ArithmeticSub, RAX, 1);
+    slowCases.push_back(m_asm.jumpIf(ConditionOverflow));
+    m_asm.arith(ArithmeticOr, RAX, R13);
+    storeRegister(dst, RAX);
+    size_t done = m_asm.jump();
+
+    for (size_t i = 0; i < slowCases.size(); i++) {
+        m_asm.linkToHere(slowCases[i]);
+    }
+    if (isIncrement) {
+        callHelper((Increment*)code, positionOf(code));
+    } else {
+        callHelper((Decrement*)code, positionOf(code));
+    }
+    m_asm.linkToHere(done);
+
+    if (jumpPosition != SIZE_MAX) {
+        jumpToByteCode(jumpPosition);
+    }
+}
+
+void JITCompiler::compileGetObjectPreComputedCase(GetObjectPreComputedCase* code)
+{
+    ASSERT(m_nextGetObjectCache < m_jitCode->m_getObjectCaches.size());
+    JITGetObjectCache* cache = &m_jitCode->m_getObjectCaches[m_nextGetObjectCache++];
+
+    std::vector<size_t> slowCases;
+    loadRegister(RAX, code->m_objectRegisterIndex);
+    checkPointerValue(RAX, slowCases);
+    // the cache only holds structures of Objects, and other PointerValues never have one there
+    m_asm.load(RCX, RAX, offsetof(Object, m_structure));
+    m_asm.arith(ArithmeticTest, RCX, RCX);
+    slowCases.push_back(m_asm.jumpIf(ConditionEqual));
+    m_asm.movImm(RDX, (size_t)cache);
+    m_asm.compareMemory(RCX, RDX, offsetof(JITGetObjectCache, m_cachedStructure));
+    slowCases.push_back(m_asm.jumpIf(ConditionNotEqual));
+    m_asm.load(RCX, RDX, offsetof(JITGetObjectCache, m_cachedIndex));
+    m_asm.load(RAX, RAX, offsetof(Object, m_values));
+    m_asm.loadIndexed(RAX, RAX, RCX);
+    decodeSmallValue(slowCases);
+    storeRegister(code->m_storeRegisterIndex, RAX);
+    size_t done = m_asm.jump();
+
+    for (size_t i = 0; i < slowCases.size(); i++) {
+        m_asm.linkToHere(slowCases[i]);
+    }
+    m_asm.mov(RDI, RBX);
+    m_asm.movImm(RSI, (size_t)code);
+    m_asm.movImm(RDX, (size_t)cache);
+    m_asm.movImm(RAX, (size_t)getObjectPreComputedCaseHelper);
+    m_asm.call(RAX);
+    exitIfHelperFailed(positionOf(code));
+    m_asm.linkToHere(done);
+}
+
+void JITCompiler::compileSetObjectPreComputedCase(SetObjectPreComputedCase* code)
+{
+    std::vector<size_t> slowCases;
+    loadRegister(RDX, code->m_objectRegisterIndex);
+    checkPointerValue(RDX, slowCases);
+    m_asm.load(RCX, RDX, offsetof(Object, m_structure));
+    m_asm.arith(ArithmeticTest, RCX, RCX);
+    slowCases.push_back(m_asm.jumpIf(ConditionEqual));
+    // own property case of the inline cache of the interpreter
+    m_asm.movImm(RSI, (size_t)code->m_inlineCache);
+    m_asm.compareMemory(RCX, RSI, offsetof(SetObjectInlineCache, m_cachedStructure));
+    slowCases.push_back(m_asm.jumpIf(ConditionNotEqual));
+    m_asm.load(RSI, RSI, offsetof(SetObjectInlineCache, m_cachedIndex));
+    m_asm.arithImm(ArithmeticCmp, RSI, -1);
+    slowCases.push_back(m_asm.jumpIf(ConditionEqual));
+    m_asm.load(RDI, RDX, offsetof(Object, m_values));
+    loadRegister(RAX, code->m_loadRegisterIndex);
+    encodeSmallValue(slowCases);
+    m_asm.storeIndexed(RDI, RSI, RAX);
+    size_t done = m_asm.jump();
+
+    for (size_t i = 0; i < slowCases.size(); i++) {
+        m_asm.linkToHere(slowCases[i]);
+    }
+    callHelper(code, positionOf(code));
+    m_asm.linkToHere(done);
+}
+
+void JITCompiler::compileGetGlobalObject(GetGlobalObject* code)
+{
+    std::vector<size_t> slowCases;
+    m_asm.movImm(RCX, (size_t)m_block->m_codeBlock->context()->globalObject());
+    m_asm.movImm(RDX, (size_t)code);
+    m_asm.load(RAX, RCX, offsetof(Object, m_structure));
+    m_asm.compareMemory(RAX, RDX, offsetof(GetGlobalObject, m_cachedStructure));
+    slowCases.push_back(m_asm.jumpIf(ConditionNotEqual));
+    m_asm.load(RDX, RDX, offsetof(GetGlobalObject, m_cachedAddress));
+    m_asm.load(RAX, RDX, 0);
+    decodeSmallValue(slowCases);
+    storeRegister(code->m_registerIndex, RAX);
+    size_t done = m_asm.jump();
+
+    for (size_t i = 0; i < slowCases.size(); i++) {
+        m_asm.linkToHere(slowCases[i]);
+    }
+    callHelper(code, positionOf(code));
+    m_asm.linkToHere(done);
+}
+
+void JITCompiler::compileSetGlobalObject(SetGlobalObject* code)
+{
+    std::vector<size_t> slowCases;
+    m_asm.movImm(RCX, (size_t)m_block->m_codeBlock->context()->globalObject());
+    m_asm.movImm(RDX, (size_t)code);
+    m_asm.load(RAX, RCX, offsetof(Object, m_structure));
+    m_asm.compareMemory(RAX, RDX, offsetof(SetGlobalObject, m_cachedStructure));
+    slowCases.push_back(m_asm.jumpIf(ConditionNotEqual));
+    loadRegister(RAX, code->m_registerIndex);
+    encodeSmallValue(slowCases);
+    m_asm.load(RDX, RDX, offsetof(SetGlobalObject, m_cachedAddress));
+    m_asm.store(RDX, 0, RAX);
+    size_t done = m_asm.jump();
+
+    for (size_t i = 0; i < slowCases.size(); i++) {
+        m_asm.linkToHere(slowCases[i]);
+    }
+    callHelper(code, positionOf(code));
+    m_asm.linkToHere(done);
+}
+
+void JITCompiler::compileJumpIfBoolean(ByteCode* code, bool jumpIfTrue, size_t registerIndex, size_t jumpPosition)
+{
+    loadRegister(RAX, registerIndex);
+    m_asm.arithImm(ArithmeticCmp, RAX, jumpIfTrue ? ValueTrue : ValueFalse);
+    jumpToByteCodeIf(ConditionEqual, jumpPosition);
+    m_asm.arithImm(ArithmeticCmp, RAX, jumpIfTrue ? ValueFalse : ValueTrue);
+    size_t done = m_asm.jumpIf(ConditionEqual);
+
+    // toBoolean never throws
+    m_asm.mov(RDI, RBX);
+    m_asm.movImm(RSI, registerIndex);
+    m_asm.movImm(RAX, (size_t)toBooleanHelper);
+    m_asm.call(RAX);
+    m_asm.movzx8(RAX, RAX);
+    m_asm.arith32(ArithmeticTest, RAX, RAX);
+    jumpToByteCodeIf(jumpIfTrue ? ConditionNotEqual : ConditionEqual, jumpPosition);
+    m_asm.linkToHere(done);
+}
+
+bool JITCompiler::compileByteCode(ByteCode* byteCode, Opcode opcode)
+{
+    size_t position = positionOf(byteCode);
+    switch (opcode) {
+    case LoadLiteralOpcode: {
+        LoadLiteral* code = (LoadLiteral*)byteCode;
+        uint64_t bits;
+        memcpy(&bits, &code->m_value, sizeof(bits));
+        m_asm.movImm(RAX, bits);
+        storeRegister(code->m_registerIndex, RAX);
+        return true;
+    }
+    case MoveOpcode: {
+        Move* code = (Move*)byteCode;
+        loadRegister(RAX, code->m_registerIndex0);
+        storeRegister(code->m_registerIndex1, RAX);
+        return true;
+    }
+    case JumpOpcode:
+        jumpToByteCode(((Jump*)byteCode)->m_jumpPosition);
+        return true;
+    case JumpIfTrueOpcode: {
+        JumpIfTrue* code = (JumpIfTrue*)byteCode;
+        compileJumpIfBoolean(code, true, code->m_registerIndex, code->m_jumpPosition);
+        return true;
+    }
+    case JumpIfFalseOpcode: {
+        JumpIfFalse* code = (JumpIfFalse*)byteCode;
+        compileJumpIfBoolean(code, false, code->m_registerIndex, code->m_jumpPosition);
+        return true;
+    }
+
+#define COMPILE_BINARY_ARITHMETIC(CodeName, operation)           \
+    case CodeName##Opcode:                                       \
+        compileBinaryArithmetic((CodeName*)byteCode, operation); \
+        return true;
+        COMPILE_BINARY_ARITHMETIC(BinaryPlus, Int32Add)
+        COMPILE_BINARY_ARITHMETIC(BinaryMinus, Int32Sub)
+        COMPILE_BINARY_ARITHMETIC(BinaryMultiply, Int32Multiply)
+        COMPILE_BINARY_ARITHMETIC(BinaryBitwiseAnd, Int32And)
+        COMPILE_BINARY_ARITHMETIC(BinaryBitwiseOr, Int32Or)
+        COMPILE_BINARY_ARITHMETIC(BinaryBitwiseXor, Int32Xor)
+#undef COMPILE_BINARY_ARITHMETIC
+
+#define COMPILE_COMPARE(CodeName, cond)                                                                                                 \
+    case Binary##CodeName##Opcode:                                                                                                      \
+        compileCompare((Binary##CodeName*)byteCode, cond, SIZE_MAX);                                                                    \
+        return true;                                                                                                                    \
+    case Binary##CodeName##AndJumpIfFalseOpcode:                                                                                        \
+        compileCompare((Binary##CodeName*)byteCode, cond, ((Binary##CodeName##AndJumpIfFalse*)byteCode)->m_jumpIfFalse.m_jumpPosition); \
+        return true;
+        COMPILE_COMPARE(Equal, ConditionEqual)
+        COMPILE_COMPARE(NotEqual, ConditionNotEqual)
+        COMPILE_COMPARE(StrictEqual, ConditionEqual)
+        COMPILE_COMPARE(NotStrictEqual, ConditionNotEqual)
+        COMPILE_COMPARE(LessThan, ConditionLess)
+        COMPILE_COMPARE(LessThanOrEqual, ConditionLessOrEqual)
+        COMPILE_COMPARE(GreaterThan, ConditionGreater)
+        COMPILE_COMPARE(GreaterThanOrEqual, ConditionGreaterOrEqual)
+#undef COMPILE_COMPARE
+
+    case IncrementOpcode: {
+        Increment* code = (Increment*)byteCode;
+        compileIncrementOrDecrement(code, true, code->m_srcIndex, code->m_dstIndex, SIZE_MAX);
+        return true;
+    }
+    case DecrementOpcode: {
+        Decrement* code = (Decrement*)byteCode;
+        compileIncrementOrDecrement(code, false, code->m_srcIndex, code->m_dstIndex, SIZE_MAX);
+        return true;
+    }
+    case IncrementAndJumpOpcode: {
+        IncrementAndJump* code = (IncrementAndJump*)byteCode;
+        compileIncrementOrDecrement(code, true, code->m_srcIndex, code->m_dstIndex, code->m_jump.m_jumpPosition);
+        return true;
+    }
+    case DecrementAndJumpOpcode: {
+        DecrementAndJump* code = (DecrementAndJump*)byteCode;
+        compileIncrementOrDecrement(code, false, code->m_srcIndex, code->m_dstIndex, code->m_jump.m_jumpPosition);
+        return true;
+    }
+    case GetGlobalObjectOpcode:
+        compileGetGlobalObject((GetGlobalObject*)byteCode);
+        return true;
+    case SetGlobalObjectOpcode:
+        compileSetGlobalObject((SetGlobalObject*)byteCode);
+        return true;
+    case GetObjectPreComputedCaseOpcode:
+        compileGetObjectPreComputedCase((GetObjectPreComputedCase*)byteCode);
+        return true;
+    case SetObjectPreComputedCaseOpcode:
+        compileSetObjectPreComputedCase((SetObjectPreComputedCase*)byteCode);
+        return true;
+    case GetObjectPreComputedCaseAndCallOpcode: {
+        GetObjectPreComputedCaseAndCall* code = (GetObjectPreComputedCaseAndCall*)byteCode;
+        compileGetObjectPreComputedCase(code);
+        // an exception from the callee is reported at the call part, like the interpreter does
+        callHelper(&code->m_call, position + sizeof(GetObjectPreComputedCase));
+        return true;
+    }
+
+#define COMPILE_WITH_HELPER(CodeName)              \
+    case CodeName##Opcode:                         \
+        callHelper((CodeName*)byteCode, position); \
+        return true;
+        COMPILE_WITH_HELPER(BinaryDivision)
+        COMPILE_WITH_HELPER(BinaryMod)
+        COMPILE_WITH_HELPER(BinaryLeftShift)
+        COMPILE_WITH_HELPER(BinarySignedRightShift)
+        COMPILE_WITH_HELPER(BinaryUnsignedRightShift)
+        COMPILE_WITH_HELPER(ToNumber)
+        COMPILE_WITH_HELPER(UnaryMinus)
+        COMPILE_WITH_HELPER(UnaryNot)
+        COMPILE_WITH_HELPER(UnaryBitwiseNot)
+        COMPILE_WITH_HELPER(GetObject)
+        COMPILE_WITH_HELPER(GetArgumentsLength)
+        COMPILE_WITH_HELPER(GetArgumentsElement)
+        COMPILE_WITH_HELPER(SetObjectOperation)
+        COMPILE_WITH_HELPER(LoadByName)
+        COMPILE_WITH_HELPER(StoreByName)
+        COMPILE_WITH_HELPER(LoadByHeapIndex)
+        COMPILE_WITH_HELPER(StoreByHeapIndex)
+        COMPILE_WITH_HELPER(LoadByClosureIndex)
+        COMPILE_WITH_HELPER(StoreByClosureIndex)
+        COMPILE_WITH_HELPER(CreateObject)
+        COMPILE_WITH_HELPER(CreateArray)
+        COMPILE_WITH_HELPER(CreateFunction)
+        COMPILE_WITH_HELPER(ObjectDefineOwnPropertyWithNameOperation)
+        COMPILE_WITH_HELPER(ArrayDefineOwnPropertyOperation)
+        COMPILE_WITH_HELPER(CallFunction)
+        COMPILE_WITH_HELPER(CallFunctionWithReceiver)
+        COMPILE_WITH_HELPER(NewOperation)
+#undef COMPILE_WITH_HELPER
+
+    default:
+        // try, finally, with, return, eval, enumeration and other rare ByteCodes
+        exitTo(position);
+        return false;
+    }
+}
+
+JITCode* JITCompiler::compile()
+{
+    size_t codeSize = m_block->m_code.size();
+    if (codeSize > UINT32_MAX) {
+        return nullptr;
+    }
+
+    // caches are referenced by address from compiled code, so they are allocated first
+    size_t getObjectCacheCount = 0;
+    for (size_t position = 0; position < codeSize;) {
+        ByteCode* code = (ByteCode*)(m_codeBuffer + position);
+        Opcode opcode = relocatedOpcode(code);
+        size_t size = byteCodeSize(opcode);
+        if (!size) {
+            return nullptr;
+        }
+        if (opcode == GetObjectPreComputedCaseOpcode || opcode == GetObjectPreComputedCaseAndCallOpcode) {
+            getObjectCacheCount++;
+        }
+        position += size;
+    }
+
+    std::unique_ptr<JITCode> jitCode(new JITCode());
+    m_jitCode = jitCode.get();
+    m_jitCode->m_getObjectCaches.resize(getObjectCacheCount);
+    m_nextGetObjectCache = 0;
+
+    // size_t (*)(JITFrame* frame, void* entry)
+    m_asm.push(RBP);
+    m_asm.mov(RBP, RSP);
+    m_asm.push(RBX);
+    m_asm.push(R12);
+    m_asm.push(R13);
+    // keeps the stack 16 byte aligned for helpers
+    m_asm.push(R14);
+    m_asm.mov(RBX, RDI);
+    m_asm.load(R12, RBX, offsetof(JITFrame, m_registerFile));
+    m_asm.movImm(R13, TagTypeNumber);
+    m_asm.jump(RSI);
+
+    // returns ByteCode position in rax to the interpreter
+    m_epilogue = m_asm.offset();
+    m_asm.pop(R14);
+    m_asm.pop(R13);
+    m_asm.pop(R12);
+    m_asm.pop(RBX);
+    m_asm.pop(RBP);
+    m_asm.ret();
+
+    for (size_t position = 0; position < codeSize;) {
+        ByteCode* code = (ByteCode*)(m_codeBuffer + position);
+        Opcode opcode = relocatedOpcode(code);
+        m_labels.push_back(std::make_pair((uint32_t)position, (uint32_t)m_asm.offset()));
+        if (compileByteCode(code, opcode)) {
+            m_jitCode->m_entries.push_back(m_labels.back());
+        }
+        position += byteCodeSize(opcode);
+    }
+
+    for (size_t i = 0; i < m_pendingJumps.size(); i++) {
+        uint32_t target = (uint32_t)m_pendingJumps[i].second;
+        auto iter = std::lower_bound(m_labels.begin(), m_labels.end(), std::make_pair(target, (uint32_t)0));
+        RELEASE_ASSERT(iter != m_labels.end() && iter->first == target);
+        m_asm.link(m_pendingJumps[i].first, iter->second);
+    }
+
+    std::vector<uint8_t>& buffer = m_asm.buffer();
+    size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    size_t allocSize = (buffer.size() + pageSize - 1) & ~(pageSize - 1);
+    void* memory = mmap(nullptr, allocSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        return nullptr;
+    }
+    memcpy(memory, buffer.data(), buffer.size());
+    if (mprotect(memory, allocSize, PROT_READ | PROT_EXEC) != 0) {
+        munmap(memory, allocSize);
+        return nullptr;
+    }
+
+    m_jitCode->m_code = memory;
+    m_jitCode->m_codeSize = allocSize;
+    return jitCode.release();
+}
+
+bool JITCompiler::getObjectPreComputedCaseHelper(JITFrame* frame, GetObjectPreComputedCase* code, JITGetObjectCache* cache)
+{
+    ExecutionState& state = *frame->m_state;
+    try {
+        const Value& willBeObject = frame->m_registerFile[code->m_objectRegisterIndex];
+        frame->m_registerFile[code->m_storeRegisterIndex] = ByteCodeInterpreter::getObjectPrecomputedCaseOperationOutOfLine(state, willBeObject, code, frame->m_byteCodeBlock);
+
+        // fill the cache of compiled code from the monomorphic cache of the interpreter
+        if (willBeObject.isObject()) {
+            ObjectStructure* structure = willBeObject.asObject()->structure();
+            size_t index = code->m_inlineCache.m_monomorphicIndex;
+            if (code->m_inlineCache.m_monomorphicStructure == structure && index != SIZE_MAX && !structure->isStructureWithFastAccess()
+                && structure->readProperty(state, index).m_descriptor.isPlainDataProperty()) {
+                if (!structure->isProtectedByTransitionTable()) {
+                    frame->m_byteCodeBlock->m_objectStructuresInUse->insert(structure);
+                }
+                cache->m_cachedStructure = structure;
+                cache->m_cachedIndex = index;
+            }
+        }
+        return true;
+    } catch (const Value& v) {
+        frame->m_exception = v;
+        frame->m_hasException = true;
+        return false;
+    }
+}
+
+bool JITCompiler::toBooleanHelper(JITFrame* frame, size_t registerIndex)
+{
+    return frame->m_registerFile[registerIndex].toBoolean(*frame->m_state);
+}
+
+void JITCompiler::execute(ExecutionState& state, BinaryPlus* code, Value* registerFile, ByteCodeBlock* block)
+{
+    registerFile[code->m_dstIndex] = ByteCodeInterpreter::binaryPlusOperation(state, registerFile[code->m_srcIndex0], registerFile[code->m_srcIndex1]);
+}
+
+void JITCompiler::execute(ExecutionState& state, BinaryMinus* code, Value* registerFile, ByteCodeBlock* block)
+{
+    registerFile[code->m_dstIndex] = ByteCodeInterpreter::binaryMinusOperation(state, registerFile[code->m_srcIndex0], registerFile[code->m_srcIndex1]);
+}
+
+void JITCompiler::execute(ExecutionState& state, BinaryMultiply* code, Value* registerFile, ByteCodeBlock* block)
+{
+    registerFile[code->m_dstIndex] = ByteCodeInterpreter::binaryMultiplyOperation(state, registerFile[code->m_srcIndex0], registerFile[code->m_srcIndex1]);
+}
+
+void JITCompiler::execute(ExecutionState& state, BinaryDivision* code, Value* registerFile, ByteCodeBlock* block)
+{
+    const Value& left = registerFile[code->m_srcIndex0];
+    const Value& right = registerFile[code->m_srcIndex1];
+    registerFile[code->m_dstIndex] = Value(left.toNumber(state) / right.toNumber(state));
+}
+
+void JITCompiler::execute(ExecutionState& state, BinaryMod* code, Value* registerFile, ByteCodeBlock* block)
+{
+    registerFile[code->m_dstIndex] = ByteCodeInterpreter::modOperation(state, registerFile[code->m_srcIndex0], registerFile[code->m_srcIndex1]);
+}
+
+void JITCompiler::execute(ExecutionState& state, BinaryEqual* code, Value* registerFile, ByteCodeBlock* block)
+{
+    registerFile[code->m_dstIndex] = Value(registerFile[code->m_srcIndex0].abstractEqualsTo(state, registerFile[code->m_srcIndex1]));
+}
+
+void JITCompiler::execute(ExecutionState& state, BinaryNotEqual* code, Value* registerFile, ByteCodeBlock* block)
+{
+    registerFile[code->m_dstIndex] = Value(!registerFile[code->m_srcIndex0].abstractEqualsTo(state, registerFile[code->m_srcIndex1]));
+}
+
+void JITCompiler::execute(ExecutionState& state, BinaryStrictEqual* code, Value* registerFile, ByteCodeBlock* block)
+{
+    registerFile[code->m_dstIndex] = Value(registerFile[code->m_srcIndex0].equalsTo(state, registerFile[code->m_srcIndex1]));
+}
+
+void JITCompiler::execute(ExecutionState& state, BinaryNotStrictEqual* code, Value* registerFile, ByteCodeBlock* block)
+{
+    registerFile[code->m_dstIndex] = Value(!registerFile[code->m_srcIndex0].equalsTo(state, registerFile[code->m_srcIndex1]));
+}
+
+void JITCompiler::execute(ExecutionState& state, BinaryLessThan* code, Value* registerFile, ByteCodeBlock* block)
+{
+    registerFile[code->m_dstIndex] = Value(ByteCodeInterpreter::abstractRelationalComparison(state, registerFile[code->m_srcIndex0], registerFile[code->m_srcIndex1], true));
+}
+
+void JITCompiler::execute(ExecutionState& state, BinaryLessThanOrEqual* code, Value* registerFile, ByteCodeBlock* block)
+{
+    registerFile[code->m_dstIndex] = Value(ByteCodeInterpreter::abstractRelationalComparisonOrEqual(state, registerFile[code->m_srcIndex0], registerFile[code->m_srcIndex1], true));
+}
+
+void JITCompiler::execute(ExecutionState& state, BinaryGreaterThan* code, Value* registerFile, ByteCodeBlock* block)
+{
+    registerFile[code->m_dstIndex] = Value(ByteCodeInterpreter::abstractRelationalComparison(state, registerFile[code->m_srcIndex1], registerFile[code->m_srcIndex0], false));
+}
+
+void JITCompiler::execute(ExecutionState& state, BinaryGreaterThanOrEqual* code, Value* registerFile, ByteCodeBlock* block)
+{
+    registerFile[code->m_dstIndex] = Value(ByteCodeInterpreter::abstractRelationalComparisonOrEqual(state, registerFile[code->m_srcIndex1], registerFile[code->m_srcIndex0], false));
+}
+
+void JITCompiler::execute(ExecutionState& state, BinaryBitwiseAnd* code, Value* registerFile, ByteCodeBlock* block)
+{
+    registerFile[code->m_dstIndex] = Value(registerFile[code->m_srcIndex0].toInt32(state) & registerFile[code->m_srcIndex1].toInt32(state));
+}
+
+void JITCompiler::execute(ExecutionState& state, BinaryBitwiseOr* code, Value* registerFile, ByteCodeBlock* block)
+{
+    registerFile[code->m_dstIndex] = Value(registerFile[code->m_srcIndex0].toInt32(state) | registerFile[code->m_srcIndex1].toInt32(state));
+}
+
+void JITCompiler::execute(ExecutionState& state, BinaryBitwiseXor* code, Value* registerFile, ByteCodeBlock* block)
+{
+    registerFile[code->m_dstIndex] = Value(registerFile[code->m_srcIndex0].toInt32(state) ^ registerFile[code->m_srcIndex1].toInt32(state));
+}
+
+void JITCompiler::execute(ExecutionState& state, BinaryLeftShift* code, Value* registerFile, ByteCodeBlock* block)
+{
+    registerFile[code->m_dstIndex] = ByteCodeInterpreter::binaryLeftShiftOperation(state, registerFile[code->m_srcIndex0], registerFile[code->m_srcIndex1]);
+}
+
+void JITCompiler::execute(ExecutionState& state, BinarySignedRightShift* code, Value* registerFile, ByteCodeBlock* block)
+{
+    registerFile[code->m_dstIndex] = ByteCodeInterpreter::binarySignedRightShiftOperation(state, registerFile[code->m_srcIndex0], registerFile[code->m_srcIndex1]);
+}
+
+void JITCompiler::execute(ExecutionState& state, BinaryUnsignedRightShift* code, Value* registerFile, ByteCodeBlock* block)
+{
+    registerFile[code->m_dstIndex] = ByteCodeInterpreter::binaryUnsignedRightShiftOperation(state, registerFile[code->m_srcIndex0], registerFile[code->m_srcIndex1]);
+}
+
+void JITCompiler::execute(ExecutionState& state, Increment* code, Value* registerFile, ByteCodeBlock* block)
+{
+    registerFile[code->m_dstIndex] = ByteCodeInterpreter::incrementOperation(state, registerFile[code->m_srcIndex]);
+}
+
+void JITCompiler::execute(ExecutionState& state, Decrement* code, Value* registerFile, ByteCodeBlock* block)
+{
+    registerFile[code->m_dstIndex] = ByteCodeInterpreter::decrementOperation(state, registerFile[code->m_srcIndex]);
+}
+
+void JITCompiler::execute(ExecutionState& state, ToNumber* code, Value* registerFile, ByteCodeBlock* block)
+{
+    registerFile[code->m_dstIndex] = Value(registerFile[code->m_srcIndex].toNumber(state));
+}
+
+void JITCompiler::execute(ExecutionState& state, UnaryMinus* code, Value* registerFile, ByteCodeBlock* block)
+{
+    registerFile[code->m_dstIndex] = Value(-registerFile[code->m_srcIndex].toNumber(state));
+}
+
+void JITCompiler::execute(ExecutionState& state, UnaryNot* code, Value* registerFile, ByteCodeBlock* block)
+{
+    registerFile[code->m_dstIndex] = Value(!registerFile[code->m_srcIndex].toBoolean(state));
+}
+
+void JITCompiler::execute(ExecutionState& state, UnaryBitwiseNot* code, Value* registerFile, ByteCodeBlock* block)
+{
+    registerFile[code->m_dstIndex] = Value(~registerFile[code->m_srcIndex].toInt32(state));
+}
+
+void JITCompiler::execute(ExecutionState& state, GetGlobalObject* code, Value* registerFile, ByteCodeBlock* block)
+{
+    registerFile[code->m_registerIndex] = ByteCodeInterpreter::getGlobalObjectOperation(state, code, block);
+}
+
+void JITCompiler::execute(ExecutionState& state, SetGlobalObject* code, Value* registerFile, ByteCodeBlock* block)
+{
+    ByteCodeInterpreter::setGlobalObjectOperation(state, code, registerFile[code->m_registerIndex], block);
+}
+
+void JITCompiler::execute(ExecutionState& state, SetObjectPreComputedCase* code, Value* registerFile, ByteCodeBlock* block)
+{
+    ByteCodeInterpreter::setObjectPreComputedCaseOperationOutOfLine(state, registerFile[code->m_objectRegisterIndex], code, registerFile[code->m_loadRegisterIndex], block);
+}
+
+void JITCompiler::execute(ExecutionState& state, GetObject* code, Value* registerFile, ByteCodeBlock* block)
+{
+    const Value& willBeObject = registerFile[code->m_objectRegisterIndex];
+    const Value& property = registerFile[code->m_propertyRegisterIndex];
+    if (!ByteCodeInterpreter::getObjectFromFastModeArray(state, willBeObject, property, registerFile[code->m_storeRegisterIndex])) {
+        registerFile[code->m_storeRegisterIndex] = ByteCodeInterpreter::getObjectOperationSlowCase(state, willBeObject, property);
+    }
+}
+
+void JITCompiler::execute(ExecutionState& state, SetObjectOperation* code, Value* registerFile, ByteCodeBlock* block)
+{
+    const Value& willBeObject = registerFile[code->m_objectRegisterIndex];
+    const Value& property = registerFile[code->m_propertyRegisterIndex];
+    if (!ByteCodeInterpreter::setObjectToFastModeArray(state, willBeObject, property, registerFile[code->m_loadRegisterIndex])) {
+        ByteCodeInterpreter::setObjectOperationSlowCase(state, willBeObject, property, registerFile[code->m_loadRegisterIndex]);
+    }
+}
+
+void JITCompiler::execute(ExecutionState& state, LoadByName* code, Value* registerFile, ByteCodeBlock* block)
+{
+    registerFile[code->m_registerIndex] = ByteCodeInterpreter::loadByName(state, state.executionContext()->lexicalEnvironment(), code->m_name);
+}
+
+void JITCompiler::execute(ExecutionState& state, StoreByName* code, Value* registerFile, ByteCodeBlock* block)
+{
+    ByteCodeInterpreter::storeByName(state, state.executionContext()->lexicalEnvironment(), code->m_name, registerFile[code->m_registerIndex]);
+}
+
+void JITCompiler::execute(ExecutionState& state, LoadByHeapIndex* code, Value* registerFile, ByteCodeBlock* block)
+{
+    registerFile[code->m_registerIndex] = ByteCodeInterpreter::heapStorageRecord(state.executionContext(), code->m_upperIndex)->m_heapStorage[code->m_index];
+}
+
+void JITCompiler::execute(ExecutionState& state, StoreByHeapIndex* code, Value* registerFile, ByteCodeBlock* block)
+{
+    ByteCodeInterpreter::heapStorageRecord(state.executionContext(), code->m_upperIndex)->m_heapStorage[code->m_index] = registerFile[code->m_registerIndex];
+}
+
+void JITCompiler::execute(ExecutionState& state, GetArgumentsLength* code, Value* registerFile, ByteCodeBlock* block)
+{
+    registerFile[code->m_storeRegisterIndex] = ByteCodeInterpreter::getArgumentsLengthOperation(state, code, state.executionContext(), registerFile, block);
+}
+
+void JITCompiler::execute(ExecutionState& state, GetArgumentsElement* code, Value* registerFile, ByteCodeBlock* block)
+{
+    registerFile[code->m_storeRegisterIndex] = ByteCodeInterpreter::getArgumentsElementOperation(state, code, state.executionContext(), registerFile, block);
+}
+
+void JITCompiler::execute(ExecutionState& state, LoadByClosureIndex* code, Value* registerFile, ByteCodeBlock* block)
+{
+    registerFile[code->m_registerIndex] = state.executionContext()->m_closureDisplay[code->m_displayIndex][code->m_index];
+}
+
+void JITCompiler::execute(ExecutionState& state, StoreByClosureIndex* code, Value* registerFile, ByteCodeBlock* block)
+{
+    state.executionContext()->m_closureDisplay[code->m_displayIndex][code->m_index] = registerFile[code->m_registerIndex];
+}
+
+void JITCompiler::execute(ExecutionState& state, CreateObject* code, Value* registerFile, ByteCodeBlock* block)
+{
+    Object* obj = new Object(state);
+    obj->reservePropertyStorage(code->m_propertyCount);
+    registerFile[code->m_registerIndex] = obj;
+}
+
+void JITCompiler::execute(ExecutionState& state, CreateArray* code, Value* registerFile, ByteCodeBlock* block)
+{
+    ArrayObject* arr = new ArrayObject(state);
+    arr->setArrayLength(state, code->m_length, true);
+    registerFile[code->m_registerIndex] = arr;
+}
+
+void JITCompiler::execute(ExecutionState& state, CreateFunction* code, Value* registerFile, ByteCodeBlock* block)
+{
+    registerFile[code->m_registerIndex] = new FunctionObject(state, code->m_codeBlock, state.executionContext()->lexicalEnvironment());
+}
+
+void JITCompiler::execute(ExecutionState& state, ObjectDefineOwnPropertyWithNameOperation* code, Value* registerFile, ByteCodeBlock* block)
+{
+    ByteCodeInterpreter::objectDefineOwnPropertyWithNameOperation(state, code, registerFile);
+}
+
+void JITCompiler::execute(ExecutionState& state, ArrayDefineOwnPropertyOperation* code, Value* registerFile, ByteCodeBlock* block)
+{
+    ByteCodeInterpreter::arrayDefineOwnPropertyOperation(state, code, registerFile);
+}
+
+void JITCompiler::execute(ExecutionState& state, CallFunction* code, Value* registerFile, ByteCodeBlock* block)
+{
+    registerFile[code->m_resultIndex] = FunctionObject::call(state, registerFile[code->m_calleeIndex], Value(), code->m_argumentCount, &registerFile[code->m_argumentsStartIndex]);
+}
+
+void JITCompiler::execute(ExecutionState& state, CallFunctionWithReceiver* code, Value* registerFile, ByteCodeBlock* block)
+{
+    registerFile[code->m_resultIndex] = FunctionObject::call(state, registerFile[code->m_calleeIndex], registerFile[code->m_receiverIndex], code->m_argumentCount, &registerFile[code->m_argumentsStartIndex]);
+}
+
+void JITCompiler::execute(ExecutionState& state, NewOperation* code, Value* registerFile, ByteCodeBlock* block)
+{
+    registerFile[code->m_resultIndex] = ByteCodeInterpreter::newOperation(state, registerFile[code->m_calleeIndex], code->m_argumentCount, &registerFile[code->m_argumentsStartIndex]);
+}
+
+JITCode* JITCode::compile(ByteCodeBlock* block)
+{
+    JITCompiler compiler(block);
+    return compiler.compile();
+}
+
+JITCode::~JITCode()
+{
+    if (m_code) {
+        munmap(m_code, m_codeSize);
+    }
+}
+
+void* JITCode::entry(size_t byteCodePosition)
+{
+    auto iter = std::lower_bound(m_entries.begin(), m_entries.end(), std::make_pair((uint32_t)byteCodePosition, (uint32_t)0));
+    if (iter == m_entries.end() || iter->first != byteCodePosition) {
+        return nullptr;
+    }
+    return (char*)m_code + iter->second;
+}
+}
+
+#endif
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2018-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotJIT__
+#define __EscargotJIT__
+
+#if defined(ESCARGOT_ENABLE_JIT)
+
+#include "runtime/Value.h"
+
+namespace Escargot {
+
+class ExecutionState;
+class ByteCodeBlock;
+class ObjectStructure;
+
+// state of an activation of JIT compiled code, shared with the helpers it calls
+struct JITFrame {
+    JITFrame(ExecutionState* state, ByteCodeBlock* byteCodeBlock, Value* registerFile)
+        : m_state(state)
+        , m_byteCodeBlock(byteCodeBlock)
+        , m_registerFile(registerFile)
+        , m_hasException(false)
+    {
+    }
+
+    ExecutionState* m_state;
+    ByteCodeBlock* m_byteCodeBlock;
+    Value* m_registerFile;
+    // helpers catch exceptions instead of unwinding through compiled code,
+    // and the interpreter throws it again at the ByteCode compiled code stopped at
+    Value m_exception;
+    bool m_hasException;
+};
+
+// GetObjectPreComputedCase cache of compiled code.
+// it only holds own plain data properties of structures which never change in place,
+// so compiled code loads the value without looking into the structure.
+struct JITGetObjectCache {
+    JITGetObjectCache()
+        : m_cachedStructure(nullptr)
+        , m_cachedIndex(0)
+    {
+    }
+
+    ObjectStructure* m_cachedStructure;
+    size_t m_cachedIndex;
+};
+
+// Native code of a ByteCodeBlock generated by a baseline template compiler for x64.
+// Each ByteCode is translated in place by a template: simple ones are inlined with a fast path
+// (int32 arithmetic and comparison, inline caches of properties and global variables),
+// others call a helper which does what the interpreter does.
+// Compiled code returns to the interpreter on ByteCodes it does not handle
+// (control flow of try, with, finally, return ...) and on exceptions.
+class JITCode {
+    friend class JITCompiler;
+
+public:
+    // returns the position of the ByteCode where the interpreter continues
+    typedef size_t (*Function)(JITFrame* frame, void* entry);
+
+    // returns nullptr if executable memory is not available
+    static JITCode* compile(ByteCodeBlock* block);
+
+    ~JITCode();
+
+    // returns nullptr if the ByteCode at |byteCodePosition| has no native code
+    void* entry(size_t byteCodePosition);
+
+    size_t run(JITFrame* frame, void* entry)
+    {
+        return ((Function)m_code)(frame, entry);
+    }
+
+    size_t codeSize()
+    {
+        return m_codeSize;
+    }
+
+private:
+    JITCode()
+        : m_code(nullptr)
+        , m_codeSize(0)
+    {
+    }
+
+    void* m_code;
+    size_t m_codeSize;
+    // (ByteCode position, offset of its native code), sorted by ByteCode position
+    std::vector<std::pair<uint32_t, uint32_t>> m_entries;
+    // structures of the caches are kept alive by ByteCodeBlock::m_objectStructuresInUse
+    std::vector<JITGetObjectCache> m_getObjectCaches;
+};
+}
+
+#endif
+
+#endif
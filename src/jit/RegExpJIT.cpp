@@ -0,0 +1,630 @@
+/*
+ * Copyright (c) 2018-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#include "Escargot.h"
+
+#if defined(ESCARGOT_ENABLE_JIT)
+
+#include "RegExpJIT.h"
+#include "X64Assembler.h"
+
+#include "Yarr.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace Escargot {
+
+// sorted and disjoint ranges of code units
+typedef std::vector<std::pair<char16_t, char16_t>> RegExpCharacterSet;
+
+static void normalizeCharacterSet(RegExpCharacterSet& set)
+{
+    std::sort(set.begin(), set.end());
+    size_t last = 0;
+    for (size_t i = 1; i < set.size(); i++) {
+        if ((unsigned)set[i].first <= (unsigned)set[last].second + 1) {
+            set[last].second = std::max(set[last].second, set[i].second);
+        } else {
+            set[++last] = set[i];
+        }
+    }
+    if (set.size()) {
+        set.resize(last + 1);
+    }
+}
+
+static RegExpCharacterSet invertCharacterSet(const RegExpCharacterSet& set)
+{
+    RegExpCharacterSet result;
+    unsigned next = 0;
+    for (size_t i = 0; i < set.size(); i++) {
+        if (set[i].first > next) {
+            result.push_back(std::make_pair((char16_t)next, (char16_t)(set[i].first - 1)));
+        }
+        next = (unsigned)set[i].second + 1;
+    }
+    if (next <= 0xFFFF) {
+        result.push_back(std::make_pair((char16_t)next, (char16_t)0xFFFF));
+    }
+    return result;
+}
+
+static bool characterSetsIntersect(const RegExpCharacterSet& a, const RegExpCharacterSet& b)
+{
+    size_t i = 0, j = 0;
+    while (i < a.size() && j < b.size()) {
+        if (a[i].second < b[j].first) {
+            i++;
+        } else if (b[j].second < a[i].first) {
+            j++;
+        } else {
+            return true;
+        }
+    }
+    return false;
+}
+
+static RegExpCharacterSet lineTerminators()
+{
+    RegExpCharacterSet set;
+    set.push_back(std::make_pair((char16_t)'\n', (char16_t)'\n'));
+    set.push_back(std::make_pair((char16_t)'\r', (char16_t)'\r'));
+    set.push_back(std::make_pair((char16_t)0x2028, (char16_t)0x2029));
+    return set;
+}
+
+struct RegExpJITNode {
+    enum Type {
+        Characters,
+        BeginOfLine,
+        EndOfLine,
+        BeginCapture,
+        EndCapture
+    };
+
+    explicit RegExpJITNode(Type type, unsigned subpatternId = 0)
+        : m_type(type)
+        , m_minCount(0)
+        , m_maxCount(0)
+        , m_subpatternId(subpatternId)
+    {
+    }
+
+    Type m_type;
+    // Characters matches m_set from m_minCount to m_maxCount times greedily
+    RegExpCharacterSet m_set;
+    unsigned m_minCount;
+    unsigned m_maxCount;
+    unsigned m_subpatternId;
+};
+
+// a loop without upper bound
+static const unsigned RegExpJITInfiniteCount = std::numeric_limits<unsigned>::max();
+
+// if a class has more ranges than this above 0xFF, the pattern is left to the interpreter
+static const size_t RegExpJITMaxHighRangeCount = 64;
+
+class RegExpJITCompiler {
+public:
+    explicit RegExpJITCompiler(YarrPattern& pattern)
+        : m_pattern(pattern)
+    {
+    }
+
+    RegExpJITCode* compile();
+
+private:
+    bool appendAlternative(PatternAlternative* alternative);
+    bool appendCharacters(PatternTerm& term, RegExpCharacterSet& set);
+    bool isBacktrackingNeeded();
+
+    void compileMatcher(bool is8Bit);
+    void loadCharacter(bool is8Bit, int32_t disp);
+    void compileCharacterTest(bool is8Bit, const RegExpCharacterSet& set, std::vector<size_t>& failJumps);
+    void compileRangeTests(const RegExpCharacterSet& set, std::vector<size_t>& matchedJumps);
+    void compileLineTerminatorTest(bool is8Bit, std::vector<size_t>& failJumps);
+    void compileCharacters(bool is8Bit, RegExpJITNode& node, std::vector<size_t>& failJumps);
+
+    void linkAll(std::vector<size_t>& jumps, size_t target)
+    {
+        for (size_t i = 0; i < jumps.size(); i++) {
+            m_asm.link(jumps[i], target);
+        }
+        jumps.clear();
+    }
+
+    YarrPattern& m_pattern;
+    std::vector<RegExpJITNode> m_nodes;
+    X64Assembler m_asm;
+    // 256 entry tables of classes and the lea instructions referencing them
+    std::vector<std::vector<uint8_t>> m_tables;
+    std::vector<std::pair<size_t, size_t>> m_tableReferences;
+};
+
+bool RegExpJITCompiler::appendCharacters(PatternTerm& term, RegExpCharacterSet& set)
+{
+    unsigned count = term.quantityCount.unsafeGet();
+    unsigned minCount, maxCount;
+    switch (term.quantityType) {
+    case QuantifierFixedCount:
+        minCount = maxCount = count;
+        break;
+    case QuantifierGreedy:
+        minCount = 0;
+        maxCount = count;
+        break;
+    default:
+        // a non-greedy loop stops at the first position the rest matches, which needs backtracking
+        return false;
+    }
+    if (!maxCount) {
+        return true;
+    }
+
+    normalizeCharacterSet(set);
+    // Yarr splits {n,m} into a fixed count term and a loop, which are merged again here
+    if (m_nodes.size() && m_nodes.back().m_type == RegExpJITNode::Characters && m_nodes.back().m_set == set
+        && m_nodes.back().m_minCount == m_nodes.back().m_maxCount) {
+        RegExpJITNode& last = m_nodes.back();
+        if ((size_t)last.m_minCount + minCount >= RegExpJITInfiniteCount) {
+            return false;
+        }
+        last.m_minCount += minCount;
+        if (maxCount == RegExpJITInfiniteCount) {
+            last.m_maxCount = RegExpJITInfiniteCount;
+        } else if ((size_t)last.m_maxCount + maxCount >= RegExpJITInfiniteCount) {
+            return false;
+        } else {
+            last.m_maxCount += maxCount;
+        }
+        return true;
+    }
+
+    RegExpJITNode node(RegExpJITNode::Characters);
+    node.m_set = std::move(set);
+    node.m_minCount = minCount;
+    node.m_maxCount = maxCount;
+    m_nodes.push_back(std::move(node));
+    return true;
+}
+
+bool RegExpJITCompiler::appendAlternative(PatternAlternative* alternative)
+{
+    for (size_t i = 0; i < alternative->m_terms.size(); i++) {
+        PatternTerm& term = alternative->m_terms[i];
+        switch (term.type) {
+        case PatternTerm::TypePatternCharacter: {
+            char16_t ch = term.patternCharacter;
+            RegExpCharacterSet set;
+            set.push_back(std::make_pair(ch, ch));
+            // Yarr turns non-ASCII characters which have other cases into classes
+            if (m_pattern.m_ignoreCase && (ch | 0x20) >= 'a' && (ch | 0x20) <= 'z') {
+                set.push_back(std::make_pair((char16_t)(ch ^ 0x20), (char16_t)(ch ^ 0x20)));
+            }
+            if (!appendCharacters(term, set)) {
+                return false;
+            }
+            break;
+        }
+        case PatternTerm::TypeCharacterClass: {
+            CharacterClass* characterClass = term.characterClass;
+            RegExpCharacterSet set;
+            for (size_t j = 0; j < characterClass->m_matches.size(); j++) {
+                set.push_back(std::make_pair((char16_t)characterClass->m_matches[j], (char16_t)characterClass->m_matches[j]));
+            }
+            for (size_t j = 0; j < characterClass->m_ranges.size(); j++) {
+                set.push_back(std::make_pair((char16_t)characterClass->m_ranges[j].begin, (char16_t)characterClass->m_ranges[j].end));
+            }
+            for (size_t j = 0; j < characterClass->m_matchesUnicode.size(); j++) {
+                set.push_back(std::make_pair((char16_t)characterClass->m_matchesUnicode[j], (char16_t)characterClass->m_matchesUnicode[j]));
+            }
+            for (size_t j = 0; j < characterClass->m_rangesUnicode.size(); j++) {
+                set.push_back(std::make_pair((char16_t)characterClass->m_rangesUnicode[j].begin, (char16_t)characterClass->m_rangesUnicode[j].end));
+            }
+            if (term.invert()) {
+                normalizeCharacterSet(set);
+                set = invertCharacterSet(set);
+            }
+            if (!appendCharacters(term, set)) {
+                return false;
+            }
+            break;
+        }
+        case PatternTerm::TypeAssertionBOL:
+            m_nodes.push_back(RegExpJITNode(RegExpJITNode::BeginOfLine));
+            break;
+        case PatternTerm::TypeAssertionEOL:
+            m_nodes.push_back(RegExpJITNode(RegExpJITNode::EndOfLine));
+            break;
+        case PatternTerm::TypeParenthesesSubpattern: {
+            PatternDisjunction* disjunction = term.parentheses.disjunction;
+            if (term.quantityType != QuantifierFixedCount || term.quantityCount.unsafeGet() != 1 || disjunction->m_alternatives.size() != 1) {
+                return false;
+            }
+            if (term.capture()) {
+                m_nodes.push_back(RegExpJITNode(RegExpJITNode::BeginCapture, term.parentheses.subpatternId));
+            }
+            if (!appendAlternative(&*disjunction->m_alternatives[0])) {
+                return false;
+            }
+            if (term.capture()) {
+                m_nodes.push_back(RegExpJITNode(RegExpJITNode::EndCapture, term.parentheses.subpatternId));
+            }
+            break;
+        }
+        default:
+            // word boundaries, back references, lookaheads ...
+            return false;
+        }
+    }
+    return true;
+}
+
+bool RegExpJITCompiler::isBacktrackingNeeded()
+{
+    for (size_t i = 0; i < m_nodes.size(); i++) {
+        RegExpJITNode& loop = m_nodes[i];
+        if (loop.m_type != RegExpJITNode::Characters || loop.m_minCount == loop.m_maxCount) {
+            continue;
+        }
+
+        // characters which the rest of the pattern can start with
+        RegExpCharacterSet follow;
+        for (size_t j = i + 1; j < m_nodes.size(); j++) {
+            RegExpJITNode& node = m_nodes[j];
+            if (node.m_type == RegExpJITNode::Characters) {
+                follow.insert(follow.end(), node.m_set.begin(), node.m_set.end());
+                if (node.m_minCount) {
+                    break;
+                }
+            } else if (node.m_type == RegExpJITNode::EndOfLine) {
+                // without multiline, $ fails before the end of the input wherever the loop stops
+                if (m_pattern.m_multiline) {
+                    RegExpCharacterSet terminators = lineTerminators();
+                    follow.insert(follow.end(), terminators.begin(), terminators.end());
+                }
+                break;
+            } else if (node.m_type == RegExpJITNode::BeginOfLine) {
+                // ^ may match only if the loop gives back characters
+                return true;
+            }
+        }
+        normalizeCharacterSet(follow);
+        if (characterSetsIntersect(loop.m_set, follow)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void RegExpJITCompiler::loadCharacter(bool is8Bit, int32_t disp)
+{
+    // rax = input[r8 + disp]
+    if (is8Bit) {
+        m_asm.loadZeroExtended8(RAX, RDI, R8, disp);
+    } else {
+        m_asm.loadZeroExtended16(RAX, RDI, R8, disp * 2);
+    }
+}
+
+void RegExpJITCompiler::compileRangeTests(const RegExpCharacterSet& set, std::vector<size_t>& matchedJumps)
+{
+    for (size_t i = 0; i < set.size(); i++) {
+        if (set[i].first == set[i].second) {
+            m_asm.arithImm32(ArithmeticCmp, RAX, set[i].first);
+            matchedJumps.push_back(m_asm.jumpIf(ConditionEqual));
+        } else {
+            m_asm.mov32(R9, RAX);
+            m_asm.arithImm32(ArithmeticSub, R9, set[i].first);
+            m_asm.arithImm32(ArithmeticCmp, R9, set[i].second - set[i].first);
+            matchedJumps.push_back(m_asm.jumpIf(ConditionBelowOrEqual));
+        }
+    }
+}
+
+void RegExpJITCompiler::compileCharacterTest(bool is8Bit, const RegExpCharacterSet& fullSet, std::vector<size_t>& failJumps)
+{
+    char16_t maxCharacter = is8Bit ? 0xFF : 0xFFFF;
+    RegExpCharacterSet set;
+    RegExpCharacterSet highSet;
+    for (size_t i = 0; i < fullSet.size(); i++) {
+        if (fullSet[i].first > maxCharacter) {
+            break;
+        }
+        set.push_back(std::make_pair(fullSet[i].first, std::min(fullSet[i].second, maxCharacter)));
+        if (fullSet[i].second > 0xFF) {
+            highSet.push_back(std::make_pair(std::max(fullSet[i].first, (char16_t)0x100), fullSet[i].second));
+        }
+    }
+
+    if (set.empty()) {
+        failJumps.push_back(m_asm.jump());
+        return;
+    }
+
+    if (set.size() == 1) {
+        char16_t first = set[0].first;
+        char16_t last = set[0].second;
+        if (first == last) {
+            m_asm.arithImm32(ArithmeticCmp, RAX, first);
+            failJumps.push_back(m_asm.jumpIf(ConditionNotEqual));
+        } else if (first == 0) {
+            if (last != maxCharacter) {
+                m_asm.arithImm32(ArithmeticCmp, RAX, last);
+                failJumps.push_back(m_asm.jumpIf(ConditionAbove));
+            }
+        } else {
+            m_asm.mov32(R9, RAX);
+            m_asm.arithImm32(ArithmeticSub, R9, first);
+            m_asm.arithImm32(ArithmeticCmp, R9, last - first);
+            failJumps.push_back(m_asm.jumpIf(ConditionAbove));
+        }
+        return;
+    }
+
+    std::vector<size_t> matchedJumps;
+    if (set.size() <= 4) {
+        compileRangeTests(set, matchedJumps);
+        failJumps.push_back(m_asm.jump());
+        linkAll(matchedJumps, m_asm.offset());
+        return;
+    }
+
+    // characters up to 0xFF are looked up in a table
+    std::vector<uint8_t> table(256, 0);
+    for (size_t i = 0; i < set.size() && set[i].first <= 0xFF; i++) {
+        for (unsigned ch = set[i].first; ch <= std::min(set[i].second, (char16_t)0xFF); ch++) {
+            table[ch] = 1;
+        }
+    }
+    size_t tableIndex = std::find(m_tables.begin(), m_tables.end(), table) - m_tables.begin();
+    if (tableIndex == m_tables.size()) {
+        m_tables.push_back(std::move(table));
+    }
+
+    size_t highJump = SIZE_MAX;
+    if (!is8Bit) {
+        m_asm.arithImm32(ArithmeticCmp, RAX, 0xFF);
+        if (highSet.empty()) {
+            failJumps.push_back(m_asm.jumpIf(ConditionAbove));
+        } else {
+            highJump = m_asm.jumpIf(ConditionAbove);
+        }
+    }
+    m_tableReferences.push_back(std::make_pair(m_asm.loadRelativeAddress(R9), tableIndex));
+    m_asm.loadZeroExtended8(R9, R9, RAX, 0);
+    m_asm.arith32(ArithmeticTest, R9, R9);
+    failJumps.push_back(m_asm.jumpIf(ConditionEqual));
+
+    if (highJump != SIZE_MAX) {
+        matchedJumps.push_back(m_asm.jump());
+        m_asm.linkToHere(highJump);
+        compileRangeTests(highSet, matchedJumps);
+        failJumps.push_back(m_asm.jump());
+        linkAll(matchedJumps, m_asm.offset());
+    }
+}
+
+void RegExpJITCompiler::compileLineTerminatorTest(bool is8Bit, std::vector<size_t>& failJumps)
+{
+    RegExpCharacterSet terminators = lineTerminators();
+    compileCharacterTest(is8Bit, terminators, failJumps);
+}
+
+void RegExpJITCompiler::compileCharacters(bool is8Bit, RegExpJITNode& node, std::vector<size_t>& failJumps)
+{
+    // fixed part
+    if (node.m_minCount <= 4) {
+        for (unsigned i = 0; i < node.m_minCount; i++) {
+            m_asm.arith(ArithmeticCmp, R8, RSI);
+            failJumps.push_back(m_asm.jumpIf(ConditionAboveOrEqual));
+            loadCharacter(is8Bit, 0);
+            compileCharacterTest(is8Bit, node.m_set, failJumps);
+            m_asm.arithImm(ArithmeticAdd, R8, 1);
+        }
+    } else {
+        m_asm.movImm(R11, node.m_minCount);
+        size_t loopStart = m_asm.offset();
+        m_asm.arith(ArithmeticCmp, R8, RSI);
+        failJumps.push_back(m_asm.jumpIf(ConditionAboveOrEqual));
+        loadCharacter(is8Bit, 0);
+        compileCharacterTest(is8Bit, node.m_set, failJumps);
+        m_asm.arithImm(ArithmeticAdd, R8, 1);
+        m_asm.arithImm(ArithmeticSub, R11, 1);
+        m_asm.link(m_asm.jumpIf(ConditionNotEqual), loopStart);
+    }
+
+    if (node.m_minCount == node.m_maxCount) {
+        return;
+    }
+
+    // greedy part, which never gives back what it consumed
+    bool hasUpperBound = node.m_maxCount != RegExpJITInfiniteCount;
+    std::vector<size_t> doneJumps;
+    if (hasUpperBound) {
+        m_asm.movImm(R11, node.m_maxCount - node.m_minCount);
+    }
+    size_t loopStart = m_asm.offset();
+    m_asm.arith(ArithmeticCmp, R8, RSI);
+    doneJumps.push_back(m_asm.jumpIf(ConditionAboveOrEqual));
+    if (hasUpperBound) {
+        m_asm.arith(ArithmeticTest, R11, R11);
+        doneJumps.push_back(m_asm.jumpIf(ConditionEqual));
+    }
+    loadCharacter(is8Bit, 0);
+    compileCharacterTest(is8Bit, node.m_set, doneJumps);
+    m_asm.arithImm(ArithmeticAdd, R8, 1);
+    if (hasUpperBound) {
+        m_asm.arithImm(ArithmeticSub, R11, 1);
+    }
+    m_asm.link(m_asm.jump(), loopStart);
+    linkAll(doneJumps, m_asm.offset());
+}
+
+void RegExpJITCompiler::compileMatcher(bool is8Bit)
+{
+    // unsigned (*)(const void* input, unsigned length, unsigned start, unsigned* output)
+    // rdi: input, rsi: length, rdx: start of the current try, rcx: output, r8: current position
+    // rax, r9, r11: temporaries
+    m_asm.mov32(RSI, RSI);
+    m_asm.mov32(RDX, RDX);
+
+    size_t tryStart = m_asm.offset();
+    m_asm.mov(R8, RDX);
+
+    std::vector<size_t> failJumps;
+    for (size_t i = 0; i < m_nodes.size(); i++) {
+        RegExpJITNode& node = m_nodes[i];
+        switch (node.m_type) {
+        case RegExpJITNode::Characters:
+            compileCharacters(is8Bit, node, failJumps);
+            break;
+        case RegExpJITNode::BeginOfLine: {
+            m_asm.arith(ArithmeticTest, R8, R8);
+            if (m_pattern.m_multiline) {
+                size_t atStart = m_asm.jumpIf(ConditionEqual);
+                loadCharacter(is8Bit, -1);
+                compileLineTerminatorTest(is8Bit, failJumps);
+                m_asm.linkToHere(atStart);
+            } else {
+                failJumps.push_back(m_asm.jumpIf(ConditionNotEqual));
+            }
+            break;
+        }
+        case RegExpJITNode::EndOfLine: {
+            m_asm.arith(ArithmeticCmp, R8, RSI);
+            if (m_pattern.m_multiline) {
+                size_t atEnd = m_asm.jumpIf(ConditionEqual);
+                loadCharacter(is8Bit, 0);
+                compileLineTerminatorTest(is8Bit, failJumps);
+                m_asm.linkToHere(atEnd);
+            } else {
+                failJumps.push_back(m_asm.jumpIf(ConditionNotEqual));
+            }
+            break;
+        }
+        case RegExpJITNode::BeginCapture:
+            m_asm.store32(RCX, node.m_subpatternId * 2 * sizeof(unsigned), R8);
+            break;
+        case RegExpJITNode::EndCapture:
+            m_asm.store32(RCX, (node.m_subpatternId * 2 + 1) * sizeof(unsigned), R8);
+            break;
+        }
+    }
+
+    // matched
+    m_asm.store32(RCX, 0, RDX);
+    m_asm.store32(RCX, sizeof(unsigned), R8);
+    m_asm.mov32(RAX, RDX);
+    m_asm.ret();
+
+    // captures are always set by a match, so what a failed try stored needs no cleanup
+    linkAll(failJumps, m_asm.offset());
+    // ^ without multiline fails at any other position
+    if (!m_nodes.size() || m_nodes[0].m_type != RegExpJITNode::BeginOfLine || m_pattern.m_multiline) {
+        m_asm.arithImm(ArithmeticAdd, RDX, 1);
+        m_asm.arith(ArithmeticCmp, RDX, RSI);
+        m_asm.link(m_asm.jumpIf(ConditionBelowOrEqual), tryStart);
+    }
+    m_asm.movImm(RAX, JSC::Yarr::offsetNoMatch);
+    m_asm.ret();
+}
+
+RegExpJITCode* RegExpJITCompiler::compile()
+{
+    if (m_pattern.m_containsBackreferences || m_pattern.m_body->m_alternatives.size() != 1) {
+        return nullptr;
+    }
+    if (!appendAlternative(&*m_pattern.m_body->m_alternatives[0]) || isBacktrackingNeeded()) {
+        return nullptr;
+    }
+    for (size_t i = 0; i < m_nodes.size(); i++) {
+        RegExpJITNode& node = m_nodes[i];
+        if (node.m_type == RegExpJITNode::Characters) {
+            size_t highRangeCount = 0;
+            for (size_t j = 0; j < node.m_set.size(); j++) {
+                highRangeCount += node.m_set[j].second > 0xFF ? 1 : 0;
+            }
+            if (highRangeCount > RegExpJITMaxHighRangeCount) {
+                return nullptr;
+            }
+        }
+    }
+
+    size_t code8Offset = m_asm.offset();
+    compileMatcher(true);
+    size_t code16Offset = m_asm.offset();
+    compileMatcher(false);
+
+    std::vector<size_t> tableOffsets;
+    for (size_t i = 0; i < m_tables.size(); i++) {
+        tableOffsets.push_back(m_asm.offset());
+        m_asm.emitData(m_tables[i].data(), m_tables[i].size());
+    }
+    for (size_t i = 0; i < m_tableReferences.size(); i++) {
+        m_asm.link(m_tableReferences[i].first, tableOffsets[m_tableReferences[i].second]);
+    }
+
+    std::vector<uint8_t>& buffer = m_asm.buffer();
+    size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    size_t allocSize = (buffer.size() + pageSize - 1) & ~(pageSize - 1);
+    void* memory = mmap(nullptr, allocSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        return nullptr;
+    }
+    memcpy(memory, buffer.data(), buffer.size());
+    if (mprotect(memory, allocSize, PROT_READ | PROT_EXEC) != 0) {
+        munmap(memory, allocSize);
+        return nullptr;
+    }
+
+    RegExpJITCode* jitCode = new RegExpJITCode();
+    jitCode->m_code = memory;
+    jitCode->m_codeSize = allocSize;
+    jitCode->m_code8 = (uint8_t*)memory + code8Offset;
+    jitCode->m_code16 = (uint8_t*)memory + code16Offset;
+    return jitCode;
+}
+
+RegExpJITCode* RegExpJITCode::compile(YarrPattern& pattern)
+{
+    return RegExpJITCompiler(pattern).compile();
+}
+
+RegExpJITCode::~RegExpJITCode()
+{
+    if (m_code) {
+        munmap(m_code, m_codeSize);
+    }
+}
+
+RegExpJITInfo::RegExpJITInfo()
+    : m_executionCount(0)
+    , m_jitCode(nullptr)
+{
+    GC_REGISTER_FINALIZER_NO_ORDER(this, [](void* obj, void*) {
+        RegExpJITInfo* self = (RegExpJITInfo*)obj;
+        delete self->m_jitCode;
+    },
+                                   nullptr, nullptr, nullptr);
+}
+}
+
+#endif
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2018-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotRegExpJIT__
+#define __EscargotRegExpJIT__
+
+#if defined(ESCARGOT_ENABLE_JIT)
+
+namespace JSC {
+namespace Yarr {
+struct YarrPattern;
+}
+}
+
+namespace Escargot {
+
+// Native matcher of a YarrPattern for x64, with variants for 8-bit and 16-bit strings.
+// Only patterns which never need to backtrack are compiled: a single alternative of characters,
+// character classes and their fixed count or greedy loops, ^, $ and captures which are not quantified.
+// A greedy loop is accepted when what can follow it never starts with what it consumes,
+// so giving back characters could not make the rest match.
+// Other patterns are matched by the interpreter of Yarr.
+class RegExpJITCode {
+    friend class RegExpJITCompiler;
+
+public:
+    // same arguments and result as JSC::Yarr::interpret
+    typedef unsigned (*Function)(const void* input, unsigned length, unsigned start, unsigned* output);
+
+    // returns nullptr if the pattern is not supported or executable memory is not available
+    static RegExpJITCode* compile(JSC::Yarr::YarrPattern& pattern);
+
+    ~RegExpJITCode();
+
+    unsigned match(const LChar* input, unsigned length, unsigned start, unsigned* output)
+    {
+        return ((Function)m_code8)(input, length, start, output);
+    }
+
+    unsigned match(const char16_t* input, unsigned length, unsigned start, unsigned* output)
+    {
+        return ((Function)m_code16)(input, length, start, output);
+    }
+
+    size_t codeSize()
+    {
+        return m_codeSize;
+    }
+
+private:
+    RegExpJITCode()
+        : m_code(nullptr)
+        , m_codeSize(0)
+        , m_code8(nullptr)
+        , m_code16(nullptr)
+    {
+    }
+
+    void* m_code;
+    size_t m_codeSize;
+    void* m_code8;
+    void* m_code16;
+};
+
+// execution count and native code of a pattern.
+// it is shared by the RegExpCacheEntry of the pattern and the RegExpObjects using it,
+// so the count survives eviction of the entry
+struct RegExpJITInfo : public gc {
+    RegExpJITInfo();
+
+    // returns nullptr until the pattern is executed ESCARGOT_REGEXP_JIT_HOT_COUNT times
+    RegExpJITCode* jitCode(JSC::Yarr::YarrPattern* pattern)
+    {
+        if (UNLIKELY(m_executionCount < ESCARGOT_REGEXP_JIT_HOT_COUNT) && ++m_executionCount == ESCARGOT_REGEXP_JIT_HOT_COUNT) {
+            m_jitCode = RegExpJITCode::compile(*pattern);
+        }
+        return m_jitCode;
+    }
+
+    size_t m_executionCount;
+    RegExpJITCode* m_jitCode;
+};
+}
+
+#endif
+
+#endif
@@ -0,0 +1,425 @@
+/*
+ * Copyright (c) 2018-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotX64Assembler__
+#define __EscargotX64Assembler__
+
+#if defined(ESCARGOT_ENABLE_JIT)
+
+namespace Escargot {
+
+enum X64Register {
+    RAX = 0,
+    RCX,
+    RDX,
+    RBX,
+    RSP,
+    RBP,
+    RSI,
+    RDI,
+    R8,
+    R9,
+    R10,
+    R11,
+    R12,
+    R13,
+    R14,
+    R15
+};
+
+enum X64Condition {
+    ConditionOverflow = 0x0,
+    ConditionBelow = 0x2,
+    ConditionAboveOrEqual = 0x3,
+    ConditionEqual = 0x4,
+    ConditionNotEqual = 0x5,
+    ConditionBelowOrEqual = 0x6,
+    ConditionAbove = 0x7,
+    ConditionSign = 0x8,
+    ConditionLess = 0xC,
+    ConditionGreaterOrEqual = 0xD,
+    ConditionLessOrEqual = 0xE,
+    ConditionGreater = 0xF
+};
+
+enum X64ArithmeticOperation {
+    // opcode of "op r/m, r" form
+    ArithmeticAdd = 0x01,
+    ArithmeticOr = 0x09,
+    ArithmeticAnd = 0x21,
+    ArithmeticSub = 0x29,
+    ArithmeticXor = 0x31,
+    ArithmeticCmp = 0x39,
+    ArithmeticTest = 0x85,
+    // register to register move shares the encoding (not usable with arithImm)
+    ArithmeticMove = 0x89
+};
+
+// minimal x64 encoder shared by JITCompiler and RegExpJITCompiler.
+// memory operands are always encoded as [base + disp32] or [base + index * scale + disp32]
+class X64Assembler {
+public:
+    size_t offset()
+    {
+        return m_buffer.size();
+    }
+
+    std::vector<uint8_t>& buffer()
+    {
+        return m_buffer;
+    }
+
+    void push(X64Register r)
+    {
+        rexIfNeeded(false, 0, 0, r);
+        emit8(0x50 + (r & 7));
+    }
+
+    void pop(X64Register r)
+    {
+        rexIfNeeded(false, 0, 0, r);
+        emit8(0x58 + (r & 7));
+    }
+
+    void ret()
+    {
+        emit8(0xC3);
+    }
+
+    void movImm(X64Register dst, uint64_t imm)
+    {
+        rexIfNeeded(imm > UINT32_MAX, 0, 0, dst);
+        emit8(0xB8 + (dst & 7));
+        if (imm > UINT32_MAX) {
+            emit64(imm);
+        } else {
+            // zero extended to 64 bits
+            emit32((uint32_t)imm);
+        }
+    }
+
+    void mov(X64Register dst, X64Register src)
+    {
+        arith(ArithmeticMove, dst, src);
+    }
+
+    void mov32(X64Register dst, X64Register src)
+    {
+        arith32(ArithmeticMove, dst, src);
+    }
+
+    void load(X64Register dst, X64Register base, int32_t disp)
+    {
+        rexIfNeeded(true, dst, 0, base);
+        emit8(0x8B);
+        memoryOperand(dst, base, disp);
+    }
+
+    void store(X64Register base, int32_t disp, X64Register src)
+    {
+        rexIfNeeded(true, src, 0, base);
+        emit8(0x89);
+        memoryOperand(src, base, disp);
+    }
+
+    void loadIndexed(X64Register dst, X64Register base, X64Register index)
+    {
+        rexIfNeeded(true, dst, index, base);
+        emit8(0x8B);
+        indexedMemoryOperand(dst, base, index);
+    }
+
+    void storeIndexed(X64Register base, X64Register index, X64Register src)
+    {
+        rexIfNeeded(true, src, index, base);
+        emit8(0x89);
+        indexedMemoryOperand(src, base, index);
+    }
+
+    void store32(X64Register base, int32_t disp, X64Register src)
+    {
+        rexIfNeeded(false, src, 0, base);
+        emit8(0x89);
+        memoryOperand(src, base, disp);
+    }
+
+    // movzx dst, byte [base + index + disp]
+    void loadZeroExtended8(X64Register dst, X64Register base, X64Register index, int32_t disp)
+    {
+        rexIfNeeded(false, dst, index, base);
+        emit8(0x0F);
+        emit8(0xB6);
+        scaledIndexedMemoryOperand(dst, base, index, 0, disp);
+    }
+
+    // movzx dst, word [base + index * 2 + disp]
+    void loadZeroExtended16(X64Register dst, X64Register base, X64Register index, int32_t disp)
+    {
+        rexIfNeeded(false, dst, index, base);
+        emit8(0x0F);
+        emit8(0xB7);
+        scaledIndexedMemoryOperand(dst, base, index, 1, disp);
+    }
+
+    // lea dst, [rip + rel32]. returns offset of rel32 to be linked later like a jump
+    size_t loadRelativeAddress(X64Register dst)
+    {
+        rexIfNeeded(true, dst, 0, 0);
+        emit8(0x8D);
+        emit8(0x05 | ((dst & 7) << 3));
+        emit32(0);
+        return offset() - 4;
+    }
+
+    // cmp r, [base + disp]
+    void compareMemory(X64Register r, X64Register base, int32_t disp)
+    {
+        rexIfNeeded(true, r, 0, base);
+        emit8(0x3B);
+        memoryOperand(r, base, disp);
+    }
+
+    // op dst, src
+    void arith(X64ArithmeticOperation op, X64Register dst, X64Register src)
+    {
+        rexIfNeeded(true, src, 0, dst);
+        emit8(op);
+        emit8(0xC0 | ((src & 7) << 3) | (dst & 7));
+    }
+
+    void arith32(X64ArithmeticOperation op, X64Register dst, X64Register src)
+    {
+        rexIfNeeded(false, src, 0, dst);
+        emit8(op);
+        emit8(0xC0 | ((src & 7) << 3) | (dst & 7));
+    }
+
+    // op dst, imm32 (sign extended)
+    void arithImm(X64ArithmeticOperation op, X64Register dst, int32_t imm)
+    {
+        rexIfNeeded(true, 0, 0, dst);
+        arithImmBody(op, dst, imm);
+    }
+
+    void arithImm32(X64ArithmeticOperation op, X64Register dst, int32_t imm)
+    {
+        rexIfNeeded(false, 0, 0, dst);
+        arithImmBody(op, dst, imm);
+    }
+
+    // test r, imm32 (sign extended)
+    void testImm(X64Register r, int32_t imm)
+    {
+        rexIfNeeded(true, 0, 0, r);
+        emit8(0xF7);
+        emit8(0xC0 | (r & 7));
+        emit32(imm);
+    }
+
+    void sar1(X64Register r)
+    {
+        rexIfNeeded(true, 0, 0, r);
+        emit8(0xD1);
+        emit8(0xC0 | (7 << 3) | (r & 7));
+    }
+
+    void sarImm(X64Register r, uint8_t imm)
+    {
+        rexIfNeeded(true, 0, 0, r);
+        emit8(0xC1);
+        emit8(0xC0 | (7 << 3) | (r & 7));
+        emit8(imm);
+    }
+
+    void imul32(X64Register dst, X64Register src)
+    {
+        rexIfNeeded(false, dst, 0, src);
+        emit8(0x0F);
+        emit8(0xAF);
+        emit8(0xC0 | ((dst & 7) << 3) | (src & 7));
+    }
+
+    void movsxd(X64Register dst, X64Register src)
+    {
+        rexIfNeeded(true, dst, 0, src);
+        emit8(0x63);
+        emit8(0xC0 | ((dst & 7) << 3) | (src & 7));
+    }
+
+    // setcc and movzx only use al, cl, dl, bl, which need no REX prefix
+    void setcc(X64Condition cond, X64Register r)
+    {
+        ASSERT(r < RSP);
+        emit8(0x0F);
+        emit8(0x90 + cond);
+        emit8(0xC0 | (r & 7));
+    }
+
+    void movzx8(X64Register dst, X64Register src)
+    {
+        ASSERT(src < RSP);
+        rexIfNeeded(false, dst, 0, 0);
+        emit8(0x0F);
+        emit8(0xB6);
+        emit8(0xC0 | ((dst & 7) << 3) | (src & 7));
+    }
+
+    void call(X64Register r)
+    {
+        rexIfNeeded(false, 0, 0, r);
+        emit8(0xFF);
+        emit8(0xC0 | (2 << 3) | (r & 7));
+    }
+
+    void jump(X64Register r)
+    {
+        rexIfNeeded(false, 0, 0, r);
+        emit8(0xFF);
+        emit8(0xC0 | (4 << 3) | (r & 7));
+    }
+
+    // jmp rel32 and jcc rel32. return offset of rel32 to be linked later
+    size_t jump()
+    {
+        emit8(0xE9);
+        emit32(0);
+        return offset() - 4;
+    }
+
+    size_t jumpIf(X64Condition cond)
+    {
+        emit8(0x0F);
+        emit8(0x80 + cond);
+        emit32(0);
+        return offset() - 4;
+    }
+
+    void link(size_t jumpOffset, size_t target)
+    {
+        int32_t rel = (int32_t)((int64_t)target - (int64_t)(jumpOffset + 4));
+        memcpy(&m_buffer[jumpOffset], &rel, sizeof(rel));
+    }
+
+    void linkToHere(size_t jumpOffset)
+    {
+        link(jumpOffset, offset());
+    }
+
+    // data referenced by loadRelativeAddress, placed after the code
+    void emitData(const uint8_t* data, size_t size)
+    {
+        m_buffer.insert(m_buffer.end(), data, data + size);
+    }
+
+private:
+    void emit8(uint8_t v)
+    {
+        m_buffer.push_back(v);
+    }
+
+    void emit32(uint32_t v)
+    {
+        for (size_t i = 0; i < 4; i++) {
+            emit8((uint8_t)(v >> (i * 8)));
+        }
+    }
+
+    void emit64(uint64_t v)
+    {
+        for (size_t i = 0; i < 8; i++) {
+            emit8((uint8_t)(v >> (i * 8)));
+        }
+    }
+
+    void rexIfNeeded(bool wide, int reg, int index, int base)
+    {
+        uint8_t rex = 0x40 | (wide ? 8 : 0) | (((reg >> 3) & 1) << 2) | (((index >> 3) & 1) << 1) | ((base >> 3) & 1);
+        if (rex != 0x40) {
+            emit8(rex);
+        }
+    }
+
+    void memoryOperand(int reg, X64Register base, int32_t disp)
+    {
+        emit8(0x80 | ((reg & 7) << 3) | (base & 7));
+        if ((base & 7) == RSP) {
+            // rsp and r12 need SIB byte
+            emit8(0x24);
+        }
+        emit32(disp);
+    }
+
+    void indexedMemoryOperand(int reg, X64Register base, X64Register index)
+    {
+        ASSERT(index != RSP);
+        emit8(0x84 | ((reg & 7) << 3));
+        emit8(0xC0 | ((index & 7) << 3) | (base & 7));
+        emit32(0);
+    }
+
+    void scaledIndexedMemoryOperand(int reg, X64Register base, X64Register index, int scale, int32_t disp)
+    {
+        ASSERT(index != RSP);
+        emit8(0x84 | ((reg & 7) << 3));
+        emit8((scale << 6) | ((index & 7) << 3) | (base & 7));
+        emit32(disp);
+    }
+
+    void arithImmBody(X64ArithmeticOperation op, X64Register dst, int32_t imm)
+    {
+        int ext;
+        switch (op) {
+        case ArithmeticAdd:
+            ext = 0;
+            break;
+        case ArithmeticOr:
+            ext = 1;
+            break;
+        case ArithmeticAnd:
+            ext = 4;
+            break;
+        case ArithmeticSub:
+            ext = 5;
+            break;
+        case ArithmeticXor:
+            ext = 6;
+            break;
+        default:
+            ASSERT(op == ArithmeticCmp);
+            ext = 7;
+            break;
+        }
+        if (imm >= -128 && imm <= 127) {
+            emit8(0x83);
+            emit8(0xC0 | (ext << 3) | (dst & 7));
+            emit8((uint8_t)imm);
+        } else {
+            emit8(0x81);
+            emit8(0xC0 | (ext << 3) | (dst & 7));
+            emit32(imm);
+        }
+    }
+
+    std::vector<uint8_t> m_buffer;
+};
+}
+
+#endif
+
+#endif
@@ -218,6 +218,10 @@ InterpretedCodeBlock::InterpretedCodeBlock(Context* ctx, Script* script, StringV
     m_script = script;
     m_src = src;
     m_byteCodeBlock = nullptr;
+    m_byteCodeBlockLastUsedEpoch = 0;
+    m_byteCodeBlockGeneration = 0;
+    m_isByteCodeBlockEvicted = false;
+    m_constructedObjectPropertyCount = 0;
 
     m_parameterCount = 0;
     m_isConstructor = false;
@@ -287,6 +291,30 @@ InterpretedCodeBlock::InterpretedCodeBlock(Context* ctx, Script* script, StringV
     m_isFunctionNameExplicitlyDeclared = m_isFunctionNameSaveOnHeap = false;
 }
 
+InterpretedCodeBlock::InterpretedCodeBlock(Context* ctx, Script* script, InterpretedCodeBlock* parentBlock)
+    : m_sourceElementStart(1, 1, 0)
+    , m_identifierOnStackCount(0)
+    , m_identifierOnHeapCount(0)
+    , m_parentCodeBlock(parentBlock)
+#ifndef NDEBUG
+    , m_locStart(SIZE_MAX, SIZE_MAX, SIZE_MAX)
+    , m_locEnd(SIZE_MAX, SIZE_MAX, SIZE_MAX)
+    , m_scopeContext(nullptr)
+#endif
+{
+    m_context = ctx;
+    m_script = script;
+    m_byteCodeBlock = nullptr;
+    m_byteCodeBlockLastUsedEpoch = 0;
+    m_byteCodeBlockGeneration = 0;
+    m_isByteCodeBlockEvicted = false;
+    m_constructedObjectPropertyCount = 0;
+
+    m_parameterCount = 0;
+    m_hasCallNativeFunctionCode = false;
+    m_isBindedFunction = false;
+}
+
 InterpretedCodeBlock::InterpretedCodeBlock(Context* ctx, Script* script, StringView src, ExtendedNodeLOC sourceElementStart, bool isStrict, AtomicString functionName, const AtomicStringTightVector& parameterNames, const ASTScopeContextNameInfoVector& innerIdentifiers,
                                            InterpretedCodeBlock* parentBlock, CodeBlockInitFlag initFlags)
     : m_sourceElementStart(sourceElementStart)
@@ -303,6 +331,10 @@ InterpretedCodeBlock::InterpretedCodeBlock(Context* ctx, Script* script, StringV
     m_script = script;
     m_src = src;
     m_byteCodeBlock = nullptr;
+    m_byteCodeBlockLastUsedEpoch = 0;
+    m_byteCodeBlockGeneration = 0;
+    m_isByteCodeBlockEvicted = false;
+    m_constructedObjectPropertyCount = 0;
 
     m_functionName = functionName;
     m_parametersInfomation.resizeWithUninitializedValues(parameterNames.size());
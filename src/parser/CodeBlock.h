@@ -89,6 +89,8 @@ class CodeBlock : public gc {
     friend class ByteCodeGenerator;
     friend class FunctionObject;
     friend class InterpretedCodeBlock;
+    friend class CodeCacheSerializer;
+    friend class CodeCacheDeserializer;
     friend int getValidValueInCodeBlock(void* ptr, GC_mark_custom_result* arr);
 
 public:
@@ -342,6 +344,8 @@ class InterpretedCodeBlock : public CodeBlock {
     friend class ByteCodeGenerator;
     friend class FunctionObject;
     friend class ByteCodeInterpreter;
+    friend class CodeCacheSerializer;
+    friend class CodeCacheDeserializer;
 
     friend int getValidValueInInterpretedCodeBlock(void* ptr, GC_mark_custom_result* arr);
 
@@ -582,6 +586,8 @@ protected:
     InterpretedCodeBlock(Context* ctx, Script* script, StringView src, bool isStrict, ExtendedNodeLOC sourceElementStart, const ASTScopeContextNameInfoVector& innerIdentifiers, CodeBlockInitFlag initFlags);
     // init function codeBlock
     InterpretedCodeBlock(Context* ctx, Script* script, StringView src, ExtendedNodeLOC sourceElementStart, bool isStrict, AtomicString functionName, const AtomicStringTightVector& parameterNames, const ASTScopeContextNameInfoVector& innerIdentifiers, InterpretedCodeBlock* parentBlock, CodeBlockInitFlag initFlags);
+    // init codeBlock restored from CodeCache. the cache fills every other field
+    InterpretedCodeBlock(Context* ctx, Script* script, InterpretedCodeBlock* parentBlock);
 
     Script* m_script;
     StringView m_src; // function source elements src
@@ -595,6 +601,15 @@ protected:
     InterpretedCodeBlock* m_parentCodeBlock;
     CodeBlockVector m_childBlocks;
 
+    // VMInstance::byteCodeBlockEpoch() of the last call. cold ByteCodeBlocks are evicted first
+    size_t m_byteCodeBlockLastUsedEpoch;
+    // counts ByteCodeBlocks generated for this function. a new one may be allocated where an evicted one was
+    uint32_t m_byteCodeBlockGeneration;
+    bool m_isByteCodeBlockEvicted;
+
+    // slack tracking of the constructor. the most properties an object constructed by this function got so far
+    uint16_t m_constructedObjectPropertyCount;
+
 #ifndef NDEBUG
     ExtendedNodeLOC m_locStart;
     ExtendedNodeLOC m_locEnd;
@@ -0,0 +1,1003 @@
+/*
+ * Copyright (c) 2018-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#include "Escargot.h"
+#include "CodeCache.h"
+#include "parser/CodeBlock.h"
+#include "parser/Script.h"
+#include "interpreter/ByteCode.h"
+#include "interpreter/ByteCodeGenerator.h"
+#include "runtime/Context.h"
+
+namespace Escargot {
+
+#define FOR_EACH_CODE_CACHE_CODE_BLOCK_FLAG(F) \
+    F(m_isConstructor)                          \
+    F(m_isStrict)                               \
+    F(m_isFunctionNameSaveOnHeap)               \
+    F(m_isFunctionNameExplicitlyDeclared)       \
+    F(m_canUseIndexedVariableStorage)           \
+    F(m_canAllocateEnvironmentOnStack)          \
+    F(m_needsComplexParameterCopy)              \
+    F(m_hasEval)                                \
+    F(m_hasWith)                                \
+    F(m_hasCatch)                               \
+    F(m_hasYield)                               \
+    F(m_inCatch)                                \
+    F(m_inWith)                                 \
+    F(m_usesArgumentsObject)                    \
+    F(m_isFunctionExpression)                   \
+    F(m_isFunctionDeclaration)                  \
+    F(m_isFunctionDeclarationWithSpecialBinding) \
+    F(m_isArrowFunctionExpression)              \
+    F(m_isInWithScope)                          \
+    F(m_isEvalCodeInFunction)                   \
+    F(m_needsVirtualIDOperation)                \
+    F(m_needToLoadThisValue)
+
+enum CodeCacheRecordKind : uint8_t {
+    CodeCacheRecordControlFlow,
+    CodeCacheRecordErrorMessage,
+};
+
+enum CodeCacheValueKind : uint8_t {
+    CodeCacheValueEmpty,
+    CodeCacheValueUndefined,
+    CodeCacheValueNull,
+    CodeCacheValueTrue,
+    CodeCacheValueFalse,
+    CodeCacheValueNumber,
+    CodeCacheValueString,
+};
+
+// String::hashValue is not guaranteed to be stable between builds, so the source key uses FNV-1a
+static uint64_t codeCacheSourceHash(String* source)
+{
+    const auto& data = source->bufferAccessData();
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < data.length; i++) {
+        hash ^= data.charAt(i);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// detects a corrupted string table or body. the body is trusted once this matches
+static uint64_t codeCacheChecksum(const uint8_t* data, size_t length)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= data[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// changes whenever the layout of a ByteCode changes, so caches of other builds are rejected
+static uint64_t codeCacheBuildFingerprint()
+{
+    uint64_t hash = ESCARGOT_CODE_CACHE_VERSION;
+#define HASH_BYTECODE_SIZE(name, pushCount, popCount) \
+    hash = hash * 31 + sizeof(name);
+    FOR_EACH_BYTECODE_OP(HASH_BYTECODE_SIZE)
+#undef HASH_BYTECODE_SIZE
+    hash = hash * 31 + OpcodeKindEnd;
+    hash = hash * 31 + sizeof(size_t);
+#ifndef NDEBUG
+    hash = hash * 31 + 1;
+#endif
+    return hash;
+}
+
+// opcode of ByteCode which is not relocated yet (see ByteCodeGenerator::relocateByteCode)
+static Opcode unrelocatedOpcode(ByteCode* code)
+{
+#if defined(COMPILER_GCC)
+    return (Opcode)(size_t)code->m_opcodeInAddress;
+#else
+    return code->m_opcode;
+#endif
+}
+
+template <typename T>
+static void storeIndex(T& field, size_t index)
+{
+    COMPILE_ASSERT(sizeof(T) >= sizeof(size_t), "");
+    memset((void*)&field, 0, sizeof(T));
+    memcpy((void*)&field, &index, sizeof(size_t));
+}
+
+template <typename T>
+static size_t loadIndex(const T& field)
+{
+    COMPILE_ASSERT(sizeof(T) >= sizeof(size_t), "");
+    size_t index;
+    memcpy(&index, (const void*)&field, sizeof(size_t));
+    return index;
+}
+
+class CodeCacheWriter {
+public:
+    CodeCacheWriter(CodeCacheData& buffer)
+        : m_buffer(buffer)
+    {
+    }
+
+    template <typename T>
+    void put(const T& value)
+    {
+        const uint8_t* p = (const uint8_t*)&value;
+        m_buffer.insert(m_buffer.end(), p, p + sizeof(T));
+    }
+
+    void putBytes(const void* data, size_t length)
+    {
+        const uint8_t* p = (const uint8_t*)data;
+        m_buffer.insert(m_buffer.end(), p, p + length);
+    }
+
+private:
+    CodeCacheData& m_buffer;
+};
+
+class CodeCacheReader {
+public:
+    CodeCacheReader(const uint8_t* data, size_t length)
+        : m_cursor(data)
+        , m_end(data + length)
+        , m_failed(false)
+    {
+    }
+
+    template <typename T>
+    T get()
+    {
+        T value;
+        if (UNLIKELY((size_t)(m_end - m_cursor) < sizeof(T))) {
+            m_failed = true;
+            memset(&value, 0, sizeof(T));
+            return value;
+        }
+        memcpy(&value, m_cursor, sizeof(T));
+        m_cursor += sizeof(T);
+        return value;
+    }
+
+    const uint8_t* getBytes(size_t length)
+    {
+        if (UNLIKELY((size_t)(m_end - m_cursor) < length)) {
+            m_failed = true;
+            return nullptr;
+        }
+        const uint8_t* ret = m_cursor;
+        m_cursor += length;
+        return ret;
+    }
+
+    // counts are checked against the remaining data before anything is allocated for them
+    size_t getCount(size_t minimumItemSize)
+    {
+        uint64_t count = get<uint64_t>();
+        if (UNLIKELY(count > (uint64_t)(m_end - m_cursor) / minimumItemSize)) {
+            m_failed = true;
+            return 0;
+        }
+        return count;
+    }
+
+    bool failed() const
+    {
+        return m_failed;
+    }
+
+    void fail()
+    {
+        m_failed = true;
+    }
+
+    bool atEnd() const
+    {
+        return m_cursor == m_end;
+    }
+
+private:
+    const uint8_t* m_cursor;
+    const uint8_t* m_end;
+    bool m_failed;
+};
+
+class CodeCacheSerializer {
+public:
+    CodeCacheSerializer(CodeCacheData& body)
+        : m_body(body)
+    {
+    }
+
+    size_t stringIndex(String* str)
+    {
+        auto iter = m_stringIndexes.find(str);
+        if (iter != m_stringIndexes.end()) {
+            return iter->second;
+        }
+        size_t idx = m_strings.size();
+        m_strings.push_back(str);
+        m_stringIndexes.insert(std::make_pair(str, idx));
+        return idx;
+    }
+
+    void writeStringTable(CodeCacheWriter& writer)
+    {
+        writer.put<uint64_t>(m_strings.size());
+        for (size_t i = 0; i < m_strings.size(); i++) {
+            const auto& data = m_strings[i]->bufferAccessData();
+            writer.put<uint8_t>(data.has8BitContent);
+            writer.put<uint64_t>(data.length);
+            writer.putBytes(data.buffer, data.length * (data.has8BitContent ? sizeof(LChar) : sizeof(char16_t)));
+        }
+    }
+
+    void writeCodeBlock(InterpretedCodeBlock* cb)
+    {
+        CodeCacheWriter writer(m_body);
+        m_codeBlockIndexes.insert(std::make_pair(cb, m_codeBlockIndexes.size()));
+
+        uint32_t flags = 0;
+        uint32_t bit = 0;
+#define WRITE_FLAG(name)      \
+    if (cb->name) {           \
+        flags |= (1u << bit); \
+    }                         \
+    bit++;
+        FOR_EACH_CODE_CACHE_CODE_BLOCK_FLAG(WRITE_FLAG)
+#undef WRITE_FLAG
+        writer.put<uint32_t>(flags);
+        writer.put<uint16_t>(cb->m_parameterCount);
+        writer.put<uint64_t>(stringIndex(cb->m_functionName.string()));
+        writer.put<uint64_t>(cb->m_src.start());
+        writer.put<uint64_t>(cb->m_src.end());
+        writer.put<uint64_t>(cb->m_sourceElementStart.line);
+        writer.put<uint64_t>(cb->m_sourceElementStart.column);
+        writer.put<uint64_t>(cb->m_sourceElementStart.index);
+
+        writer.put<uint64_t>(cb->m_parametersInfomation.size());
+        for (size_t i = 0; i < cb->m_parametersInfomation.size(); i++) {
+            const InterpretedCodeBlock::FunctionParametersInfo& info = cb->m_parametersInfomation[i];
+            writer.put<uint8_t>(info.m_isHeapAllocated);
+            writer.put<uint8_t>(info.m_isDuplicated);
+            writer.put<int32_t>(info.m_index);
+            writer.put<uint64_t>(stringIndex(info.m_name.string()));
+        }
+
+        writer.put<uint16_t>(cb->m_identifierOnStackCount);
+        writer.put<uint16_t>(cb->m_identifierOnHeapCount);
+        writer.put<uint64_t>(cb->m_identifierInfos.size());
+        for (size_t i = 0; i < cb->m_identifierInfos.size(); i++) {
+            const CodeBlock::IdentifierInfo& info = cb->m_identifierInfos[i];
+            writer.put<uint8_t>(info.m_needToAllocateOnStack);
+            writer.put<uint8_t>(info.m_isMutable);
+            writer.put<uint8_t>(info.m_isExplicitlyDeclaredOrParameterName);
+            writer.put<uint64_t>(info.m_indexForIndexedStorage);
+            writer.put<uint64_t>(stringIndex(info.m_name.string()));
+        }
+
+        writer.put<uint64_t>(cb->m_childBlocks.size());
+        for (size_t i = 0; i < cb->m_childBlocks.size(); i++) {
+            writeCodeBlock(cb->m_childBlocks[i]);
+        }
+    }
+
+    bool writeByteCodeBlock(ByteCodeBlock* block)
+    {
+        CodeCacheWriter writer(m_body);
+        writer.put<uint8_t>(block->m_isEvalMode);
+        writer.put<uint8_t>(block->m_isOnGlobal);
+        writer.put<uint8_t>(block->m_shouldClearStack);
+        writer.put<uint32_t>(block->m_requiredRegisterFileSizeInValueSize);
+
+        writer.put<uint64_t>(block->m_numeralLiteralData.size());
+        for (size_t i = 0; i < block->m_numeralLiteralData.size(); i++) {
+            writer.put<double>(block->m_numeralLiteralData[i].asNumber());
+        }
+
+        // operands are rewritten on a copy; the tables they refer to are written before the code
+        CodeCacheData code(block->m_code.data(), block->m_code.data() + block->m_code.size());
+        size_t valueCount = 0;
+        CodeCacheData values;
+        CodeCacheWriter valueWriter(values);
+        size_t recordCount = 0;
+        CodeCacheData records;
+        CodeCacheWriter recordWriter(records);
+
+        size_t idx = 0;
+        while (idx < code.size()) {
+            ByteCode* currentCode = (ByteCode*)&code[idx];
+            Opcode opcode = unrelocatedOpcode(currentCode);
+            size_t size = byteCodeSize(opcode);
+            if (!size || idx + size > code.size()) {
+                return false;
+            }
+
+            switch (opcode) {
+            case LoadLiteralOpcode: {
+                LoadLiteral* cd = (LoadLiteral*)currentCode;
+                Value v = cd->m_value;
+                if (v.isEmpty()) {
+                    valueWriter.put<uint8_t>(CodeCacheValueEmpty);
+                } else if (v.isUndefined()) {
+                    valueWriter.put<uint8_t>(CodeCacheValueUndefined);
+                } else if (v.isNull()) {
+                    valueWriter.put<uint8_t>(CodeCacheValueNull);
+                } else if (v.isBoolean()) {
+                    valueWriter.put<uint8_t>(v.asBoolean() ? CodeCacheValueTrue : CodeCacheValueFalse);
+                } else if (v.isNumber()) {
+                    valueWriter.put<uint8_t>(CodeCacheValueNumber);
+                    valueWriter.put<double>(v.asNumber());
+                } else if (v.isString()) {
+                    valueWriter.put<uint8_t>(CodeCacheValueString);
+                    valueWriter.put<uint64_t>(stringIndex(v.asString()));
+                } else {
+                    return false;
+                }
+                storeIndex(cd->m_value, valueCount++);
+                break;
+            }
+            case LoadByNameOpcode:
+                storeAtomicString(((LoadByName*)currentCode)->m_name);
+                break;
+            case StoreByNameOpcode:
+                storeAtomicString(((StoreByName*)currentCode)->m_name);
+                break;
+            case ObjectDefineOwnPropertyWithNameOperationOpcode:
+                storeAtomicString(((ObjectDefineOwnPropertyWithNameOperation*)currentCode)->m_propertyName);
+                break;
+            case UnaryTypeofOpcode:
+                storeAtomicString(((UnaryTypeof*)currentCode)->m_id);
+                break;
+            case UnaryDeleteOpcode:
+                storeAtomicString(((UnaryDelete*)currentCode)->m_id);
+                break;
+            case CallFunctionInWithScopeOpcode:
+                storeAtomicString(((CallFunctionInWithScope*)currentCode)->m_calleeName);
+                break;
+            case TryOperationOpcode:
+                storeAtomicString(((TryOperation*)currentCode)->m_catchVariableName);
+                break;
+            case GetObjectPreComputedCaseOpcode:
+                if (!storePropertyName(((GetObjectPreComputedCase*)currentCode)->m_propertyName)) {
+                    return false;
+                }
+                break;
+            case SetObjectPreComputedCaseOpcode:
+                if (!storePropertyName(((SetObjectPreComputedCase*)currentCode)->m_propertyName)) {
+                    return false;
+                }
+                ((SetObjectPreComputedCase*)currentCode)->m_inlineCache = nullptr;
+                break;
+            case GetGlobalObjectOpcode:
+                if (!storePropertyName(((GetGlobalObject*)currentCode)->m_propertyName)) {
+                    return false;
+                }
+                break;
+            case SetGlobalObjectOpcode:
+                if (!storePropertyName(((SetGlobalObject*)currentCode)->m_propertyName)) {
+                    return false;
+                }
+                break;
+            case CreateFunctionOpcode: {
+                CreateFunction* cd = (CreateFunction*)currentCode;
+                if (!cd->m_codeBlock->isInterpretedCodeBlock() || !storeCodeBlock(cd->m_codeBlock, cd->m_codeBlock->asInterpretedCodeBlock())) {
+                    return false;
+                }
+                break;
+            }
+            case DeclareFunctionDeclarationsOpcode: {
+                DeclareFunctionDeclarations* cd = (DeclareFunctionDeclarations*)currentCode;
+                if (!storeCodeBlock(cd->m_codeBlock, cd->m_codeBlock)) {
+                    return false;
+                }
+                break;
+            }
+            case TemplateOperationOpcode:
+                storeIndex(((TemplateOperation*)currentCode)->m_quasi, stringIndex(((TemplateOperation*)currentCode)->m_quasi));
+                break;
+            case LoadRegexpOpcode: {
+                LoadRegexp* cd = (LoadRegexp*)currentCode;
+                storeIndex(cd->m_body, stringIndex(cd->m_body));
+                storeIndex(cd->m_option, stringIndex(cd->m_option));
+                break;
+            }
+            case JumpComplexCaseOpcode: {
+                JumpComplexCase* cd = (JumpComplexCase*)currentCode;
+                ControlFlowRecord* record = cd->m_controlFlowRecord;
+                // only jumps are decided at generation time
+                if (record->reason() != ControlFlowRecord::NeedsJump) {
+                    return false;
+                }
+                recordWriter.put<uint8_t>(CodeCacheRecordControlFlow);
+                recordWriter.put<uint64_t>(record->wordValue());
+                recordWriter.put<uint64_t>(record->count());
+                recordWriter.put<uint64_t>(record->outerLimitCount());
+                storeIndex(cd->m_controlFlowRecord, recordCount++);
+                break;
+            }
+            case ThrowStaticErrorOperationOpcode: {
+                ThrowStaticErrorOperation* cd = (ThrowStaticErrorOperation*)currentCode;
+                size_t length = strlen(cd->m_errorMessage);
+                recordWriter.put<uint8_t>(CodeCacheRecordErrorMessage);
+                recordWriter.put<uint64_t>(length);
+                recordWriter.putBytes(cd->m_errorMessage, length);
+                storeIndex(cd->m_errorMessage, recordCount++);
+                break;
+            }
+            default:
+                break;
+            }
+
+            idx += size;
+        }
+
+        writer.put<uint64_t>(valueCount);
+        writer.putBytes(values.data(), values.size());
+        writer.put<uint64_t>(recordCount);
+        writer.putBytes(records.data(), records.size());
+        writer.put<uint64_t>(code.size());
+        writer.putBytes(code.data(), code.size());
+        return true;
+    }
+
+private:
+    void storeAtomicString(AtomicString& field)
+    {
+        storeIndex(field, stringIndex(field.string()));
+    }
+
+    bool storePropertyName(PropertyName& field)
+    {
+        if (!field.hasAtomicString()) {
+            return false;
+        }
+        storeIndex(field, stringIndex(field.plainString()));
+        return true;
+    }
+
+    template <typename T>
+    bool storeCodeBlock(T& field, InterpretedCodeBlock* cb)
+    {
+        auto iter = m_codeBlockIndexes.find(cb);
+        if (iter == m_codeBlockIndexes.end()) {
+            return false;
+        }
+        storeIndex(field, iter->second);
+        return true;
+    }
+
+    CodeCacheData& m_body;
+    std::vector<String*> m_strings;
+    std::unordered_map<String*, size_t> m_stringIndexes;
+    std::unordered_map<InterpretedCodeBlock*, size_t> m_codeBlockIndexes;
+};
+
+bool CodeCache::serialize(Context* context, String* source, bool strictFromOutside, InterpretedCodeBlock* topCodeBlock, ByteCodeBlock* byteCodeBlock, CodeCacheData& result)
+{
+    CodeCacheData body;
+    CodeCacheSerializer serializer(body);
+    serializer.writeCodeBlock(topCodeBlock);
+    if (!serializer.writeByteCodeBlock(byteCodeBlock)) {
+        return false;
+    }
+
+    result.clear();
+    CodeCacheWriter writer(result);
+    writer.put<uint32_t>(ESCARGOT_CODE_CACHE_MAGIC);
+    writer.put<uint64_t>(codeCacheBuildFingerprint());
+    writer.put<uint64_t>(source->length());
+    writer.put<uint64_t>(codeCacheSourceHash(source));
+    writer.put<uint8_t>(strictFromOutside);
+
+    CodeCacheData payload;
+    CodeCacheWriter payloadWriter(payload);
+    serializer.writeStringTable(payloadWriter);
+    payloadWriter.putBytes(body.data(), body.size());
+    writer.put<uint64_t>(payload.size());
+    writer.put<uint64_t>(codeCacheChecksum(payload.data(), payload.size()));
+    writer.putBytes(payload.data(), payload.size());
+    return true;
+}
+
+class CodeCacheDeserializer {
+public:
+    CodeCacheDeserializer(Context* context, String* source, CodeCacheReader& reader)
+        : m_context(context)
+        , m_source(source)
+        , m_script(nullptr)
+        , m_reader(reader)
+    {
+    }
+
+    Script* readScript(String* fileName)
+    {
+        m_script = new Script(fileName, new StringView(m_source, 0, m_source->length()));
+        if (!readStringTable()) {
+            return nullptr;
+        }
+
+        InterpretedCodeBlock* topCodeBlock = readCodeBlock(nullptr);
+        if (!topCodeBlock) {
+            return nullptr;
+        }
+
+        ByteCodeBlock* byteCodeBlock = readByteCodeBlock(topCodeBlock);
+        if (!byteCodeBlock || !m_reader.atEnd()) {
+            return nullptr;
+        }
+
+        m_script->m_topCodeBlock = topCodeBlock;
+        m_script->m_byteCodeBlockFromCodeCache = byteCodeBlock;
+        return m_script;
+    }
+
+    bool readStringTable()
+    {
+        size_t count = m_reader.getCount(sizeof(uint8_t) + sizeof(uint64_t));
+        m_strings.resize(count);
+        m_atomicStrings.resize(count);
+        for (size_t i = 0; i < count; i++) {
+            bool is8Bit = m_reader.get<uint8_t>();
+            uint64_t length = m_reader.get<uint64_t>();
+            if (m_reader.failed() || length > SIZE_MAX / sizeof(char16_t)) {
+                return false;
+            }
+            const uint8_t* data = m_reader.getBytes(length * (is8Bit ? sizeof(LChar) : sizeof(char16_t)));
+            if (!data) {
+                return false;
+            }
+            if (!length) {
+                m_strings[i] = String::emptyString;
+            } else if (is8Bit) {
+                m_strings[i] = new Latin1String((const LChar*)data, length);
+            } else {
+                m_strings[i] = new UTF16String((const char16_t*)data, length);
+            }
+            m_atomicStrings[i] = nullptr;
+        }
+        return !m_reader.failed();
+    }
+
+    InterpretedCodeBlock* readCodeBlock(InterpretedCodeBlock* parent)
+    {
+        InterpretedCodeBlock* cb = new InterpretedCodeBlock(m_context, m_script, parent);
+        m_codeBlocks.push_back(cb);
+
+        uint32_t flags = m_reader.get<uint32_t>();
+        uint32_t bit = 0;
+#define READ_FLAG(name)                   \
+    cb->name = (flags & (1u << bit)) != 0; \
+    bit++;
+        FOR_EACH_CODE_CACHE_CODE_BLOCK_FLAG(READ_FLAG)
+#undef READ_FLAG
+        cb->m_parameterCount = m_reader.get<uint16_t>();
+        cb->m_functionName = atomicString(m_reader.get<uint64_t>());
+        uint64_t srcStart = m_reader.get<uint64_t>();
+        uint64_t srcEnd = m_reader.get<uint64_t>();
+        if (m_reader.failed() || srcStart > srcEnd || srcEnd > m_source->length()) {
+            return nullptr;
+        }
+        cb->m_src = StringView(m_source, srcStart, srcEnd);
+        cb->m_sourceElementStart.line = m_reader.get<uint64_t>();
+        cb->m_sourceElementStart.column = m_reader.get<uint64_t>();
+        cb->m_sourceElementStart.index = m_reader.get<uint64_t>();
+
+        size_t parameterCount = m_reader.getCount(2 * sizeof(uint8_t) + sizeof(int32_t) + sizeof(uint64_t));
+        cb->m_parametersInfomation.resizeWithUninitializedValues(parameterCount);
+        for (size_t i = 0; i < parameterCount; i++) {
+            InterpretedCodeBlock::FunctionParametersInfo& info = cb->m_parametersInfomation[i];
+            info.m_isHeapAllocated = m_reader.get<uint8_t>();
+            info.m_isDuplicated = m_reader.get<uint8_t>();
+            info.m_index = m_reader.get<int32_t>();
+            info.m_name = atomicString(m_reader.get<uint64_t>());
+        }
+
+        cb->m_identifierOnStackCount = m_reader.get<uint16_t>();
+        cb->m_identifierOnHeapCount = m_reader.get<uint16_t>();
+        size_t identifierCount = m_reader.getCount(3 * sizeof(uint8_t) + 2 * sizeof(uint64_t));
+        for (size_t i = 0; i < identifierCount; i++) {
+            CodeBlock::IdentifierInfo info;
+            info.m_needToAllocateOnStack = m_reader.get<uint8_t>();
+            info.m_isMutable = m_reader.get<uint8_t>();
+            info.m_isExplicitlyDeclaredOrParameterName = m_reader.get<uint8_t>();
+            info.m_indexForIndexedStorage = m_reader.get<uint64_t>();
+            info.m_name = atomicString(m_reader.get<uint64_t>());
+            cb->m_identifierInfos.push_back(info);
+        }
+
+        size_t childCount = m_reader.getCount(sizeof(uint32_t));
+        if (m_reader.failed()) {
+            return nullptr;
+        }
+        cb->m_childBlocks.resizeWithUninitializedValues(childCount);
+        for (size_t i = 0; i < childCount; i++) {
+            cb->m_childBlocks[i] = readCodeBlock(cb);
+            if (!cb->m_childBlocks[i]) {
+                return nullptr;
+            }
+        }
+
+        return m_reader.failed() ? nullptr : cb;
+    }
+
+    ByteCodeBlock* readByteCodeBlock(InterpretedCodeBlock* topCodeBlock)
+    {
+        ByteCodeBlock* block = new ByteCodeBlock(topCodeBlock);
+        block->m_isEvalMode = m_reader.get<uint8_t>();
+        block->m_isOnGlobal = m_reader.get<uint8_t>();
+        block->m_shouldClearStack = m_reader.get<uint8_t>();
+        block->m_requiredRegisterFileSizeInValueSize = m_reader.get<uint32_t>();
+
+        size_t numeralCount = m_reader.getCount(sizeof(double));
+        block->m_numeralLiteralData.resizeWithUninitializedValues(numeralCount);
+        for (size_t i = 0; i < numeralCount; i++) {
+            block->m_numeralLiteralData[i] = Value(m_reader.get<double>());
+        }
+
+        std::vector<Value> values(m_reader.getCount(sizeof(uint8_t)));
+        for (size_t i = 0; i < values.size(); i++) {
+            switch (m_reader.get<uint8_t>()) {
+            case CodeCacheValueEmpty:
+                values[i] = Value(Value::EmptyValue);
+                break;
+            case CodeCacheValueUndefined:
+                values[i] = Value();
+                break;
+            case CodeCacheValueNull:
+                values[i] = Value(Value::Null);
+                break;
+            case CodeCacheValueTrue:
+                values[i] = Value(true);
+                break;
+            case CodeCacheValueFalse:
+                values[i] = Value(false);
+                break;
+            case CodeCacheValueNumber:
+                values[i] = Value(m_reader.get<double>());
+                break;
+            case CodeCacheValueString: {
+                String* str = string(m_reader.get<uint64_t>());
+                if (!str) {
+                    return nullptr;
+                }
+                block->m_literalData.pushBack(str);
+                values[i] = Value(str);
+                break;
+            }
+            default:
+                return nullptr;
+            }
+        }
+
+        std::vector<ControlFlowRecord*> controlFlowRecords(m_reader.getCount(sizeof(uint8_t) + sizeof(uint64_t)));
+        std::vector<char*> errorMessages(controlFlowRecords.size());
+        for (size_t i = 0; i < controlFlowRecords.size(); i++) {
+            controlFlowRecords[i] = nullptr;
+            errorMessages[i] = nullptr;
+            uint8_t kind = m_reader.get<uint8_t>();
+            if (kind == CodeCacheRecordControlFlow) {
+                uint64_t position = m_reader.get<uint64_t>();
+                uint64_t count = m_reader.get<uint64_t>();
+                uint64_t outerLimitCount = m_reader.get<uint64_t>();
+                controlFlowRecords[i] = new ControlFlowRecord(ControlFlowRecord::ControlFlowReason::NeedsJump, (size_t)position, count, outerLimitCount);
+                block->m_literalData.pushBack(controlFlowRecords[i]);
+            } else if (kind == CodeCacheRecordErrorMessage) {
+                size_t length = m_reader.getCount(sizeof(char));
+                const uint8_t* message = m_reader.getBytes(length);
+                if (!message) {
+                    return nullptr;
+                }
+                errorMessages[i] = (char*)GC_MALLOC_ATOMIC(length + 1);
+                memcpy(errorMessages[i], message, length);
+                errorMessages[i][length] = 0;
+                block->m_literalData.pushBack(errorMessages[i]);
+            } else {
+                return nullptr;
+            }
+        }
+
+        size_t codeSize = m_reader.getCount(sizeof(char));
+        const uint8_t* codeData = m_reader.getBytes(codeSize);
+        if (m_reader.failed()) {
+            return nullptr;
+        }
+        block->m_code.resizeWithUninitializedValues(codeSize);
+        memcpy(block->m_code.data(), codeData, codeSize);
+
+        // the interpreter trusts operands, so every jump target and register of the code is checked
+        char* code = block->m_code.data();
+        std::vector<bool> isByteCodeStart(codeSize, false);
+        std::vector<size_t> jumpTargets;
+        Opcode lastOpcode = OpcodeKindEnd;
+        size_t idx = 0;
+        while (idx < codeSize) {
+            ByteCode* currentCode = (ByteCode*)&code[idx];
+            Opcode opcode = unrelocatedOpcode(currentCode);
+            size_t size = opcode < OpcodeKindEnd ? byteCodeSize(opcode) : 0;
+            if (!size || idx + size > codeSize || opcode == FillOpcodeTableOpcode) {
+                return nullptr;
+            }
+            isByteCodeStart[idx] = true;
+            lastOpcode = opcode;
+
+#ifndef NDEBUG
+            // ByteCode has a vtable in debug builds. copy construct every ByteCode to put a valid vtable pointer of this process
+            switch (opcode) {
+#define RESTORE_BYTECODE_VTABLE(name, pushCount, popCount) \
+    case name##Opcode: {                                   \
+        name tmp(*(name*)currentCode);                     \
+        new (currentCode) name(tmp);                       \
+        break;                                             \
+    }
+                FOR_EACH_BYTECODE_OP(RESTORE_BYTECODE_VTABLE)
+#undef RESTORE_BYTECODE_VTABLE
+            default:
+                RELEASE_ASSERT_NOT_REACHED();
+            }
+#endif
+
+            switch (opcode) {
+            case LoadLiteralOpcode: {
+                LoadLiteral* cd = (LoadLiteral*)currentCode;
+                size_t valueIndex = loadIndex(cd->m_value);
+                if (valueIndex >= values.size()) {
+                    return nullptr;
+                }
+                cd->m_value = values[valueIndex];
+                break;
+            }
+            case LoadByNameOpcode:
+                restoreAtomicString(((LoadByName*)currentCode)->m_name);
+                break;
+            case StoreByNameOpcode:
+                restoreAtomicString(((StoreByName*)currentCode)->m_name);
+                break;
+            case ObjectDefineOwnPropertyWithNameOperationOpcode:
+                restoreAtomicString(((ObjectDefineOwnPropertyWithNameOperation*)currentCode)->m_propertyName);
+                break;
+            case UnaryTypeofOpcode:
+                restoreAtomicString(((UnaryTypeof*)currentCode)->m_id);
+                break;
+            case UnaryDeleteOpcode:
+                restoreAtomicString(((UnaryDelete*)currentCode)->m_id);
+                break;
+            case CallFunctionInWithScopeOpcode:
+                restoreAtomicString(((CallFunctionInWithScope*)currentCode)->m_calleeName);
+                break;
+            case GetObjectPreComputedCaseOpcode: {
+                GetObjectPreComputedCase* cd = (GetObjectPreComputedCase*)currentCode;
+                restorePropertyName(cd->m_propertyName);
+                new (&cd->m_inlineCache) GetObjectInlineCache();
+                break;
+            }
+            case SetObjectPreComputedCaseOpcode: {
+                SetObjectPreComputedCase* cd = (SetObjectPreComputedCase*)currentCode;
+                restorePropertyName(cd->m_propertyName);
+                cd->m_inlineCache = new SetObjectInlineCache();
+                block->m_literalData.pushBack(cd->m_inlineCache);
+                break;
+            }
+            case GetGlobalObjectOpcode: {
+                GetGlobalObject* cd = (GetGlobalObject*)currentCode;
+                restorePropertyName(cd->m_propertyName);
+                cd->m_cachedAddress = nullptr;
+                cd->m_cachedStructure = nullptr;
+                break;
+            }
+            case SetGlobalObjectOpcode: {
+                SetGlobalObject* cd = (SetGlobalObject*)currentCode;
+                restorePropertyName(cd->m_propertyName);
+                cd->m_cachedAddress = nullptr;
+                cd->m_cachedStructure = nullptr;
+                break;
+            }
+            case CallFunctionOpcode:
+                new (&((CallFunction*)currentCode)->m_callCache) CallFunctionCache();
+                break;
+            case CallFunctionWithReceiverOpcode:
+                new (&((CallFunctionWithReceiver*)currentCode)->m_callCache) CallFunctionCache();
+                break;
+            case CreateFunctionOpcode: {
+                CreateFunction* cd = (CreateFunction*)currentCode;
+                cd->m_codeBlock = codeBlock(loadIndex(cd->m_codeBlock));
+                break;
+            }
+            case DeclareFunctionDeclarationsOpcode: {
+                DeclareFunctionDeclarations* cd = (DeclareFunctionDeclarations*)currentCode;
+                cd->m_codeBlock = codeBlock(loadIndex(cd->m_codeBlock));
+                break;
+            }
+            case TemplateOperationOpcode: {
+                TemplateOperation* cd = (TemplateOperation*)currentCode;
+                cd->m_quasi = string(loadIndex(cd->m_quasi));
+                block->m_literalData.pushBack(cd->m_quasi);
+                break;
+            }
+            case LoadRegexpOpcode: {
+                LoadRegexp* cd = (LoadRegexp*)currentCode;
+                cd->m_body = string(loadIndex(cd->m_body));
+                cd->m_option = string(loadIndex(cd->m_option));
+                block->m_literalData.pushBack(cd->m_body);
+                block->m_literalData.pushBack(cd->m_option);
+                break;
+            }
+            case JumpComplexCaseOpcode: {
+                JumpComplexCase* cd = (JumpComplexCase*)currentCode;
+                size_t recordIndex = loadIndex(cd->m_controlFlowRecord);
+                if (recordIndex >= controlFlowRecords.size() || !controlFlowRecords[recordIndex]) {
+                    return nullptr;
+                }
+                cd->m_controlFlowRecord = controlFlowRecords[recordIndex];
+                jumpTargets.push_back(cd->m_controlFlowRecord->wordValue());
+                break;
+            }
+            case ThrowStaticErrorOperationOpcode: {
+                ThrowStaticErrorOperation* cd = (ThrowStaticErrorOperation*)currentCode;
+                size_t recordIndex = loadIndex(cd->m_errorMessage);
+                if (recordIndex >= errorMessages.size() || !errorMessages[recordIndex]) {
+                    return nullptr;
+                }
+                cd->m_errorMessage = errorMessages[recordIndex];
+                break;
+            }
+            case JumpOpcode:
+                jumpTargets.push_back(((Jump*)currentCode)->m_jumpPosition);
+                break;
+            case JumpIfTrueOpcode:
+                jumpTargets.push_back(((JumpIfTrue*)currentCode)->m_jumpPosition);
+                break;
+            case JumpIfFalseOpcode:
+                jumpTargets.push_back(((JumpIfFalse*)currentCode)->m_jumpPosition);
+                break;
+            case TryOperationOpcode: {
+                TryOperation* cd = (TryOperation*)currentCode;
+                restoreAtomicString(cd->m_catchVariableName);
+                if (cd->m_hasCatch) {
+                    jumpTargets.push_back(cd->m_catchPosition);
+                }
+                jumpTargets.push_back(cd->m_tryCatchEndPosition);
+                break;
+            }
+            case CheckIfKeyIsLastOpcode:
+                jumpTargets.push_back(((CheckIfKeyIsLast*)currentCode)->m_forInEndPosition);
+                break;
+            // global code never reads variables of upper functions or arguments
+            case LoadByClosureIndexOpcode:
+            case StoreByClosureIndexOpcode:
+            case GetArgumentsLengthOpcode:
+            case GetArgumentsElementOpcode:
+                return nullptr;
+            // superinstructions are made by ByteCodeGenerator::fuseByteCode after a cache is written
+            case BinaryEqualAndJumpIfFalseOpcode:
+            case BinaryNotEqualAndJumpIfFalseOpcode:
+            case BinaryStrictEqualAndJumpIfFalseOpcode:
+            case BinaryNotStrictEqualAndJumpIfFalseOpcode:
+            case BinaryLessThanAndJumpIfFalseOpcode:
+            case BinaryLessThanOrEqualAndJumpIfFalseOpcode:
+            case BinaryGreaterThanAndJumpIfFalseOpcode:
+            case BinaryGreaterThanOrEqualAndJumpIfFalseOpcode:
+            case IncrementAndJumpOpcode:
+            case DecrementAndJumpOpcode:
+            case GetObjectPreComputedCaseAndCallOpcode:
+                return nullptr;
+            default:
+                break;
+            }
+
+            if (m_reader.failed()) {
+                return nullptr;
+            }
+            idx += size;
+        }
+
+        if (lastOpcode != EndOpcode) {
+            return nullptr;
+        }
+        for (size_t i = 0; i < jumpTargets.size(); i++) {
+            if (jumpTargets[i] >= codeSize || !isByteCodeStart[jumpTargets[i]]) {
+                return nullptr;
+            }
+        }
+
+        if (!ByteCodeGenerator::relocateByteCode(block)) {
+            return nullptr;
+        }
+        return block;
+    }
+
+    AtomicString atomicString(uint64_t idx)
+    {
+        if (idx >= m_strings.size()) {
+            m_reader.fail();
+            return AtomicString();
+        }
+        if (!m_atomicStrings[idx]) {
+            m_atomicStrings[idx] = AtomicString(m_context, m_strings[idx]).string();
+        }
+        return AtomicString::fromPayload(m_atomicStrings[idx]);
+    }
+
+    void restoreAtomicString(AtomicString& field)
+    {
+        field = atomicString(loadIndex(field));
+    }
+
+    void restorePropertyName(PropertyName& field)
+    {
+        field = PropertyName(atomicString(loadIndex(field)));
+    }
+
+    InterpretedCodeBlock* codeBlock(size_t idx)
+    {
+        // the global code block is never created by bytecode
+        if (idx == 0 || idx >= m_codeBlocks.size()) {
+            m_reader.fail();
+            return nullptr;
+        }
+        return m_codeBlocks[idx];
+    }
+
+    String* string(uint64_t idx)
+    {
+        if (idx >= m_strings.size()) {
+            m_reader.fail();
+            return nullptr;
+        }
+        return m_strings[idx];
+    }
+
+private:
+    Context* m_context;
+    String* m_source;
+    Script* m_script;
+    CodeCacheReader& m_reader;
+    // GC is disabled while a cache is read, so these are not rooted
+    std::vector<String*> m_strings;
+    std::vector<String*> m_atomicStrings;
+    std::vector<InterpretedCodeBlock*> m_codeBlocks;
+};
+
+Script* CodeCache::deserialize(Context* context, String* source, String* fileName, bool strictFromOutside, const uint8_t* data, size_t length)
+{
+    CodeCacheReader reader(data, length);
+    if (reader.get<uint32_t>() != ESCARGOT_CODE_CACHE_MAGIC || reader.get<uint64_t>() != codeCacheBuildFingerprint()
+        || reader.get<uint64_t>() != source->length() || reader.get<uint64_t>() != codeCacheSourceHash(source)
+        || reader.get<uint8_t>() != (uint8_t)strictFromOutside || reader.failed()) {
+        return nullptr;
+    }
+    uint64_t payloadSize = reader.get<uint64_t>();
+    uint64_t checksum = reader.get<uint64_t>();
+    const uint8_t* payload = reader.getBytes(payloadSize);
+    if (!payload || !reader.atEnd() || codeCacheChecksum(payload, payloadSize) != checksum) {
+        return nullptr;
+    }
+    CodeCacheReader payloadReader(payload, payloadSize);
+
+    GC_disable();
+    CodeCacheDeserializer deserializer(context, source, payloadReader);
+    Script* script = deserializer.readScript(fileName);
+    GC_enable();
+    return script;
+}
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2018-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotCodeCache__
+#define __EscargotCodeCache__
+
+namespace Escargot {
+
+class Context;
+class String;
+class Script;
+class InterpretedCodeBlock;
+class ByteCodeBlock;
+
+#define ESCARGOT_CODE_CACHE_MAGIC 0x43435345 // "ESCC"
+#define ESCARGOT_CODE_CACHE_VERSION 2
+
+typedef std::vector<uint8_t> CodeCacheData;
+
+// Serialized form of a parsed script.
+//
+// header | string table | InterpretedCodeBlock tree (pre-order) | ByteCodeBlock of global code
+//
+// The header holds a fingerprint of this build's bytecode layout, a hash of the source and
+// a checksum of the rest, so a cache is only accepted for the exact source and binary which produced it.
+// Jump targets and register operands of the bytecode are checked again when it is loaded.
+// The bytecode is stored before ByteCodeGenerator::relocateByteCode, and every operand that
+// points into the heap (LoadLiteral values, AtomicString / PropertyName operands, CodeBlocks...)
+// is replaced by an index into the string table or another table of the cache.
+// Function bodies are not stored; they are generated lazily from the source as usual.
+class CodeCache {
+public:
+    static bool serialize(Context* context, String* source, bool strictFromOutside, InterpretedCodeBlock* topCodeBlock, ByteCodeBlock* byteCodeBlock, CodeCacheData& result);
+    // returns nullptr if |data| is malformed or was not produced from |source| by this build
+    static Script* deserialize(Context* context, String* source, String* fileName, bool strictFromOutside, const uint8_t* data, size_t length);
+};
+}
+
+#endif
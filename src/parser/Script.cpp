@@ -30,20 +30,39 @@
 #include "runtime/SandBox.h"
 #include "util/Util.h"
 #include "parser/ast/AST.h"
+#include "parser/esprima_cpp/esprima.h"
 
 namespace Escargot {
 
-Value Script::execute(ExecutionState& state, bool isEvalMode, bool needNewEnv, bool isOnGlobal)
+ByteCodeBlock* Script::generateTopByteCodeBlock(ExecutionState& state, bool isEvalMode, bool isOnGlobal)
 {
+    if (m_byteCodeBlockFromCodeCache) {
+        ByteCodeBlock* block = m_byteCodeBlockFromCodeCache;
+        m_byteCodeBlockFromCodeCache = nullptr;
+        if (block->m_isEvalMode == isEvalMode && block->m_isOnGlobal == isOnGlobal) {
+            return block;
+        }
+    }
+
     RefPtr<Node> programNode = m_topCodeBlock->cachedASTNode();
     if (m_topCodeBlock->m_cachedASTNode) {
         m_topCodeBlock->m_cachedASTNode->deref();
     }
     m_topCodeBlock->m_cachedASTNode = nullptr;
+
+    if (!programNode) {
+        // restored from a CodeCache which has global code for another execution mode
+        programNode = esprima::parseProgram(state.context(), m_topCodeBlock->src(), m_topCodeBlock->isStrict(), SIZE_MAX).get();
+    }
     ASSERT(programNode && programNode->type() == ASTNodeType::Program);
 
     ByteCodeGenerator g;
-    m_topCodeBlock->m_byteCodeBlock = g.generateByteCode(state.context(), m_topCodeBlock, programNode.get(), ((ProgramNode*)programNode.get())->scopeContext(), isEvalMode, isOnGlobal);
+    return g.generateByteCode(state.context(), m_topCodeBlock, programNode.get(), ((ProgramNode*)programNode.get())->scopeContext(), isEvalMode, isOnGlobal);
+}
+
+Value Script::execute(ExecutionState& state, bool isEvalMode, bool needNewEnv, bool isOnGlobal)
+{
+    m_topCodeBlock->m_byteCodeBlock = generateTopByteCodeBlock(state, isEvalMode, isOnGlobal);
 
     LexicalEnvironment* env;
     ExecutionContext* prevEc;
@@ -25,15 +25,18 @@
 namespace Escargot {
 
 class InterpretedCodeBlock;
+class ByteCodeBlock;
 class Context;
 
 class Script : public gc {
     friend class ScriptParser;
     friend class GlobalObject;
+    friend class CodeCacheDeserializer;
     Script(String* fileName, String* src)
         : m_fileName(fileName)
         , m_src(src)
         , m_topCodeBlock(nullptr)
+        , m_byteCodeBlockFromCodeCache(nullptr)
     {
     }
 
@@ -71,9 +74,12 @@ public:
 
 protected:
     Value executeLocal(ExecutionState& state, Value thisValue, InterpretedCodeBlock* parentCodeBlock, bool isEvalMode = false, bool needNewEnv = false);
+    ByteCodeBlock* generateTopByteCodeBlock(ExecutionState& state, bool isEvalMode, bool isOnGlobal);
     String* m_fileName;
     String* m_src;
     InterpretedCodeBlock* m_topCodeBlock;
+    // global code restored from a CodeCache. it is used by the first execution only
+    ByteCodeBlock* m_byteCodeBlockFromCodeCache;
 };
 }
 
@@ -22,6 +22,7 @@
 #include "runtime/Context.h"
 #include "runtime/VMInstance.h"
 #include "interpreter/ByteCode.h"
+#include "interpreter/ByteCodeGenerator.h"
 #include "parser/esprima_cpp/esprima.h"
 #include "parser/ScriptParser.h"
 #include "parser/ast/AST.h"
@@ -285,4 +286,34 @@ std::tuple<RefPtr<Node>, ASTScopeContext*> ScriptParser::parseFunction(Interpret
         RELEASE_ASSERT_NOT_REACHED();
     }
 }
+
+bool ScriptParser::produceCodeCache(String* script, String* fileName, CodeCacheData& cache, bool strictFromOutside)
+{
+    ScriptParserResult result = parse(script, fileName, strictFromOutside);
+    if (result.m_error) {
+        return false;
+    }
+
+    InterpretedCodeBlock* topCodeBlock = result.m_script->m_topCodeBlock;
+    RefPtr<Node> programNode = topCodeBlock->cachedASTNode();
+    topCodeBlock->m_cachedASTNode->deref();
+    topCodeBlock->m_cachedASTNode = nullptr;
+
+    // global code is stored for the execution mode of ScriptRef::execute
+    ByteCodeGenerator g;
+    ByteCodeBlock* block = g.generateByteCode(m_context, topCodeBlock, programNode.get(), ((ProgramNode*)programNode.get())->scopeContext(), false, false, false, false);
+    return CodeCache::serialize(m_context, script, strictFromOutside, topCodeBlock, block, cache);
+}
+
+ScriptParser::ScriptParserResult ScriptParser::parseWithCodeCache(String* script, String* fileName, const uint8_t* cache, size_t cacheLength, bool& cacheRejected, bool strictFromOutside)
+{
+    Script* restored = CodeCache::deserialize(m_context, script, fileName, strictFromOutside, cache, cacheLength);
+    cacheRejected = !restored;
+    if (!restored) {
+        return parse(script, fileName, strictFromOutside);
+    }
+
+    m_context->vmInstance()->m_parsedSourceCodes.push_back(script);
+    return ScriptParserResult(restored, nullptr);
+}
 }
@@ -23,6 +23,7 @@
 #include "parser/Script.h"
 #include "runtime/String.h"
 #include "runtime/ErrorObject.h"
+#include "parser/CodeCache.h"
 
 namespace Escargot {
 
@@ -65,6 +66,11 @@ public:
     ScriptParserResult parse(StringView script, String* fileName = String::emptyString, InterpretedCodeBlock* parentCodeBlock = nullptr, bool strictFromOutside = false, bool isEvalCodeInFunction = false, size_t stackSizeRemain = SIZE_MAX);
     std::tuple<RefPtr<Node>, ASTScopeContext*> parseFunction(InterpretedCodeBlock* codeBlock, size_t stackSizeRemain, ExecutionState* state = nullptr);
 
+    // parses |script| and writes its CodeCache into |cache|. returns false if |script| has an error or cannot be cached
+    bool produceCodeCache(String* script, String* fileName, CodeCacheData& cache, bool strictFromOutside = false);
+    // restores |script| from |cache|. falls back to parse when |cache| does not match |script| or this build
+    ScriptParserResult parseWithCodeCache(String* script, String* fileName, const uint8_t* cache, size_t cacheLength, bool& cacheRejected, bool strictFromOutside = false);
+
 protected:
     InterpretedCodeBlock* generateCodeBlockTreeFromAST(Context* ctx, StringView source, Script* script, ProgramNode* program);
     InterpretedCodeBlock* generateCodeBlockTreeFromASTWalker(Context* ctx, StringView source, Script* script, ASTScopeContext* scopeCtx, InterpretedCodeBlock* parentCodeBlock);
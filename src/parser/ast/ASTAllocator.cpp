@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2018-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#include "Escargot.h"
+#include "ASTAllocator.h"
+
+namespace Escargot {
+
+thread_local ASTAllocator* ASTAllocator::s_current;
+
+ASTAllocator::Session::Session()
+    : m_allocator(new ASTAllocator())
+    , m_previousAllocator(s_current)
+{
+    s_current = m_allocator;
+}
+
+ASTAllocator::Session::~Session()
+{
+    ASSERT(s_current == m_allocator);
+    s_current = m_previousAllocator;
+    m_allocator->endSession();
+}
+
+ASTAllocator::ASTAllocator()
+    : m_chunkCurrent(nullptr)
+    , m_chunkEnd(nullptr)
+    , m_nextChunkSize(InitialChunkSize)
+    , m_liveNodeCount(0)
+    , m_isSessionEnded(false)
+{
+}
+
+ASTAllocator::~ASTAllocator()
+{
+    ASSERT(s_current != this);
+    for (size_t i = 0; i < m_chunks.size(); i++) {
+        GC_FREE(m_chunks[i]);
+    }
+}
+
+void* ASTAllocator::allocateSlowCase(size_t size)
+{
+    // big allocations get a chunk of their own, so the current chunk is not wasted
+    if (size > m_nextChunkSize / 4) {
+        void* ret = GC_MALLOC_UNCOLLECTABLE(size);
+        m_chunks.push_back(ret);
+        return ret;
+    }
+
+    char* chunk = (char*)GC_MALLOC_UNCOLLECTABLE(m_nextChunkSize);
+    m_chunks.push_back(chunk);
+    m_chunkCurrent = chunk + size;
+    m_chunkEnd = chunk + m_nextChunkSize;
+    if (m_nextChunkSize < MaxChunkSize) {
+        m_nextChunkSize *= 2;
+    }
+    return chunk;
+}
+}
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2018-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef ASTAllocator_h
+#define ASTAllocator_h
+
+namespace Escargot {
+
+// Bump pointer allocator of a parse session.
+// Nodes and ScannerResults created while a session is active are carved out of large chunks
+// instead of being allocated one by one. Deleting a Node only counts it down,
+// and every chunk is released at once when the session is over and its last Node is gone
+// (usually right after ByteCode generation drops the AST).
+// Chunks are uncollectable but scanned, because Nodes hold pointers to gc objects.
+// Nodes of a session are freed on the thread which parsed them.
+class ASTAllocator {
+public:
+    // makes a new allocator current while it is alive. parse sessions may nest.
+    class Session {
+    public:
+        Session();
+        ~Session();
+
+    private:
+        ASTAllocator* m_allocator;
+        ASTAllocator* m_previousAllocator;
+    };
+
+    static ASTAllocator* current()
+    {
+        return s_current;
+    }
+
+    // every Node has a header which remembers its allocator.
+    // Nodes created outside of a session (e.g. while generating ByteCode) fall back to the gc heap.
+    static void* allocateNode(size_t size)
+    {
+        void** header;
+        if (s_current) {
+            header = (void**)s_current->allocate(size + NodeHeaderSize);
+            s_current->m_liveNodeCount++;
+        } else {
+            header = (void**)GC_MALLOC_UNCOLLECTABLE(size + NodeHeaderSize);
+        }
+        *header = s_current;
+        return (char*)header + NodeHeaderSize;
+    }
+
+    static void freeNode(void* ptr)
+    {
+        void** header = (void**)((char*)ptr - NodeHeaderSize);
+        ASTAllocator* allocator = (ASTAllocator*)*header;
+        if (allocator) {
+            allocator->releaseNode();
+        } else {
+            GC_FREE(header);
+        }
+    }
+
+    void* allocate(size_t size)
+    {
+        size = (size + (AllocationAlignment - 1)) & ~(AllocationAlignment - 1);
+        if (LIKELY(size <= (size_t)(m_chunkEnd - m_chunkCurrent))) {
+            void* ret = m_chunkCurrent;
+            m_chunkCurrent += size;
+            return ret;
+        }
+        return allocateSlowCase(size);
+    }
+
+private:
+    static const size_t AllocationAlignment = 8;
+    // keeps the Node itself aligned like the allocation
+    static const size_t NodeHeaderSize = (sizeof(void*) + AllocationAlignment - 1) & ~(AllocationAlignment - 1);
+    static const size_t InitialChunkSize = 4 * 1024;
+    static const size_t MaxChunkSize = 128 * 1024;
+
+    ASTAllocator();
+    ~ASTAllocator();
+
+    void* allocateSlowCase(size_t size);
+    void releaseNode()
+    {
+        ASSERT(m_liveNodeCount);
+        if (--m_liveNodeCount == 0 && m_isSessionEnded) {
+            delete this;
+        }
+    }
+    void endSession()
+    {
+        m_isSessionEnded = true;
+        if (m_liveNodeCount == 0) {
+            delete this;
+        }
+    }
+
+    // each thread parses with its own allocator, so the current one is per thread
+    static thread_local ASTAllocator* s_current;
+
+    char* m_chunkCurrent;
+    char* m_chunkEnd;
+    size_t m_nextChunkSize;
+    size_t m_liveNodeCount;
+    bool m_isSessionEnded;
+    std::vector<void*> m_chunks;
+};
+}
+
+#endif
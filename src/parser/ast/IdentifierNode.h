@@ -45,6 +45,7 @@ public:
 
     virtual void generateStoreByteCode(ByteCodeBlock* codeBlock, ByteCodeGenerateContext* context, ByteCodeRegisterIndex srcRegister, bool needToReferenceSelf)
     {
+        markArgumentsObjectUse(context);
         if (context->m_codeBlock->asInterpretedCodeBlock()->isGlobalScopeCodeBlock()) {
             if (context->m_isWithScope || context->m_catchScopeCount || context->m_isEvalCode) {
                 codeBlock->pushCode(StoreByName(ByteCodeLOC(m_loc.index), srcRegister, m_name), context, this);
@@ -75,6 +76,8 @@ public:
                     if (srcRegister != REGULAR_REGISTER_LIMIT + info.m_index) {
                         codeBlock->pushCode(Move(ByteCodeLOC(m_loc.index), srcRegister, REGULAR_REGISTER_LIMIT + info.m_index), context, this);
                     }
+                } else if (info.m_upperIndex && !context->m_isEvalCode) {
+                    codeBlock->pushCode(StoreByClosureIndex(ByteCodeLOC(m_loc.index), srcRegister, codeBlock->closureDisplayIndex(info.m_upperIndex), info.m_index), context, this);
                 } else {
                     size_t cIdx = context->m_catchScopeCount;
                     codeBlock->pushCode(StoreByHeapIndex(ByteCodeLOC(m_loc.index), srcRegister, info.m_upperIndex + cIdx, info.m_index), context, this);
@@ -88,6 +91,7 @@ public:
 
     virtual void generateExpressionByteCode(ByteCodeBlock* codeBlock, ByteCodeGenerateContext* context, ByteCodeRegisterIndex dstRegister)
     {
+        markArgumentsObjectUse(context);
         if (context->m_codeBlock->asInterpretedCodeBlock()->isGlobalScopeCodeBlock()) {
             if (context->m_isWithScope || context->m_catchScopeCount || context->m_isEvalCode) {
                 codeBlock->pushCode(LoadByName(ByteCodeLOC(m_loc.index), dstRegister, m_name), context, this);
@@ -115,6 +119,8 @@ public:
                         }
                     } else
                         codeBlock->pushCode(Move(ByteCodeLOC(m_loc.index), REGULAR_REGISTER_LIMIT + info.m_index, dstRegister), context, this);
+                } else if (info.m_upperIndex && !context->m_isEvalCode) {
+                    codeBlock->pushCode(LoadByClosureIndex(ByteCodeLOC(m_loc.index), dstRegister, codeBlock->closureDisplayIndex(info.m_upperIndex), info.m_index), context, this);
                 } else {
                     size_t cIdx = context->m_catchScopeCount;
                     codeBlock->pushCode(LoadByHeapIndex(ByteCodeLOC(m_loc.index), dstRegister, info.m_upperIndex + cIdx, info.m_index), context, this);
@@ -138,6 +144,7 @@ public:
 
     std::pair<bool, ByteCodeRegisterIndex> isAllocatedOnStack(ByteCodeGenerateContext* context, bool checkMutable = true)
     {
+        markArgumentsObjectUse(context);
         if ((context->m_codeBlock->asInterpretedCodeBlock()->canUseIndexedVariableStorage() || context->m_codeBlock->asInterpretedCodeBlock()->isGlobalScopeCodeBlock())) {
             InterpretedCodeBlock::IndexedIdentifierInfo info = context->m_codeBlock->asInterpretedCodeBlock()->indexedIdentifierInfo(m_name);
             if (!info.m_isResultSaved) {
@@ -190,6 +197,14 @@ public:
     }
 
 protected:
+    // every use of arguments but the ones of MemberExpressionNode needs the arguments object
+    void markArgumentsObjectUse(ByteCodeGenerateContext* context)
+    {
+        if (UNLIKELY(m_name == context->m_codeBlock->context()->staticStrings().arguments)) {
+            context->m_byteCodeBlock->m_needsArgumentsObject = true;
+        }
+    }
+
     AtomicString m_name;
 };
 }
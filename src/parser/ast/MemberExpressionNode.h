@@ -67,6 +67,21 @@ public:
         bool prevHead = context->m_isHeadOfMemberExpression;
         context->m_isHeadOfMemberExpression = false;
 
+        if (!(context->m_inCallingExpressionScope && prevHead) && isArgumentsObjectAccess(context)) {
+            // arguments.length and arguments[property] are read from the arguments of the frame
+            // while the function does not create its arguments object
+            ByteCodeRegisterIndex argumentsIndex = REGULAR_REGISTER_LIMIT + context->m_codeBlock->asInterpretedCodeBlock()->indexedIdentifierInfo(m_object->asIdentifier()->name()).m_index;
+            if (isPreComputedCase()) {
+                codeBlock->pushCode(GetArgumentsLength(ByteCodeLOC(m_loc.index), argumentsIndex, dstIndex, context->m_catchScopeCount), context, this);
+            } else {
+                size_t propertyIndex = m_property->getRegister(codeBlock, context);
+                m_property->generateExpressionByteCode(codeBlock, context, propertyIndex);
+                codeBlock->pushCode(GetArgumentsElement(ByteCodeLOC(m_loc.index), argumentsIndex, propertyIndex, dstIndex, context->m_catchScopeCount), context, this);
+                context->giveUpRegister();
+            }
+            return;
+        }
+
         bool isSimple = true;
 
         if (!m_object->isIdentifier() || (!m_property->isLiteral() && !m_property->isIdentifier())) {
@@ -84,9 +99,7 @@ public:
 
         if (isPreComputedCase()) {
             ASSERT(m_property->isIdentifier());
-            size_t pos = codeBlock->currentCodeSize();
             codeBlock->pushCode(GetObjectPreComputedCase(ByteCodeLOC(m_loc.index), objectIndex, dstIndex, m_property->asIdentifier()->name()), context, this);
-            context->m_getObjectCodePositions.push_back(pos);
         } else {
             size_t propertyIndex = m_property->getRegister(codeBlock, context);
             m_property->generateExpressionByteCode(codeBlock, context, propertyIndex);
@@ -155,9 +168,7 @@ public:
         if (isPreComputedCase()) {
             size_t objectIndex = context->getLastRegisterIndex();
             size_t resultIndex = context->getRegister();
-            size_t pos = codeBlock->currentCodeSize();
             codeBlock->pushCode(GetObjectPreComputedCase(ByteCodeLOC(m_loc.index), objectIndex, resultIndex, m_property->asIdentifier()->name()), context, this);
-            context->m_getObjectCodePositions.push_back(pos);
         } else {
             size_t objectIndex = context->getLastRegisterIndex(1);
             size_t propertyIndex = context->getLastRegisterIndex();
@@ -183,6 +194,20 @@ public:
     }
 
 protected:
+    bool isArgumentsObjectAccess(ByteCodeGenerateContext* context)
+    {
+        if (!m_object->isIdentifier() || m_object->asIdentifier()->name() != context->m_codeBlock->context()->staticStrings().arguments) {
+            return false;
+        }
+        if (isPreComputedCase() && propertyName() != context->m_codeBlock->context()->staticStrings().length) {
+            return false;
+        }
+        if (context->m_isEvalCode || context->m_isWithScope || (context->m_catchScopeCount && context->m_lastCatchVariableName == context->m_codeBlock->context()->staticStrings().arguments)) {
+            return false;
+        }
+        return !context->m_codeBlock->asInterpretedCodeBlock()->isGlobalScopeCodeBlock() && ByteCodeGenerator::canReadArgumentsDirectly(context->m_codeBlock->asInterpretedCodeBlock());
+    }
+
     RefPtr<Node> m_object; // object: Expression;
     RefPtr<Node> m_property; // property: Identifier | Expression;
 
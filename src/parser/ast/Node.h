@@ -22,6 +22,7 @@
 
 #include "runtime/AtomicString.h"
 #include "runtime/Value.h"
+#include "parser/ast/ASTAllocator.h"
 
 namespace Escargot {
 
@@ -182,14 +183,15 @@ public:
 
     virtual ASTNodeType type() = 0;
 
+    // Nodes are allocated from the ASTAllocator of the current parse session
     inline void *operator new(size_t size)
     {
-        return GC_MALLOC_UNCOLLECTABLE(size);
+        return ASTAllocator::allocateNode(size);
     }
 
     inline void operator delete(void *obj)
     {
-        GC_FREE(obj);
+        ASTAllocator::freeNode(obj);
     }
 
     bool isIdentifier()
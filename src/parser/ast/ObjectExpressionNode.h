@@ -42,7 +42,7 @@ public:
     virtual ASTNodeType type() { return ASTNodeType::ObjectExpression; }
     virtual void generateExpressionByteCode(ByteCodeBlock* codeBlock, ByteCodeGenerateContext* context, ByteCodeRegisterIndex dstRegister)
     {
-        codeBlock->pushCode(CreateObject(ByteCodeLOC(m_loc.index), dstRegister), context, this);
+        codeBlock->pushCode(CreateObject(ByteCodeLOC(m_loc.index), dstRegister, m_properties.size()), context, this);
         size_t objIndex = dstRegister;
         for (unsigned i = 0; i < m_properties.size(); i++) {
             PropertyNode* p = m_properties[i].get();
@@ -49,6 +49,7 @@ public:
         m_block->generateStatementByteCode(codeBlock, context);
         codeBlock->pushCode(TryCatchWithBodyEnd(ByteCodeLOC(m_loc.index)), context, this);
         size_t tryCatchBodyPos = codeBlock->lastCodePosition<TryCatchWithBodyEnd>();
+        codeBlock->pushExceptionRegion(pos, tryCatchBodyPos, true);
         if (m_handler) {
             size_t prev = context->m_catchScopeCount;
             context->m_catchScopeCount++;
@@ -80,6 +81,7 @@ public:
             codeBlock->peekCode<TryOperation>(pos)->m_hasCatch = true;
             codeBlock->peekCode<TryOperation>(pos)->m_catchVariableName = m_handler->param()->name();
             codeBlock->pushCode(TryCatchWithBodyEnd(ByteCodeLOC(m_loc.index)), context, this);
+            codeBlock->pushExceptionRegion(codeBlock->peekCode<TryOperation>(pos)->m_catchPosition, codeBlock->currentCodeSize(), false);
             context->m_catchScopeCount = prev;
         }
 
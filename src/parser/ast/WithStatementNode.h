@@ -52,6 +52,7 @@ public:
 
         codeBlock->pushCode(TryCatchWithBodyEnd(ByteCodeLOC(m_loc.index)), context, this);
         codeBlock->peekCode<WithOperation>(withPos)->m_withEndPostion = codeBlock->currentCodeSize();
+        codeBlock->pushExceptionRegion(withPos, codeBlock->currentCodeSize(), false);
         context->m_isWithScope = isWithScopeBefore;
 
         context->m_tryStatementScopeCount--;
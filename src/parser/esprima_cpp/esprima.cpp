@@ -728,6 +728,11 @@ public:
             initialResultMemoryPoolSize--;
             return initialResultMemoryPool[initialResultMemoryPoolSize];
         } else if (resultMemoryPool.size() == 0) {
+            // results are recycled through the pools while the session is alive,
+            // so they are released together with the AST
+            if (ASTAllocator::current()) {
+                return (ScannerResult*)ASTAllocator::current()->allocate(sizeof(ScannerResult));
+            }
             auto ret = (ScannerResult*)GC_MALLOC(sizeof(ScannerResult));
             return ret;
         } else {
@@ -9105,6 +9110,8 @@ public:
 
 RefPtr<ProgramNode> parseProgram(::Escargot::Context* ctx, StringView source, bool strictFromOutside, size_t stackRemain)
 {
+    // the session should outlive the parser, which releases the last ScannerResults
+    ASTAllocator::Session session;
     Parser parser(ctx, source, stackRemain);
     parser.context->strict = strictFromOutside;
     RefPtr<ProgramNode> nd = parser.parseProgram();
@@ -9113,6 +9120,7 @@ RefPtr<ProgramNode> parseProgram(::Escargot::Context* ctx, StringView source, bo
 
 std::tuple<RefPtr<Node>, ASTScopeContext*> parseSingleFunction(::Escargot::Context* ctx, InterpretedCodeBlock* codeBlock, size_t stackRemain)
 {
+    ASTAllocator::Session session;
     Parser parser(ctx, codeBlock->src(), stackRemain, codeBlock->sourceElementStart().line, codeBlock->sourceElementStart().column, codeBlock->sourceElementStart().index);
     parser.trackUsingNames = false;
     parser.config.parseSingleFunction = true;
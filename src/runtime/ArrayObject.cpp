@@ -30,6 +30,7 @@ size_t g_arrayObjectTag;
 
 ArrayObject::ArrayObject(ExecutionState& state)
     : Object(state, ESCARGOT_OBJECT_BUILTIN_PROPERTY_NUMBER + 1, true)
+    , m_elementKind(ArrayElementKindInt32)
 {
     m_structure = state.context()->defaultStructureForArrayObject();
     m_values[ESCARGOT_OBJECT_BUILTIN_PROPERTY_NUMBER] = Value(0);
@@ -172,6 +173,7 @@ bool ArrayObject::deleteOwnProperty(ExecutionState& state, const ObjectPropertyN
             uint64_t len = getArrayLength(state);
             if (idx < len) {
                 m_fastModeData[idx] = Value(Value::EmptyValue);
+                markElementKindHoley();
                 ensureObjectRareData()->m_shouldUpdateEnumerateObjectData = true;
                 return true;
             }
@@ -264,7 +266,7 @@ void ArrayObject::convertIntoNonFastMode(ExecutionState& state)
     m_fastModeData.clear();
 }
 
-bool ArrayObject::setArrayLength(ExecutionState& state, const uint64_t& newLength)
+bool ArrayObject::setArrayLength(ExecutionState& state, const uint64_t& newLength, bool newElementsWillBeStored)
 {
     ASSERT(isExtensible() || newLength <= getArrayLength(state));
 
@@ -282,6 +284,9 @@ bool ArrayObject::setArrayLength(ExecutionState& state, const uint64_t& newLengt
         auto oldLenDesc = structure()->readProperty(state, (size_t)0);
         m_values[ESCARGOT_OBJECT_BUILTIN_PROPERTY_NUMBER] = Value(newLength);
         m_fastModeData.resize(oldSize, newLength, Value(Value::EmptyValue));
+        if (newLength > oldSize && !newElementsWillBeStored) {
+            markElementKindHoley();
+        }
 
         if (UNLIKELY(!oldLenDesc.m_descriptor.isWritable())) {
             convertIntoNonFastMode(state);
@@ -368,11 +373,11 @@ bool ArrayObject::setFastModeValue(ExecutionState& state, const ObjectPropertyNa
                 if (UNLIKELY(!isExtensible())) {
                     return false;
                 }
-                if (UNLIKELY(!setArrayLength(state, idx + 1)) || UNLIKELY(!isFastModeArray())) {
+                if (UNLIKELY(!setArrayLength(state, idx + 1, idx == len)) || UNLIKELY(!isFastModeArray())) {
                     return false;
                 }
             }
-            m_fastModeData[idx] = desc.value();
+            setFastModeElement(idx, desc.value());
             return true;
         }
     }
@@ -406,17 +411,429 @@ bool ArrayObject::setIndexedProperty(ExecutionState& state, const Value& propert
                 if (UNLIKELY(!isExtensible())) {
                     return false;
                 }
-                if (UNLIKELY(!setArrayLength(state, idx + 1)) || UNLIKELY(!isFastModeArray())) {
+                if (UNLIKELY(!setArrayLength(state, idx + 1, idx == len)) || UNLIKELY(!isFastModeArray())) {
                     return set(state, ObjectPropertyName(state, property), value, this);
                 }
             }
-            m_fastModeData[idx] = value;
+            setFastModeElement(idx, value);
             return true;
         }
     }
     return set(state, ObjectPropertyName(state, property), value, this);
 }
 
+// elements of an Int32 kind array were int32 when they were stored, so they can be searched by raw payload.
+// returns false when the payload of |number| is not unique (int32 out of smi range is boxed on 32-bit)
+static bool searchPayloadOfInt32(const Value& number, intptr_t& payload)
+{
+    // -0 becomes 0 here, which is fine for both === and SameValueZero
+    SmallValue target = Value((int32_t)number.asNumber());
+    if (target.isStoredInHeap()) {
+        return false;
+    }
+    payload = target.payload();
+    return true;
+}
+
+static bool isInt32Representable(double d)
+{
+    return d >= std::numeric_limits<int32_t>::min() && d <= std::numeric_limits<int32_t>::max() && (double)(int32_t)d == d;
+}
+
+bool ArrayObject::indexOfInFastMode(ExecutionState& state, const Value& element, uint32_t fromIndex, uint32_t length, int64_t& result)
+{
+    if (!isFastModeArray()) {
+        return false;
+    }
+
+    // fast mode arrays have no indexed property on their prototypes,
+    // so holes and indexes over the current length are not present at all
+    uint32_t end = std::min(length, getArrayLength(state));
+    SmallValue* data = m_fastModeData.data();
+    ArrayElementKind type = elementType();
+    result = -1;
+
+    if (type != ArrayElementKindGeneric) {
+        if (!element.isNumber()) {
+            return true;
+        }
+        if (type == ArrayElementKindInt32) {
+            if (!isInt32Representable(element.asNumber())) {
+                return true;
+            }
+            intptr_t payload;
+            if (searchPayloadOfInt32(element, payload)) {
+                for (uint32_t i = fromIndex; i < end; i++) {
+                    if (data[i].payload() == payload) {
+                        result = i;
+                        return true;
+                    }
+                }
+                return true;
+            }
+        }
+        double d = element.asNumber();
+        for (uint32_t i = fromIndex; i < end; i++) {
+            Value v(data[i]);
+            if (v.isNumber() && v.asNumber() == d) {
+                result = i;
+                return true;
+            }
+        }
+        return true;
+    }
+
+    for (uint32_t i = fromIndex; i < end; i++) {
+        Value v(data[i]);
+        if (!v.isEmpty() && v.equalsTo(state, element)) {
+            result = i;
+            return true;
+        }
+    }
+    return true;
+}
+
+bool ArrayObject::includesInFastMode(ExecutionState& state, const Value& element, uint32_t fromIndex, uint32_t length, bool& result)
+{
+    if (!isFastModeArray()) {
+        return false;
+    }
+
+    // holes and indexes over the current length are read as undefined
+    uint32_t end = std::min(length, getArrayLength(state));
+    SmallValue* data = m_fastModeData.data();
+    ArrayElementKind type = elementType();
+    result = true;
+
+    if (element.isUndefined()) {
+        if (end < length && fromIndex < length) {
+            return true;
+        }
+        if (isHoleyElementKind() || type == ArrayElementKindGeneric) {
+            for (uint32_t i = fromIndex; i < end; i++) {
+                Value v(data[i]);
+                if (v.isEmpty() || v.isUndefined()) {
+                    return true;
+                }
+            }
+        }
+        result = false;
+        return true;
+    }
+
+    if (type != ArrayElementKindGeneric) {
+        result = false;
+        if (!element.isNumber()) {
+            return true;
+        }
+        if (type == ArrayElementKindInt32) {
+            if (!isInt32Representable(element.asNumber())) {
+                return true;
+            }
+            intptr_t payload;
+            if (searchPayloadOfInt32(element, payload)) {
+                for (uint32_t i = fromIndex; i < end; i++) {
+                    if (data[i].payload() == payload) {
+                        result = true;
+                        return true;
+                    }
+                }
+                return true;
+            }
+        }
+        double d = element.asNumber();
+        bool searchNaN = std::isnan(d);
+        for (uint32_t i = fromIndex; i < end; i++) {
+            Value v(data[i]);
+            if (v.isNumber() && (searchNaN ? std::isnan(v.asNumber()) : v.asNumber() == d)) {
+                result = true;
+                return true;
+            }
+        }
+        return true;
+    }
+
+    for (uint32_t i = fromIndex; i < end; i++) {
+        Value v(data[i]);
+        if (!v.isEmpty() && v.equalsToByTheSameValueZeroAlgorithm(state, element)) {
+            return true;
+        }
+    }
+    result = false;
+    return true;
+}
+
+bool ArrayObject::fillInFastMode(ExecutionState& state, const Value& value, uint32_t start, uint32_t end)
+{
+    // filling a hole of non-extensible array should fail, so it is left to the generic path
+    if (!isFastModeArray() || end > getArrayLength(state) || (isHoleyElementKind() && !isExtensible())) {
+        return false;
+    }
+
+    // stores Value one by one, because a boxed double SmallValue should not be shared between slots
+    SmallValue* data = m_fastModeData.data();
+    for (uint32_t i = start; i < end; i++) {
+        data[i] = value;
+    }
+    if (start < end) {
+        widenElementKind(value);
+    }
+    return true;
+}
+
+String* ArrayObject::joinInFastMode(ExecutionState& state, String* separator, uint32_t length)
+{
+    // converting an object to string may call user code, so only numbers are joined here
+    if (!isFastModeArray() || elementType() == ArrayElementKindGeneric) {
+        return nullptr;
+    }
+
+    uint32_t end = std::min(length, getArrayLength(state));
+    SmallValue* data = m_fastModeData.data();
+    StringBuilder builder;
+    for (uint32_t i = 0; i < length; i++) {
+        if (i != 0 && separator->length()) {
+            if (builder.contentLength() > STRING_MAXIMUM_LENGTH - separator->length()) {
+                ErrorObject::throwBuiltinError(state, ErrorObject::RangeError, errorMessage_String_InvalidStringLength);
+            }
+            builder.appendString(separator);
+        }
+        if (i < end) {
+            Value v(data[i]);
+            if (!v.isEmpty()) {
+                builder.appendString(v.toString(state));
+            }
+        }
+    }
+    return builder.finalize(&state);
+}
+
+static size_t int32ToDecimalString(int32_t value, char* buffer)
+{
+    char reversed[10];
+    size_t length = 0;
+    uint32_t u = value < 0 ? -(uint32_t)value : value;
+    do {
+        reversed[length++] = '0' + (u % 10);
+        u /= 10;
+    } while (u);
+
+    size_t pos = 0;
+    if (value < 0) {
+        buffer[pos++] = '-';
+    }
+    while (length) {
+        buffer[pos++] = reversed[--length];
+    }
+    buffer[pos] = 0;
+    return pos;
+}
+
+bool ArrayObject::sortInFastModeByDefaultOrder(ExecutionState& state)
+{
+    // the default order compares ToString of the elements.
+    // strings of int32 are made of ascii only, so they can be compared without allocating Strings
+    if (!isFastModeArray() || elementType() != ArrayElementKindInt32) {
+        return false;
+    }
+
+    size_t length = getArrayLength(state);
+    std::vector<int32_t> values;
+    values.reserve(length);
+    for (size_t i = 0; i < length; i++) {
+        Value v(m_fastModeData[i]);
+        if (!v.isEmpty()) {
+            values.push_back(v.asInt32());
+        }
+    }
+
+    std::sort(values.begin(), values.end(), [](int32_t a, int32_t b) -> bool {
+        char bufferA[12];
+        char bufferB[12];
+        int32ToDecimalString(a, bufferA);
+        int32ToDecimalString(b, bufferB);
+        return strcmp(bufferA, bufferB) < 0;
+    });
+
+    // holes go to the end
+    for (size_t i = 0; i < values.size(); i++) {
+        m_fastModeData[i] = Value(values[i]);
+    }
+    for (size_t i = values.size(); i < length; i++) {
+        m_fastModeData[i] = Value(Value::EmptyValue);
+    }
+    return true;
+}
+
+// copies elements into another array.
+// a boxed double of 32-bit is updated in place when its slot is overwritten, so it is not shared between arrays
+static void copyFastModeElements(SmallValue* dst, const SmallValue* src, size_t count)
+{
+#ifdef ESCARGOT_64
+    memcpy(dst, src, sizeof(SmallValue) * count);
+#else
+    for (size_t i = 0; i < count; i++) {
+        dst[i] = Value(src[i]);
+    }
+#endif
+}
+
+bool ArrayObject::pushInFastMode(ExecutionState& state, size_t argc, Value* argv)
+{
+    if (!canChangeFastModeLength(state)) {
+        return false;
+    }
+    uint64_t length = getArrayLength(state);
+    if (length + argc > ESCARGOT_ARRAY_NON_FASTMODE_MIN_SIZE) {
+        return false;
+    }
+
+    setArrayLength(state, length + argc, true);
+    for (size_t i = 0; i < argc; i++) {
+        setFastModeElement(length + i, argv[i]);
+    }
+    return true;
+}
+
+bool ArrayObject::shiftInFastMode(ExecutionState& state, Value& first)
+{
+    if (!canChangeFastModeLength(state)) {
+        return false;
+    }
+    uint32_t length = getArrayLength(state);
+    if (length == 0) {
+        return false;
+    }
+
+    // moving a hole is the same as deleting the property it moves to
+    SmallValue* data = m_fastModeData.data();
+    first = data[0];
+    if (first.isEmpty()) {
+        first = Value();
+    }
+    memmove(data, data + 1, sizeof(SmallValue) * (length - 1));
+    data[length - 1] = Value(Value::EmptyValue);
+    setArrayLength(state, length - 1);
+    return true;
+}
+
+bool ArrayObject::unshiftInFastMode(ExecutionState& state, size_t argc, Value* argv)
+{
+    if (!canChangeFastModeLength(state)) {
+        return false;
+    }
+    uint64_t length = getArrayLength(state);
+    if (length + argc > ESCARGOT_ARRAY_NON_FASTMODE_MIN_SIZE) {
+        return false;
+    }
+
+    setArrayLength(state, length + argc, true);
+    SmallValue* data = m_fastModeData.data();
+    memmove(data + argc, data, sizeof(SmallValue) * length);
+    for (size_t i = 0; i < argc; i++) {
+        // the slot still has a copy of the moved element
+        data[i] = Value(Value::EmptyValue);
+        setFastModeElement(i, argv[i]);
+    }
+    return true;
+}
+
+ArrayObject* ArrayObject::spliceInFastMode(ExecutionState& state, uint32_t length, uint32_t start, uint32_t deleteCount, size_t itemCount, Value* items)
+{
+    if (!canChangeFastModeLength(state) || getArrayLength(state) != length) {
+        return nullptr;
+    }
+    ASSERT(start + deleteCount <= length);
+    uint64_t newLength = (uint64_t)length - deleteCount + itemCount;
+    if (newLength > ESCARGOT_ARRAY_NON_FASTMODE_MIN_SIZE) {
+        return nullptr;
+    }
+
+    ArrayObject* removed = new ArrayObject(state);
+    ASSERT(removed->isFastModeArray());
+    removed->setArrayLength(state, deleteCount, true);
+    copyFastModeElements(removed->m_fastModeData.data(), m_fastModeData.data() + start, deleteCount);
+    removed->mergeElementKind(m_elementKind);
+
+    size_t tailCount = length - start - deleteCount;
+    if (itemCount > deleteCount) {
+        setArrayLength(state, newLength, true);
+        SmallValue* data = m_fastModeData.data();
+        memmove(data + start + itemCount, data + start + deleteCount, sizeof(SmallValue) * tailCount);
+    } else if (itemCount < deleteCount) {
+        SmallValue* data = m_fastModeData.data();
+        memmove(data + start + itemCount, data + start + deleteCount, sizeof(SmallValue) * tailCount);
+        for (size_t i = newLength; i < length; i++) {
+            data[i] = Value(Value::EmptyValue);
+        }
+        setArrayLength(state, newLength);
+    }
+
+    SmallValue* data = m_fastModeData.data();
+    for (size_t i = 0; i < itemCount; i++) {
+        data[start + i] = Value(Value::EmptyValue);
+        setFastModeElement(start + i, items[i]);
+    }
+    return removed;
+}
+
+ArrayObject* ArrayObject::sliceInFastMode(ExecutionState& state, uint32_t length, uint32_t start, uint32_t end)
+{
+    if (!isFastModeArray() || getArrayLength(state) != length) {
+        return nullptr;
+    }
+    ASSERT(end <= length);
+
+    ArrayObject* array = new ArrayObject(state);
+    ASSERT(array->isFastModeArray());
+    if (start < end) {
+        array->setArrayLength(state, end - start, true);
+        copyFastModeElements(array->m_fastModeData.data(), m_fastModeData.data() + start, end - start);
+        array->mergeElementKind(m_elementKind);
+    }
+    return array;
+}
+
+bool ArrayObject::concatInFastMode(ExecutionState& state, ArrayObject* source, const Value& value)
+{
+    if (!canChangeFastModeLength(state) || (source && !source->isFastModeArray())) {
+        return false;
+    }
+    uint64_t length = getArrayLength(state);
+    uint64_t count = source ? source->getArrayLength(state) : 1;
+    if (length + count > ESCARGOT_ARRAY_NON_FASTMODE_MIN_SIZE) {
+        return false;
+    }
+
+    setArrayLength(state, length + count, true);
+    if (source) {
+        copyFastModeElements(m_fastModeData.data() + length, source->m_fastModeData.data(), count);
+        mergeElementKind(source->m_elementKind);
+    } else {
+        setFastModeElement(length, value);
+    }
+    return true;
+}
+
+bool ArrayObject::defineFastModeElement(ExecutionState& state, uint32_t idx, const Value& value)
+{
+    if (!canChangeFastModeLength(state)) {
+        return false;
+    }
+    uint32_t length = getArrayLength(state);
+    if (idx > length) {
+        return false;
+    }
+    if (idx == length) {
+        if (idx >= ESCARGOT_ARRAY_NON_FASTMODE_MIN_SIZE) {
+            return false;
+        }
+        setArrayLength(state, idx + 1, true);
+    }
+    setFastModeElement(idx, value);
+    return true;
+}
+
 ArrayIteratorObject::ArrayIteratorObject(ExecutionState& state, Object* a, Type type)
     : IteratorObject(state)
     , m_array(a)
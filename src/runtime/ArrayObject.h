@@ -31,6 +31,18 @@ namespace Escargot {
 
 extern size_t g_arrayObjectTag;
 
+// kind of the elements of a fast mode array.
+// the element type only widens (Int32 -> Double -> Generic) and a packed array only becomes holey,
+// so a kind never claims less than what the elements really are.
+// Double covers every number, and holey arrays may have EmptyValue between 0 and length.
+enum ArrayElementKind : uint8_t {
+    ArrayElementKindInt32 = 0,
+    ArrayElementKindDouble = 1,
+    ArrayElementKindGeneric = 2,
+    ArrayElementKindTypeMask = 3,
+    ArrayElementKindHoleyFlag = 4,
+};
+
 class ArrayIteratorObject;
 
 class ArrayObject : public Object {
@@ -38,6 +50,7 @@ class ArrayObject : public Object {
     friend class Context;
     friend class Object;
     friend class ByteCodeInterpreter;
+    friend class JITCompiler;
     friend Value builtinArrayConstructor(ExecutionState& state, Value thisValue, size_t argc, Value* argv, bool isNewExpression);
     friend void initializeCustomAllocators();
     friend int getValidValueInArrayObject(void* ptr, GC_mark_custom_result* arr);
@@ -60,6 +73,11 @@ public:
     }
     virtual bool deleteOwnProperty(ExecutionState& state, const ObjectPropertyName& P) ESCARGOT_OBJECT_SUBCLASS_MUST_REDEFINE override;
     virtual void enumeration(ExecutionState& state, bool (*callback)(ExecutionState& state, Object* self, const ObjectPropertyName&, const ObjectStructurePropertyDescriptor& desc, void* data), void* data, bool shouldSkipSymbolKey = true) ESCARGOT_OBJECT_SUBCLASS_MUST_REDEFINE override;
+
+    virtual bool isEnumerationCacheable() override
+    {
+        return false;
+    }
     virtual uint64_t length(ExecutionState& state) override
     {
         return getArrayLength(state);
@@ -68,6 +86,40 @@ public:
     virtual ObjectGetResult getIndexedProperty(ExecutionState& state, const Value& property) override;
     virtual bool setIndexedProperty(ExecutionState& state, const Value& property, const Value& value) override;
 
+    // typed loops of Array.prototype builtins over the fast mode elements.
+    // they return false (or nullptr) when they cannot be used, and the caller takes the generic path
+    bool indexOfInFastMode(ExecutionState& state, const Value& element, uint32_t fromIndex, uint32_t length, int64_t& result);
+    bool includesInFastMode(ExecutionState& state, const Value& element, uint32_t fromIndex, uint32_t length, bool& result);
+    bool fillInFastMode(ExecutionState& state, const Value& value, uint32_t start, uint32_t end);
+    String* joinInFastMode(ExecutionState& state, String* separator, uint32_t length);
+    bool sortInFastModeByDefaultOrder(ExecutionState& state);
+
+    // fast paths of Array.prototype builtins which move elements or change the length.
+    // they do nothing and return false (or nullptr) when the array is not a plain fast mode array,
+    // and the caller should follow the generic path of the spec then
+    bool pushInFastMode(ExecutionState& state, size_t argc, Value* argv);
+    bool shiftInFastMode(ExecutionState& state, Value& first);
+    bool unshiftInFastMode(ExecutionState& state, size_t argc, Value* argv);
+    // splice and slice also give up when user code has changed the length since the builtin read it
+    ArrayObject* spliceInFastMode(ExecutionState& state, uint32_t length, uint32_t start, uint32_t deleteCount, size_t itemCount, Value* items);
+    ArrayObject* sliceInFastMode(ExecutionState& state, uint32_t length, uint32_t start, uint32_t end);
+    // appends every element of |source|, or |value| itself when source is nullptr
+    bool concatInFastMode(ExecutionState& state, ArrayObject* source, const Value& value);
+
+    // reads an element without side effects. returns false for holes and for arrays not in fast mode
+    ALWAYS_INLINE bool getFastModeElement(ExecutionState& state, uint32_t idx, Value& value)
+    {
+        if (LIKELY(isFastModeArray() && idx < getArrayLength(state))) {
+            value = m_fastModeData[idx];
+            return !value.isEmpty();
+        }
+        return false;
+    }
+
+    // defines a {writable, enumerable, configurable} element at idx <= length, like builtins creating new arrays do.
+    // returns false when it cannot be done in fast mode
+    bool defineFastModeElement(ExecutionState& state, uint32_t idx, const Value& value);
+
     // Use custom allocator for Array object (for Badtime)
     void* operator new(size_t size);
     void* operator new[](size_t size) = delete;
@@ -104,14 +156,64 @@ protected:
         return m_values[ESCARGOT_OBJECT_BUILTIN_PROPERTY_NUMBER].toUint32(state);
     }
 
-    bool setArrayLength(ExecutionState& state, const uint64_t& newLength);
+    // when newElementsWillBeStored is true, the caller stores every slot grown right after,
+    // so growing does not make this array holey
+    bool setArrayLength(ExecutionState& state, const uint64_t& newLength, bool newElementsWillBeStored = false);
     bool defineArrayLengthProperty(ExecutionState& state, const ObjectPropertyDescriptor& desc);
     void convertIntoNonFastMode(ExecutionState& state);
 
     ObjectGetResult getFastModeValue(ExecutionState& state, const ObjectPropertyName& P);
     bool setFastModeValue(ExecutionState& state, const ObjectPropertyName& P, const ObjectPropertyDescriptor& desc);
 
+    bool isHoleyElementKind() const
+    {
+        return m_elementKind & ArrayElementKindHoleyFlag;
+    }
+
+    ArrayElementKind elementType() const
+    {
+        return (ArrayElementKind)(m_elementKind & ArrayElementKindTypeMask);
+    }
+
+    void markElementKindHoley()
+    {
+        m_elementKind |= ArrayElementKindHoleyFlag;
+    }
+
+    // for elements copied from an array of |kind|
+    void mergeElementKind(uint8_t kind)
+    {
+        uint8_t type = std::max(elementType(), (ArrayElementKind)(kind & ArrayElementKindTypeMask));
+        m_elementKind = ((m_elementKind | kind) & ArrayElementKindHoleyFlag) | type;
+    }
+
+    // fast mode arrays which are extensible and have writable length can grow and move elements freely
+    bool canChangeFastModeLength(ExecutionState& state)
+    {
+        return isFastModeArray() && isExtensible() && structure()->readProperty(state, (size_t)0).m_descriptor.isWritable();
+    }
+
+    ALWAYS_INLINE void widenElementKind(const Value& value)
+    {
+        uint8_t type = elementType();
+        if (type != ArrayElementKindGeneric) {
+            uint8_t newType = value.isInt32() ? ArrayElementKindInt32 : (value.isNumber() ? ArrayElementKindDouble : ArrayElementKindGeneric);
+            if (newType > type) {
+                m_elementKind = (m_elementKind & ArrayElementKindHoleyFlag) | newType;
+            }
+        }
+    }
+
+    // every store into m_fastModeData should go through here, to keep the element kind up to date
+    ALWAYS_INLINE void setFastModeElement(size_t idx, const Value& value)
+    {
+        ASSERT(isFastModeArray());
+        m_fastModeData[idx] = value;
+        widenElementKind(value);
+    }
+
     VectorWithNoSize<SmallValue, GCUtil::gc_malloc_ignore_off_page_allocator<SmallValue>> m_fastModeData;
+    uint8_t m_elementKind;
 };
 
 class ArrayIteratorObject : public IteratorObject {
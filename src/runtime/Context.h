@@ -75,7 +75,7 @@ public:
         return *m_scriptParser;
     }
 
-    RegExpCacheMap* regexpCache()
+    RegExpCache* regexpCache()
     {
         return m_regexpCache;
     }
@@ -218,7 +218,7 @@ protected:
     ScriptParser* m_scriptParser;
     Vector<CodeBlock*, GCUtil::gc_malloc_ignore_off_page_allocator<CodeBlock*>>& m_compiledCodeBlocks;
     WTF::BumpPointerAllocator* m_bumpPointerAllocator;
-    RegExpCacheMap* m_regexpCache;
+    RegExpCache* m_regexpCache;
     ObjectStructure* m_defaultStructureForObject;
     ObjectStructure* m_defaultStructureForFunctionObject;
     ObjectStructure* m_defaultStructureForArrowFunctionObject;
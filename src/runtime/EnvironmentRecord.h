@@ -468,6 +468,7 @@ public:
 class FunctionEnvironmentRecordOnHeap : public FunctionEnvironmentRecord {
     friend class LexicalEnvironment;
     friend class ByteCodeInterpreter;
+    friend class JITCompiler;
     friend class FunctionObject;
 
 public:
@@ -26,12 +26,14 @@ class Context;
 class LexicalEnvironment;
 class EnvironmentRecord;
 class Value;
+class SmallValue;
 
 class ExecutionContext : public gc {
     friend class FunctionObject;
     friend class ByteCodeInterpreter;
     friend class SandBox;
     friend class Script;
+    friend class JITCompiler;
 
 public:
     ExecutionContext(Context* context, ExecutionContext* parent = nullptr, LexicalEnvironment* lexicalEnvironment = nullptr, bool inStrictMode = false)
@@ -39,6 +41,7 @@ public:
         , m_context(context)
         , m_parent(parent)
         , m_lexicalEnvironment(lexicalEnvironment)
+        , m_closureDisplay(nullptr)
     {
     }
 
@@ -69,6 +72,8 @@ private:
     Context* m_context;
     ExecutionContext* m_parent;
     LexicalEnvironment* m_lexicalEnvironment;
+    // FunctionObject::closureDisplay of the running function. contexts of catch and with bodies share it
+    SmallValue** m_closureDisplay;
 };
 }
 
@@ -34,10 +34,15 @@ typedef Vector<ControlFlowRecord*, GCUtil::gc_malloc_ignore_off_page_allocator<C
 struct ExecutionStateRareData : public gc {
     Vector<ControlFlowRecord*, GCUtil::gc_malloc_ignore_off_page_allocator<ControlFlowRecord*>>* m_controlFlowRecord;
     ExecutionState* m_parent;
+    // set by a throw in a try body which is caught by the same ByteCodeBlock.
+    // it returns from the activation of the try body instead of unwinding with a C++ exception,
+    // and the value is kept in the exception slot of SandBox
+    bool m_hasPendingException;
     ExecutionStateRareData()
     {
         m_controlFlowRecord = nullptr;
         m_parent = nullptr;
+        m_hasPendingException = false;
     }
 };
 
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2018-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#include "Escargot.h"
+#include "ExternalString.h"
+
+#if defined(OS_POSIX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Escargot {
+
+void* ExternalString::operator new(size_t size)
+{
+    // the buffer is outside of the GC heap, and m_releaseData belongs to the embedder
+    return GC_MALLOC_ATOMIC(size);
+}
+
+void ExternalString::registerReleaseCallback(ReleaseCallback release, void* releaseData)
+{
+    m_release = release;
+    m_releaseData = releaseData;
+    if (release) {
+        GC_REGISTER_FINALIZER_NO_ORDER(this, [](void* obj,
+                                                void*) {
+            ExternalString* self = (ExternalString*)obj;
+            self->m_release(self->m_bufferAccessData.buffer, self->m_bufferAccessData.length, self->m_releaseData);
+        },
+                                       nullptr, nullptr, nullptr);
+    }
+}
+
+UTF16StringData ExternalString::toUTF16StringData() const
+{
+    if (!m_bufferAccessData.has8BitContent) {
+        return UTF16StringData(characters16(), length());
+    }
+    UTF16StringData ret;
+    size_t len = length();
+    ret.resizeWithUninitializedValues(len);
+    for (size_t i = 0; i < len; i++) {
+        ret[i] = m_bufferAccessData.uncheckedCharAtFor8Bit(i);
+    }
+    return ret;
+}
+
+UTF8StringData ExternalString::toUTF8StringData() const
+{
+    return m_bufferAccessData.toUTF8String<UTF8StringData>();
+}
+
+UTF8StringDataNonGCStd ExternalString::toNonGCUTF8StringData() const
+{
+    return m_bufferAccessData.toUTF8String<UTF8StringDataNonGCStd>();
+}
+
+static void freeMallocedBuffer(const void* buffer, size_t length, void* data)
+{
+    free(const_cast<void*>(buffer));
+}
+
+String* ExternalString::createFromUTF8(const char* buffer, size_t length, ReleaseCallback release, void* releaseData)
+{
+    if (length == 0) {
+        if (release) {
+            release(buffer, length, releaseData);
+        }
+        return String::emptyString;
+    }
+
+    if (isAllASCII(buffer, length)) {
+        return new ExternalString((const LChar*)buffer, length, release, releaseData);
+    }
+
+    // non-ASCII content is decoded only once, and still kept out of the GC heap
+    UTF16StringDataNonGCStd decoded = utf8StringToNonGCUTF16String(buffer, length);
+    if (release) {
+        release(buffer, length, releaseData);
+    }
+
+    size_t decodedLength = decoded.length();
+    if (isAllLatin1(decoded.data(), decodedLength)) {
+        LChar* latin1 = (LChar*)malloc(decodedLength);
+        for (size_t i = 0; i < decodedLength; i++) {
+            latin1[i] = (LChar)decoded[i];
+        }
+        return new ExternalString(latin1, decodedLength, freeMallocedBuffer, nullptr);
+    }
+
+    char16_t* utf16 = (char16_t*)malloc(decodedLength * sizeof(char16_t));
+    memcpy(utf16, decoded.data(), decodedLength * sizeof(char16_t));
+    return new ExternalString(utf16, decodedLength, freeMallocedBuffer, nullptr);
+}
+
+#if defined(OS_POSIX)
+static void unmapFile(const void* buffer, size_t length, void* data)
+{
+    munmap(const_cast<void*>(buffer), length);
+}
+#endif
+
+String* ExternalString::createFromFile(const char* fileName)
+{
+#if defined(OS_POSIX)
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+        size_t length = st.st_size;
+        if (length == 0) {
+            close(fd);
+            return String::emptyString;
+        }
+        void* mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (mapped == MAP_FAILED) {
+            return nullptr;
+        }
+        return createFromUTF8((const char*)mapped, length, unmapFile, nullptr);
+    }
+    close(fd);
+#endif
+
+    // pipes, devices and platforms without mmap are read into a malloc-ed buffer instead
+    FILE* fp = fopen(fileName, "rb");
+    if (!fp) {
+        return nullptr;
+    }
+
+    size_t length = 0;
+    size_t capacity = 4096;
+    char* buffer = (char*)malloc(capacity);
+    while (true) {
+        length += fread(buffer + length, 1, capacity - length, fp);
+        if (length < capacity) {
+            break;
+        }
+        capacity *= 2;
+        buffer = (char*)realloc(buffer, capacity);
+    }
+    bool failed = ferror(fp);
+    fclose(fp);
+
+    if (failed) {
+        free(buffer);
+        return nullptr;
+    }
+    return createFromUTF8(buffer, length, freeMallocedBuffer, nullptr);
+}
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2018-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotExternalString__
+#define __EscargotExternalString__
+
+#include "runtime/String.h"
+
+namespace Escargot {
+
+// String whose characters live outside of the GC heap (an mmapped file or a buffer owned by the embedder).
+// Only the String object itself is allocated by GC; the buffer is never scanned nor copied,
+// and |release| is called with the original buffer when the string is collected.
+class ExternalString : public String {
+public:
+    // |length| is the number of characters of |buffer|
+    typedef void (*ReleaseCallback)(const void* buffer, size_t length, void* data);
+
+    ExternalString(const LChar* buffer, size_t length, ReleaseCallback release, void* releaseData)
+        : String()
+    {
+        m_bufferAccessData.has8BitContent = true;
+        m_bufferAccessData.length = length;
+        m_bufferAccessData.buffer = buffer;
+        registerReleaseCallback(release, releaseData);
+    }
+
+    ExternalString(const char16_t* buffer, size_t length, ReleaseCallback release, void* releaseData)
+        : String()
+    {
+        m_bufferAccessData.has8BitContent = false;
+        m_bufferAccessData.length = length;
+        m_bufferAccessData.buffer = buffer;
+        registerReleaseCallback(release, releaseData);
+    }
+
+    // Validates |buffer| once: ASCII content is wrapped as is,
+    // otherwise it is decoded into a malloc-ed Latin-1 or UTF-16 buffer and |release| is called immediately.
+    static String* createFromUTF8(const char* buffer, size_t length, ReleaseCallback release, void* releaseData);
+    // Maps |fileName| read-only where mmap is available.
+    // returns nullptr if the file cannot be read
+    static String* createFromFile(const char* fileName);
+
+    virtual char16_t charAt(const size_t& idx) const
+    {
+        return m_bufferAccessData.charAt(idx);
+    }
+
+    virtual size_t length() const
+    {
+        return m_bufferAccessData.length;
+    }
+
+    virtual const LChar* characters8() const
+    {
+        ASSERT(m_bufferAccessData.has8BitContent);
+        return (const LChar*)m_bufferAccessData.buffer;
+    }
+
+    virtual const char16_t* characters16() const
+    {
+        ASSERT(!m_bufferAccessData.has8BitContent);
+        return (const char16_t*)m_bufferAccessData.buffer;
+    }
+
+    virtual UTF16StringData toUTF16StringData() const;
+    virtual UTF8StringData toUTF8StringData() const;
+    virtual UTF8StringDataNonGCStd toNonGCUTF8StringData() const;
+
+    // the release callback is registered as a finalizer, so ExternalString is always allocated by GC
+    void* operator new(size_t size);
+    void* operator new[](size_t size) = delete;
+
+protected:
+    void registerReleaseCallback(ReleaseCallback release, void* releaseData);
+
+    ReleaseCallback m_release;
+    void* m_releaseData;
+};
+}
+
+#endif
@@ -94,6 +94,7 @@ FunctionObject::FunctionObject(ExecutionState& state, CodeBlock* codeBlock, ForG
     : Object(state, ESCARGOT_OBJECT_BUILTIN_PROPERTY_NUMBER + 2, false)
     , m_codeBlock(codeBlock)
     , m_outerEnvironment(nullptr)
+    , m_closureDisplay(nullptr)
 {
     ASSERT(!isConstructor());
     initFunctionObject(state);
@@ -103,6 +104,7 @@ FunctionObject::FunctionObject(ExecutionState& state, CodeBlock* codeBlock, ForB
     : Object(state, codeBlock->isConstructor() ? (ESCARGOT_OBJECT_BUILTIN_PROPERTY_NUMBER + 3) : (ESCARGOT_OBJECT_BUILTIN_PROPERTY_NUMBER + 2), false)
     , m_codeBlock(codeBlock)
     , m_outerEnvironment(nullptr)
+    , m_closureDisplay(nullptr)
 {
     initFunctionObject(state);
     setPrototype(state, state.context()->globalObject()->functionPrototype());
@@ -114,6 +116,7 @@ FunctionObject::FunctionObject(ExecutionState& state, NativeFunctionInfo info)
     : Object(state, info.m_isConstructor ? (ESCARGOT_OBJECT_BUILTIN_PROPERTY_NUMBER + 3) : (ESCARGOT_OBJECT_BUILTIN_PROPERTY_NUMBER + 2), false)
     , m_codeBlock(new CodeBlock(state.context(), info))
     , m_outerEnvironment(nullptr)
+    , m_closureDisplay(nullptr)
 {
     initFunctionObject(state);
     setPrototype(state, state.context()->globalObject()->functionPrototype());
@@ -123,6 +126,7 @@ FunctionObject::FunctionObject(ExecutionState& state, NativeFunctionInfo info, F
     : Object(state, ESCARGOT_OBJECT_BUILTIN_PROPERTY_NUMBER + 3, false)
     , m_codeBlock(new CodeBlock(state.context(), info))
     , m_outerEnvironment(nullptr)
+    , m_closureDisplay(nullptr)
 {
     ASSERT(isConstructor());
     initFunctionObject(state);
@@ -136,6 +140,7 @@ FunctionObject::FunctionObject(ExecutionState& state, CodeBlock* codeBlock, Lexi
              false)
     , m_codeBlock(codeBlock)
     , m_outerEnvironment(outerEnv)
+    , m_closureDisplay(nullptr)
 {
     initFunctionObject(state);
     setPrototype(state, state.context()->globalObject()->functionPrototype());
@@ -147,6 +152,7 @@ FunctionObject::FunctionObject(ExecutionState& state, CodeBlock* codeBlock, Stri
              false)
     , m_codeBlock(codeBlock)
     , m_outerEnvironment(nullptr)
+    , m_closureDisplay(nullptr)
 {
     m_values[ESCARGOT_OBJECT_BUILTIN_PROPERTY_NUMBER + 0] = Value(name);
     initFunctionObject(state);
@@ -173,46 +179,65 @@ bool FunctionObject::hasInstance(ExecutionState& state, const Value& left)
     return false;
 }
 
-NEVER_INLINE void FunctionObject::generateBytecodeBlock(ExecutionState& state)
+// evicts least recently used ByteCodeBlocks until byte code size reaches the low-water mark of the budget
+void FunctionObject::evictColdByteCodeBlocks(ExecutionState& state)
 {
+    VMInstance* vmInstance = state.context()->vmInstance();
     Vector<CodeBlock*, GCUtil::gc_malloc_ignore_off_page_allocator<CodeBlock*>>& v = state.context()->compiledCodeBlocks();
 
-    auto& currentCodeSizeTotal = state.context()->vmInstance()->compiledByteCodeSize();
-
-    if (currentCodeSizeTotal > FUNCTION_OBJECT_BYTECODE_SIZE_MAX) {
-        currentCodeSizeTotal = 0;
-        std::vector<CodeBlock*, gc_allocator<CodeBlock*>> codeBlocksInCurrentStack;
-
-        ExecutionContext* ec = state.executionContext();
-        while (ec) {
-            auto env = ec->lexicalEnvironment();
-            if (env->record()->isDeclarativeEnvironmentRecord() && env->record()->asDeclarativeEnvironmentRecord()->isFunctionEnvironmentRecord()) {
-                if (env->record()->asDeclarativeEnvironmentRecord()->asFunctionEnvironmentRecord()->functionObject()->codeBlock()->isInterpretedCodeBlock()) {
-                    InterpretedCodeBlock* cblk = env->record()->asDeclarativeEnvironmentRecord()->asFunctionEnvironmentRecord()->functionObject()->codeBlock()->asInterpretedCodeBlock();
-                    if (cblk->script() && cblk->byteCodeBlock()) {
-                        if (std::find(codeBlocksInCurrentStack.begin(), codeBlocksInCurrentStack.end(), cblk) == codeBlocksInCurrentStack.end()) {
-                            codeBlocksInCurrentStack.push_back(cblk);
-                        }
+    std::vector<CodeBlock*, gc_allocator<CodeBlock*>> codeBlocksInCurrentStack;
+    ExecutionContext* ec = state.executionContext();
+    while (ec) {
+        auto env = ec->lexicalEnvironment();
+        if (env->record()->isDeclarativeEnvironmentRecord() && env->record()->asDeclarativeEnvironmentRecord()->isFunctionEnvironmentRecord()) {
+            if (env->record()->asDeclarativeEnvironmentRecord()->asFunctionEnvironmentRecord()->functionObject()->codeBlock()->isInterpretedCodeBlock()) {
+                InterpretedCodeBlock* cblk = env->record()->asDeclarativeEnvironmentRecord()->asFunctionEnvironmentRecord()->functionObject()->codeBlock()->asInterpretedCodeBlock();
+                if (cblk->script() && cblk->byteCodeBlock()) {
+                    if (std::find(codeBlocksInCurrentStack.begin(), codeBlocksInCurrentStack.end(), cblk) == codeBlocksInCurrentStack.end()) {
+                        codeBlocksInCurrentStack.push_back(cblk);
                     }
                 }
             }
-            ec = ec->parent();
         }
+        ec = ec->parent();
+    }
 
-        for (size_t i = 0; i < v.size(); i++) {
-            if (std::find(codeBlocksInCurrentStack.begin(), codeBlocksInCurrentStack.end(), v[i]) == codeBlocksInCurrentStack.end()) {
-                v[i]->m_byteCodeBlock = nullptr;
-            }
-        }
+    std::sort(v.data(), v.data() + v.size(), [](CodeBlock* a, CodeBlock* b) -> bool {
+        return a->asInterpretedCodeBlock()->m_byteCodeBlockLastUsedEpoch < b->asInterpretedCodeBlock()->m_byteCodeBlockLastUsedEpoch;
+    });
 
-        v.clear();
-        v.resizeWithUninitializedValues(codeBlocksInCurrentStack.size());
+    // sizes of ByteCodeBlocks grow after generation (inline caches), so recompute the total here
+    size_t total = 0;
+    for (size_t i = 0; i < v.size(); i++) {
+        total += v[i]->m_byteCodeBlock->memoryAllocatedSize();
+    }
 
-        for (size_t i = 0; i < codeBlocksInCurrentStack.size(); i++) {
-            v[i] = codeBlocksInCurrentStack[i];
-            currentCodeSizeTotal += v[i]->m_byteCodeBlock->memoryAllocatedSize();
+    size_t lowWaterMark = vmInstance->byteCodeSizeBudget() / 100 * FUNCTION_OBJECT_BYTECODE_SIZE_LOW_WATER_MARK_PERCENT;
+    size_t remainCount = 0;
+    for (size_t i = 0; i < v.size(); i++) {
+        InterpretedCodeBlock* cblk = v[i]->asInterpretedCodeBlock();
+        if (total > lowWaterMark && std::find(codeBlocksInCurrentStack.begin(), codeBlocksInCurrentStack.end(), cblk) == codeBlocksInCurrentStack.end()) {
+            total -= cblk->m_byteCodeBlock->memoryAllocatedSize();
+            cblk->m_byteCodeBlock = nullptr;
+            cblk->m_isByteCodeBlockEvicted = true;
+            vmInstance->byteCodeBlockEvictionCount()++;
+        } else {
+            v[remainCount++] = cblk;
         }
     }
+    v.resizeWithUninitializedValues(remainCount);
+
+    vmInstance->compiledByteCodeSize() = total;
+}
+
+NEVER_INLINE void FunctionObject::generateBytecodeBlock(ExecutionState& state)
+{
+    VMInstance* vmInstance = state.context()->vmInstance();
+    auto& currentCodeSizeTotal = vmInstance->compiledByteCodeSize();
+
+    if (currentCodeSizeTotal > vmInstance->byteCodeSizeBudget()) {
+        evictColdByteCodeBlocks(state);
+    }
     ASSERT(!m_codeBlock->hasCallNativeFunctionCode());
 
     volatile int sp;
@@ -223,16 +248,22 @@ NEVER_INLINE void FunctionObject::generateBytecodeBlock(ExecutionState& state)
     size_t stackRemainApprox = STACK_LIMIT_FROM_BASE - (currentStackBase - state.stackBase());
 #endif
 
-
-    auto ret = state.context()->scriptParser().parseFunction(m_codeBlock->asInterpretedCodeBlock(), stackRemainApprox, &state);
+    InterpretedCodeBlock* codeBlock = m_codeBlock->asInterpretedCodeBlock();
+    auto ret = state.context()->scriptParser().parseFunction(codeBlock, stackRemainApprox, &state);
     RefPtr<Node> ast = std::get<0>(ret);
 
     ByteCodeGenerator g;
-    m_codeBlock->m_byteCodeBlock = g.generateByteCode(state.context(), m_codeBlock->asInterpretedCodeBlock(), ast.get(), std::get<1>(ret), false, false, false);
+    codeBlock->m_byteCodeBlock = g.generateByteCode(state.context(), codeBlock, ast.get(), std::get<1>(ret), false, false, false);
+    codeBlock->m_byteCodeBlockGeneration++;
 
-    v.pushBack(m_codeBlock);
+    if (codeBlock->m_isByteCodeBlockEvicted) {
+        codeBlock->m_isByteCodeBlockEvicted = false;
+        vmInstance->byteCodeBlockRegenerationCount()++;
+    }
+    codeBlock->m_byteCodeBlockLastUsedEpoch = vmInstance->advanceByteCodeBlockEpoch();
+    state.context()->compiledCodeBlocks().pushBack(m_codeBlock);
 
-    currentCodeSizeTotal += m_codeBlock->m_byteCodeBlock->memoryAllocatedSize();
+    currentCodeSizeTotal += codeBlock->m_byteCodeBlock->memoryAllocatedSize();
 }
 
 Value FunctionObject::callSlowCase(ExecutionState& state, const Value& callee, const Value& receiver, const size_t& argc, Value* argv, bool isNewExpression)
@@ -263,6 +294,7 @@ Object* FunctionObject::newInstance(ExecutionState& state, const size_t& argc, V
         receiver = cb->nativeFunctionData()->m_ctorFn(state, cb, argc, argv);
     } else {
         receiver = new Object(state);
+        receiver->reservePropertyStorage(cb->asInterpretedCodeBlock()->m_constructedObjectPropertyCount);
     }
 
     if (targetFunction->getFunctionPrototype(state).isObject())
@@ -273,8 +305,16 @@ Object* FunctionObject::newInstance(ExecutionState& state, const size_t& argc, V
     Value res = processCall(state, receiver, argc, argv, true);
     if (res.isObject())
         return res.asObject();
-    else
-        return receiver;
+
+    if (!cb->hasCallNativeFunctionCode()) {
+        // slack tracking. later objects reserve storage for what this one got in the constructor
+        InterpretedCodeBlock* interpretedCodeBlock = cb->asInterpretedCodeBlock();
+        size_t propertyCount = std::min(receiver->m_structure->propertyCount(), (size_t)OBJECT_CONSTRUCTOR_SLACK_PROPERTY_COUNT_MAX);
+        if (propertyCount > interpretedCodeBlock->m_constructedObjectPropertyCount) {
+            interpretedCodeBlock->m_constructedObjectPropertyCount = propertyCount;
+        }
+    }
+    return receiver;
 }
 
 Value FunctionObject::processCall(ExecutionState& state, const Value& receiverSrc, const size_t& argc, Value* argv, bool isNewExpression)
@@ -329,12 +369,62 @@ Value FunctionObject::processCall(ExecutionState& state, const Value& receiverSr
         }
     }
 
+    ByteCodeBlock* blk = prepareByteCodeBlock(state);
+    ExecutionState* newState = initializeInterpretedCallFrame(state, blk, alloca(interpretedCallFrameSize(m_codeBlock->asInterpretedCodeBlock(), blk)), receiverSrc, argc, argv);
+
+    // run function
+    size_t unused;
+    const Value returnValue = ByteCodeInterpreter::interpret(*newState, blk, 0, newState->registerFile(), &unused);
+    if (UNLIKELY(blk->m_shouldClearStack))
+        clearStack<512>();
+
+    return returnValue;
+}
+
+ByteCodeBlock* FunctionObject::prepareByteCodeBlock(ExecutionState& state)
+{
     // prepare ByteCodeBlock if needed
     if (UNLIKELY(m_codeBlock->asInterpretedCodeBlock()->byteCodeBlock() == nullptr)) {
         generateBytecodeBlock(state);
     }
+    m_codeBlock->asInterpretedCodeBlock()->m_byteCodeBlockLastUsedEpoch = m_codeBlock->context()->vmInstance()->byteCodeBlockEpoch();
+    return m_codeBlock->asInterpretedCodeBlock()->byteCodeBlock();
+}
+
+size_t FunctionObject::interpretedCallFrameSize(InterpretedCodeBlock* codeBlock, ByteCodeBlock* blk)
+{
+    size_t valueCount = blk->m_requiredRegisterFileSizeInValueSize + codeBlock->identifierOnStackCount() + blk->m_numeralLiteralData.size();
+    size_t size = valueCount * sizeof(Value) + sizeof(ExecutionState);
+    if (LIKELY(codeBlock->canAllocateEnvironmentOnStack())) {
+        size += sizeof(FunctionEnvironmentRecordSimple) + sizeof(ExecutionContext) + sizeof(LexicalEnvironment);
+    }
+    return size;
+}
+
+void FunctionObject::fillInterpretedCallFrameLayout(InterpretedCodeBlock* codeBlock, ByteCodeBlock* blk, InterpretedCallFrameLayout& layout)
+{
+    layout.m_frameSize = interpretedCallFrameSize(codeBlock, blk);
+    layout.m_registerSize = blk->m_requiredRegisterFileSizeInValueSize;
+    layout.m_stackStorageSize = codeBlock->identifierOnStackCount();
+    layout.m_literalStorageSize = blk->m_numeralLiteralData.size();
+    layout.m_parameterCount = codeBlock->parameterCount();
+    layout.m_isStrict = codeBlock->isStrict();
+    layout.m_isSimple = codeBlock->canAllocateEnvironmentOnStack() && !codeBlock->needsComplexParameterCopy() && !codeBlock->usesArgumentsObject()
+        && !codeBlock->m_isFunctionNameSaveOnHeap && !codeBlock->m_isFunctionNameExplicitlyDeclared;
+    if (codeBlock->isArrowFunctionExpression()) {
+        layout.m_receiverMode = InterpretedCallFrameLayout::ReceiverGlobalObject;
+    } else if (codeBlock->isStrict()) {
+        layout.m_receiverMode = InterpretedCallFrameLayout::ReceiverAsIs;
+    } else {
+        layout.m_receiverMode = InterpretedCallFrameLayout::ReceiverToObject;
+    }
+}
 
-    ByteCodeBlock* blk = m_codeBlock->asInterpretedCodeBlock()->byteCodeBlock();
+// frame layout: [register file | stack storage | literal storage] ExecutionState [record, ExecutionContext, LexicalEnvironment]
+ExecutionState* FunctionObject::initializeInterpretedCallFrame(ExecutionState& state, ByteCodeBlock* blk, void* frame, const Value& receiverSrc, const size_t& argc, Value* argv)
+{
+    Context* ctx = m_codeBlock->context();
+    bool isStrict = m_codeBlock->isStrict();
 
     size_t registerSize = blk->m_requiredRegisterFileSizeInValueSize;
     size_t stackStorageSize = m_codeBlock->asInterpretedCodeBlock()->identifierOnStackCount();
@@ -342,14 +432,22 @@ Value FunctionObject::processCall(ExecutionState& state, const Value& receiverSr
     Value* literalStorageSrc = blk->m_numeralLiteralData.data();
     size_t parameterCopySize = std::min(argc, (size_t)m_codeBlock->parameterCount());
 
+    Value* registerFile = (Value*)frame;
+    Value* stackStorage = registerFile + registerSize;
+    char* frameObjects = (char*)(stackStorage + stackStorageSize + literalStorageSize);
+    ExecutionState* newState = (ExecutionState*)frameObjects;
+    frameObjects += sizeof(ExecutionState);
+
     // prepare env, ec
     FunctionEnvironmentRecord* record;
     ExecutionContext* ec;
 
     if (LIKELY(m_codeBlock->canAllocateEnvironmentOnStack())) {
         // no capture, very simple case
-        record = new (alloca(sizeof(FunctionEnvironmentRecordSimple))) FunctionEnvironmentRecordSimple(this);
-        ec = new (alloca(sizeof(ExecutionContext))) ExecutionContext(ctx, state.executionContext(), new (alloca(sizeof(LexicalEnvironment))) LexicalEnvironment(record, outerEnvironment()), isStrict);
+        record = new (frameObjects) FunctionEnvironmentRecordSimple(this);
+        frameObjects += sizeof(FunctionEnvironmentRecordSimple);
+        LexicalEnvironment* env = new (frameObjects + sizeof(ExecutionContext)) LexicalEnvironment(record, outerEnvironment());
+        ec = new (frameObjects) ExecutionContext(ctx, state.executionContext(), env, isStrict);
     } else {
         if (LIKELY(m_codeBlock->canUseIndexedVariableStorage())) {
             record = new FunctionEnvironmentRecordOnHeap(this, argc, argv);
@@ -362,9 +460,7 @@ Value FunctionObject::processCall(ExecutionState& state, const Value& receiverSr
         }
         ec = new ExecutionContext(ctx, state.executionContext(), new LexicalEnvironment(record, outerEnvironment()), isStrict);
     }
-
-    Value* registerFile = (Value*)alloca((registerSize + stackStorageSize + literalStorageSize) * sizeof(Value));
-    Value* stackStorage = registerFile + registerSize;
+    ec->m_closureDisplay = closureDisplay(blk);
 
     {
         Value* literalStorage = stackStorage + stackStorageSize;
@@ -456,19 +552,83 @@ Value FunctionObject::processCall(ExecutionState& state, const Value& receiverSr
         }
     }
 
-    ExecutionState newState(ctx, &state, ec, registerFile);
+    new (newState) ExecutionState(ctx, &state, ec, registerFile);
 
-    if (UNLIKELY(m_codeBlock->usesArgumentsObject())) {
-        generateArgumentsObject(newState, record, stackStorage);
+    // the code may read arguments.length and arguments[property] without it, see GetArgumentsLength
+    if (UNLIKELY(m_codeBlock->usesArgumentsObject()) && blk->m_needsArgumentsObject) {
+        generateArgumentsObject(*newState, record, stackStorage);
     }
 
-    // run function
-    size_t unused;
-    const Value returnValue = ByteCodeInterpreter::interpret(newState, blk, 0, registerFile, &unused);
-    if (UNLIKELY(blk->m_shouldClearStack))
-        clearStack<512>();
+    return newState;
+}
 
-    return returnValue;
+ExecutionState* FunctionObject::initializeSimpleInterpretedCallFrame(ExecutionState& state, ByteCodeBlock* blk, const InterpretedCallFrameLayout& layout, void* frame, const Value& receiverSrc, const size_t& argc, Value* argv)
+{
+    ASSERT(layout.m_isSimple);
+    Context* ctx = m_codeBlock->context();
+
+    Value* registerFile = (Value*)frame;
+    Value* stackStorage = registerFile + layout.m_registerSize;
+    Value* literalStorage = stackStorage + layout.m_stackStorageSize;
+    const Value* literalStorageSrc = blk->m_numeralLiteralData.data();
+    for (size_t i = 0; i < layout.m_literalStorageSize; i++) {
+        literalStorage[i] = literalStorageSrc[i];
+    }
+
+    char* frameObjects = (char*)(literalStorage + layout.m_literalStorageSize);
+    ExecutionState* newState = (ExecutionState*)frameObjects;
+    FunctionEnvironmentRecord* record = new (frameObjects + sizeof(ExecutionState)) FunctionEnvironmentRecordSimple(this);
+    frameObjects += sizeof(ExecutionState) + sizeof(FunctionEnvironmentRecordSimple);
+    LexicalEnvironment* env = new (frameObjects + sizeof(ExecutionContext)) LexicalEnvironment(record, outerEnvironment());
+    ExecutionContext* ec = new (frameObjects) ExecutionContext(ctx, state.executionContext(), env, layout.m_isStrict);
+    ec->m_closureDisplay = closureDisplay(blk);
+
+    if (LIKELY(layout.m_receiverMode == InterpretedCallFrameLayout::ReceiverAsIs)) {
+        stackStorage[0] = receiverSrc;
+    } else if (layout.m_receiverMode == InterpretedCallFrameLayout::ReceiverToObject && !receiverSrc.isUndefinedOrNull()) {
+        stackStorage[0] = receiverSrc.toObject(state);
+    } else {
+        stackStorage[0] = ctx->globalObject();
+    }
+    stackStorage[1] = this;
+
+    size_t parameterCopySize = std::min(argc, (size_t)layout.m_parameterCount);
+    for (size_t i = 0; i < parameterCopySize; i++) {
+        stackStorage[i + 2] = argv[i];
+    }
+    for (size_t i = parameterCopySize + 2; i < layout.m_stackStorageSize; i++) {
+        stackStorage[i] = Value();
+    }
+
+    return new (newState) ExecutionState(ctx, &state, ec, registerFile);
+}
+
+SmallValue** FunctionObject::closureDisplay(ByteCodeBlock* blk)
+{
+    if (LIKELY(m_closureDisplay != nullptr) || blk->m_closureDisplaySize == 0) {
+        return m_closureDisplay;
+    }
+    return buildClosureDisplay(blk);
+}
+
+NEVER_INLINE SmallValue** FunctionObject::buildClosureDisplay(ByteCodeBlock* blk)
+{
+    size_t size = blk->m_closureDisplaySize;
+    SmallValue** display = (SmallValue**)GC_MALLOC(sizeof(SmallValue*) * size);
+    LexicalEnvironment* env = m_outerEnvironment;
+    for (size_t i = 0; i < size; i++) {
+        // levels between the accessed ones may keep nothing on the heap
+        EnvironmentRecord* record = env->record();
+        if (record->isDeclarativeEnvironmentRecord() && record->asDeclarativeEnvironmentRecord()->isFunctionEnvironmentRecord()
+            && record->asDeclarativeEnvironmentRecord()->asFunctionEnvironmentRecord()->isFunctionEnvironmentRecordOnHeap()) {
+            display[i] = ((FunctionEnvironmentRecordOnHeap*)record)->m_heapStorage.data();
+        } else {
+            display[i] = nullptr;
+        }
+        env = env->outerEnvironment();
+    }
+    m_closureDisplay = display;
+    return display;
 }
 
 void FunctionObject::generateArgumentsObject(ExecutionState& state, FunctionEnvironmentRecord* fnRecord, Value* stackStorage)
@@ -29,10 +29,12 @@ namespace Escargot {
 extern size_t g_functionObjectTag;
 
 class FunctionEnvironmentRecord;
+struct InterpretedCallFrameLayout;
 
 class FunctionObject : public Object {
     friend class GlobalObject;
     friend class Script;
+    friend class ByteCodeInterpreter;
     void initFunctionObject(ExecutionState& state);
 
     enum ForGlobalBuiltin { __ForGlobalBuiltin__ };
@@ -133,9 +135,24 @@ protected:
     Value processCall(ExecutionState& state, const Value& receiver, const size_t& argc, Value* argv, bool isNewExpression);
     static Value callSlowCase(ExecutionState& state, const Value& callee, const Value& receiver, const size_t& argc, Value* argv, bool isNewExpression);
     void generateArgumentsObject(ExecutionState& state, FunctionEnvironmentRecord* fnRecord, Value* stackStorage);
+
+    // a call of an interpreted function keeps its register file, ExecutionState and environment in one frame.
+    // processCall allocates the frame on the native stack, ByteCodeInterpreter on the frame stack of VMInstance
+    ByteCodeBlock* prepareByteCodeBlock(ExecutionState& state);
+    static size_t interpretedCallFrameSize(InterpretedCodeBlock* codeBlock, ByteCodeBlock* blk);
+    static void fillInterpretedCallFrameLayout(InterpretedCodeBlock* codeBlock, ByteCodeBlock* blk, InterpretedCallFrameLayout& layout);
+    ExecutionState* initializeInterpretedCallFrame(ExecutionState& state, ByteCodeBlock* blk, void* frame, const Value& receiverSrc, const size_t& argc, Value* argv);
+    // same as initializeInterpretedCallFrame for a frame whose layout is simple
+    ExecutionState* initializeSimpleInterpretedCallFrame(ExecutionState& state, ByteCodeBlock* blk, const InterpretedCallFrameLayout& layout, void* frame, const Value& receiverSrc, const size_t& argc, Value* argv);
     void generateBytecodeBlock(ExecutionState& state);
+    static void evictColdByteCodeBlocks(ExecutionState& state);
+    // heap storage of the upper function environments, display[i] is the one i + 1 levels above this function.
+    // the outer environment never changes, so it is built on the first call which needs it
+    SmallValue** closureDisplay(ByteCodeBlock* blk);
+    SmallValue** buildClosureDisplay(ByteCodeBlock* blk);
     CodeBlock* m_codeBlock;
     LexicalEnvironment* m_outerEnvironment;
+    SmallValue** m_closureDisplay;
 };
 }
 
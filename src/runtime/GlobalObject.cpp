@@ -28,6 +28,7 @@
 #include "Context.h"
 #include "ErrorObject.h"
 #include "StringObject.h"
+#include "ExternalString.h"
 #include "NumberObject.h"
 #include "DateObject.h"
 #include "parser/ScriptParser.h"
@@ -51,41 +52,9 @@ static Value builtinPrint(ExecutionState& state, Value thisValue, size_t argc, V
 
 static String* builtinHelperFileRead(ExecutionState& state, const char* fileName, AtomicString builtinName)
 {
-    FILE* fp = fopen(fileName, "r");
-    String* src = String::emptyString;
-    if (fp) {
-        std::string utf8Str;
-        Latin1StringDataNonGCStd str;
-        char buf[512];
-        bool hasNonLatin1Content = false;
-        while (fgets(buf, sizeof buf, fp) != NULL) {
-            if (!hasNonLatin1Content) {
-                const char* source = buf;
-                size_t len = strlen(buf);
-                int charlen;
-                bool valid;
-                while (source < buf + len) {
-                    char32_t ch = readUTF8Sequence(source, valid, charlen);
-                    if (ch > 255) {
-                        hasNonLatin1Content = true;
-                        fseek(fp, 0, SEEK_SET);
-                        break;
-                    } else {
-                        str += (LChar)ch;
-                    }
-                }
-            } else {
-                utf8Str += buf;
-            }
-        }
-        fclose(fp);
-        if (hasNonLatin1Content) {
-            auto s = utf8StringToUTF16String(utf8Str.data(), utf8Str.length());
-            src = new UTF16String(std::move(s));
-        } else {
-            src = new Latin1String(str.data(), str.length());
-        }
-    } else {
+    // the file is mapped rather than copied into the GC heap; see ExternalString
+    String* src = ExternalString::createFromFile(fileName);
+    if (!src) {
         char msg[1024];
         snprintf(msg, sizeof(msg), "%%s: cannot open file %s", fileName);
         String* globalObjectString = state.context()->staticStrings().GlobalObject.string();
@@ -53,14 +53,14 @@ Value builtinArrayConstructor(ExecutionState& state, Value thisValue, size_t arg
         array = new ArrayObject(state);
     }
 
-    array->setArrayLength(state, size);
+    array->setArrayLength(state, size, interpretArgumentsAsElements);
 
     if (interpretArgumentsAsElements) {
         Value val = argv[0];
         if (argc > 1 || !val.isInt32()) {
             if (array->isFastModeArray()) {
                 for (size_t idx = 0; idx < argc; idx++) {
-                    array->m_fastModeData[idx] = argv[idx];
+                    array->setFastModeElement(idx, argv[idx]);
                 }
             } else {
                 for (size_t idx = 0; idx < argc; idx++) {
@@ -239,6 +239,13 @@ static Value builtinArrayJoin(ExecutionState& state, Value thisValue, size_t arg
     }
     ToStringRecursionPreventerItemAutoHolder holder(state, thisBinded);
 
+    if (thisBinded->isArrayObject()) {
+        String* result = thisBinded->asArrayObject()->joinInFastMode(state, sep, len);
+        if (result) {
+            return result;
+        }
+    }
+
     StringBuilder builder;
     double prevIndex = 0;
     double curIndex = 0;
@@ -347,6 +354,10 @@ static Value builtinArraySort(ExecutionState& state, Value thisValue, size_t arg
     }
     bool defaultSort = (argc == 0) || cmpfn.isUndefined();
 
+    if (defaultSort && thisObject->isArrayObject() && thisObject->asArrayObject()->sortInFastModeByDefaultOrder(state)) {
+        return thisObject;
+    }
+
     thisObject->sort(state, [defaultSort, &cmpfn, &state](const Value& a, const Value& b) -> bool {
         if (a.isEmpty() && b.isUndefined())
             return false;
@@ -377,9 +388,6 @@ static Value builtinArraySplice(ExecutionState& state, Value thisValue, size_t a
     // Let O be the result of calling ToObject passing the this value as the argument.
     RESOLVE_THIS_BINDING_TO_OBJECT(O, Array, splice);
 
-    // Let A be a new array created as if by the expression new Array()where Array is the standard built-in constructor with that name.
-    ArrayObject* A = new ArrayObject(state);
-
     // Let lenVal be the result of calling the [[Get]] internal method of O with argument "length".
     // Let len be ToUint32(lenVal).
     int64_t len = O->length(state);
@@ -401,6 +409,16 @@ static Value builtinArraySplice(ExecutionState& state, Value thisValue, size_t a
         actualDeleteCount = len - actualStart;
     }
 
+    if (O->isArrayObject()) {
+        ArrayObject* removed = O->asArrayObject()->spliceInFastMode(state, len, actualStart, actualDeleteCount, argc > 2 ? argc - 2 : 0, argv + 2);
+        if (removed) {
+            return removed;
+        }
+    }
+
+    // Let A be a new array created as if by the expression new Array()where Array is the standard built-in constructor with that name.
+    ArrayObject* A = new ArrayObject(state);
+
     // Let k be 0.
     int64_t k = 0;
 
@@ -544,6 +562,12 @@ static Value builtinArrayConcat(ExecutionState& state, Value thisValue, size_t a
         if (argi.isObject() && argi.asObject()->isArrayObject()) {
             ArrayObject* arr = argi.asObject()->asArrayObject();
 
+            uint64_t arrLength = arr->length(state);
+            if (array->concatInFastMode(state, arr, Value())) {
+                n += arrLength;
+                continue;
+            }
+
             // Let k be 0.
             uint64_t k = 0;
             // Let len be the result of calling the [[Get]] internal method of E with argument "length".
@@ -565,6 +589,8 @@ static Value builtinArrayConcat(ExecutionState& state, Value thisValue, size_t a
 
             n += len;
             array->setThrowsException(state, ObjectPropertyName(state.context()->staticStrings().length), Value(n), array);
+        } else if (array->concatInFastMode(state, nullptr, argi)) {
+            n++;
         } else {
             array->defineOwnPropertyThrowsException(state, ObjectPropertyName(state, Value(n++)), ObjectPropertyDescriptor(argi, ObjectPropertyDescriptor::AllPresent));
         }
@@ -583,6 +609,13 @@ static Value builtinArraySlice(ExecutionState& state, Value thisValue, size_t ar
     double relativeEnd = (argv[1].isUndefined()) ? len : argv[1].toInteger(state);
     uint32_t finalEnd = (relativeEnd < 0) ? std::max((double)len + relativeEnd, 0.0) : std::min(relativeEnd, (double)len);
 
+    if (thisObject->isArrayObject()) {
+        ArrayObject* array = thisObject->asArrayObject()->sliceInFastMode(state, len, k, finalEnd);
+        if (array) {
+            return array;
+        }
+    }
+
     int64_t n = 0;
     ArrayObject* array = new ArrayObject(state);
     while (k < finalEnd) {
@@ -623,9 +656,18 @@ static Value builtinArrayForEach(ExecutionState& state, Value thisValue, size_t
     if (argc > 1)
         T = argv[1];
 
+    ArrayObject* fastArray = thisObject->isArrayObject() ? thisObject->asArrayObject() : nullptr;
     uint32_t k = 0;
     while (k < len) {
         Value Pk = Value(k);
+        // the callback may change the array, so the fast mode is checked every time
+        Value fastValue;
+        if (fastArray && fastArray->getFastModeElement(state, k, fastValue)) {
+            Value args[3] = { fastValue, Pk, thisObject };
+            callbackfn.asFunction()->call(state, T, 3, args);
+            k++;
+            continue;
+        }
         auto res = thisObject->get(state, ObjectPropertyName(state, Pk));
         if (res.hasValue()) {
             Value kValue = res.value(state, thisObject);
@@ -682,6 +724,13 @@ static Value builtinArrayIndexOf(ExecutionState& state, Value thisValue, size_t
         }
     }
 
+    if (O->isArrayObject()) {
+        int64_t result;
+        if (O->asArrayObject()->indexOfInFastMode(state, argv[0], k, len, result)) {
+            return Value(result);
+        }
+    }
+
     // Repeat, while k<len
     while (k < len) {
         // Let kPresent be the result of calling the [[HasProperty]] internal method of O with argument ToString(k).
@@ -849,8 +898,24 @@ static Value builtinArrayFilter(ExecutionState& state, Value thisValue, size_t a
     uint64_t k = 0;
     // Let to be 0.
     uint64_t to = 0;
+    ArrayObject* fastArray = O->isArrayObject() ? O->asArrayObject() : nullptr;
     // Repeat, while k < len
     while (k < len) {
+        // the callback may change O, so the fast mode is checked every time
+        Value fastValue;
+        if (fastArray && fastArray->getFastModeElement(state, k, fastValue)) {
+            Value v[] = { fastValue, Value(k), O };
+            Value selected = callbackfn.asFunction()->call(state, T, 3, v);
+            if (selected.toBoolean(state)) {
+                if (!A->defineFastModeElement(state, to, fastValue)) {
+                    A->defineOwnProperty(state, ObjectPropertyName(state, Value(to)), ObjectPropertyDescriptor(fastValue, ObjectPropertyDescriptor::AllPresent));
+                }
+                to++;
+            }
+            k++;
+            continue;
+        }
+
         // Let Pk be ToString(k).
         ObjectPropertyName Pk(state, Value(k));
         // Let kPresent be the result of calling the [[HasProperty]] internal method of O with argument Pk.
@@ -909,9 +974,22 @@ static Value builtinArrayMap(ExecutionState& state, Value thisValue, size_t argc
 
     // Let k be 0.
     uint64_t k = 0;
+    ArrayObject* fastArray = O->isArrayObject() ? O->asArrayObject() : nullptr;
 
     // Repeat, while k < len
     while (k < len) {
+        // the callback may change O, so the fast mode is checked every time
+        Value fastValue;
+        if (fastArray && fastArray->getFastModeElement(state, k, fastValue)) {
+            Value v[] = { fastValue, Value(k), O };
+            Value mappedValue = callbackfn.asFunction()->call(state, T, 3, v);
+            if (!A->defineFastModeElement(state, k, mappedValue)) {
+                A->defineOwnProperty(state, ObjectPropertyName(state, Value(k)), ObjectPropertyDescriptor(mappedValue, ObjectPropertyDescriptor::AllPresent));
+            }
+            k++;
+            continue;
+        }
+
         // Let Pk be ToString(k).
         ObjectPropertyName Pk(state, Value(k));
         // Let kPresent be the result of calling the [[HasProperty]] internal method of O with argument Pk.
@@ -1024,6 +1102,16 @@ static Value builtinArrayIncludes(ExecutionState& state, Value thisValue, size_t
         k = 0;
     }
 
+    if (O->isArrayObject() && len <= std::numeric_limits<uint32_t>::max()) {
+        bool result;
+        if (k >= len) {
+            return Value(false);
+        }
+        if (O->asArrayObject()->includesInFastMode(state, searchElement, k, len, result)) {
+            return Value(result);
+        }
+    }
+
     // Repeat, while k < len
     while (k < len) {
         // Let elementK be the result of ? Get(O, ! ToString(k)).
@@ -1040,6 +1128,43 @@ static Value builtinArrayIncludes(ExecutionState& state, Value thisValue, size_t
     return Value(false);
 }
 
+// Array.prototype.fill ( value [ , start [ , end ] ] )
+static Value builtinArrayFill(ExecutionState& state, Value thisValue, size_t argc, Value* argv, bool isNewExpression)
+{
+    // Let O be ? ToObject(this value).
+    RESOLVE_THIS_BINDING_TO_OBJECT(O, Array, fill);
+    // Let len be ? ToLength(? Get(O, "length")).
+    double len = O->lengthES6(state);
+
+    // Let relativeStart be ? ToInteger(start).
+    double relativeStart = argc >= 2 ? argv[1].toInteger(state) : 0;
+    // If relativeStart < 0, let k be max((len + relativeStart), 0); else let k be min(relativeStart, len).
+    double k = relativeStart < 0 ? std::max(len + relativeStart, 0.0) : std::min(relativeStart, len);
+
+    // If end is undefined, let relativeEnd be len; else let relativeEnd be ? ToInteger(end).
+    double relativeEnd = (argc >= 3 && !argv[2].isUndefined()) ? argv[2].toInteger(state) : len;
+    // If relativeEnd < 0, let final be max((len + relativeEnd), 0); else let final be min(relativeEnd, len).
+    double finalIndex = relativeEnd < 0 ? std::max(len + relativeEnd, 0.0) : std::min(relativeEnd, len);
+
+    if (O->isArrayObject() && finalIndex <= std::numeric_limits<uint32_t>::max()) {
+        if (k >= finalIndex || O->asArrayObject()->fillInFastMode(state, argv[0], k, finalIndex)) {
+            return O;
+        }
+    }
+
+    // Repeat, while k < final
+    while (k < finalIndex) {
+        // Let Pk be ! ToString(k).
+        // Perform ? Set(O, Pk, value, true).
+        O->setIndexedPropertyThrowsException(state, Value(k), argv[0]);
+        // Increase k by 1.
+        k++;
+    }
+
+    // Return O.
+    return O;
+}
+
 static Value builtinArrayToLocaleString(ExecutionState& state, Value thisValue, size_t argc, Value* argv, bool isNewExpression)
 {
     // Let array be the result of calling ToObject passing the this value as the argument.
@@ -1300,6 +1425,11 @@ static Value builtinArrayPush(ExecutionState& state, Value thisValue, size_t arg
     // Let lenVal be the result of calling the [[Get]] internal method of O with argument "length".
     // Let n be ToUint32(lenVal).
     int64_t n = O->length(state);
+
+    if (O->isArrayObject() && O->asArrayObject()->pushInFastMode(state, argc, argv)) {
+        return Value(n + argc);
+    }
+
     // Let items be an internal List whose elements are, in left to right order, the arguments that were passed to this function invocation.
     // Repeat, while items is not empty
     // Remove the first element from items and let E be the value of the element.
@@ -1331,8 +1461,14 @@ static Value builtinArrayShift(ExecutionState& state, Value thisValue, size_t ar
         // Return undefined.
         return Value();
     }
+
+    Value first;
+    if (O->isArrayObject() && O->asArrayObject()->shiftInFastMode(state, first)) {
+        return first;
+    }
+
     // Let first be the result of calling the [[Get]] internal method of O with argument "0".
-    Value first = O->get(state, ObjectPropertyName(state, Value(0))).value(state, O);
+    first = O->get(state, ObjectPropertyName(state, Value(0))).value(state, O);
     // Let k be 1.
     int64_t k = 1;
     // Repeat, while k < len
@@ -1388,6 +1524,11 @@ static Value builtinArrayUnshift(ExecutionState& state, Value thisValue, size_t
 
     // Let argCount be the number of actual arguments.
     size_t argCount = argc;
+
+    if (O->isArrayObject() && O->asArrayObject()->unshiftInFastMode(state, argc, argv)) {
+        return Value(len + argCount);
+    }
+
     // Let k be len.
     int64_t k = len;
 
@@ -1596,6 +1737,8 @@ void GlobalObject::installArray(ExecutionState& state)
                                                        ObjectPropertyDescriptor(new FunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().every, builtinArrayEvery, 1, nullptr, NativeFunctionInfo::Strict)), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
     m_arrayPrototype->defineOwnPropertyThrowsException(state, ObjectPropertyName(state.context()->staticStrings().includes),
                                                        ObjectPropertyDescriptor(new FunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().every, builtinArrayIncludes, 1, nullptr, NativeFunctionInfo::Strict)), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
+    m_arrayPrototype->defineOwnPropertyThrowsException(state, ObjectPropertyName(state.context()->staticStrings().fill),
+                                                       ObjectPropertyDescriptor(new FunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().fill, builtinArrayFill, 1, nullptr, NativeFunctionInfo::Strict)), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
     m_arrayPrototype->defineOwnPropertyThrowsException(state, ObjectPropertyName(state.context()->staticStrings().filter),
                                                        ObjectPropertyDescriptor(new FunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().filter, builtinArrayFilter, 1, nullptr, NativeFunctionInfo::Strict)), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
     m_arrayPrototype->defineOwnPropertyThrowsException(state, ObjectPropertyName(state.context()->staticStrings().reduce),
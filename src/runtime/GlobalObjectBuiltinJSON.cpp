@@ -26,9 +26,8 @@
 #include "TypedArrayObject.h"
 #include "BooleanObject.h"
 
-#define RAPIDJSON_PARSE_DEFAULT_FLAGS kParseFullPrecisionFlag
 #define RAPIDJSON_ERROR_CHARTYPE char
-#include <rapidjson/document.h>
+#include <rapidjson/reader.h>
 #include <rapidjson/filereadstream.h>
 #include <rapidjson/memorystream.h>
 #include <rapidjson/internal/dtoa.h>
@@ -38,11 +37,13 @@
 
 namespace Escargot {
 
-template <typename Encoding>
+// reads |SourceCharType| characters as characters of |Encoding|
+// so 8-bit strings can be parsed without widening them first
+template <typename Encoding, typename SourceCharType = typename Encoding::Ch>
 struct JSONStringStream {
     typedef typename Encoding::Ch Ch;
 
-    JSONStringStream(const Ch* src, size_t length)
+    JSONStringStream(const SourceCharType* src, size_t length)
         : src_(src)
         , head_(src)
         , tail_(src + length)
@@ -77,92 +78,207 @@ struct JSONStringStream {
         return 0;
     }
 
-    const Ch* src_; //!< Current read position.
-    const Ch* head_; //!< Original head of the string.
-    const Ch* tail_;
+    const SourceCharType* src_; //!< Current read position.
+    const SourceCharType* head_; //!< Original head of the string.
+    const SourceCharType* tail_;
 };
 
-template <typename CharType, typename JSONCharType>
-static Value parseJSONWorker(ExecutionState& state, rapidjson::GenericValue<JSONCharType>& value)
-{
-    volatile int sp;
-    size_t currentStackBase = (size_t)&sp;
-#ifdef STACK_GROWS_DOWN
-    if (UNLIKELY((state.stackBase() - currentStackBase) > STACK_LIMIT_FROM_BASE)) {
-#else
-    if (UNLIKELY((currentStackBase - state.stackBase()) > STACK_LIMIT_FROM_BASE)) {
-#endif
-        ErrorObject::throwBuiltinError(state, ErrorObject::RangeError, "Maximum call stack size exceeded");
-    }
-
-    if (value.IsBool()) {
-        return Value(value.GetBool());
-    } else if (value.IsInt()) {
-        return Value(value.GetInt());
-    } else if (value.IsUint()) {
-        return Value(value.GetUint());
-    } else if (value.IsInt64()) {
-        return Value(value.GetInt64());
-    } else if (value.IsUint64()) {
-        return Value(value.GetUint64());
-    } else if (value.IsDouble()) {
-        return Value(value.GetDouble());
-    } else if (value.IsNull()) {
-        return Value(Value::Null);
-    } else if (value.IsString()) {
-        if (std::is_same<CharType, char16_t>::value) {
-            const char16_t* chars = (const char16_t*)value.GetString();
-            unsigned len = value.GetStringLength();
-            if (isAllLatin1(chars, len)) {
-                return new Latin1String(chars, len);
-            } else {
-                return new UTF16String(chars, len);
+// builds values from rapidjson reader events directly, without a DOM.
+// values of unfinished arrays and objects wait on m_values (and their keys on m_keys)
+// until the end of the container, so each container is created with its final size.
+class JSONParseHandler {
+public:
+    typedef char16_t Ch;
+    static const size_t keyCacheSize = 64;
+
+    JSONParseHandler(ExecutionState& state)
+        : m_state(state)
+        , m_keyCache(keyCacheSize, PropertyName(AtomicString()))
+    {
+    }
+
+    Value result()
+    {
+        ASSERT(m_values.size() == 1);
+        return m_values[0];
+    }
+
+    bool Null()
+    {
+        m_values.push_back(Value(Value::Null));
+        return true;
+    }
+
+    bool Bool(bool b)
+    {
+        m_values.push_back(Value(b));
+        return true;
+    }
+
+    bool Int(int i)
+    {
+        m_values.push_back(Value(i));
+        return true;
+    }
+
+    bool Uint(unsigned u)
+    {
+        m_values.push_back(Value(u));
+        return true;
+    }
+
+    bool Int64(int64_t i)
+    {
+        m_values.push_back(Value(i));
+        return true;
+    }
+
+    bool Uint64(uint64_t u)
+    {
+        m_values.push_back(Value(u));
+        return true;
+    }
+
+    bool Double(double d)
+    {
+        m_values.push_back(Value(d));
+        return true;
+    }
+
+    bool RawNumber(const Ch*, rapidjson::SizeType, bool)
+    {
+        // only for kParseNumbersAsStringsFlag
+        RELEASE_ASSERT_NOT_REACHED();
+        return false;
+    }
+
+    bool String(const Ch* str, rapidjson::SizeType length, bool)
+    {
+        m_values.push_back(Value(createString(str, length)));
+        return true;
+    }
+
+    bool StartObject()
+    {
+        return true;
+    }
+
+    bool Key(const Ch* str, rapidjson::SizeType length, bool)
+    {
+        m_keys.push_back(lookupKey(str, length));
+        return true;
+    }
+
+    bool EndObject(rapidjson::SizeType memberCount)
+    {
+        ASSERT(m_keys.size() >= memberCount && m_values.size() >= memberCount);
+        size_t keyBase = m_keys.size() - memberCount;
+        size_t valueBase = m_values.size() - memberCount;
+
+        Object* obj = new Object(m_state);
+        obj->reservePropertyStorage(memberCount);
+        for (size_t i = 0; i < memberCount; i++) {
+            // keys are added in the same order for records of the same shape,
+            // so they share structures through the transition table
+            obj->defineOwnProperty(m_state, ObjectPropertyName(m_state, m_keys[keyBase + i]), ObjectPropertyDescriptor(m_values[valueBase + i], ObjectPropertyDescriptor::AllPresent));
+        }
+
+        m_keys.erase(m_keys.begin() + keyBase, m_keys.end());
+        m_values.resize(valueBase);
+        m_values.push_back(Value(obj));
+        return true;
+    }
+
+    bool StartArray()
+    {
+        return true;
+    }
+
+    bool EndArray(rapidjson::SizeType elementCount)
+    {
+        ASSERT(m_values.size() >= elementCount);
+        size_t valueBase = m_values.size() - elementCount;
+
+        ArrayObject* arr = new ArrayObject(m_state);
+        if (elementCount && !arr->pushInFastMode(m_state, elementCount, &m_values[valueBase])) {
+            for (size_t i = 0; i < elementCount; i++) {
+                arr->defineOwnProperty(m_state, ObjectPropertyName(m_state, Value(i)), ObjectPropertyDescriptor(m_values[valueBase + i], ObjectPropertyDescriptor::AllPresent));
+            }
+        }
+
+        m_values.resize(valueBase);
+        m_values.push_back(Value(arr));
+        return true;
+    }
+
+private:
+    static ::Escargot::String* createString(const Ch* str, size_t length)
+    {
+        if (isAllLatin1(str, length)) {
+            return new Latin1String(str, length);
+        }
+        return new UTF16String(str, length);
+    }
+
+    static bool equalsKey(const PropertyName& name, const Ch* str, size_t length)
+    {
+        const StringBufferAccessData& data = name.plainString()->bufferAccessData();
+        if (data.length != length) {
+            return false;
+        }
+        if (data.has8BitContent) {
+            const LChar* chars = (const LChar*)data.buffer;
+            for (size_t i = 0; i < length; i++) {
+                if (chars[i] != str[i]) {
+                    return false;
+                }
             }
         } else {
-            const char* valueAsString = (const char*)value.GetString();
-            if (isAllASCII(valueAsString, strlen(valueAsString))) {
-                return new ASCIIString(valueAsString);
-            } else {
-                return new UTF16String(utf8StringToUTF16String(valueAsString, strlen(valueAsString)));
+            if (memcmp(data.buffer, str, sizeof(Ch) * length)) {
+                return false;
             }
         }
-    } else if (value.IsArray()) {
-        ArrayObject* arr = new ArrayObject(state);
-        size_t i = 0;
-        auto iter = value.Begin();
-        while (iter != value.End()) {
-            arr->defineOwnProperty(state, ObjectPropertyName(state, Value(i++)), ObjectPropertyDescriptor(parseJSONWorker<CharType, JSONCharType>(state, *iter), ObjectPropertyDescriptor::AllPresent));
-            iter++;
-        }
-        return arr;
-    } else if (value.IsObject()) {
-        Object* obj = new Object(state);
-        auto iter = value.MemberBegin();
-        while (iter != value.MemberEnd()) {
-            Value propertyName = parseJSONWorker<CharType, JSONCharType>(state, iter->name);
-            ASSERT(propertyName.isString());
-            obj->defineOwnProperty(state, ObjectPropertyName(state, propertyName), ObjectPropertyDescriptor(parseJSONWorker<CharType, JSONCharType>(state, iter->value), ObjectPropertyDescriptor::AllPresent));
-            iter++;
-        }
-        return obj;
-    } else {
-        RELEASE_ASSERT_NOT_REACHED();
+        return true;
     }
-}
 
-template <typename CharType, typename JSONCharType>
-Value parseJSON(ExecutionState& state, const CharType* data, size_t length)
+    // records mostly repeat a few keys, so a small direct mapped cache avoids
+    // creating a string and looking up the atomic string table for each of them
+    PropertyName lookupKey(const Ch* str, size_t length)
+    {
+        size_t hash = length;
+        for (size_t i = 0; i < length; i++) {
+            hash = hash * 31 + str[i];
+        }
+        PropertyName& entry = m_keyCache[hash % keyCacheSize];
+        if (LIKELY(equalsKey(entry, str, length))) {
+            return entry;
+        }
+
+        entry = PropertyName(m_state, Value(createString(str, length)));
+        return entry;
+    }
+
+    ExecutionState& m_state;
+    std::vector<Value, GCUtil::gc_malloc_ignore_off_page_allocator<Value>> m_values;
+    std::vector<PropertyName, GCUtil::gc_malloc_ignore_off_page_allocator<PropertyName>> m_keys;
+    std::vector<PropertyName, GCUtil::gc_malloc_ignore_off_page_allocator<PropertyName>> m_keyCache;
+};
+
+template <typename CharType>
+static Value parseJSON(ExecutionState& state, const CharType* data, size_t length)
 {
     auto strings = &state.context()->staticStrings();
-    rapidjson::GenericDocument<JSONCharType> jsonDocument;
+    // iterative parsing does not consume the native stack for nested values
+    rapidjson::GenericReader<rapidjson::UTF16<char16_t>, rapidjson::UTF16<char16_t>> reader;
+    JSONStringStream<rapidjson::UTF16<char16_t>, CharType> stringStream(data, length);
+    JSONParseHandler handler(state);
 
-    JSONStringStream<JSONCharType> stringStream(data, length);
-    jsonDocument.ParseStream(stringStream);
-    if (jsonDocument.HasParseError()) {
-        ErrorObject::throwBuiltinError(state, ErrorObject::SyntaxError, strings->JSON.string(), true, strings->parse.string(), rapidjson::GetParseError_En(jsonDocument.GetParseError()));
+    rapidjson::ParseResult result = reader.Parse<rapidjson::kParseFullPrecisionFlag | rapidjson::kParseIterativeFlag>(stringStream, handler);
+    if (result.IsError()) {
+        ErrorObject::throwBuiltinError(state, ErrorObject::SyntaxError, strings->JSON.string(), true, strings->parse.string(), rapidjson::GetParseError_En(result.Code()));
     }
 
-    return parseJSONWorker<CharType, JSONCharType>(state, jsonDocument);
+    return handler.result();
 }
 
 String* codePointTo4digitString(int codepoint)
@@ -197,16 +313,9 @@ static Value builtinJSONParse(ExecutionState& state, Value thisValue, size_t arg
     Value unfiltered;
 
     if (JText->has8BitContent()) {
-        size_t len = JText->length();
-        char16_t* char16Buf = new char16_t[len];
-        std::unique_ptr<char16_t[]> buf(char16Buf);
-        const LChar* srcBuf = JText->characters8();
-        for (size_t i = 0; i < len; i++) {
-            char16Buf[i] = srcBuf[i];
-        }
-        unfiltered = parseJSON<char16_t, rapidjson::UTF16<char16_t>>(state, buf.get(), JText->length());
+        unfiltered = parseJSON<LChar>(state, JText->characters8(), JText->length());
     } else {
-        unfiltered = parseJSON<char16_t, rapidjson::UTF16<char16_t>>(state, JText->characters16(), JText->length());
+        unfiltered = parseJSON<char16_t>(state, JText->characters16(), JText->length());
     }
 
     // 4
@@ -279,17 +388,551 @@ static Value builtinJSONParse(ExecutionState& state, Value thisValue, size_t arg
     return unfiltered;
 }
 
+// output of JSON.stringify. it stays 8-bit until a character out of Latin-1 is appended
+class JSONStringBuffer {
+public:
+    JSONStringBuffer()
+        : m_is8Bit(true)
+    {
+    }
+
+    void appendChar(char16_t ch)
+    {
+        if (LIKELY(m_is8Bit)) {
+            if (LIKELY(ch < 256)) {
+                m_latin1.push_back((LChar)ch);
+                return;
+            }
+            convertTo16Bit();
+        }
+        m_utf16.push_back(ch);
+    }
+
+    void appendASCII(const char* chars, size_t length)
+    {
+        append((const LChar*)chars, length);
+    }
+
+    void append(const LChar* chars, size_t length)
+    {
+        if (LIKELY(m_is8Bit)) {
+            m_latin1.append(chars, length);
+        } else {
+            m_utf16.append(chars, chars + length);
+        }
+    }
+
+    void append(const char16_t* chars, size_t length)
+    {
+        if (LIKELY(m_is8Bit)) {
+            if (isAllLatin1(chars, length)) {
+                m_latin1.append(chars, chars + length);
+                return;
+            }
+            convertTo16Bit();
+        }
+        m_utf16.append(chars, length);
+    }
+
+    void append(String* str)
+    {
+        const StringBufferAccessData& data = str->bufferAccessData();
+        if (data.has8BitContent) {
+            append((const LChar*)data.buffer, data.length);
+        } else {
+            append((const char16_t*)data.buffer, data.length);
+        }
+    }
+
+    void appendInt32(int32_t value)
+    {
+        char buffer[12];
+        char* end = buffer + sizeof(buffer);
+        char* start = end;
+        uint32_t absValue = value < 0 ? -(uint32_t)value : (uint32_t)value;
+        do {
+            *--start = '0' + (absValue % 10);
+            absValue /= 10;
+        } while (absValue);
+        if (value < 0) {
+            *--start = '-';
+        }
+        appendASCII(start, end - start);
+    }
+
+    // http://www.ecma-international.org/ecma-262/6.0/#sec-quotejsonstring
+    void appendQuotedString(String* str)
+    {
+        const StringBufferAccessData& data = str->bufferAccessData();
+        appendChar('"');
+        if (data.has8BitContent) {
+            appendEscapedString((const LChar*)data.buffer, data.length);
+        } else {
+            appendEscapedString((const char16_t*)data.buffer, data.length);
+        }
+        appendChar('"');
+    }
+
+    String* finalize(ExecutionState& state)
+    {
+        size_t length = m_is8Bit ? m_latin1.length() : m_utf16.length();
+        if (UNLIKELY(length > STRING_MAXIMUM_LENGTH)) {
+            ErrorObject::throwBuiltinError(state, ErrorObject::RangeError, errorMessage_String_InvalidStringLength);
+        }
+        if (m_is8Bit) {
+            return new Latin1String(m_latin1.data(), m_latin1.length());
+        }
+        return new UTF16String(m_utf16.data(), m_utf16.length());
+    }
+
+private:
+    static bool needsEscape(char16_t ch)
+    {
+        return ch < ' ' || ch == '"' || ch == '\\';
+    }
+
+    // returns the position of the first character which needs escape, or |length|
+    static size_t findCharacterNeedsEscape(const LChar* chars, size_t start, size_t length)
+    {
+        // tests 8 characters at once; a byte of |found| has its high bit set
+        // when the byte is less than 0x20 or equals to '"' or '\\'
+        const uint64_t ones = 0x0101010101010101ULL;
+        const uint64_t highBits = 0x8080808080808080ULL;
+        size_t i = start;
+        for (; i + 8 <= length; i += 8) {
+            uint64_t word;
+            memcpy(&word, chars + i, sizeof(word));
+            uint64_t quote = word ^ (ones * '"');
+            uint64_t backslash = word ^ (ones * '\\');
+            uint64_t found = ((word - ones * ' ') & ~word) | ((quote - ones) & ~quote) | ((backslash - ones) & ~backslash);
+            if (UNLIKELY(found & highBits)) {
+                break;
+            }
+        }
+        for (; i < length; i++) {
+            if (needsEscape(chars[i])) {
+                return i;
+            }
+        }
+        return length;
+    }
+
+    static size_t findCharacterNeedsEscape(const char16_t* chars, size_t start, size_t length)
+    {
+        for (size_t i = start; i < length; i++) {
+            if (needsEscape(chars[i])) {
+                return i;
+            }
+        }
+        return length;
+    }
+
+    template <typename CharType>
+    void appendEscapedString(const CharType* chars, size_t length)
+    {
+        size_t start = 0;
+        while (true) {
+            size_t end = findCharacterNeedsEscape(chars, start, length);
+            append(chars + start, end - start);
+            if (end == length) {
+                break;
+            }
+            appendEscapedChar(chars[end]);
+            start = end + 1;
+        }
+    }
+
+    void appendEscapedChar(char16_t ch)
+    {
+        appendChar('\\');
+        switch (ch) {
+        case '"':
+        case '\\':
+            appendChar(ch);
+            break;
+        case '\b':
+            appendChar('b');
+            break;
+        case '\f':
+            appendChar('f');
+            break;
+        case '\n':
+            appendChar('n');
+            break;
+        case '\r':
+            appendChar('r');
+            break;
+        case '\t':
+            appendChar('t');
+            break;
+        default: {
+            ASSERT(ch < ' ');
+            const char* hex = "0123456789abcdef";
+            char buffer[5] = { 'u', '0', '0', hex[ch >> 4], hex[ch & 0xf] };
+            appendASCII(buffer, sizeof(buffer));
+            break;
+        }
+        }
+    }
+
+    void convertTo16Bit()
+    {
+        ASSERT(m_is8Bit);
+        m_utf16.assign(m_latin1.begin(), m_latin1.end());
+        m_latin1 = Latin1StringDataNonGCStd();
+        m_is8Bit = false;
+    }
+
+    bool m_is8Bit;
+    Latin1StringDataNonGCStd m_latin1;
+    UTF16StringDataNonGCStd m_utf16;
+};
+
+struct JSONStringifyKey {
+    String* m_name;
+    size_t m_index;
+};
+
+// what JSON.stringify learned about objects which have a structure
+struct JSONStringifyStructureInfo : public gc {
+    JSONStringifyStructureInfo()
+        : m_hasKeys(false)
+        , m_noToJSONPrototype(nullptr)
+        , m_noToJSONEpoch(0)
+    {
+    }
+
+    // own enumerable string keys and their indexes in the structure.
+    // only for objects whose enumeration() visits nothing but their structure
+    bool m_hasKeys;
+    Vector<JSONStringifyKey, GCUtil::gc_malloc_ignore_off_page_allocator<JSONStringifyKey>> m_keys;
+    // there is no toJSON on the prototype chain while the [[Prototype]] is m_noToJSONPrototype
+    // and VMInstance::prototypeEpoch() is m_noToJSONEpoch
+    Object* m_noToJSONPrototype;
+    size_t m_noToJSONEpoch;
+};
+
+struct JSONStringifyFrame {
+    Object* m_object;
+    // keys are m_info->m_keys when m_info is not nullptr, and JSONStringifier::m_keys[m_keyBase, m_keyBase + m_length) otherwise
+    ObjectStructure* m_structure;
+    JSONStringifyStructureInfo* m_info;
+    size_t m_keyBase;
+    uint64_t m_length;
+    uint64_t m_index;
+    bool m_isArray;
+    bool m_hasMember;
+};
+
+// http://www.ecma-international.org/ecma-262/6.0/#sec-json.stringify
+// arrays and objects being serialized are on m_frames instead of the native stack,
+// and everything is written into one buffer
+class JSONStringifier {
+public:
+    typedef std::vector<ObjectPropertyName, GCUtil::gc_malloc_ignore_off_page_allocator<ObjectPropertyName>> PropertyList;
+
+    JSONStringifier(ExecutionState& state, FunctionObject* replacerFunc, PropertyList* propertyList, String* gap)
+        : m_state(state)
+        , m_replacerFunc(replacerFunc)
+        , m_propertyList(propertyList)
+        , m_gap(gap)
+        , m_lastStructure(nullptr)
+        , m_lastInfo(nullptr)
+    {
+    }
+
+    Value stringify(const Value& rootValue)
+    {
+        // 9, 10
+        // the wrapper is observable only through the replacer
+        Object* wrapper = nullptr;
+        if (m_replacerFunc) {
+            wrapper = new Object(m_state);
+            wrapper->defineOwnProperty(m_state, ObjectPropertyName(m_state, String::emptyString), ObjectPropertyDescriptor(rootValue, ObjectPropertyDescriptor::AllPresent));
+        }
+
+        Value value = resolveValue(wrapper, String::emptyString, rootValue);
+        if (!isSerializable(value)) {
+            return Value();
+        }
+        writeValue(value);
+
+        while (m_frames.size()) {
+            JSONStringifyFrame& frame = m_frames.back();
+            if (frame.m_index == frame.m_length) {
+                if (frame.m_hasMember && m_gap->length()) {
+                    writeIndent(m_frames.size() - 1);
+                }
+                m_buffer.appendChar(frame.m_isArray ? ']' : '}');
+                if (!frame.m_info) {
+                    m_keys.erase(m_keys.begin() + frame.m_keyBase, m_keys.end());
+                }
+                m_frames.pop_back();
+                continue;
+            }
+
+            uint64_t index = frame.m_index++;
+            Object* holder = frame.m_object;
+            // writeValue can push a new frame, so |frame| is not used after it
+            if (frame.m_isArray) {
+                Value element;
+                if (!holder->isArrayObject() || !holder->asArrayObject()->getFastModeElement(m_state, index, element)) {
+                    element = holder->get(m_state, ObjectPropertyName(m_state, Value(index))).value(m_state, holder);
+                }
+                element = resolveValue(holder, Value(index), element);
+                writeSeparator(frame);
+                if (isSerializable(element)) {
+                    writeValue(element);
+                } else {
+                    m_buffer.appendASCII("null", 4);
+                }
+            } else {
+                String* key;
+                Value member;
+                if (frame.m_info) {
+                    const JSONStringifyKey& cachedKey = frame.m_info->m_keys[index];
+                    key = cachedKey.m_name;
+                    if (LIKELY(holder->structure() == frame.m_structure)) {
+                        member = holder->getOwnPropertyUtilForObject(m_state, cachedKey.m_index, holder);
+                    } else {
+                        member = holder->get(m_state, ObjectPropertyName(m_state, Value(key))).value(m_state, holder);
+                    }
+                } else {
+                    ObjectPropertyName name = m_keys[frame.m_keyBase + index];
+                    key = name.toPropertyName(m_state).plainString();
+                    member = holder->get(m_state, name).value(m_state, holder);
+                }
+                member = resolveValue(holder, key, member);
+                if (isSerializable(member)) {
+                    writeSeparator(frame);
+                    m_buffer.appendQuotedString(key);
+                    m_buffer.appendChar(':');
+                    if (m_gap->length()) {
+                        m_buffer.appendChar(' ');
+                    }
+                    writeValue(member);
+                }
+            }
+        }
+
+        return m_buffer.finalize(m_state);
+    }
+
+private:
+    JSONStringifyStructureInfo* structureInfo(ObjectStructure* structure)
+    {
+        if (structure == m_lastStructure) {
+            return m_lastInfo;
+        }
+        JSONStringifyStructureInfo*& info = m_structureInfo[structure];
+        if (!info) {
+            info = new JSONStringifyStructureInfo();
+        }
+        m_lastStructure = structure;
+        m_lastInfo = info;
+        return info;
+    }
+
+    bool hasNoToJSON(Object* obj)
+    {
+        const AtomicString& toJSON = m_state.context()->staticStrings().toJSON;
+        if (obj->structure()->findProperty(toJSON) != SIZE_MAX) {
+            return false;
+        }
+        // every object on the prototype chain is marked, so any change of them bumps the prototype epoch
+        for (Object* proto = obj->getPrototypeObject(); proto; proto = proto->getPrototypeObject()) {
+            if (!proto->isInlineCacheable() || proto->structure()->findProperty(toJSON) != SIZE_MAX) {
+                return false;
+            }
+            if (!proto->isEverSetAsPrototypeObject()) {
+                proto->markAsPrototypeObject(m_state);
+            }
+        }
+        return true;
+    }
+
+    Value toJSONFunction(Object* obj)
+    {
+        if (LIKELY(obj->isInlineCacheable())) {
+            VMInstance* vmInstance = m_state.context()->vmInstance();
+            JSONStringifyStructureInfo* info = structureInfo(obj->structure());
+            Object* proto = obj->getPrototypeObject();
+            if (info->m_noToJSONEpoch == vmInstance->prototypeEpoch() && info->m_noToJSONPrototype == proto) {
+                return Value();
+            }
+            if (hasNoToJSON(obj)) {
+                info->m_noToJSONPrototype = proto;
+                info->m_noToJSONEpoch = vmInstance->prototypeEpoch();
+                return Value();
+            }
+        }
+        return obj->get(m_state, ObjectPropertyName(m_state.context()->staticStrings().toJSON)).value(m_state, obj);
+    }
+
+    // SerializeJSONProperty 2-4
+    // |key| is a string, or an array index which is converted into a string only for user functions
+    Value resolveValue(Object* holder, const Value& key, Value value)
+    {
+        if (value.isObject()) {
+            Value toJSON = toJSONFunction(value.asObject());
+            if (toJSON.isPointerValue() && toJSON.asPointerValue()->isFunctionObject()) {
+                Value arguments[] = { key.toString(m_state) };
+                value = FunctionObject::call(m_state, toJSON, value, 1, arguments);
+            }
+        }
+
+        if (m_replacerFunc) {
+            Value arguments[] = { key.toString(m_state), value };
+            value = FunctionObject::call(m_state, m_replacerFunc, holder, 2, arguments);
+        }
+
+        if (value.isObject()) {
+            if (value.asObject()->isNumberObject()) {
+                value = Value(value.toNumber(m_state));
+            } else if (value.asObject()->isStringObject()) {
+                value = Value(value.toString(m_state));
+            } else if (value.asObject()->isBooleanObject()) {
+                value = Value(value.asObject()->asBooleanObject()->primitiveValue());
+            }
+        }
+        return value;
+    }
+
+    // SerializeJSONProperty returns undefined for the others
+    static bool isSerializable(const Value& value)
+    {
+        return value.isNull() || value.isBoolean() || value.isString() || value.isNumber() || (value.isObject() && !value.isFunction());
+    }
+
+    // SerializeJSONProperty 5-11
+    void writeValue(const Value& value)
+    {
+        ASSERT(isSerializable(value));
+        if (value.isNull()) {
+            m_buffer.appendASCII("null", 4);
+        } else if (value.isBoolean()) {
+            if (value.asBoolean()) {
+                m_buffer.appendASCII("true", 4);
+            } else {
+                m_buffer.appendASCII("false", 5);
+            }
+        } else if (value.isString()) {
+            m_buffer.appendQuotedString(value.asString());
+        } else if (value.isInt32()) {
+            m_buffer.appendInt32(value.asInt32());
+        } else if (value.isNumber()) {
+            if (std::isfinite(value.asNumber())) {
+                m_buffer.append(value.toString(m_state));
+            } else {
+                m_buffer.appendASCII("null", 4);
+            }
+        } else {
+            enterObject(value.asObject());
+        }
+    }
+
+    // SerializeJSONObject, SerializeJSONArray 1-6
+    void enterObject(Object* obj)
+    {
+        bool isArray = obj->isArrayObject() || obj->isTypedArrayObject();
+        for (size_t i = 0; i < m_frames.size(); i++) {
+            if (m_frames[i].m_object == obj) {
+                auto strings = &m_state.context()->staticStrings();
+                ErrorObject::throwBuiltinError(m_state, ErrorObject::TypeError, strings->JSON.string(), false, strings->stringify.string(), isArray ? errorMessage_GlobalObject_JAError : errorMessage_GlobalObject_JOError);
+            }
+        }
+
+        JSONStringifyFrame frame;
+        frame.m_object = obj;
+        frame.m_structure = nullptr;
+        frame.m_info = nullptr;
+        frame.m_keyBase = m_keys.size();
+        frame.m_length = 0;
+        frame.m_index = 0;
+        frame.m_isArray = isArray;
+        frame.m_hasMember = false;
+
+        if (isArray) {
+            frame.m_length = obj->length(m_state);
+            m_buffer.appendChar('[');
+        } else if (m_propertyList) {
+            m_keys.insert(m_keys.end(), m_propertyList->begin(), m_propertyList->end());
+            frame.m_length = m_propertyList->size();
+            m_buffer.appendChar('{');
+        } else if (obj->isEnumerationCacheable()) {
+            ObjectStructure* structure = obj->structure();
+            JSONStringifyStructureInfo* info = structureInfo(structure);
+            if (!info->m_hasKeys) {
+                for (size_t i = 0; i < structure->propertyCount(); i++) {
+                    const ObjectStructureItem& item = structure->readProperty(m_state, i);
+                    if (!item.m_propertyName.isSymbol() && item.m_descriptor.isEnumerable()) {
+                        JSONStringifyKey key;
+                        key.m_name = item.m_propertyName.plainString();
+                        key.m_index = i;
+                        info->m_keys.pushBack(key);
+                    }
+                }
+                info->m_hasKeys = true;
+            }
+            frame.m_structure = structure;
+            frame.m_info = info;
+            frame.m_length = info->m_keys.size();
+            m_buffer.appendChar('{');
+        } else {
+            obj->enumeration(m_state, [](ExecutionState& state, Object* self, const ObjectPropertyName& P, const ObjectStructurePropertyDescriptor& desc, void* data) -> bool {
+                if (desc.isEnumerable()) {
+                    ((PropertyList*)data)->push_back(P);
+                }
+                return true;
+            },
+                             &m_keys);
+            frame.m_length = m_keys.size() - frame.m_keyBase;
+            m_buffer.appendChar('{');
+        }
+
+        m_frames.push_back(frame);
+    }
+
+    void writeIndent(size_t depth)
+    {
+        m_buffer.appendChar('\n');
+        for (size_t i = 0; i < depth; i++) {
+            m_buffer.append(m_gap);
+        }
+    }
+
+    void writeSeparator(JSONStringifyFrame& frame)
+    {
+        if (frame.m_hasMember) {
+            m_buffer.appendChar(',');
+        }
+        frame.m_hasMember = true;
+        if (m_gap->length()) {
+            writeIndent(m_frames.size());
+        }
+    }
+
+    ExecutionState& m_state;
+    FunctionObject* m_replacerFunc;
+    PropertyList* m_propertyList;
+    String* m_gap;
+    JSONStringBuffer m_buffer;
+    std::vector<JSONStringifyFrame, GCUtil::gc_malloc_ignore_off_page_allocator<JSONStringifyFrame>> m_frames;
+    PropertyList m_keys;
+    ObjectStructure* m_lastStructure;
+    JSONStringifyStructureInfo* m_lastInfo;
+    std::unordered_map<ObjectStructure*, JSONStringifyStructureInfo*, std::hash<ObjectStructure*>, std::equal_to<ObjectStructure*>,
+                       GCUtil::gc_malloc_ignore_off_page_allocator<std::pair<ObjectStructure* const, JSONStringifyStructureInfo*>>>
+        m_structureInfo;
+};
+
 static Value builtinJSONStringify(ExecutionState& state, Value thisValue, size_t argc, Value* argv, bool isNewExpression)
 {
-    auto strings = &state.context()->staticStrings();
-
     // 1, 2, 3
     Value value = argv[0];
     Value replacer = argv[1];
     Value space = argv[2];
-    String* indent = new ASCIIString("");
-    ValueVector stack;
-    std::vector<ObjectPropertyName, GCUtil::gc_malloc_ignore_off_page_allocator<ObjectPropertyName>> propertyList;
+    JSONStringifier::PropertyList propertyList;
     bool propertyListTouched = false;
 
     // 4
@@ -370,265 +1013,7 @@ static Value builtinJSONStringify(ExecutionState& state, Value thisValue, size_t
         }
     }
 
-    std::function<Value(ObjectPropertyName key, Object * holder)> Str;
-    std::function<String*(ArrayObject*)> JA;
-    std::function<String*(Object*)> JO;
-    std::function<String*(ObjectPropertyName value)> Quote;
-
-    Str = [&](ObjectPropertyName key, Object* holder) -> Value {
-        Value value = holder->get(state, key).value(state, holder);
-        if (value.isObject()) {
-            Object* valObj = value.asPointerValue()->asObject();
-            Value toJson = valObj->get(state, ObjectPropertyName(state, strings->toJSON)).value(state, valObj);
-            if (toJson.isPointerValue() && toJson.asPointerValue()->isFunctionObject()) {
-                Value arguments[] = { key.toPlainValue(state) };
-                value = FunctionObject::call(state, toJson, value, 1, arguments);
-            }
-        }
-
-        if (replacerFunc != NULL) {
-            Value arguments[] = { key.toPlainValue(state), value };
-            value = FunctionObject::call(state, replacerFunc, holder, 2, arguments);
-        }
-
-        if (value.isObject()) {
-            if (value.asObject()->isNumberObject()) {
-                value = Value(value.toNumber(state));
-            } else if (value.asObject()->isStringObject()) {
-                value = Value(value.toString(state));
-            } else if (value.asObject()->isBooleanObject()) {
-                value = Value(value.asObject()->asBooleanObject()->primitiveValue());
-            }
-        }
-        if (value.isNull()) {
-            return strings->null.string();
-        }
-        if (value.isBoolean()) {
-            return value.asBoolean() ? strings->stringTrue.string() : strings->stringFalse.string();
-        }
-        if (value.isString()) {
-            return Value(Quote(ObjectPropertyName(state, value)));
-        }
-        if (value.isNumber()) {
-            double d = value.toNumber(state);
-            if (std::isfinite(d)) {
-                return value.toString(state);
-            }
-            return strings->null.string();
-        }
-        if (value.isObject()) {
-            if (!value.isFunction()) {
-                if (value.asObject()->isArrayObject() || value.asObject()->isTypedArrayObject()) {
-                    return JA(value.asObject()->asArrayObject());
-                } else {
-                    return JO(value.asObject());
-                }
-            }
-        }
-
-        return Value();
-    };
-
-    Quote = [&](ObjectPropertyName value) -> String* {
-        String* str = value.toPropertyName(state).plainString();
-
-        StringBuilder product;
-        product.appendChar('"');
-        for (size_t i = 0; i < str->length(); ++i) {
-            char16_t c = str->charAt(i);
-
-            if (c == u'\"' || c == u'\\') {
-                product.appendChar('\\');
-                product.appendChar(c);
-            } else if (c == u'\b') {
-                product.appendChar('\\');
-                product.appendChar('b');
-            } else if (c == u'\f') {
-                product.appendChar('\\');
-                product.appendChar('f');
-            } else if (c == u'\n') {
-                product.appendChar('\\');
-                product.appendChar('n');
-            } else if (c == u'\r') {
-                product.appendChar('\\');
-                product.appendChar('r');
-            } else if (c == u'\t') {
-                product.appendChar('\\');
-                product.appendChar('t');
-            } else if (c < u' ') {
-                product.appendChar('\\');
-                product.appendChar('u');
-                product.appendString(codePointTo4digitString(c));
-            } else {
-                product.appendChar(c);
-            }
-        }
-        product.appendChar('"');
-        return product.finalize(&state);
-    };
-
-    JA = [&](ArrayObject* arrayObj) -> String* {
-        // 1
-        for (size_t i = 0; i < stack.size(); i++) {
-            Value& v = stack[i];
-            if (v == Value(arrayObj)) {
-                ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, strings->JSON.string(), false, strings->stringify.string(), errorMessage_GlobalObject_JAError);
-            }
-        }
-        // 2
-        stack.push_back(Value(arrayObj));
-        // 3
-        String* stepback = indent;
-        // 4
-        StringBuilder newIndent;
-        newIndent.appendString(indent);
-        newIndent.appendString(gap);
-        indent = newIndent.finalize(&state);
-        // 5
-        std::vector<String*, gc_allocator_ignore_off_page<String*>> partial;
-        // 6, 7
-        uint32_t len = arrayObj->length(state);
-        uint32_t index = 0;
-        // 8
-        while (index < len) {
-            Value strP = Str(ObjectPropertyName(state, Value(index).toString(state)), arrayObj);
-            if (strP.isUndefined()) {
-                partial.push_back(strings->null.string());
-            } else {
-                partial.push_back(strP.asString());
-            }
-            index++;
-        }
-        // 9
-        StringBuilder final;
-        final.appendChar('[');
-        if (partial.size() != 0) {
-            if (gap->length() == 0) {
-                for (size_t i = 0; i < partial.size(); ++i) {
-                    final.appendString(partial[i]);
-                    if (i < partial.size() - 1) {
-                        final.appendChar(',');
-                    }
-                }
-            } else {
-                final.appendChar('\n');
-                final.appendString(indent);
-                StringBuilder seperatorBuilder;
-                seperatorBuilder.appendChar(',');
-                seperatorBuilder.appendChar('\n');
-                seperatorBuilder.appendString(indent);
-                String* seperator = seperatorBuilder.finalize(&state);
-                for (size_t i = 0; i < partial.size(); ++i) {
-                    final.appendString(partial[i]);
-                    if (i < partial.size() - 1) {
-                        final.appendString(seperator);
-                    }
-                }
-                final.appendChar('\n');
-                final.appendString(stepback);
-            }
-        }
-        final.appendChar(']');
-
-        // 11
-        stack.pop_back();
-        // 12
-        indent = stepback;
-
-        return final.finalize(&state);
-    };
-
-    JO = [&](Object* value) -> String* {
-        // 1
-        for (size_t i = 0; i < stack.size(); i++) {
-            if (stack[i] == value) {
-                ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, strings->JSON.string(), false, strings->stringify.string(), errorMessage_GlobalObject_JOError);
-            }
-        }
-        // 2
-        stack.push_back(Value(value));
-        // 3
-        String* stepback = indent;
-        // 4
-        StringBuilder newIndent;
-        newIndent.appendString(indent);
-        newIndent.appendString(gap);
-        indent = newIndent.finalize(&state);
-        // 5, 6
-        std::vector<ObjectPropertyName, GCUtil::gc_malloc_ignore_off_page_allocator<ObjectPropertyName>> k;
-        if (propertyListTouched) {
-            k = propertyList;
-        } else {
-            value->enumeration(state, [](ExecutionState& state, Object* self, const ObjectPropertyName& P, const ObjectStructurePropertyDescriptor& desc, void* data) -> bool {
-                std::vector<ObjectPropertyName, GCUtil::gc_malloc_ignore_off_page_allocator<ObjectPropertyName>>* k = (std::vector<ObjectPropertyName, GCUtil::gc_malloc_ignore_off_page_allocator<ObjectPropertyName>>*)data;
-                if (desc.isEnumerable()) {
-                    k->push_back(P);
-                }
-                return true;
-            },
-                               &k);
-        }
-
-        // 7
-        std::vector<String*, gc_allocator_ignore_off_page<String*>> partial;
-        // 8
-        int len = k.size();
-        for (int i = 0; i < len; ++i) {
-            Value strP = Str(k[i], value);
-            if (!strP.isUndefined()) {
-                StringBuilder member;
-                member.appendString(Quote(k[i]));
-                member.appendChar(':');
-                if (gap->length() != 0) {
-                    member.appendChar(' ');
-                }
-                member.appendString(strP.toString(state));
-                partial.push_back(member.finalize(&state));
-            }
-        }
-        // 9
-        StringBuilder final;
-        final.appendChar('{');
-        if (partial.size() != 0) {
-            if (gap->length() == 0) {
-                for (size_t i = 0; i < partial.size(); ++i) {
-                    final.appendString(partial[i]);
-                    if (i < partial.size() - 1) {
-                        final.appendChar(',');
-                    }
-                }
-            } else {
-                final.appendChar('\n');
-                final.appendString(indent);
-                StringBuilder seperatorBuilder;
-                seperatorBuilder.appendChar(',');
-                seperatorBuilder.appendChar('\n');
-                seperatorBuilder.appendString(indent);
-                String* seperator = seperatorBuilder.finalize(&state);
-                for (size_t i = 0; i < partial.size(); ++i) {
-                    final.appendString(partial[i]);
-                    if (i < partial.size() - 1) {
-                        final.appendString(seperator);
-                    }
-                }
-                final.appendChar('\n');
-                final.appendString(stepback);
-            }
-        }
-        final.appendChar('}');
-        // 11
-        stack.pop_back();
-        // 12
-        indent = stepback;
-
-        return final.finalize(&state);
-    };
-
-    // 9
-    Object* wrapper = new Object(state);
-    // 10
-    wrapper->defineOwnProperty(state, ObjectPropertyName(state, String::emptyString), ObjectPropertyDescriptor(value, ObjectPropertyDescriptor::AllPresent));
-    return Str(ObjectPropertyName(state, Value(String::emptyString)), wrapper);
+    return JSONStringifier(state, replacerFunc, propertyListTouched ? &propertyList : nullptr, gap).stringify(value);
 }
 
 void GlobalObject::installJSON(ExecutionState& state)
@@ -136,17 +136,16 @@ static Value builtinSetForEach(ExecutionState& state, Value thisValue, size_t ar
         T = argv[1];
     }
     // Let entries be the List that is the value of S's [[SetData]] internal slot.
-    const SetObject::SetObjectData& entries = S->storage();
+    SetObject::SetObjectData& entries = S->storage();
     // Repeat for each e that is an element of entries, in original insertion order
-    for (size_t i = 0; i < entries.size(); i++) {
-        Value e = entries[i];
-        // If e is not empty, then
-        if (!e.isEmpty()) {
-            // If e.[[Key]] is not empty, then
-            // Perform ? Call(callbackfn, T, « e, e, S »).
-            Value argv[3] = { Value(e), Value(e), Value(S) };
-            callbackfn.asFunction()->call(state, T, 3, argv);
-        }
+    // If e is not empty, then (SetObjectData::next skips empty entries)
+    SetObject::SetObjectData::Data* cursorData = nullptr;
+    size_t cursorIndex = 0;
+    while (SmallValue* entry = entries.next(cursorData, cursorIndex)) {
+        Value e = *entry;
+        // Perform ? Call(callbackfn, T, « e, e, S »).
+        Value argv[3] = { Value(e), Value(e), Value(S) };
+        callbackfn.asFunction()->call(state, T, 3, argv);
     }
 
     return Value();
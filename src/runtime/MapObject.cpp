@@ -48,85 +48,46 @@ void* MapObject::operator new(size_t size)
 
 void MapObject::clear(ExecutionState& state)
 {
-    for (size_t i = 0; i < m_storage.size(); i++) {
-        m_storage[i] = std::make_pair(Value(Value::EmptyValue), Value(Value::EmptyValue));
-    }
+    m_storage.clear();
 }
 
 size_t MapObject::size(ExecutionState& state)
 {
-    size_t siz = 0;
-    for (size_t i = 0; i < m_storage.size(); i++) {
-        Value existingKey = m_storage[i].first;
-        if (existingKey.isEmpty()) {
-            continue;
-        }
-        siz++;
-    }
-    return siz;
+    return m_storage.size();
 }
 
 bool MapObject::deleteOperation(ExecutionState& state, const Value& key)
 {
-    for (size_t i = 0; i < m_storage.size(); i++) {
-        Value existingKey = m_storage[i].first;
-        if (existingKey.isEmpty()) {
-            continue;
-        }
-        if (existingKey.equalsToByTheSameValueZeroAlgorithm(state, key)) {
-            m_storage[i] = std::make_pair(Value(Value::EmptyValue), Value(Value::EmptyValue));
-            return true;
-        }
-    }
-    return false;
+    return m_storage.remove(state, key);
 }
 
 Value MapObject::get(ExecutionState& state, const Value& key)
 {
-    for (size_t i = 0; i < m_storage.size(); i++) {
-        Value existingKey = m_storage[i].first;
-        if (existingKey.isEmpty()) {
-            continue;
-        }
-        if (existingKey.equalsToByTheSameValueZeroAlgorithm(state, key)) {
-            return m_storage[i].second;
-        }
+    MapObjectDataItem* e = m_storage.find(state, key);
+    if (e) {
+        return e->second;
     }
     return Value();
 }
 
 bool MapObject::has(ExecutionState& state, const Value& key)
 {
-    for (size_t i = 0; i < m_storage.size(); i++) {
-        Value existingKey = m_storage[i].first;
-        if (existingKey.isEmpty()) {
-            continue;
-        }
-        if (existingKey.equalsToByTheSameValueZeroAlgorithm(state, key)) {
-            return true;
-        }
-    }
-    return false;
+    return m_storage.find(state, key) != nullptr;
 }
 
 void MapObject::set(ExecutionState& state, const Value& key, const Value& value)
 {
-    for (size_t i = 0; i < m_storage.size(); i++) {
-        Value existingKey = m_storage[i].first;
-        if (existingKey.isEmpty()) {
-            continue;
-        }
-        if (existingKey.equalsToByTheSameValueZeroAlgorithm(state, key)) {
-            m_storage[i].second = value;
-            return;
-        }
+    MapObjectDataItem* e = m_storage.find(state, key);
+    if (e) {
+        e->second = value;
+        return;
     }
 
     // If key is -0, let key be +0.
     if (key.isNumber() && key.asNumber() == 0 && std::signbit(key.asNumber()) == true) {
-        m_storage.pushBack(std::make_pair(Value(0), value));
+        m_storage.add(Value(0)) = std::make_pair(Value(0), value);
     } else {
-        m_storage.pushBack(std::make_pair(key, value));
+        m_storage.add(key) = std::make_pair(key, value);
     }
 }
 
@@ -148,6 +109,7 @@ MapIteratorObject* MapObject::entries(ExecutionState& state)
 MapIteratorObject::MapIteratorObject(ExecutionState& state, MapObject* map, Type type)
     : IteratorObject(state)
     , m_map(map)
+    , m_iteratorData(nullptr)
     , m_iteratorIndex(0)
     , m_type(type)
 {
@@ -164,6 +126,7 @@ void* MapIteratorObject::operator new(size_t size)
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(MapIteratorObject, m_prototype));
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(MapIteratorObject, m_values));
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(MapIteratorObject, m_map));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(MapIteratorObject, m_iteratorData));
         descr = GC_make_descriptor(obj_bitmap, GC_WORD_LEN(MapIteratorObject));
         typeInited = true;
     }
@@ -176,7 +139,6 @@ std::pair<Value, bool> MapIteratorObject::advance(ExecutionState& state)
     // Let index be the value of the [[MapNextIndex]] internal slot of O.
     // Let itemKind be the value of the [[MapIterationKind]] internal slot of O.
     MapObject* m = m_map;
-    size_t index = m_iteratorIndex;
     Type itemKind = m_type;
 
     // If m is undefined, return CreateIterResultObject(undefined, true).
@@ -186,33 +148,27 @@ std::pair<Value, bool> MapIteratorObject::advance(ExecutionState& state)
 
     // Let entries be the List that is the value of the [[MapData]] internal slot of m.
     // Repeat while index is less than the total number of elements of entries. The number of elements must be redetermined each time this method is evaluated.
-    while (index < m->m_storage.size()) {
-        // Let e be the Record {[[Key]], [[Value]]} that is the value of entries[index].
-        auto e = m->m_storage[index];
-        // Set index to index+1.
-        index++;
-        // Set the [[MapNextIndex]] internal slot of O to index.
-        m_iteratorIndex = index;
-
-        if (e.first.isEmpty()) {
-            continue;
-        }
-        // If e.[[Key]] is not empty, then
+    // NOTE: removed entries (e.[[Key]] is empty) are skipped by MapObjectData::next, which also
+    // translates [[MapNextIndex]] when the storage was compacted or cleared since the last call.
+    MapObject::MapObjectDataItem* e = m->m_storage.next(m_iteratorData, m_iteratorIndex);
+    if (e) {
         // If itemKind is "key", let result be e.[[Key]].
         // Else if itemKind is "value", let result be e.[[Value]].
         // Else,
         // Assert: itemKind is "key+value".
         // Let result be CreateArrayFromList(« e.[[Key]], e.[[Value]] »).
         // Return CreateIterResultObject(result, false).
+        Value key = e->first;
+        Value value = e->second;
         Value result;
         if (itemKind == Type::TypeKey) {
-            result = e.first;
+            result = key;
         } else if (itemKind == Type::TypeValue) {
-            result = e.second;
+            result = value;
         } else if (itemKind == Type::TypeKeyValue) {
             ArrayObject* arr = new ArrayObject(state);
-            arr->defineOwnProperty(state, ObjectPropertyName(state, Value(0)), ObjectPropertyDescriptor(e.first, ObjectPropertyDescriptor::AllPresent));
-            arr->defineOwnProperty(state, ObjectPropertyName(state, Value(1)), ObjectPropertyDescriptor(e.second, ObjectPropertyDescriptor::AllPresent));
+            arr->defineOwnProperty(state, ObjectPropertyName(state, Value(0)), ObjectPropertyDescriptor(key, ObjectPropertyDescriptor::AllPresent));
+            arr->defineOwnProperty(state, ObjectPropertyName(state, Value(1)), ObjectPropertyDescriptor(value, ObjectPropertyDescriptor::AllPresent));
             result = arr;
         }
         return std::make_pair(result, false);
@@ -220,6 +176,7 @@ std::pair<Value, bool> MapIteratorObject::advance(ExecutionState& state)
 
     // Set the [[Map]] internal slot of O to undefined.
     m_map = nullptr;
+    m_iteratorData = nullptr;
     // Return CreateIterResultObject(undefined, true).
     return std::make_pair(Value(), true);
 }
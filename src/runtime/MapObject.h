@@ -22,6 +22,7 @@
 
 #include "runtime/Object.h"
 #include "runtime/IteratorObject.h"
+#include "runtime/OrderedHashTable.h"
 
 namespace Escargot {
 
@@ -31,7 +32,31 @@ class MapObject : public Object {
     friend class MapIteratorObject;
 
 public:
-    typedef TightVector<std::pair<SmallValue, SmallValue>, GCUtil::gc_malloc_ignore_off_page_allocator<std::pair<SmallValue, SmallValue>>> MapObjectData;
+    typedef std::pair<SmallValue, SmallValue> MapObjectDataItem;
+    struct MapObjectDataTraits {
+        static bool isEmpty(const MapObjectDataItem& e)
+        {
+            return e.first.isEmpty();
+        }
+        static void makeEmpty(MapObjectDataItem& e)
+        {
+            e.first = Value(Value::EmptyValue);
+            e.second = Value(Value::EmptyValue);
+        }
+        static size_t hash(const Value& key)
+        {
+            return hashValueForSameValueZero(key);
+        }
+        static size_t hashEntry(const MapObjectDataItem& e)
+        {
+            return hashValueForSameValueZero(e.first);
+        }
+        static bool matches(ExecutionState& state, const MapObjectDataItem& e, const Value& key)
+        {
+            return Value(e.first).equalsToByTheSameValueZeroAlgorithm(state, key);
+        }
+    };
+    typedef OrderedHashTable<MapObjectDataItem, Value, MapObjectDataTraits> MapObjectData;
     MapObject(ExecutionState& state);
 
     virtual bool isMapObject() const override
@@ -59,7 +84,7 @@ public:
     void* operator new(size_t size);
     void* operator new[](size_t size) = delete;
 
-    const MapObjectData& storage()
+    MapObjectData& storage()
     {
         return m_storage;
     }
@@ -92,6 +117,7 @@ public:
 
 protected:
     MapObject* m_map;
+    MapObject::MapObjectData::Data* m_iteratorData;
     size_t m_iteratorIndex;
     Type m_type;
 };
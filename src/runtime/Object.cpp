@@ -405,6 +405,12 @@ void Object::setPrototype(ExecutionState& state, const Value& value)
     } else {
         m_prototype = o;
     }
+    invalidatePrototypeChainCachesIfNeeded(state);
+}
+
+void Object::invalidatePrototypeChainCaches(ExecutionState& state)
+{
+    state.context()->vmInstance()->invalidatePrototypeChainCaches();
 }
 
 void Object::markAsPrototypeObject(ExecutionState& state)
@@ -475,6 +481,7 @@ bool Object::defineOwnProperty(ExecutionState& state, const ObjectPropertyName&
         } else {
             m_values.pushBack(Value(new JSGetterSetter(desc.getterSetter())), m_structure->propertyCount());
         }
+        invalidatePrototypeChainCachesIfNeeded(state);
 
         // ASSERT(m_values.size() == m_structure->propertyCount());
         return true;
@@ -648,19 +655,21 @@ bool Object::defineOwnProperty(ExecutionState& state, const ObjectPropertyName&
             if (!structure()->isStructureWithFastAccess())
                 m_structure = structure()->convertToWithFastAccess(state);
 
-            if (newDesc.isDataDescriptor() && m_structure->m_properties[idx].m_descriptor.isNativeAccessorProperty()) {
+            ObjectStructureItem& ownedItem = m_structure->propertyItemForFastAccess(idx);
+            if (newDesc.isDataDescriptor() && ownedItem.m_descriptor.isNativeAccessorProperty()) {
                 auto newNative = new ObjectPropertyNativeGetterSetterData(newDesc.isWritable(), newDesc.isEnumerable(), newDesc.isConfigurable(),
-                                                                          m_structure->m_properties[idx].m_descriptor.nativeGetterSetterData()->m_getter, m_structure->m_properties[idx].m_descriptor.nativeGetterSetterData()->m_setter);
-                m_structure->m_properties[idx].m_descriptor = ObjectStructurePropertyDescriptor::createDataButHasNativeGetterSetterDescriptor(newNative);
+                                                                          ownedItem.m_descriptor.nativeGetterSetterData()->m_getter, ownedItem.m_descriptor.nativeGetterSetterData()->m_setter);
+                ownedItem.m_descriptor = ObjectStructurePropertyDescriptor::createDataButHasNativeGetterSetterDescriptor(newNative);
             } else {
-                m_structure->m_properties[idx].m_descriptor = newDesc.toObjectStructurePropertyDescriptor();
+                ownedItem.m_descriptor = newDesc.toObjectStructurePropertyDescriptor();
             }
 
             m_structure = new ObjectStructureWithFastAccess(state, *((ObjectStructureWithFastAccess*)m_structure));
+            invalidatePrototypeChainCachesIfNeeded(state);
 
             ASSERT(structureBefore != m_structure);
             if (newDesc.isDataDescriptor()) {
-                return setOwnDataPropertyUtilForObjectInner(state, idx, m_structure->m_properties[idx], newDesc.value());
+                return setOwnDataPropertyUtilForObjectInner(state, idx, m_structure->readProperty(state, idx), newDesc.value());
             } else {
                 m_values[idx] = Value(new JSGetterSetter(newDesc.getterSetter()));
             }
@@ -821,6 +830,7 @@ void Object::deleteOwnProperty(ExecutionState& state, size_t idx)
 {
     m_structure = m_structure->removeProperty(state, idx);
     m_values.erase(idx, m_structure->propertyCount() + 1);
+    invalidatePrototypeChainCachesIfNeeded(state);
 
     // ASSERT(m_values.size() == m_structure->propertyCount());
 }
@@ -1013,6 +1023,7 @@ bool Object::defineNativeDataAccessorProperty(ExecutionState& state, const Objec
 
     m_structure = m_structure->addProperty(state, P.toPropertyName(state), ObjectStructurePropertyDescriptor::createDataButHasNativeGetterSetterDescriptor(data));
     m_values.pushBack(objectInternalData, m_structure->propertyCount());
+    invalidatePrototypeChainCachesIfNeeded(state);
 
     return true;
 }
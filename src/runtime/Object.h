@@ -523,7 +523,10 @@ class Object : public PointerValue {
     friend class VMInstance;
     friend class GlobalObject;
     friend class ByteCodeInterpreter;
+    friend class JITCompiler;
+    friend class FunctionObject;
     friend struct ObjectRareData;
+    friend class JSONStringifier;
     static Object* createBuiltinObjectPrototype(ExecutionState& state);
 
 public:
@@ -720,6 +723,12 @@ public:
         return true;
     }
 
+    // for-in keys can be cached on the structure only when enumeration() visits nothing but the structure
+    virtual bool isEnumerationCacheable()
+    {
+        return isInlineCacheable();
+    }
+
     ObjectRareData* ensureObjectRareData()
     {
         if (rareData() == nullptr) {
@@ -782,6 +791,14 @@ public:
         ensureObjectRareData()->m_internalSlot = object;
     }
 
+    // reserves storage for |count| more properties which are going to be added soon
+    // (e.g. properties of an object literal or what a constructor assigns to this)
+    // so adding them does not grow the storage one by one
+    void reservePropertyStorage(size_t count)
+    {
+        m_values.reserve(m_structure->propertyCount(), m_structure->propertyCount() + count);
+    }
+
     static void throwCannotDefineError(ExecutionState& state, const PropertyName& P);
     static void throwCannotWriteError(ExecutionState& state, const PropertyName& P);
     static void throwCannotDeleteError(ExecutionState& state, const PropertyName& P);
@@ -810,9 +827,12 @@ protected:
     }
     ObjectStructure* m_structure;
     Object* m_prototype;
-    TightVectorWithNoSize<SmallValue, GCUtil::gc_malloc_ignore_off_page_allocator<SmallValue>> m_values;
+    // storage grows geometrically. its capacity comes from the gc block, so it costs no extra word
+    TightVectorWithNoSizeUseGCCapacity<SmallValue, GCUtil::gc_malloc_ignore_off_page_allocator<SmallValue>> m_values;
 
-    COMPILE_ASSERT(sizeof(TightVectorWithNoSize<SmallValue, GCUtil::gc_malloc_ignore_off_page_allocator<SmallValue>>) == sizeof(size_t) * 1, "");
+#ifndef GC_DEBUG
+    COMPILE_ASSERT(sizeof(TightVectorWithNoSizeUseGCCapacity<SmallValue, GCUtil::gc_malloc_ignore_off_page_allocator<SmallValue>>) == sizeof(size_t) * 1, "");
+#endif
 
     ObjectStructure* structure() const
     {
@@ -902,6 +922,15 @@ protected:
     }
 
     void markAsPrototypeObject(ExecutionState& state);
+
+    // should be called after changing structure or [[Prototype]] of this object
+    ALWAYS_INLINE void invalidatePrototypeChainCachesIfNeeded(ExecutionState& state)
+    {
+        if (UNLIKELY(isEverSetAsPrototypeObject())) {
+            invalidatePrototypeChainCaches(state);
+        }
+    }
+    void invalidatePrototypeChainCaches(ExecutionState& state);
     void deleteOwnProperty(ExecutionState& state, size_t idx);
 };
 }
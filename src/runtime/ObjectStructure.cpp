@@ -28,8 +28,10 @@ void* ObjectStructure::operator new(size_t size)
     static GC_descr descr;
     if (!typeInited) {
         GC_word obj_bitmap[GC_BITMAP_SIZE(ObjectStructure)] = { 0 };
-        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ObjectStructure, m_properties));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ObjectStructure, m_propertyTable));
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ObjectStructure, m_transitionTable));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ObjectStructure, m_transitionTableMap));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ObjectStructure, m_enumerationCache));
         descr = GC_make_descriptor(obj_bitmap, GC_WORD_LEN(ObjectStructure));
         typeInited = true;
     }
@@ -43,9 +45,10 @@ void* ObjectStructureWithFastAccess::operator new(size_t size)
     if (!typeInited) {
         const size_t len = GC_BITMAP_SIZE(ObjectStructureWithFastAccess);
         GC_word obj_bitmap[len] = { 0 };
-        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ObjectStructureWithFastAccess, m_properties));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ObjectStructureWithFastAccess, m_propertyTable));
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ObjectStructureWithFastAccess, m_transitionTable));
-        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ObjectStructureWithFastAccess, m_propertyNameMap));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ObjectStructureWithFastAccess, m_transitionTableMap));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ObjectStructureWithFastAccess, m_enumerationCache));
         descr = GC_make_descriptor(obj_bitmap, GC_WORD_LEN(ObjectStructureWithFastAccess));
         typeInited = true;
     }
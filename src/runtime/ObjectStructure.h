@@ -28,6 +28,7 @@
 namespace Escargot {
 
 class ObjectStructure;
+struct EnumerateObjectKeys;
 
 struct ObjectStructureItem : public gc {
     ObjectStructureItem(const PropertyName& as, const ObjectStructurePropertyDescriptor& desc)
@@ -53,10 +54,134 @@ struct ObjectStructureTransitionItem : public gc {
     }
 };
 
-typedef Vector<ObjectStructureItem, GCUtil::gc_malloc_ignore_off_page_allocator<ObjectStructureItem>> ObjectStructureItemVector;
 typedef Vector<ObjectStructureTransitionItem, GCUtil::gc_malloc_ignore_off_page_allocator<ObjectStructureTransitionItem>> ObjectStructureTransitionTableVector;
+typedef std::unordered_multimap<PropertyName, size_t, std::hash<PropertyName>, std::equal_to<PropertyName>, gc_allocator<std::pair<const PropertyName, size_t>>> ObjectStructureTransitionTableMap;
 
 #define ESCARGOT_OBJECT_STRUCTURE_ACCESS_CACHE_BUILD_MIN_SIZE 96
+#ifndef ESCARGOT_OBJECT_STRUCTURE_PROPERTY_TABLE_INDEX_BUILD_MIN_SIZE
+#define ESCARGOT_OBJECT_STRUCTURE_PROPERTY_TABLE_INDEX_BUILD_MIN_SIZE 12
+#endif
+#ifndef ESCARGOT_OBJECT_STRUCTURE_TRANSITION_MAP_BUILD_MIN_SIZE
+#define ESCARGOT_OBJECT_STRUCTURE_TRANSITION_MAP_BUILD_MIN_SIZE 8
+#endif
+
+// Property items of ObjectStructures.
+// A table is shared along a transition chain: each structure uses the first
+// m_propertyCount items of its table, and a child structure appends its new
+// item in place when its parent is the last user of the table and there is room left.
+// Items of a shared table never move or change, so references returned by
+// ObjectStructure::readProperty stay valid.
+// ObjectStructureWithFastAccess owns its table exclusively and may modify it.
+class ObjectStructurePropertyTable : public gc {
+public:
+    explicit ObjectStructurePropertyTable(size_t capacity)
+        : m_items(GCUtil::gc_malloc_ignore_off_page_allocator<ObjectStructureItem>().allocate(capacity))
+        , m_size(0)
+        , m_capacity(capacity)
+        , m_index(nullptr)
+    {
+    }
+
+    ObjectStructurePropertyTable(ObjectStructurePropertyTable* src, size_t count, size_t capacity)
+        : ObjectStructurePropertyTable(capacity)
+    {
+        ASSERT(count <= capacity);
+        if (count) {
+            memcpy(m_items, src->m_items, sizeof(ObjectStructureItem) * count);
+        }
+        m_size = count;
+    }
+
+    static size_t capacityFor(size_t count)
+    {
+        return std::max((size_t)4, count + (count + 1) / 2);
+    }
+
+    size_t size() const
+    {
+        return m_size;
+    }
+
+    size_t capacity() const
+    {
+        return m_capacity;
+    }
+
+    ObjectStructureItem& operator[](size_t idx)
+    {
+        ASSERT(idx < m_size);
+        return m_items[idx];
+    }
+
+    void append(const ObjectStructureItem& item)
+    {
+        if (UNLIKELY(m_size == m_capacity)) {
+            // only reachable for exclusively owned tables
+            ObjectStructureItem* newItems = GCUtil::gc_malloc_ignore_off_page_allocator<ObjectStructureItem>().allocate(capacityFor(m_capacity + 1));
+            memcpy(newItems, m_items, sizeof(ObjectStructureItem) * m_size);
+            GCUtil::gc_malloc_ignore_off_page_allocator<ObjectStructureItem>().deallocate(m_items, m_capacity);
+            m_items = newItems;
+            m_capacity = capacityFor(m_capacity + 1);
+        }
+        m_items[m_size] = item;
+        if (m_index) {
+            m_index->insert(std::make_pair(item.m_propertyName, m_size));
+        }
+        m_size++;
+    }
+
+    void erase(size_t idx)
+    {
+        ASSERT(idx < m_size);
+        memmove(&m_items[idx], &m_items[idx + 1], sizeof(ObjectStructureItem) * (m_size - idx - 1));
+        m_size--;
+        m_index = nullptr;
+    }
+
+    // returns the index of the first item named |name| among the first |count| items
+    size_t find(const PropertyName& name, size_t count)
+    {
+        ASSERT(count <= m_size);
+        if (count < ESCARGOT_OBJECT_STRUCTURE_PROPERTY_TABLE_INDEX_BUILD_MIN_SIZE) {
+            for (size_t i = 0; i < count; i++) {
+                if (m_items[i].m_propertyName == name) {
+                    return i;
+                }
+            }
+            return SIZE_MAX;
+        }
+
+        if (UNLIKELY(!m_index)) {
+            buildIndex();
+        }
+        auto iter = m_index->find(name);
+        if (iter == m_index->end() || iter->second >= count) {
+            return SIZE_MAX;
+        }
+        return iter->second;
+    }
+
+    void* operator new(size_t size)
+    {
+        return GC_MALLOC(size);
+    }
+    void* operator new[](size_t size) = delete;
+
+private:
+    void buildIndex()
+    {
+        m_index = new (GC) PropertyNameMap();
+        m_index->reserve(m_capacity);
+        for (size_t i = 0; i < m_size; i++) {
+            m_index->insert(std::make_pair(m_items[i].m_propertyName, i));
+        }
+    }
+
+    ObjectStructureItem* m_items;
+    size_t m_size;
+    size_t m_capacity;
+    PropertyNameMap* m_index;
+};
 
 class ObjectStructure : public gc {
     friend class Object;
@@ -69,15 +194,22 @@ public:
         m_isProtectedByTransitionTable = false;
         m_hasIndexPropertyName = false;
         m_isStructureWithFastAccess = false;
+        m_propertyTable = nullptr;
+        m_propertyCount = 0;
+        m_transitionTableMap = nullptr;
+        m_enumerationCache = nullptr;
     }
 
-    ObjectStructure(ExecutionState&, ObjectStructureItemVector&& properties, bool needsTransitionTable, bool hasIndexPropertyName)
-        : m_properties(std::move(properties))
+    ObjectStructure(ExecutionState&, ObjectStructurePropertyTable* propertyTable, size_t propertyCount, bool needsTransitionTable, bool hasIndexPropertyName)
     {
         m_needsTransitionTable = needsTransitionTable;
         m_isProtectedByTransitionTable = false;
         m_hasIndexPropertyName = hasIndexPropertyName;
         m_isStructureWithFastAccess = false;
+        m_propertyTable = propertyTable;
+        m_propertyCount = propertyCount;
+        m_transitionTableMap = nullptr;
+        m_enumerationCache = nullptr;
     }
 
     size_t findProperty(ExecutionState& state, String* propertyName)
@@ -93,17 +225,10 @@ public:
 
     size_t findProperty(const PropertyName& s)
     {
-        if (UNLIKELY(m_isStructureWithFastAccess)) {
-            return findPropertyWithMap(s);
-        }
-
-        size_t siz = m_properties.size();
-        for (size_t i = 0; i < siz; i++) {
-            if (m_properties[i].m_propertyName == s) {
-                return i;
-            }
+        if (!m_propertyCount) {
+            return SIZE_MAX;
         }
-        return SIZE_MAX;
+        return m_propertyTable->find(s, m_propertyCount);
     }
 
     ObjectStructureItem readProperty(ExecutionState& state, String* propertyName)
@@ -113,7 +238,8 @@ public:
 
     const ObjectStructureItem& readProperty(ExecutionState&, size_t idx)
     {
-        return m_properties[idx];
+        ASSERT(idx < m_propertyCount);
+        return (*m_propertyTable)[idx];
     }
 
     ObjectStructure* addProperty(ExecutionState& state, String* propertyName, const ObjectStructurePropertyDescriptor& desc)
@@ -149,7 +275,18 @@ public:
 
     size_t propertyCount() const
     {
-        return m_properties.size();
+        return m_propertyCount;
+    }
+
+    // for-in keys of objects which have this structure (see ByteCodeInterpreter::executeEnumerateObject)
+    EnumerateObjectKeys* enumerationCache()
+    {
+        return m_enumerationCache;
+    }
+
+    void setEnumerationCache(EnumerateObjectKeys* keys)
+    {
+        m_enumerationCache = keys;
     }
 
     void* operator new(size_t size);
@@ -160,12 +297,41 @@ protected:
     bool m_needsTransitionTable;
     bool m_hasIndexPropertyName;
     bool m_isStructureWithFastAccess;
-    ObjectStructureItemVector m_properties;
+    ObjectStructurePropertyTable* m_propertyTable;
+    size_t m_propertyCount;
     ObjectStructureTransitionTableVector m_transitionTable;
+    ObjectStructureTransitionTableMap* m_transitionTableMap;
+    EnumerateObjectKeys* m_enumerationCache;
+
+    // only for ObjectStructureWithFastAccess, which owns its property table
+    ObjectStructureItem& propertyItemForFastAccess(size_t idx)
+    {
+        ASSERT(m_isStructureWithFastAccess);
+        return (*m_propertyTable)[idx];
+    }
+
+    // returns a table whose first m_propertyCount items are ours and which has room for one more item at m_propertyCount
+    ObjectStructurePropertyTable* propertyTableForAppend()
+    {
+        if (m_propertyTable && m_propertyTable->size() == m_propertyCount && m_propertyCount < m_propertyTable->capacity()) {
+            return m_propertyTable;
+        }
+        return new ObjectStructurePropertyTable(m_propertyTable, m_propertyCount, ObjectStructurePropertyTable::capacityFor(m_propertyCount + 1));
+    }
 
     size_t searchTransitionTable(const PropertyName& s, const ObjectStructurePropertyDescriptor& desc)
     {
         ASSERT(m_needsTransitionTable);
+        if (m_transitionTableMap) {
+            auto range = m_transitionTableMap->equal_range(s);
+            for (auto iter = range.first; iter != range.second; ++iter) {
+                if (m_transitionTable[iter->second].m_descriptor == desc) {
+                    return iter->second;
+                }
+            }
+            return SIZE_MAX;
+        }
+
         size_t len = m_transitionTable.size();
         for (size_t i = 0; i < len; i++) {
             if (m_transitionTable[i].m_descriptor == desc && m_transitionTable[i].m_propertyName == s) {
@@ -175,18 +341,18 @@ protected:
         return SIZE_MAX;
     }
 
-    size_t findPropertyWithMap(const PropertyName& s)
+    void appendToTransitionTable(const ObjectStructureTransitionItem& item)
     {
-        const PropertyNameMap& map = propertyNameMap();
-        auto iter = map.find(s);
-        if (map.end() == iter) {
-            return SIZE_MAX;
-        } else {
-            return iter->second;
+        m_transitionTable.pushBack(item);
+        if (m_transitionTableMap) {
+            m_transitionTableMap->insert(std::make_pair(item.m_propertyName, m_transitionTable.size() - 1));
+        } else if (m_transitionTable.size() > ESCARGOT_OBJECT_STRUCTURE_TRANSITION_MAP_BUILD_MIN_SIZE) {
+            m_transitionTableMap = new (GC) ObjectStructureTransitionTableMap();
+            for (size_t i = 0; i < m_transitionTable.size(); i++) {
+                m_transitionTableMap->insert(std::make_pair(m_transitionTable[i].m_propertyName, i));
+            }
         }
     }
-
-    PropertyNameMap& propertyNameMap();
 };
 
 class ObjectStructureWithFastAccess : public ObjectStructure {
@@ -194,60 +360,34 @@ class ObjectStructureWithFastAccess : public ObjectStructure {
     friend class ObjectStructure;
 
 public:
-    ObjectStructureWithFastAccess(ExecutionState& state)
-        : ObjectStructure(state, false)
-        , m_propertyNameMap(new (GC) PropertyNameMap())
+    ObjectStructureWithFastAccess(ExecutionState& state, ObjectStructurePropertyTable* ownedPropertyTable, bool hasIndexPropertyName)
+        : ObjectStructure(state, ownedPropertyTable, ownedPropertyTable->size(), false, hasIndexPropertyName)
     {
         m_isStructureWithFastAccess = true;
-        buildPropertyNameMap();
-    }
-
-    ObjectStructureWithFastAccess(ExecutionState& state, ObjectStructureItemVector&& properties, bool hasIndexPropertyName)
-        : ObjectStructure(state, std::move(properties), false, hasIndexPropertyName)
-        , m_propertyNameMap(new (GC) PropertyNameMap())
-    {
-        m_isStructureWithFastAccess = true;
-        buildPropertyNameMap();
     }
 
+    // takes the property table of |old|; |old| must not be used after this
     ObjectStructureWithFastAccess(ExecutionState& state, ObjectStructureWithFastAccess& old)
-        : ObjectStructure(state, std::move(old.m_properties), old.m_needsTransitionTable, old.m_hasIndexPropertyName)
-        , m_propertyNameMap(old.m_propertyNameMap)
+        : ObjectStructure(state, old.m_propertyTable, old.m_propertyTable->size(), old.m_needsTransitionTable, old.m_hasIndexPropertyName)
     {
         m_isStructureWithFastAccess = true;
-        old.m_propertyNameMap = nullptr;
-    }
-
-    void buildPropertyNameMap()
-    {
-        m_propertyNameMap->clear();
-        size_t len = m_properties.size();
-        for (size_t i = 0; i < len; i++) {
-            m_propertyNameMap->insert(std::make_pair(m_properties[i].m_propertyName, i));
-        }
+        old.m_propertyTable = nullptr;
+        old.m_propertyCount = 0;
     }
 
     void* operator new(size_t size);
     void* operator new[](size_t size) = delete;
-
-    PropertyNameMap* m_propertyNameMap;
 };
 
-inline PropertyNameMap& ObjectStructure::propertyNameMap()
-{
-    ASSERT(m_isStructureWithFastAccess);
-    ObjectStructureWithFastAccess* self = (ObjectStructureWithFastAccess*)this;
-    return *self->m_propertyNameMap;
-}
-
 inline ObjectStructure* ObjectStructure::addProperty(ExecutionState& state, const PropertyName& name, const ObjectStructurePropertyDescriptor& desc)
 {
     ObjectStructureItem newItem(name, desc);
+    bool nameIsIndexString = m_hasIndexPropertyName ? true : name.isIndexString();
+
     if (m_isStructureWithFastAccess) {
-        m_properties.pushBack(newItem);
-        bool nameIsIndexString = m_hasIndexPropertyName ? true : name.isIndexString();
+        m_propertyTable->append(newItem);
+        m_propertyCount++;
         m_hasIndexPropertyName = m_hasIndexPropertyName | nameIsIndexString;
-        propertyNameMap().insert(std::make_pair(name, m_properties.size() - 1));
         ObjectStructureWithFastAccess* self = (ObjectStructureWithFastAccess*)this;
         ObjectStructureWithFastAccess* newSelf = new ObjectStructureWithFastAccess(state, *self);
         return newSelf;
@@ -262,19 +402,22 @@ inline ObjectStructure* ObjectStructure::addProperty(ExecutionState& state, cons
         ASSERT(m_transitionTable.size() == 0);
     }
 
-    bool nameIsIndexString = m_hasIndexPropertyName ? true : name.isIndexString();
-    ObjectStructureItemVector newProperties(m_properties, newItem);
     ObjectStructure* newObjectStructure;
 
-    if (newProperties.size() > ESCARGOT_OBJECT_STRUCTURE_ACCESS_CACHE_BUILD_MIN_SIZE)
-        newObjectStructure = new ObjectStructureWithFastAccess(state, std::move(newProperties), m_hasIndexPropertyName | nameIsIndexString);
-    else
-        newObjectStructure = new ObjectStructure(state, std::move(newProperties), m_needsTransitionTable, m_hasIndexPropertyName | nameIsIndexString);
+    if (m_propertyCount + 1 > ESCARGOT_OBJECT_STRUCTURE_ACCESS_CACHE_BUILD_MIN_SIZE) {
+        ObjectStructurePropertyTable* ownedTable = new ObjectStructurePropertyTable(m_propertyTable, m_propertyCount, ObjectStructurePropertyTable::capacityFor(m_propertyCount + 1));
+        ownedTable->append(newItem);
+        newObjectStructure = new ObjectStructureWithFastAccess(state, ownedTable, m_hasIndexPropertyName | nameIsIndexString);
+    } else {
+        ObjectStructurePropertyTable* table = propertyTableForAppend();
+        table->append(newItem);
+        newObjectStructure = new ObjectStructure(state, table, m_propertyCount + 1, m_needsTransitionTable, m_hasIndexPropertyName | nameIsIndexString);
+    }
 
     if (m_needsTransitionTable && !newObjectStructure->isStructureWithFastAccess()) {
         ObjectStructureTransitionItem newTransitionItem(name, desc, newObjectStructure);
         newObjectStructure->m_isProtectedByTransitionTable = true;
-        m_transitionTable.pushBack(newTransitionItem);
+        appendToTransitionTable(newTransitionItem);
     }
 
     return newObjectStructure;
@@ -283,29 +426,24 @@ inline ObjectStructure* ObjectStructure::addProperty(ExecutionState& state, cons
 inline ObjectStructure* ObjectStructure::removeProperty(ExecutionState& state, size_t pIndex)
 {
     if (m_isStructureWithFastAccess) {
-        m_properties.erase(pIndex);
-        propertyNameMap().clear();
+        m_propertyTable->erase(pIndex);
+        m_propertyCount--;
         ObjectStructureWithFastAccess* self = (ObjectStructureWithFastAccess*)this;
-        self->buildPropertyNameMap();
         ObjectStructureWithFastAccess* newSelf = new ObjectStructureWithFastAccess(state, *self);
         return newSelf;
     }
 
-    ObjectStructureItemVector newProperties;
-    newProperties.resizeWithUninitializedValues(m_properties.size() - 1);
-
-    size_t newIdx = 0;
+    ObjectStructurePropertyTable* newTable = new ObjectStructurePropertyTable(ObjectStructurePropertyTable::capacityFor(m_propertyCount - 1));
     bool hasIndexString = false;
-    for (size_t i = 0; i < m_properties.size(); i++) {
+    for (size_t i = 0; i < m_propertyCount; i++) {
         if (i == pIndex)
             continue;
-        hasIndexString = hasIndexString | m_properties[i].m_propertyName.isIndexString();
-        newProperties[newIdx].m_propertyName = m_properties[i].m_propertyName;
-        newProperties[newIdx].m_descriptor = m_properties[i].m_descriptor;
-        newIdx++;
+        const ObjectStructureItem& item = (*m_propertyTable)[i];
+        hasIndexString = hasIndexString | item.m_propertyName.isIndexString();
+        newTable->append(item);
     }
 
-    return new ObjectStructure(state, std::move(newProperties), false, hasIndexString);
+    return new ObjectStructure(state, newTable, newTable->size(), false, hasIndexString);
 }
 
 inline ObjectStructure* ObjectStructure::escapeTransitionMode(ExecutionState& state)
@@ -315,28 +453,20 @@ inline ObjectStructure* ObjectStructure::escapeTransitionMode(ExecutionState& st
     }
 
     ASSERT(inTransitionMode());
-    ObjectStructureItemVector newItem(m_properties);
-    return new ObjectStructure(state, std::move(newItem), false, m_hasIndexPropertyName);
+    // items are immutable in a shared table, so the new structure can share ours
+    return new ObjectStructure(state, m_propertyTable, m_propertyCount, false, m_hasIndexPropertyName);
 }
 
 inline ObjectStructure* ObjectStructure::convertToWithFastAccess(ExecutionState& state)
 {
     ASSERT(!m_isStructureWithFastAccess);
-    ObjectStructureItemVector v = m_properties;
-    return new ObjectStructureWithFastAccess(state, std::move(v), m_hasIndexPropertyName);
+    ObjectStructurePropertyTable* ownedTable = new ObjectStructurePropertyTable(m_propertyTable, m_propertyCount, ObjectStructurePropertyTable::capacityFor(m_propertyCount));
+    return new ObjectStructureWithFastAccess(state, ownedTable, m_hasIndexPropertyName);
 }
 }
 
 namespace std {
 
-template <>
-struct is_fundamental<Escargot::ObjectStructureItem> {
-    operator bool() const
-    {
-        return true;
-    }
-};
-
 template <>
 struct is_fundamental<Escargot::ObjectStructureTransitionItem> {
     operator bool() const
@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) 2018-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotOrderedHashTable__
+#define __EscargotOrderedHashTable__
+
+#include "runtime/Value.h"
+
+namespace Escargot {
+
+class ExecutionState;
+
+// Hash for the SameValueZero algorithm: equal keys must produce equal hashes,
+// so numbers are hashed by numeric value (int32 and double encodings of the same
+// number collide on purpose, -0 is folded into +0 and every NaN is the same key)
+// and strings are hashed by content.
+inline size_t hashPointerForOrderedHashTable(const void* ptr)
+{
+    size_t h = (size_t)ptr;
+    h ^= (h >> 4) ^ (h >> 12);
+    return h ^ (h >> 20);
+}
+
+inline size_t hashValueForSameValueZero(const Value& key)
+{
+    if (key.isPointerValue()) {
+        PointerValue* p = key.asPointerValue();
+        if (p->isString()) {
+            return p->asString()->hashValue();
+        }
+        return hashPointerForOrderedHashTable(p);
+    }
+
+    if (key.isNumber()) {
+        double d = key.asNumber();
+        if (std::isnan(d)) {
+            return 0x7ff80000;
+        }
+        int32_t i = (int32_t)d;
+        if (i == d) {
+            return (size_t)i * 2654435761u;
+        }
+        uint64_t bits;
+        memcpy(&bits, &d, sizeof(double));
+        return (size_t)(bits ^ (bits >> 32));
+    }
+
+    return (size_t)key.asRawData();
+}
+
+// Data of OrderedHashTable. A table is never resized in place:
+// growing, compacting or clearing allocates a new one and leaves a forwarding
+// record in the old one (m_next, m_removedIndexes), so that iterators which still
+// hold the old table can translate their position without being registered anywhere.
+template <typename Entry>
+class OrderedHashTableData : public gc {
+public:
+    static const uint32_t invalidIndex = std::numeric_limits<uint32_t>::max();
+
+    explicit OrderedHashTableData(size_t capacity)
+        : m_entries(GCUtil::gc_malloc_ignore_off_page_allocator<Entry>().allocate(capacity))
+        , m_buckets(GCUtil::gc_malloc_atomic_ignore_off_page_allocator<uint32_t>().allocate(capacity))
+        , m_chain(GCUtil::gc_malloc_atomic_ignore_off_page_allocator<uint32_t>().allocate(capacity))
+        , m_capacity(capacity)
+        , m_usedCount(0)
+        , m_liveCount(0)
+        , m_next(nullptr)
+        , m_removedIndexes(nullptr)
+        , m_removedIndexCount(0)
+        , m_cleared(false)
+    {
+        ASSERT(capacity && (capacity & (capacity - 1)) == 0);
+        memset(m_buckets, 0xff, sizeof(uint32_t) * capacity);
+    }
+
+    Entry* m_entries;
+    uint32_t* m_buckets;
+    uint32_t* m_chain;
+    size_t m_capacity;
+    // number of entry slots used in insertion order, including removed ones
+    size_t m_usedCount;
+    size_t m_liveCount;
+
+    OrderedHashTableData<Entry>* m_next;
+    uint32_t* m_removedIndexes;
+    size_t m_removedIndexCount;
+    bool m_cleared;
+
+    void followForwarding(size_t& index)
+    {
+        ASSERT(m_next);
+        if (m_cleared) {
+            index = 0;
+        } else {
+            index -= std::lower_bound(m_removedIndexes, m_removedIndexes + m_removedIndexCount, (uint32_t)index) - m_removedIndexes;
+        }
+    }
+
+    void releaseStorage()
+    {
+        m_entries = nullptr;
+        m_buckets = nullptr;
+        m_chain = nullptr;
+        m_capacity = m_usedCount = m_liveCount = 0;
+    }
+};
+
+// Deterministic insertion-ordered hash table (close table).
+// Entries live in insertion order in m_entries; m_buckets / m_chain index them by hash.
+// Removed entries are marked empty (Traits::makeEmpty) and dropped on the next rehash.
+//
+// Traits must provide
+//   static bool isEmpty(const Entry&);
+//   static void makeEmpty(Entry&);
+//   static size_t hash(const Key&);
+//   static size_t hashEntry(const Entry&);
+//   static bool matches(ExecutionState&, const Entry&, const Key&);
+template <typename Entry, typename Key, typename Traits>
+class OrderedHashTable {
+public:
+    typedef OrderedHashTableData<Entry> Data;
+    static const size_t minimumCapacity = 8;
+
+    OrderedHashTable()
+        : m_data(nullptr)
+    {
+    }
+
+    Data* data() const
+    {
+        return m_data;
+    }
+
+    size_t size() const
+    {
+        return m_data ? m_data->m_liveCount : 0;
+    }
+
+    Entry* find(ExecutionState& state, const Key& key) const
+    {
+        if (!m_data) {
+            return nullptr;
+        }
+        uint32_t idx = m_data->m_buckets[Traits::hash(key) & (m_data->m_capacity - 1)];
+        while (idx != Data::invalidIndex) {
+            Entry& e = m_data->m_entries[idx];
+            if (!Traits::isEmpty(e) && Traits::matches(state, e, key)) {
+                return &e;
+            }
+            idx = m_data->m_chain[idx];
+        }
+        return nullptr;
+    }
+
+    // Appends a new slot for |key|, which must not be in the table yet.
+    // The caller fills the returned entry immediately.
+    Entry& add(const Key& key)
+    {
+        if (!m_data || m_data->m_usedCount == m_data->m_capacity) {
+            rehash(m_data ? countLiveEntries() + 1 : 1);
+        }
+        Data* d = m_data;
+        uint32_t idx = d->m_usedCount++;
+        d->m_liveCount++;
+        size_t bucket = Traits::hash(key) & (d->m_capacity - 1);
+        d->m_chain[idx] = d->m_buckets[bucket];
+        d->m_buckets[bucket] = idx;
+        return d->m_entries[idx];
+    }
+
+    bool remove(ExecutionState& state, const Key& key)
+    {
+        Entry* e = find(state, key);
+        if (!e) {
+            return false;
+        }
+        Traits::makeEmpty(*e);
+        m_data->m_liveCount--;
+        if (m_data->m_capacity > minimumCapacity && m_data->m_liveCount * 4 < m_data->m_capacity) {
+            rehash(m_data->m_liveCount);
+        }
+        return true;
+    }
+
+    void clear()
+    {
+        if (!m_data) {
+            return;
+        }
+        Data* old = m_data;
+        m_data = new Data(minimumCapacity);
+        old->m_cleared = true;
+        old->m_next = m_data;
+        old->releaseStorage();
+    }
+
+    // Iteration protocol shared by iterator objects and forEach:
+    // (|data|, |index|) is a cursor that survives rehashing and clearing of the table.
+    // Returns the next live entry at or after the cursor and moves the cursor past it,
+    // or nullptr when iteration is done.
+    Entry* next(Data*& data, size_t& index) const
+    {
+        if (!data) {
+            if (!m_data) {
+                return nullptr;
+            }
+            data = m_data;
+            index = 0;
+        }
+        while (data->m_next) {
+            data->followForwarding(index);
+            data = data->m_next;
+        }
+        while (index < data->m_usedCount) {
+            Entry& e = data->m_entries[index++];
+            if (!Traits::isEmpty(e)) {
+                return &e;
+            }
+        }
+        return nullptr;
+    }
+
+private:
+    size_t countLiveEntries() const
+    {
+        // weak tables lose entries without notice, so m_liveCount is only an upper bound there
+        size_t count = 0;
+        for (size_t i = 0; i < m_data->m_usedCount; i++) {
+            if (!Traits::isEmpty(m_data->m_entries[i])) {
+                count++;
+            }
+        }
+        return count;
+    }
+
+    void rehash(size_t liveCount)
+    {
+        size_t capacity = minimumCapacity;
+        while (capacity < liveCount * 2) {
+            capacity *= 2;
+        }
+
+        Data* old = m_data;
+        Data* d = new Data(capacity);
+        if (old) {
+            if (countLiveEntries() != old->m_usedCount) {
+                // a collection in this allocation can empty more entries of a weak table,
+                // so the buffer is sized for every used slot rather than for the entries counted above
+                old->m_removedIndexes = GCUtil::gc_malloc_atomic_ignore_off_page_allocator<uint32_t>().allocate(old->m_usedCount);
+            }
+            for (size_t i = 0; i < old->m_usedCount; i++) {
+                Entry& e = old->m_entries[i];
+                if (Traits::isEmpty(e)) {
+                    ASSERT(old->m_removedIndexes && old->m_removedIndexCount < old->m_usedCount);
+                    old->m_removedIndexes[old->m_removedIndexCount++] = i;
+                    continue;
+                }
+                uint32_t idx = d->m_usedCount++;
+                size_t bucket = Traits::hashEntry(e) & (capacity - 1);
+                d->m_entries[idx] = e;
+                d->m_chain[idx] = d->m_buckets[bucket];
+                d->m_buckets[bucket] = idx;
+            }
+            d->m_liveCount = d->m_usedCount;
+            old->m_next = d;
+            old->releaseStorage();
+        }
+        m_data = d;
+    }
+
+    Data* m_data;
+};
+}
+
+#endif
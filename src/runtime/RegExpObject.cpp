@@ -24,6 +24,10 @@
 
 #include "Yarr.h"
 
+#if defined(ESCARGOT_ENABLE_JIT)
+#include "jit/RegExpJIT.h"
+#endif
+
 namespace Escargot {
 
 RegExpObject::RegExpObject(ExecutionState& state, String* source, String* option)
@@ -64,6 +68,9 @@ void* RegExpObject::operator new(size_t size)
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(RegExpObject, m_source));
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(RegExpObject, m_yarrPattern));
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(RegExpObject, m_bytecodePattern));
+#if defined(ESCARGOT_ENABLE_JIT)
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(RegExpObject, m_jitInfo));
+#endif
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(RegExpObject, m_lastIndex));
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(RegExpObject, m_lastExecutedString));
         descr = GC_make_descriptor(obj_bitmap, GC_WORD_LEN(RegExpObject));
@@ -138,6 +145,9 @@ void RegExpObject::init(ExecutionState& state, String* source, String* option)
 
     m_yarrPattern = entry.m_yarrPattern;
     m_bytecodePattern = entry.m_bytecodePattern;
+#if defined(ESCARGOT_ENABLE_JIT)
+    m_jitInfo = entry.m_jitInfo;
+#endif
 }
 
 void RegExpObject::setLastIndex(ExecutionState& state, const Value& v)
@@ -208,6 +218,9 @@ void RegExpObject::setOption(const Option& option)
         || ((m_option & Option::IgnoreCase) != (option & Option::IgnoreCase))) {
         ASSERT(!m_yarrPattern);
         m_bytecodePattern = NULL;
+#if defined(ESCARGOT_ENABLE_JIT)
+        m_jitInfo = nullptr;
+#endif
     }
     m_option = option;
 }
@@ -215,14 +228,10 @@ void RegExpObject::setOption(const Option& option)
 RegExpObject::RegExpCacheEntry& RegExpObject::getCacheEntryAndCompileIfNeeded(ExecutionState& state, String* source, const Option& option)
 {
     auto cache = state.context()->regexpCache();
-    auto it = cache->find(RegExpCacheKey(source, option));
-    if (it != cache->end()) {
-        return it->second;
+    RegExpCacheEntry* cachedEntry = cache->find(RegExpCacheKey(source, option));
+    if (cachedEntry) {
+        return *cachedEntry;
     } else {
-        if (cache->size() > 256) {
-            cache->clear();
-        }
-
         const char* yarrError = nullptr;
         JSC::Yarr::YarrPattern* yarrPattern = nullptr;
         try {
@@ -230,7 +239,58 @@ RegExpObject::RegExpCacheEntry& RegExpObject::getCacheEntryAndCompileIfNeeded(Ex
         } catch (const std::bad_alloc& e) {
             ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, "got too complicated RegExp pattern to process");
         }
-        return cache->insert(std::make_pair(RegExpCacheKey(source, option), RegExpCacheEntry(yarrError, yarrPattern))).first->second;
+        RegExpCacheEntry entry(yarrError, yarrPattern);
+#if defined(ESCARGOT_ENABLE_JIT)
+        if (!yarrError) {
+            entry.m_jitInfo = new (PointerFreeGC) RegExpJITInfo();
+        }
+#endif
+        return cache->insert(RegExpCacheKey(source, option), entry);
+    }
+}
+
+RegExpObject::RegExpCacheEntry* RegExpCache::find(const RegExpObject::RegExpCacheKey& key)
+{
+    auto iter = m_map.find(key);
+    if (iter == m_map.end()) {
+        m_missCount++;
+        return nullptr;
+    }
+    m_hitCount++;
+    if (iter->second != m_items.begin()) {
+        m_items.splice(m_items.begin(), m_items, iter->second);
+    }
+    return &iter->second->second;
+}
+
+RegExpObject::RegExpCacheEntry& RegExpCache::insert(const RegExpObject::RegExpCacheKey& key, const RegExpObject::RegExpCacheEntry& entry)
+{
+    ASSERT(m_map.find(key) == m_map.end());
+    m_items.push_front(std::make_pair(key, entry));
+    m_map.insert(std::make_pair(key, m_items.begin()));
+    evictIfNeeded();
+    return m_items.front().second;
+}
+
+void RegExpCache::clear()
+{
+    m_map.clear();
+    m_items.clear();
+}
+
+void RegExpCache::setBudget(size_t budget)
+{
+    m_budget = budget;
+    evictIfNeeded();
+}
+
+void RegExpCache::evictIfNeeded()
+{
+    // RegExpObjects which use an evicted pattern keep it alive by themselves
+    while (m_items.size() > std::max(m_budget, (size_t)1)) {
+        m_map.erase(m_items.back().first);
+        m_items.pop_back();
+        m_evictionCount++;
     }
 }
 
@@ -257,6 +317,9 @@ bool RegExpObject::match(ExecutionState& state, String* str, RegexMatchResult& m
             return false;
         }
         m_yarrPattern = entry.m_yarrPattern;
+#if defined(ESCARGOT_ENABLE_JIT)
+        m_jitInfo = entry.m_jitInfo;
+#endif
 
         if (entry.m_bytecodePattern) {
             m_bytecodePattern = entry.m_bytecodePattern;
@@ -277,6 +340,9 @@ bool RegExpObject::match(ExecutionState& state, String* str, RegexMatchResult& m
     bool gotResult = false;
     bool reachToEnd = false;
     unsigned* outputBuf = ALLOCA(sizeof(unsigned) * 2 * (subPatternNum + 1), unsigned int, state);
+#if defined(ESCARGOT_ENABLE_JIT)
+    RegExpJITCode* jitCode = m_jitInfo ? m_jitInfo->jitCode(m_yarrPattern) : nullptr;
+#endif
     outputBuf[1] = start;
     do {
         start = outputBuf[1];
@@ -284,6 +350,14 @@ bool RegExpObject::match(ExecutionState& state, String* str, RegexMatchResult& m
         if (start > length) {
             break;
         }
+#if defined(ESCARGOT_ENABLE_JIT)
+        if (jitCode) {
+            if (LIKELY(str->has8BitContent()))
+                result = jitCode->match(str->characters8(), length, start, outputBuf);
+            else
+                result = jitCode->match(str->characters16(), length, start, outputBuf);
+        } else
+#endif
         if (LIKELY(str->has8BitContent()))
             result = JSC::Yarr::interpret(m_bytecodePattern, str->characters8(), length, start, outputBuf);
         else
@@ -32,6 +32,10 @@ struct BytecodePattern;
 
 namespace Escargot {
 
+#if defined(ESCARGOT_ENABLE_JIT)
+struct RegExpJITInfo;
+#endif
+
 struct RegexMatchResult {
     struct RegexMatchResultPiece {
         unsigned m_start, m_end;
@@ -55,21 +59,21 @@ public:
         Unicode = 1 << 5,
     };
 
+    // keyed by the content of the source, so the same pattern created again from another string shares the entry
     struct RegExpCacheKey {
         RegExpCacheKey(const String* body, Option option)
             : m_body(body)
-            , m_multiline(option & RegExpObject::Option::MultiLine)
-            , m_ignoreCase(option & RegExpObject::Option::IgnoreCase)
+            // global changes only how lastIndex is used, so it does not split entries
+            , m_option((Option)(option & (Option::IgnoreCase | Option::MultiLine | Option::Sticky | Option::Unicode)))
         {
         }
 
         bool operator==(const RegExpCacheKey& otherKey) const
         {
-            return (m_body == otherKey.m_body) && (m_multiline == otherKey.m_multiline) && (m_ignoreCase == otherKey.m_ignoreCase);
+            return (m_option == otherKey.m_option) && (m_body == otherKey.m_body || m_body->equals(otherKey.m_body));
         }
         const String* m_body;
-        const bool m_multiline;
-        const bool m_ignoreCase;
+        const Option m_option;
     };
 
     struct RegExpCacheEntry {
@@ -77,12 +81,19 @@ public:
             : m_yarrError(yarrError)
             , m_yarrPattern(yarrPattern)
             , m_bytecodePattern(bytecodePattern)
+#if defined(ESCARGOT_ENABLE_JIT)
+            , m_jitInfo(nullptr)
+#endif
         {
         }
 
         const char* m_yarrError;
         JSC::Yarr::YarrPattern* m_yarrPattern;
         JSC::Yarr::BytecodePattern* m_bytecodePattern;
+#if defined(ESCARGOT_ENABLE_JIT)
+        // execution count of the pattern and its native code
+        RegExpJITInfo* m_jitInfo;
+#endif
     };
 
     RegExpObject(ExecutionState& state);
@@ -167,15 +178,14 @@ private:
     Option m_option;
     JSC::Yarr::YarrPattern* m_yarrPattern;
     JSC::Yarr::BytecodePattern* m_bytecodePattern;
+#if defined(ESCARGOT_ENABLE_JIT)
+    RegExpJITInfo* m_jitInfo;
+#endif
 
     SmallValue m_lastIndex;
     const String* m_lastExecutedString;
 };
 
-typedef std::unordered_map<RegExpObject::RegExpCacheKey, RegExpObject::RegExpCacheEntry,
-                           std::hash<RegExpObject::RegExpCacheKey>, std::equal_to<RegExpObject::RegExpCacheKey>,
-                           gc_allocator<std::pair<const RegExpObject::RegExpCacheKey, RegExpObject::RegExpCacheEntry>>>
-    RegExpCacheMap;
 }
 
 namespace std {
@@ -184,7 +194,7 @@ template <>
 struct hash<Escargot::RegExpObject::RegExpCacheKey> {
     size_t operator()(Escargot::RegExpObject::RegExpCacheKey const& x) const
     {
-        return x.m_body->hashValue();
+        return x.m_body->hashValue() ^ x.m_option;
     }
 };
 
@@ -197,4 +207,70 @@ struct equal_to<Escargot::RegExpObject::RegExpCacheKey> {
 };
 }
 
+namespace Escargot {
+
+// compiled patterns shared between RegExpObjects which have the same source and flags.
+// when there are more entries than the budget, the least recently used one is evicted
+class RegExpCache {
+public:
+    typedef std::pair<RegExpObject::RegExpCacheKey, RegExpObject::RegExpCacheEntry> RegExpCacheItem;
+    typedef std::list<RegExpCacheItem, gc_allocator<RegExpCacheItem>> RegExpCacheItemList;
+
+    RegExpCache()
+        : m_budget(REGEXP_CACHE_SIZE_MAX)
+        , m_hitCount(0)
+        , m_missCount(0)
+        , m_evictionCount(0)
+    {
+    }
+
+    // returns nullptr if there is no entry. found entry becomes the most recently used one
+    RegExpObject::RegExpCacheEntry* find(const RegExpObject::RegExpCacheKey& key);
+    // the new entry is never evicted by this insertion, so the returned reference is valid until the next insertion
+    RegExpObject::RegExpCacheEntry& insert(const RegExpObject::RegExpCacheKey& key, const RegExpObject::RegExpCacheEntry& entry);
+    void clear();
+
+    size_t size() const
+    {
+        return m_map.size();
+    }
+
+    size_t budget() const
+    {
+        return m_budget;
+    }
+
+    void setBudget(size_t budget);
+
+    size_t hitCount() const
+    {
+        return m_hitCount;
+    }
+
+    size_t missCount() const
+    {
+        return m_missCount;
+    }
+
+    size_t evictionCount() const
+    {
+        return m_evictionCount;
+    }
+
+private:
+    void evictIfNeeded();
+
+    // the most recently used entry comes first
+    RegExpCacheItemList m_items;
+    std::unordered_map<RegExpObject::RegExpCacheKey, RegExpCacheItemList::iterator,
+                       std::hash<RegExpObject::RegExpCacheKey>, std::equal_to<RegExpObject::RegExpCacheKey>,
+                       gc_allocator<std::pair<const RegExpObject::RegExpCacheKey, RegExpCacheItemList::iterator>>>
+        m_map;
+    size_t m_budget;
+    size_t m_hitCount;
+    size_t m_missCount;
+    size_t m_evictionCount;
+};
+}
+
 #endif
@@ -48,71 +48,36 @@ void* SetObject::operator new(size_t size)
 
 void SetObject::clear(ExecutionState& state)
 {
-    for (size_t i = 0; i < m_storage.size(); i++) {
-        m_storage[i] = Value(Value::EmptyValue);
-    }
+    m_storage.clear();
 }
 
 bool SetObject::deleteOperation(ExecutionState& state, const Value& key)
 {
-    for (size_t i = 0; i < m_storage.size(); i++) {
-        Value existingKey = m_storage[i];
-        if (existingKey.isEmpty()) {
-            continue;
-        }
-        if (existingKey.equalsToByTheSameValueZeroAlgorithm(state, key)) {
-            m_storage[i] = Value(Value::EmptyValue);
-            return true;
-        }
-    }
-    return false;
+    return m_storage.remove(state, key);
 }
 
 void SetObject::add(ExecutionState& state, const Value& key)
 {
-    for (size_t i = 0; i < m_storage.size(); i++) {
-        Value existingKey = m_storage[i];
-        if (existingKey.isEmpty()) {
-            continue;
-        }
-        if (existingKey.equalsToByTheSameValueZeroAlgorithm(state, key)) {
-            return;
-        }
+    if (m_storage.find(state, key)) {
+        return;
     }
 
     // If key is -0, let key be +0.
     if (key.isNumber() && key.asNumber() == 0 && std::signbit(key.asNumber()) == true) {
-        m_storage.pushBack(Value(0));
+        m_storage.add(Value(0)) = Value(0);
     } else {
-        m_storage.pushBack(key);
+        m_storage.add(key) = key;
     }
 }
 
 bool SetObject::has(ExecutionState& state, const Value& key)
 {
-    for (size_t i = 0; i < m_storage.size(); i++) {
-        Value existingKey = m_storage[i];
-        if (existingKey.isEmpty()) {
-            continue;
-        }
-        if (existingKey.equalsToByTheSameValueZeroAlgorithm(state, key)) {
-            return true;
-        }
-    }
-    return false;
+    return m_storage.find(state, key) != nullptr;
 }
 
 size_t SetObject::size(ExecutionState& state)
 {
-    size_t siz = 0;
-    for (size_t i = 0; i < m_storage.size(); i++) {
-        Value existingKey = m_storage[i];
-        if (existingKey.isEmpty()) {
-            continue;
-        }
-        siz++;
-    }
-    return siz;
+    return m_storage.size();
 }
 
 SetIteratorObject* SetObject::values(ExecutionState& state)
@@ -133,6 +98,7 @@ SetIteratorObject* SetObject::entries(ExecutionState& state)
 SetIteratorObject::SetIteratorObject(ExecutionState& state, SetObject* set, Type type)
     : IteratorObject(state)
     , m_set(set)
+    , m_iteratorData(nullptr)
     , m_iteratorIndex(0)
     , m_type(type)
 {
@@ -149,6 +115,7 @@ void* SetIteratorObject::operator new(size_t size)
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(SetIteratorObject, m_prototype));
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(SetIteratorObject, m_values));
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(SetIteratorObject, m_set));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(SetIteratorObject, m_iteratorData));
         descr = GC_make_descriptor(obj_bitmap, GC_WORD_LEN(SetIteratorObject));
         typeInited = true;
     }
@@ -161,7 +128,6 @@ std::pair<Value, bool> SetIteratorObject::advance(ExecutionState& state)
     // Let index be the value of the [[SetNextIndex]] internal slot of O.
     // Let itemKind be the value of the [[SetIterationKind]] internal slot of O.
     SetObject* s = m_set;
-    size_t index = m_iteratorIndex;
     Type itemKind = m_type;
 
     // If s is undefined, return CreateIterResultObject(undefined, true).
@@ -171,18 +137,11 @@ std::pair<Value, bool> SetIteratorObject::advance(ExecutionState& state)
 
     // Let entries be the List that is the value of the [[SetData]] internal slot of s.
     // Repeat while index is less than the total number of elements of entries. The number of elements must be redetermined each time this method is evaluated.
-    while (index < s->m_storage.size()) {
-        // Let e be entries[index].
-        Value e = s->m_storage[index];
-        // Set index to index+1.
-        index++;
-        // Set the [[SetNextIndex]] internal slot of O to index.
-        m_iteratorIndex = index;
-
-        if (e.isEmpty()) {
-            continue;
-        }
-
+    // NOTE: removed entries are skipped by SetObjectData::next, which also
+    // translates [[SetNextIndex]] when the storage was compacted or cleared since the last call.
+    SmallValue* entry = s->m_storage.next(m_iteratorData, m_iteratorIndex);
+    if (entry) {
+        Value e = *entry;
         Value result;
         if (itemKind == Type::TypeKeyValue) {
             ArrayObject* arr = new ArrayObject(state);
@@ -198,6 +157,7 @@ std::pair<Value, bool> SetIteratorObject::advance(ExecutionState& state)
 
     // Set the [[IteratedSet]] internal slot of O to undefined.
     m_set = nullptr;
+    m_iteratorData = nullptr;
     // Return CreateIterResultObject(undefined, true).
     return std::make_pair(Value(), true);
 }
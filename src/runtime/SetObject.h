@@ -22,6 +22,7 @@
 
 #include "runtime/Object.h"
 #include "runtime/IteratorObject.h"
+#include "runtime/OrderedHashTable.h"
 
 namespace Escargot {
 
@@ -31,7 +32,29 @@ class SetObject : public Object {
     friend class SetIteratorObject;
 
 public:
-    typedef TightVector<SmallValue, GCUtil::gc_malloc_ignore_off_page_allocator<SmallValue>> SetObjectData;
+    struct SetObjectDataTraits {
+        static bool isEmpty(const SmallValue& e)
+        {
+            return e.isEmpty();
+        }
+        static void makeEmpty(SmallValue& e)
+        {
+            e = Value(Value::EmptyValue);
+        }
+        static size_t hash(const Value& key)
+        {
+            return hashValueForSameValueZero(key);
+        }
+        static size_t hashEntry(const SmallValue& e)
+        {
+            return hashValueForSameValueZero(e);
+        }
+        static bool matches(ExecutionState& state, const SmallValue& e, const Value& key)
+        {
+            return Value(e).equalsToByTheSameValueZeroAlgorithm(state, key);
+        }
+    };
+    typedef OrderedHashTable<SmallValue, Value, SetObjectDataTraits> SetObjectData;
     SetObject(ExecutionState& state);
 
     virtual bool isSetObject() const override
@@ -58,7 +81,7 @@ public:
     void* operator new(size_t size);
     void* operator new[](size_t size) = delete;
 
-    const SetObjectData& storage()
+    SetObjectData& storage()
     {
         return m_storage;
     }
@@ -91,6 +114,7 @@ public:
 
 protected:
     SetObject* m_set;
+    SetObject::SetObjectData::Data* m_iteratorData;
     size_t m_iteratorIndex;
     Type m_type;
 };
@@ -37,6 +37,7 @@ COMPILE_ASSERT(sizeof(SmallValueData) == 4, "");
 COMPILE_ASSERT(sizeof(SmallValueData) == 8, "");
 #endif
 
+// box of doubles which are not small integers. only 32-bit builds use it. 64-bit builds store doubles unboxed
 class DoubleInSmallValue : public PointerValue {
     friend class SmallValue;
 
@@ -147,6 +148,16 @@ const int kSmiValueSize = PlatformSmiTagging::kSmiValueSize;
     ((reinterpret_cast<intptr_t>(value) & ::Escargot::SmallValueImpl::kSmiTagMask) == ::Escargot::SmallValueImpl::kSmiTag)
 #define HAS_OBJECT_TAG(value) \
     ((value & ::Escargot::SmallValueImpl::kHeapObjectTagMask) == ::Escargot::SmallValueImpl::kHeapObjectTag)
+
+#ifdef ESCARGOT_64
+// On 64-bit, doubles are stored unboxed with the encoding of Value (DoubleEncodeOffset is added),
+// so their payload begins with 0x0001..0xFFFE.
+// Smis begin with 0x0000 or 0xFFFF by sign extension, and pointers and constants begin with 0x0000.
+// Payload of a double is never an address of the heap, so the conservative collector ignores it.
+// the sum is unsigned, a payload near the top of intptr_t would overflow a signed one
+#define HAS_DOUBLE_TAG(value) \
+    ((uint64_t)(value) + (uint64_t)DoubleEncodeOffset >= (uint64_t)DoubleEncodeOffset * 2)
+#endif
 }
 
 extern size_t g_doubleInSmallValueTag;
@@ -194,6 +205,11 @@ public:
 
     bool isStoredInHeap()
     {
+#ifdef ESCARGOT_64
+        if (HAS_DOUBLE_TAG(m_data.payload)) {
+            return false;
+        }
+#endif
         if (HAS_OBJECT_TAG(m_data.payload)) {
             PointerValue* v = (PointerValue*)m_data.payload;
             if (((size_t)v) > smallValueEmpty) {
@@ -226,6 +242,12 @@ public:
 
     operator Value() const
     {
+#ifdef ESCARGOT_64
+        if (HAS_DOUBLE_TAG(m_data.payload)) {
+            // integral doubles come back as int32 like they do from DoubleInSmallValue on 32-bit
+            return Value(bitwise_cast<double>((uint64_t)m_data.payload - (uint64_t)DoubleEncodeOffset));
+        }
+#endif
         if (HAS_OBJECT_TAG(m_data.payload)) {
             PointerValue* v = (PointerValue*)m_data.payload;
             if (((size_t)v) <= smallValueEmpty) {
@@ -257,27 +279,32 @@ public:
         if (HAS_OBJECT_TAG(m_data.payload)) {
             return false;
         }
+#ifdef ESCARGOT_64
+        if (HAS_DOUBLE_TAG(m_data.payload)) {
+            return false;
+        }
+#endif
 
         return true;
     }
 
     uint32_t asInt32()
     {
-        ASSERT(!HAS_OBJECT_TAG(m_data.payload));
+        ASSERT(isInt32());
         int32_t value = SmallValueImpl::PlatformSmiTagging::SmiToInt(m_data.payload);
         return (uint32_t)value;
     }
 
     uint32_t asUint32()
     {
-        ASSERT(!HAS_OBJECT_TAG(m_data.payload));
+        ASSERT(isInt32());
         int32_t value = SmallValueImpl::PlatformSmiTagging::SmiToInt(m_data.payload);
         return (uint32_t)value;
     }
 
     uint32_t toUint32(ExecutionState& state)
     {
-        if (UNLIKELY(HAS_OBJECT_TAG(m_data.payload))) {
+        if (UNLIKELY(!isInt32())) {
             return operator Escargot::Value().toUint32(state);
         } else {
             int32_t value = SmallValueImpl::PlatformSmiTagging::SmiToInt(m_data.payload);
@@ -310,6 +337,9 @@ public:
             if (from.isInt32() && SmallValueImpl::PlatformSmiTagging::IsValidSmi(i32 = from.asInt32())) {
                 m_data.payload = SmallValueImpl::PlatformSmiTagging::IntToSmi(i32);
             } else if (from.isNumber()) {
+#ifdef ESCARGOT_64
+                m_data.payload = encodeDouble(from.asNumber());
+#else
                 auto payload = m_data.payload;
                 if (((size_t)payload > (size_t)smallValueEmpty) && HAS_OBJECT_TAG(payload)) {
                     PointerValue* v = (PointerValue*)payload;
@@ -319,6 +349,7 @@ public:
                     }
                 }
                 m_data.payload = reinterpret_cast<intptr_t>(new DoubleInSmallValue(from.asNumber()));
+#endif
             } else if (from.isUndefined()) {
                 m_data.payload = (intptr_t)(smallValueUndefined);
             } else if (from.isTrue()) {
@@ -354,7 +385,11 @@ protected:
             if (from.isInt32() && SmallValueImpl::PlatformSmiTagging::IsValidSmi(i32 = from.asInt32())) {
                 m_data.payload = SmallValueImpl::PlatformSmiTagging::IntToSmi(i32);
             } else if (from.isNumber()) {
+#ifdef ESCARGOT_64
+                m_data.payload = encodeDouble(from.asNumber());
+#else
                 m_data.payload = reinterpret_cast<intptr_t>(new DoubleInSmallValue(from.asNumber()));
+#endif
             } else if (from.isUndefined()) {
                 m_data.payload = (intptr_t)(smallValueUndefined);
             } else if (from.isTrue()) {
@@ -376,6 +411,17 @@ protected:
     {
     }
 
+#ifdef ESCARGOT_64
+    static intptr_t encodeDouble(double d)
+    {
+        // impure NaNs would begin with 0xFFFF (or 0x0000 after adding DoubleEncodeOffset)
+        if (UNLIKELY((bitwise_cast<int64_t>(d) & DoubleInvalidBeginning) == DoubleInvalidBeginning)) {
+            d = std::numeric_limits<double>::quiet_NaN();
+        }
+        return (intptr_t)(bitwise_cast<uint64_t>(d) + (uint64_t)DoubleEncodeOffset);
+    }
+#endif
+
 
     SmallValueData m_data;
 };
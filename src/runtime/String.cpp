@@ -157,6 +157,12 @@ char32_t readUTF8Sequence(const char*& sequence, bool& valid, int& charlen)
 }
 
 UTF16StringData utf8StringToUTF16String(const char* buf, const size_t& len)
+{
+    UTF16StringDataNonGCStd str = utf8StringToNonGCUTF16String(buf, len);
+    return UTF16StringData(str.data(), str.length());
+}
+
+UTF16StringDataNonGCStd utf8StringToNonGCUTF16String(const char* buf, const size_t& len)
 {
     UTF16StringDataNonGCStd str;
     const char* source = buf;
@@ -182,7 +188,7 @@ UTF16StringData utf8StringToUTF16String(const char* buf, const size_t& len)
         }
     }
 
-    return UTF16StringData(str.data(), str.length());
+    return str;
 }
 
 ASCIIStringData utf16StringToASCIIString(const char16_t* buf, const size_t& len)
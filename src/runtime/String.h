@@ -47,6 +47,7 @@ bool isAllLatin1(const char16_t* buf, const size_t& len);
 bool isIndexString(String* str);
 char32_t readUTF8Sequence(const char*& sequence, bool& valid, int& charlen);
 UTF16StringData utf8StringToUTF16String(const char* buf, const size_t& len);
+UTF16StringDataNonGCStd utf8StringToNonGCUTF16String(const char* buf, const size_t& len);
 UTF8StringData utf16StringToUTF8String(const char16_t* buf, const size_t& len);
 ASCIIStringData utf16StringToASCIIString(const char16_t* buf, const size_t& len);
 ASCIIStringData dtoa(double number);
@@ -285,6 +285,11 @@ public:
         Object::enumeration(state, callback, data);
     }
 
+    virtual bool isEnumerationCacheable() override
+    {
+        return false;
+    }
+
     void allocateTypedArray(ExecutionState& state, unsigned length)
     {
         auto obj = new ArrayBufferObject(state);
@@ -23,6 +23,7 @@
 #include "ArrayObject.h"
 #include "StringObject.h"
 #include "JobQueue.h"
+#include "interpreter/ByteCode.h"
 
 namespace Escargot {
 
@@ -151,7 +152,18 @@ static ObjectPropertyNativeGetterSetterData regexpLastIndexGetterSetterData(
 
 VMInstance::VMInstance(const char* locale, const char* timezone)
     : m_didSomePrototypeObjectDefineIndexedProperty(false)
+    , m_prototypeEpoch(1)
     , m_compiledByteCodeSize(0)
+    , m_byteCodeBlockEpoch(0)
+    , m_byteCodeSizeBudget(FUNCTION_OBJECT_BYTECODE_SIZE_MAX)
+    , m_byteCodeBlockEvictionCount(0)
+    , m_byteCodeBlockRegenerationCount(0)
+    , m_megamorphicPropertyCache(nullptr)
+    , m_megamorphicPropertyCacheHitCount(0)
+    , m_megamorphicPropertyCacheMissCount(0)
+    , m_interpreterFrameStack(nullptr)
+    , m_interpreterFrameStackTop(nullptr)
+    , m_interpreterFrameStackEnd(nullptr)
     , m_cachedUTC(nullptr)
 {
     if (!String::emptyString) {
@@ -162,6 +174,9 @@ VMInstance::VMInstance(const char* locale, const char* timezone)
     // TODO call destructor
     m_bumpPointerAllocator = new (GC) WTF::BumpPointerAllocator();
 
+    m_megamorphicPropertyCache = GCUtil::gc_malloc_allocator<GetObjectMegamorphicCacheEntry>().allocate(ESCARGOT_MEGAMORPHIC_PROPERTY_CACHE_SIZE);
+    clearMegamorphicPropertyCache();
+
 #ifdef ENABLE_ICU
     m_timezone = nullptr;
     if (timezone) {
@@ -285,12 +300,33 @@ VMInstance::VMInstance(const char* locale, const char* timezone)
 
 void VMInstance::clearCaches()
 {
+    clearMegamorphicPropertyCache();
     m_compiledCodeBlocks.clear();
     m_regexpCache.clear();
     m_cachedUTC = nullptr;
     globalSymbolRegistry().clear();
 }
 
+void VMInstance::clearMegamorphicPropertyCache()
+{
+    if (m_megamorphicPropertyCache) {
+        memset(m_megamorphicPropertyCache, 0, sizeof(GetObjectMegamorphicCacheEntry) * ESCARGOT_MEGAMORPHIC_PROPERTY_CACHE_SIZE);
+    }
+}
+
+void* VMInstance::allocateInterpreterFrameSlowCase(size_t size)
+{
+    if (m_interpreterFrameStack) {
+        return nullptr;
+    }
+
+    // allocated on first use, most scripts never call from the interpreter.
+    // frames are linked by pointers into the stack, so it never moves or grows
+    m_interpreterFrameStack = (char*)allocateInterpreterFrameStack(&m_interpreterFrameStackTop, INTERPRETER_FRAME_STACK_SIZE);
+    m_interpreterFrameStackEnd = m_interpreterFrameStackTop + INTERPRETER_FRAME_STACK_SIZE;
+    return allocateInterpreterFrame(size);
+}
+
 void VMInstance::somePrototypeObjectDefineIndexedProperty(ExecutionState& state)
 {
     m_didSomePrototypeObjectDefineIndexedProperty = true;
@@ -33,8 +33,10 @@ namespace Escargot {
 
 class SandBox;
 class CodeBlock;
+class ByteCodeBlock;
 class JobQueue;
 class Job;
+struct GetObjectMegamorphicCacheEntry;
 
 // TODO species, match, replace, search, split, isConcatSpreadable
 #define DEFINE_GLOBAL_SYMBOLS(F) \
@@ -68,6 +70,10 @@ public:
     ~VMInstance()
     {
         clearCaches();
+        // the stack points to m_interpreterFrameStackTop, so it should not outlive this
+        if (m_interpreterFrameStack) {
+            GC_FREE(m_interpreterFrameStack);
+        }
 #ifdef ENABLE_ICU
         delete m_timezone;
 #endif
@@ -162,6 +168,18 @@ public:
 
     void somePrototypeObjectDefineIndexedProperty(ExecutionState& state);
 
+    // inline caches validate lookups through prototype chains with this epoch.
+    // it is bumped whenever an object used as a prototype changes its structure or [[Prototype]]
+    size_t prototypeEpoch()
+    {
+        return m_prototypeEpoch;
+    }
+
+    void invalidatePrototypeChainCaches()
+    {
+        m_prototypeEpoch++;
+    }
+
     ToStringRecursionPreventer& toStringRecursionPreventer()
     {
         return m_toStringRecursionPreventer;
@@ -199,6 +217,79 @@ public:
         return m_compiledByteCodeSize;
     }
 
+    size_t byteCodeBlockEpoch()
+    {
+        return m_byteCodeBlockEpoch;
+    }
+
+    size_t advanceByteCodeBlockEpoch()
+    {
+        return ++m_byteCodeBlockEpoch;
+    }
+
+    size_t byteCodeSizeBudget()
+    {
+        return m_byteCodeSizeBudget;
+    }
+
+    void setByteCodeSizeBudget(size_t budget)
+    {
+        m_byteCodeSizeBudget = budget;
+    }
+
+    size_t& byteCodeBlockEvictionCount()
+    {
+        return m_byteCodeBlockEvictionCount;
+    }
+
+    size_t& byteCodeBlockRegenerationCount()
+    {
+        return m_byteCodeBlockRegenerationCount;
+    }
+
+    GetObjectMegamorphicCacheEntry* megamorphicPropertyCache()
+    {
+        return m_megamorphicPropertyCache;
+    }
+
+    size_t& megamorphicPropertyCacheHitCount()
+    {
+        return m_megamorphicPropertyCacheHitCount;
+    }
+
+    size_t& megamorphicPropertyCacheMissCount()
+    {
+        return m_megamorphicPropertyCacheMissCount;
+    }
+
+    void clearMegamorphicPropertyCache();
+
+    // frames of interpreted functions which ByteCodeInterpreter calls without recursion.
+    // returns nullptr if the stack is full, then the function is called on the native stack
+    void* allocateInterpreterFrame(size_t size)
+    {
+        // keeps Values of every frame aligned
+        size = (size + sizeof(double) - 1) & ~(sizeof(double) - 1);
+        if (UNLIKELY((size_t)(m_interpreterFrameStackEnd - m_interpreterFrameStackTop) < size)) {
+            return allocateInterpreterFrameSlowCase(size);
+        }
+        void* frame = m_interpreterFrameStackTop;
+        m_interpreterFrameStackTop += size;
+        return frame;
+    }
+
+    // frees the frame and every frame above it.
+    // GC scans the stack only up to the top, so popped frames are left as they are
+    void freeInterpreterFrame(void* frame)
+    {
+        m_interpreterFrameStackTop = (char*)frame;
+    }
+
+    RegExpCache* regexpCache()
+    {
+        return &m_regexpCache;
+    }
+
 protected:
     StaticStrings m_staticStrings;
     AtomicStringMap m_atomicStringMap;
@@ -211,6 +302,7 @@ protected:
 
     // this flag should affect VM-wide array object
     bool m_didSomePrototypeObjectDefineIndexedProperty;
+    size_t m_prototypeEpoch;
 
     ObjectStructure* m_defaultStructureForObject;
     ObjectStructure* m_defaultStructureForFunctionObject;
@@ -231,12 +323,27 @@ protected:
     Vector<String*, GCUtil::gc_malloc_ignore_off_page_allocator<String*>> m_parsedSourceCodes;
     Vector<CodeBlock*, GCUtil::gc_malloc_ignore_off_page_allocator<CodeBlock*>> m_compiledCodeBlocks;
     size_t m_compiledByteCodeSize;
+    // advanced whenever a ByteCodeBlock is generated
+    size_t m_byteCodeBlockEpoch;
+    size_t m_byteCodeSizeBudget;
+    size_t m_byteCodeBlockEvictionCount;
+    size_t m_byteCodeBlockRegenerationCount;
+
+    GetObjectMegamorphicCacheEntry* m_megamorphicPropertyCache;
+    size_t m_megamorphicPropertyCacheHitCount;
+    size_t m_megamorphicPropertyCacheMissCount;
+
+    void* allocateInterpreterFrameSlowCase(size_t size);
+    char* m_interpreterFrameStack;
+    char* m_interpreterFrameStackTop;
+    char* m_interpreterFrameStackEnd;
+    // reset by every other allocation and free, so the top is always the frame freed last when it is set
 
     ToStringRecursionPreventer m_toStringRecursionPreventer;
 
     // regexp object data
     WTF::BumpPointerAllocator* m_bumpPointerAllocator;
-    RegExpCacheMap m_regexpCache;
+    RegExpCache m_regexpCache;
 
 // date object data
 #ifdef ENABLE_ICU
@@ -61,54 +61,36 @@ void* WeakMapObject::operator new(size_t size)
 
 bool WeakMapObject::deleteOperation(ExecutionState& state, Object* key)
 {
-    for (size_t i = 0; i < m_storage.size(); i++) {
-        auto existingKey = m_storage[i]->key;
-        if (existingKey == key) {
-            m_storage[i]->key = nullptr;
-            m_storage[i]->data = SmallValue(nullptr);
-            return true;
-        }
-    }
-    return false;
+    return m_storage.remove(state, key);
 }
 
 Value WeakMapObject::get(ExecutionState& state, Object* key)
 {
-    for (size_t i = 0; i < m_storage.size(); i++) {
-        auto existingKey = m_storage[i]->key;
-        if (existingKey == key) {
-            return m_storage[i]->data;
-        }
+    WeakMapObjectDataItem** e = m_storage.find(state, key);
+    if (e) {
+        return (*e)->data;
     }
     return Value();
 }
 
 bool WeakMapObject::has(ExecutionState& state, Object* key)
 {
-    for (size_t i = 0; i < m_storage.size(); i++) {
-        auto existingKey = m_storage[i]->key;
-        if (existingKey == key) {
-            return true;
-        }
-    }
-    return false;
+    return m_storage.find(state, key) != nullptr;
 }
 
 
 void WeakMapObject::set(ExecutionState& state, Object* key, const Value& value)
 {
-    for (size_t i = 0; i < m_storage.size(); i++) {
-        auto existingKey = m_storage[i]->key;
-        if (existingKey == key) {
-            m_storage[i]->data = value;
-            return;
-        }
+    WeakMapObjectDataItem** e = m_storage.find(state, key);
+    if (e) {
+        (*e)->data = value;
+        return;
     }
 
     auto newData = new WeakMapObjectDataItem();
     newData->key = key;
     newData->data = value;
     GC_GENERAL_REGISTER_DISAPPEARING_LINK((void**)&(newData->key), newData->key);
-    m_storage.pushBack(newData);
+    m_storage.add(key) = newData;
 }
 }
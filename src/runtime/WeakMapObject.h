@@ -21,6 +21,7 @@
 #define __EscargotWeakMapObject__
 
 #include "runtime/Object.h"
+#include "runtime/OrderedHashTable.h"
 
 namespace Escargot {
 
@@ -33,7 +34,30 @@ public:
         void* operator new(size_t size);
         void* operator new[](size_t size) = delete;
     };
-    typedef TightVector<WeakMapObjectDataItem*, GCUtil::gc_malloc_ignore_off_page_allocator<WeakMapObjectDataItem*>> WeakMapObjectData;
+    // The key of an item is a disappearing link; an item whose key was collected counts as empty.
+    struct WeakMapObjectDataTraits {
+        static bool isEmpty(WeakMapObjectDataItem* const& e)
+        {
+            return !e || !e->key;
+        }
+        static void makeEmpty(WeakMapObjectDataItem*& e)
+        {
+            e = nullptr;
+        }
+        static size_t hash(Object* const& key)
+        {
+            return hashPointerForOrderedHashTable(key);
+        }
+        static size_t hashEntry(WeakMapObjectDataItem* const& e)
+        {
+            return hashPointerForOrderedHashTable(e->key);
+        }
+        static bool matches(ExecutionState& state, WeakMapObjectDataItem* const& e, Object* const& key)
+        {
+            return e->key == key;
+        }
+    };
+    typedef OrderedHashTable<WeakMapObjectDataItem*, Object*, WeakMapObjectDataTraits> WeakMapObjectData;
     WeakMapObject(ExecutionState& state);
 
     virtual bool isWeakMapObject() const
@@ -48,45 +48,23 @@ void* WeakSetObject::operator new(size_t size)
 
 bool WeakSetObject::deleteOperation(ExecutionState& state, Object* key)
 {
-    for (size_t i = 0; i < m_storage.size(); i++) {
-        if (m_storage[i]) {
-            Object* existingKey = m_storage[i]->key;
-            if (existingKey == key) {
-                m_storage[i] = nullptr;
-                return true;
-            }
-        }
-    }
-    return false;
+    return m_storage.remove(state, key);
 }
 
 void WeakSetObject::add(ExecutionState& state, Object* key)
 {
-    for (size_t i = 0; i < m_storage.size(); i++) {
-        if (m_storage[i]) {
-            Object* existingKey = m_storage[i]->key;
-            if (existingKey == key) {
-                return;
-            }
-        }
+    if (m_storage.find(state, key)) {
+        return;
     }
 
     auto newData = new WeakSetObjectDataItem();
     newData->key = key;
     GC_GENERAL_REGISTER_DISAPPEARING_LINK((void**)&(newData->key), newData->key);
-    m_storage.pushBack(newData);
+    m_storage.add(key) = newData;
 }
 
 bool WeakSetObject::has(ExecutionState& state, Object* key)
 {
-    for (size_t i = 0; i < m_storage.size(); i++) {
-        if (m_storage[i]) {
-            Object* existingKey = m_storage[i]->key;
-            if (existingKey == key) {
-                return true;
-            }
-        }
-    }
-    return false;
+    return m_storage.find(state, key) != nullptr;
 }
 }
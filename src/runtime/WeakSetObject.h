@@ -21,6 +21,7 @@
 #define __EscargotWeakSetObject__
 
 #include "runtime/Object.h"
+#include "runtime/OrderedHashTable.h"
 
 namespace Escargot {
 
@@ -35,7 +36,30 @@ public:
         void* operator new[](size_t size) = delete;
     };
 
-    typedef TightVector<WeakSetObjectDataItem*, GCUtil::gc_malloc_ignore_off_page_allocator<WeakSetObjectDataItem*>> WeakSetObjectData;
+    // The key of an item is a disappearing link; an item whose key was collected counts as empty.
+    struct WeakSetObjectDataTraits {
+        static bool isEmpty(WeakSetObjectDataItem* const& e)
+        {
+            return !e || !e->key;
+        }
+        static void makeEmpty(WeakSetObjectDataItem*& e)
+        {
+            e = nullptr;
+        }
+        static size_t hash(Object* const& key)
+        {
+            return hashPointerForOrderedHashTable(key);
+        }
+        static size_t hashEntry(WeakSetObjectDataItem* const& e)
+        {
+            return hashPointerForOrderedHashTable(e->key);
+        }
+        static bool matches(ExecutionState& state, WeakSetObjectDataItem* const& e, Object* const& key)
+        {
+            return e->key == key;
+        }
+    };
+    typedef OrderedHashTable<WeakSetObjectDataItem*, Object*, WeakSetObjectDataTraits> WeakSetObjectData;
     WeakSetObject(ExecutionState& state);
 
     virtual bool isWeakSetObject() const
@@ -22,6 +22,7 @@
 #include "runtime/ExecutionContext.h"
 #include "util/Vector.h"
 #include "runtime/Value.h"
+#include "runtime/ExternalString.h"
 #include "parser/ScriptParser.h"
 #ifdef ESCARGOT_ENABLE_PROMISE
 #include "runtime/JobQueue.h"
@@ -73,6 +74,20 @@ NEVER_INLINE bool eval(Escargot::Context* context, Escargot::String* str, Escarg
     return true;
 }
 
+// parses a script without running it. used to measure the parser alone
+NEVER_INLINE bool parse(Escargot::Context* context, Escargot::String* str, Escargot::String* fileName)
+{
+    auto result = context->scriptParser().parse(str, fileName);
+    if (result.m_error) {
+        puts(result.m_error->message->toUTF8StringData().data());
+        return false;
+    }
+    // release the AST as executing the script does
+    result.m_script->topCodeBlock()->cachedASTNode()->deref();
+    result.m_script->topCodeBlock()->clearCachedASTNode();
+    return true;
+}
+
 int main(int argc, char* argv[])
 {
 #ifndef NDEBUG
@@ -91,8 +106,7 @@ int main(int argc, char* argv[])
 #endif
 
     bool runShell = true;
-
-    Escargot::FunctionObject* fnRead = context->globalObject()->getOwnProperty(stateForInit, Escargot::ObjectPropertyName(stateForInit, Escargot::String::fromUTF8("read", 4))).value(stateForInit, context->globalObject()).asFunction();
+    bool parseOnly = false;
 
     for (int i = 1; i < argc; i++) {
         if (strlen(argv[i]) >= 2 && argv[i][0] == '-') { // parse command line option
@@ -101,6 +115,10 @@ int main(int argc, char* argv[])
                     runShell = true;
                     continue;
                 }
+                if (strcmp(argv[i], "--parse-only") == 0) {
+                    parseOnly = true;
+                    continue;
+                }
             } else { // `-option` case
                 if (strcmp(argv[i], "-e") == 0) {
                     runShell = false;
@@ -120,12 +138,14 @@ int main(int argc, char* argv[])
             continue;
         }
 
-        FILE* fp = fopen(argv[i], "r");
-        if (fp) {
+        Escargot::String* src = Escargot::ExternalString::createFromFile(argv[i]);
+        if (src) {
             runShell = false;
-            Escargot::Value arg(Escargot::String::fromUTF8(argv[i], strlen(argv[i])));
-            Escargot::String* src = Escargot::FunctionObject::call(stateForInit, fnRead, Escargot::Value(), 1, &arg).asString();
-
+            if (parseOnly) {
+                if (!parse(context, src, Escargot::String::fromUTF8(argv[i], strlen(argv[i]))))
+                    return 3;
+                continue;
+            }
             if (!eval(context, src, Escargot::String::fromUTF8(argv[i], strlen(argv[i])), false))
                 return 3;
         } else {
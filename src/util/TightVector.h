@@ -404,6 +404,135 @@ public:
 protected:
     T* m_buffer;
 };
+
+// Vector without size like TightVectorWithNoSize, but it grows geometrically.
+// capacity is not stored in the vector. it is the size of the gc block of the buffer,
+// so it can be used only with gc allocators which clear new memory.
+template <typename T, typename Allocator>
+class TightVectorWithNoSizeUseGCCapacity : public gc {
+public:
+    TightVectorWithNoSizeUseGCCapacity()
+    {
+        m_buffer = nullptr;
+#ifdef GC_DEBUG
+        m_capacity = 0;
+#endif
+    }
+
+    TightVectorWithNoSizeUseGCCapacity(const TightVectorWithNoSizeUseGCCapacity<T, Allocator>& other) = delete;
+
+    const TightVectorWithNoSizeUseGCCapacity<T, Allocator>& operator=(const TightVectorWithNoSizeUseGCCapacity<T, Allocator>& other) = delete;
+
+    ~TightVectorWithNoSizeUseGCCapacity()
+    {
+        if (m_buffer) {
+            Allocator().deallocate(m_buffer);
+        }
+    }
+
+    size_t capacity() const
+    {
+#ifdef GC_DEBUG
+        // the debugging allocator puts a header and a trailer into the gc block
+        return m_capacity;
+#else
+        if (m_buffer) {
+            return GC_size(m_buffer) / sizeof(T);
+        }
+        return 0;
+#endif
+    }
+
+    void pushBack(const T& val, size_t newSize)
+    {
+        if (UNLIKELY(newSize > capacity())) {
+            grow(newSize - 1, std::max(newSize, capacity() * 2));
+        }
+        m_buffer[newSize - 1] = val;
+    }
+
+    void push_back(const T& val, size_t newSize)
+    {
+        pushBack(val, newSize);
+    }
+
+    // allocates room for |newCapacity| items at once.
+    // callers which know how many items will be pushed use this to avoid growing the buffer step by step
+    void reserve(size_t currentSize, size_t newCapacity)
+    {
+        if (newCapacity > capacity()) {
+            grow(currentSize, newCapacity);
+        }
+    }
+
+    T& operator[](const size_t& idx)
+    {
+        return m_buffer[idx];
+    }
+
+    const T& operator[](const size_t& idx) const
+    {
+        return m_buffer[idx];
+    }
+
+    void resizeWithUninitializedValues(size_t oldSize, size_t newSize)
+    {
+        if (newSize <= capacity()) {
+            return;
+        }
+        grow(oldSize, newSize);
+    }
+
+    void erase(size_t pos, size_t currentSize)
+    {
+        erase(pos, pos + 1, currentSize);
+    }
+
+    // items are moved in place. the buffer keeps its capacity
+    void erase(size_t start, size_t end, size_t currentSize)
+    {
+        ASSERT(start < end);
+        ASSERT(end <= currentSize);
+
+        size_t c = end - start;
+        for (size_t i = end; i < currentSize; i++) {
+            m_buffer[i - c] = m_buffer[i];
+        }
+        // clear slots left behind, so they do not keep dead objects alive
+        for (size_t i = currentSize - c; i < currentSize; i++) {
+            m_buffer[i] = T();
+        }
+    }
+
+    T* data()
+    {
+        return m_buffer;
+    }
+
+protected:
+    void grow(size_t currentSize, size_t newCapacity)
+    {
+        T* newBuffer = Allocator().allocate(newCapacity);
+        if (std::is_fundamental<T>()) {
+            memcpy(newBuffer, m_buffer, sizeof(T) * currentSize);
+        } else {
+            for (size_t i = 0; i < currentSize; i++) {
+                newBuffer[i] = m_buffer[i];
+            }
+        }
+        if (m_buffer)
+            Allocator().deallocate(m_buffer);
+        m_buffer = newBuffer;
+#ifdef GC_DEBUG
+        m_capacity = newCapacity;
+#endif
+    }
+
+    T* m_buffer;
+#ifdef GC_DEBUG
+    size_t m_capacity;
+#endif
+};
 }
 
 #endif
@@ -16,10 +16,34 @@
 
 #include <EscargotPublic.h>
 #include <string.h>
+#include <string>
 
 #define CHECK(name, cond) \
     printf(name" | %s\n", (cond) ? "pass" : "fail");
 
+// runs |scriptRef| in a new sandbox and returns its result as a string, or the message of what it threw
+static std::string runScript(Escargot::ContextRef* ctx, Escargot::ExecutionStateRef* es, Escargot::ScriptRef* scriptRef)
+{
+    if (!scriptRef) {
+        return "SyntaxError";
+    }
+    Escargot::SandBoxRef* sb = Escargot::SandBoxRef::create(ctx);
+    auto sandBoxResult = sb->run([&](Escargot::ExecutionStateRef* state) -> Escargot::ValueRef* {
+        return scriptRef->execute(state);
+    });
+    sb->destroy();
+    if (!sandBoxResult.error->isEmpty()) {
+        return "throws " + sandBoxResult.msgStr->toStdUTF8String();
+    }
+    return sandBoxResult.result->toString(es)->toStdUTF8String();
+}
+
+static std::string evalScript(Escargot::ContextRef* ctx, Escargot::ExecutionStateRef* es, const char* script, const char* filename)
+{
+    Escargot::ScriptRef* scriptRef = ctx->scriptParser()->parse(Escargot::StringRef::fromASCII(script, strlen(script)), Escargot::StringRef::fromASCII(filename, strlen(filename))).m_script;
+    return runScript(ctx, es, scriptRef);
+}
+
 int main(int argc, char* argv[])
 {
 #ifndef NDEBUG
@@ -173,6 +197,858 @@ int main(int argc, char* argv[])
         sb->destroy();
     }
 
+    {
+        const char* script = "function getX(o) { return o.x; } var sum = 0; for (var i = 0; i < 400; i++) { var o = {}; o['p' + (i % 40)] = 1; o.x = 1; sum += getX(o); } sum";
+        CHECK("Megamorphic property cache result", evalScript(ctx, es, script, "Megamorphic.js") == "400");
+        CHECK("Megamorphic property cache hit", vm->megamorphicPropertyCacheHitCount() > 0);
+        CHECK("Megamorphic property cache miss", vm->megamorphicPropertyCacheMissCount() > 0);
+    }
+
+    {
+        const char* script = "function one() { return 1; } function two() { return 2; } var sum = 0; for (var i = 0; i < 10; i++) { sum += one() + two(); } sum";
+
+        size_t oldBudget = vm->byteCodeSizeBudget();
+        vm->setByteCodeSizeBudget(1);
+        std::string result = evalScript(ctx, es, script, "ByteCodeEviction.js");
+        vm->setByteCodeSizeBudget(oldBudget);
+
+        CHECK("ByteCode eviction result", result == "30");
+        CHECK("ByteCode eviction count", vm->byteCodeBlockEvictionCount() > 0);
+        CHECK("ByteCode regeneration count", vm->byteCodeBlockRegenerationCount() > 0);
+    }
+
+    {
+        // the callee of a call site is evicted and generated again, maybe at the address of its collected ByteCodeBlock
+        const char* script = "function lit(x) { return x * 1.5 + 2.25; }"
+                             "function other(x) { var a = 3.5, b = 4.75; return x + a + b; }"
+                             "function site(f, x) { return f(x); }"
+                             "var s = 0;"
+                             "for (var i = 0; i < 200; i++) { s += site(lit, i) + site(other, i); if (i % 20 == 0) { gc(); } }"
+                             "s;";
+
+        size_t oldBudget = vm->byteCodeSizeBudget();
+        vm->setByteCodeSizeBudget(1);
+        CHECK("Call site across ByteCode eviction", evalScript(ctx, es, script, "EvictedCallSite.js") == "51850");
+        vm->setByteCodeSizeBudget(oldBudget);
+    }
+
+    {
+        const char* script = "var n = 0; for (var i = 0; i < 10; i++) { if (new RegExp('a' + 'b+', 'i').test('xABBy')) n++; if (new RegExp('c' + (i % 4)).test('c1')) n++; } n";
+
+        size_t oldBudget = vm->regExpCacheBudget();
+        size_t oldHitCount = vm->regExpCacheHitCount();
+        size_t oldEvictionCount = vm->regExpCacheEvictionCount();
+        vm->setRegExpCacheBudget(2);
+        std::string result = evalScript(ctx, es, script, "RegExpCache.js");
+        vm->setRegExpCacheBudget(oldBudget);
+
+        CHECK("RegExp cache result", result == "13");
+        CHECK("RegExp cache hit by content", vm->regExpCacheHitCount() > oldHitCount);
+        CHECK("RegExp cache eviction", vm->regExpCacheEvictionCount() > oldEvictionCount);
+    }
+
+    {
+        const char* script = "function add(a, b) { return a + b; } var o = { name: 'cache' }; var s = 0; for (var i = 0; i < 10; i++) { s = add(s, i); } o.name + s";
+        const char* otherScript = "'other source'";
+        const char* filename = "CodeCache.js";
+        Escargot::StringRef* source = Escargot::StringRef::fromASCII(script, strlen(script));
+        Escargot::StringRef* fileNameRef = Escargot::StringRef::fromASCII(filename, strlen(filename));
+
+        std::vector<uint8_t> cache;
+        CHECK("Code cache produce", ctx->scriptParser()->produceCodeCache(source, fileNameRef, cache) && cache.size() > 0);
+
+        bool cacheRejected = true;
+        Escargot::ScriptRef* scriptRef = ctx->scriptParser()->parseWithCodeCache(source, fileNameRef, cache.data(), cache.size(), &cacheRejected).m_script;
+        CHECK("Code cache accepted", scriptRef && !cacheRejected);
+        CHECK("Code cache result", runScript(ctx, es, scriptRef) == "cache45");
+
+        Escargot::StringRef* otherSource = Escargot::StringRef::fromASCII(otherScript, strlen(otherScript));
+        scriptRef = ctx->scriptParser()->parseWithCodeCache(otherSource, fileNameRef, cache.data(), cache.size(), &cacheRejected).m_script;
+        CHECK("Code cache rejected for other source", scriptRef && cacheRejected);
+
+        // a cache file damaged anywhere is rejected, and the script is parsed from its source
+        FILE* file = tmpfile();
+        std::vector<uint8_t> corrupted(cache.size());
+        bool fileRead = file && fwrite(cache.data(), 1, cache.size(), file) == cache.size() && fseek(file, 0, SEEK_SET) == 0
+            && fread(corrupted.data(), 1, corrupted.size(), file) == corrupted.size();
+        if (file) {
+            fclose(file);
+        }
+        bool allRejected = fileRead;
+        for (size_t i = 0; fileRead && i < corrupted.size(); i += 3) {
+            corrupted[i] ^= 0x41;
+            scriptRef = ctx->scriptParser()->parseWithCodeCache(source, fileNameRef, corrupted.data(), corrupted.size(), &cacheRejected).m_script;
+            allRejected = allRejected && scriptRef && cacheRejected;
+            corrupted[i] ^= 0x41;
+        }
+        CHECK("Code cache rejected when corrupted", allRejected);
+
+        cache.resize(cache.size() / 2);
+        scriptRef = ctx->scriptParser()->parseWithCodeCache(source, fileNameRef, cache.data(), cache.size(), &cacheRejected).m_script;
+        CHECK("Code cache rejected when truncated", scriptRef && cacheRejected);
+    }
+
+    {
+        static const char script[] = "function f(x) { return 'ext' + x; } f(7)";
+        Escargot::StringRef* source = Escargot::StringRef::fromExternalUTF8(script, strlen(script));
+        CHECK("External string length", source->length() == strlen(script));
+
+        const char* filename = "External.js";
+        Escargot::ScriptRef* scriptRef = ctx->scriptParser()->parse(source, Escargot::StringRef::fromASCII(filename, strlen(filename))).m_script;
+        CHECK("External string parse", runScript(ctx, es, scriptRef) == "ext7");
+
+        static const char nonASCII[] = "caf\xc3\xa9";
+        CHECK("External string non-ASCII", Escargot::StringRef::fromExternalUTF8(nonASCII, strlen(nonASCII))->length() == 4);
+
+        CHECK("External file missing", !Escargot::StringRef::fromFile("/nonexistent/escargot/file.js"));
+    }
+
+    {
+        // keys die while the tables grow and shrink, so rehashing meets entries emptied by collections
+        const char* script = "var wm = new WeakMap(); var ws = new WeakSet(); var live = []; var n = 0;"
+                             "for (var i = 0; i < 2000; i++) { var k = {}; wm.set(k, i); ws.add(k); if (i % 7 == 0) live.push(k);"
+                             "  if (i % 100 == 0) gc(); if (i % 3 == 0) { var t = {}; wm.set(t, 0); ws.add(t); wm.delete(t); ws.delete(t); } }"
+                             "gc(); for (var j = 0; j < live.length; j++) { if (wm.get(live[j]) === j * 7 && ws.has(live[j])) n++; } n == live.length";
+        CHECK("WeakMap and WeakSet rehash with collected keys", evalScript(ctx, es, script, "WeakRehash.js") == "true");
+    }
+
+    {
+        // results of a function compiled after ESCARGOT_JIT_HOT_COUNT calls are compared with its first, interpreted runs.
+        // the inputs leave int32 fast paths of compiled code for helpers, and loops overflow int32 after they are compiled
+        const char* script = "function f(a, b) { return [a + b, a - b, a * b, 1 / (a * b), a / b, a % b, a < b, a <= b, a > b, a >= b, a == b, a === b, a & b, a | b, a ^ b, a << 3, a >> 1, a >>> 28, -a, ~a, !a].join(); }"
+                             "var inputs = [[1, 2], [2147483647, 1], [-2147483648, -1], [0, -5], [-1, 0], [1.5, 2], [\"a\", 3], [\"2\", \"10\"], [null, undefined], [{ valueOf: function() { return 4; } }, 2], [1e300, 1e10], [NaN, 0]];"
+                             "function run() { var r = []; for (var j = 0; j < inputs.length; j++) r.push(f(inputs[j][0], inputs[j][1])); return r.join(\"|\"); }"
+                             "var cold = run();"
+                             "for (var i = 0; i < 3000; i++) f(i, i + 1);"
+                             "var hot = run();"
+                             "function inc(n) { var s = 2147481647; for (var i = 0; i < n; i++) s++; return s; }"
+                             "function dec(n) { var s = -2147481648; for (var i = 0; i < n; i++) s = s - 1; return s; }"
+                             "cold === hot && inc(3000) === 2147484647 && dec(3000) === -2147484648";
+        CHECK("JIT arithmetic matches the interpreter", evalScript(ctx, es, script, "JITArithmetic.js") == "true");
+    }
+
+    {
+        // property, global, array and closure access of compiled code on objects of other structures than the ones it was compiled with
+        const char* script = "var total = 0;"
+                             "function P(x) { this.x = x; this.y = x * 2; }"
+                             "function make(kind, i) {"
+                             "    if (kind == 0) return new P(i);"
+                             "    if (kind == 1) return { y: 1, x: i };"
+                             "    if (kind == 2) return Object.create({ x: i, y: 5 });"
+                             "    if (kind == 3) return { get x() { return i + 0.5; }, y: \"s\" };"
+                             "    return Object.freeze({ x: i, y: 3 });"
+                             "}"
+                             "function h(o, arr, k) {"
+                             "    total = total + o.x;"
+                             "    o.y = o.y + 1;"
+                             "    arr[k] = o.x;"
+                             "    var c = { a: o.x, b: [o.y, arr.length] };"
+                             "    return [arr[k], o.y, arr.length, c.a, c.b[1], arr[k + 1]].join();"
+                             "}"
+                             "function counter() { var n = 0; return function() { n = n + 1; return n; }; }"
+                             "function run() {"
+                             "    var r = [];"
+                             "    total = 0;"
+                             "    for (var j = 0; j < 10; j++) {"
+                             "        var arr = j & 1 ? [1, , 3] : [];"
+                             "        r.push(h(make(j % 5, j), arr, j % 4));"
+                             "    }"
+                             "    var c = counter();"
+                             "    for (var j = 0; j < 5; j++) c();"
+                             "    r.push(total, c());"
+                             "    return r.join(\"|\");"
+                             "}"
+                             "var cold = run();"
+                             "for (var i = 0; i < 3000; i++) h(new P(i), [], i & 1);"
+                             "var hot = run();"
+                             "for (var i = 0; i < 3000; i++) run();"
+                             "cold === hot && run() === cold";
+        CHECK("JIT property access matches the interpreter", evalScript(ctx, es, script, "JITProperties.js") == "true");
+    }
+
+    {
+        // exceptions raised in helpers and callees of compiled code, caught in and out of compiled frames
+        const char* script = "function get(o) { return o.x.y; }"
+                             "function loop(n, bad) { var s = 0; for (var i = 0; i < n; i++) s += get(i == bad ? {} : { x: { y: 1 } }); return s; }"
+                             "function add(a, b) { return a + b; }"
+                             "function callee(i) { if (i % 500 == 499) throw new RangeError(\"r\" + i); return i; }"
+                             "function catchInLoop(n) { var c = 0; for (var i = 0; i < n; i++) { try { c += callee(i); } catch (e) { c -= 1; } } return c; }"
+                             "function catchOwn(n) { var c = 0; for (var i = 0; i < n; i++) { try { if (i % 100 == 0) null.x; } catch (e) { c++; } } return c; }"
+                             "var r = [];"
+                             "r.push(loop(3000, -1));"
+                             "try { loop(3000, 2000); } catch (e) { r.push(e instanceof TypeError); }"
+                             "r.push(loop(10, -1));"
+                             "for (var i = 0; i < 3000; i++) add(i, 1);"
+                             "try { add({ valueOf: function() { throw \"v\"; } }, 1); } catch (e) { r.push(e); }"
+                             "r.push(add(1, 2));"
+                             "r.push(catchInLoop(5000), catchOwn(5000));"
+                             "function thrower(n) { for (var i = 0; i < n; i++) { if (i == n - 1) throw new Error(\"at \" + i); } }"
+                             "for (var i = 0; i < 20; i++) { try { thrower(200); } catch (e) { r.push(e.message); } }"
+                             "r.length + \":\" + r.slice(0, 8).join()";
+        CHECK("JIT exceptions", evalScript(ctx, es, script, "JITExceptions.js") == "27:3000,true,10,v,3,12470000,50,at 199");
+    }
+
+    {
+        // doubles outside of small integers stored in properties, elements, heap variables and globals,
+        // read back after a collection
+        const char* script = "var vals = [0.5, -0, 0 / 0, 4.0, 1e308, 5e-324, -Infinity, Infinity, -2147483649.5, 9007199254740992, -1.7976931348623157e308, 1.1, 2147483648, -1073741825, 1073741823, -1073741824, 1073741824];"
+                             "function same(a, b) { return a !== a ? b !== b : a === b && 1 / a === 1 / b; }"
+                             "function holder(v) { var h = v; return function() { return h; }; }"
+                             "var o = {}, arr = [], fns = [];"
+                             "for (var i = 0; i < vals.length; i++) { o[\"p\" + i] = vals[i]; arr.push(vals[i]); fns.push(holder(vals[i])); this[\"g\" + i] = vals[i]; }"
+                             "var x = 0.5, ox = { x: 0.5 };"
+                             "for (var i = 0; i < 200; i++) { x = x * 1.5 - 0.25; ox.x = ox.x * 1.5 - 0.25; }"
+                             "gc();"
+                             "var ok = same(x, ox.x);"
+                             "for (var i = 0; i < vals.length; i++) { ok = ok && same(o[\"p\" + i], vals[i]) && same(arr[i], vals[i]) && same(fns[i](), vals[i]) && same(this[\"g\" + i], vals[i]); }"
+                             "ok && typeof o.p3 === \"number\" && o.p3 === 4";
+        CHECK("Doubles stored in SmallValue", evalScript(ctx, es, script, "SmallValueDouble.js") == "true");
+    }
+
+    {
+        // searches, join, sort and fill on int32, double and generic arrays, packed and holey, as their kinds widen
+        const char* script = "var r = [];"
+                             "var a = [1, 2, 3];"
+                             "r.push(a.indexOf(2), a.indexOf(2.5), a.indexOf(\"2\"), a.includes(3), a.lastIndexOf(1));"
+                             "a.push(2.5);"
+                             "r.push(a.indexOf(2.5), a.indexOf(3), a.join(\"-\"));"
+                             "a.push(\"x\");"
+                             "r.push(a.indexOf(\"x\"), a.indexOf(3), a.includes(\"2\"), a.join());"
+                             "var d = [0.5, -0, NaN];"
+                             "r.push(d.indexOf(0), d.indexOf(NaN), d.includes(NaN), d.includes(0), d.lastIndexOf(-0));"
+                             "var h = [1, , 3];"
+                             "r.push(h.indexOf(undefined), h.includes(undefined), h.join(), h.length);"
+                             "var s = [10, 9, 1, 100, -5, 2147483647, -2147483648];"
+                             "r.push(s.slice().sort().join(), s.join());"
+                             "var big = [3, 1];"
+                             "big[10] = 2;"
+                             "r.push(big.sort().join(), big.length, 5 in big);"
+                             "var f = new Array(5).fill(7);"
+                             "r.push(f.join(), f.indexOf(7));"
+                             "f.fill(0.5, 1, 3);"
+                             "r.push(f.join(), f.indexOf(0.5));"
+                             "f.fill(\"s\", -1);"
+                             "r.push(f.join(), f.indexOf(\"s\"), f.indexOf(7));"
+                             "var t = [1, 2];"
+                             "t[1] = 1.5;"
+                             "t[0] = {};"
+                             "r.push(t.indexOf(1.5), t.join());"
+                             "r.join(\"|\")";
+        CHECK("Array element kinds", evalScript(ctx, es, script, "ArrayElementKinds.js") == "1|-1|-1|true|0|3|2|1-2-3-2.5|4|2|false|1,2,3,2.5,x|1|-1|true|true|1|-1|true|1,,3|3|-2147483648,-5,1,10,100,2147483647,9|10,9,1,100,-5,2147483647,-2147483648|1,2,3,,,,,,,,|11|false|7,7,7,7,7|0|7,0.5,0.5,7,7|1|7,0.5,0.5,7,s|4|0|1|[object Object],1.5");
+    }
+
+    {
+        // Array builtins on frozen, non-extensible and non-writable length arrays, arrays changed by their callbacks,
+        // holey and sparse arrays
+        const char* script = "var r = [];"
+                             "function t(f) { try { return f(); } catch (e) { return e.name; } }"
+                             "var fz = Object.freeze([1, 2, 3]);"
+                             "r.push(t(function() { return fz.push(4); }), t(function() { return fz.shift(); }), t(function() { return fz.unshift(0); }), t(function() { return fz.splice(0, 1); }), t(function() { return fz.fill(0); }), fz.join(), fz.slice(1).join(), fz.concat([4]).join());"
+                             "var ne = Object.preventExtensions([1, 2, 3]);"
+                             "r.push(t(function() { return ne.push(4); }), ne.length, ne.shift(), ne.join(), t(function() { return ne.unshift(9); }), ne.join(), ne.map(function(v) { return v + 1; }).join());"
+                             "var nw = [1, 2];"
+                             "Object.defineProperty(nw, \"length\", { writable: false });"
+                             "r.push(t(function() { return nw.push(3); }), nw.join(), nw.length, nw.slice(0).length);"
+                             "var m = [1, 2, 3, 4];"
+                             "var mr = m.map(function(v, i, arr) { if (i == 0) arr.length = 2; return v * 2; });"
+                             "r.push(mr.join(), mr.length, 3 in mr, m.length);"
+                             "var fe = [1, 2, 3], seen = [];"
+                             "fe.forEach(function(v, i, arr) { if (i == 0) { arr.push(99); arr[2] = 30; } seen.push(v); });"
+                             "r.push(seen.join(), fe.join());"
+                             "var fl = [1, 2, 3, 4, 5];"
+                             "r.push(fl.filter(function(v, i, arr) { if (i == 1) arr.splice(0, 2); return v & 1; }).join(), fl.join());"
+                             "var k = [1, 2, 3];"
+                             "r.push(k.map(function(v, i, arr) { if (i == 0) { arr[1] = \"s\"; arr[100000] = 1; } return v; }).join(), k.length);"
+                             "var kt = [1, 2];"
+                             "kt.push(1.5);"
+                             "kt.unshift(\"a\");"
+                             "r.push(kt.indexOf(1.5), kt.slice(1).indexOf(2), kt.concat([true], 3.5).join());"
+                             "var cc = [1, , 3].concat([4, , 6]);"
+                             "r.push(cc.length, 1 in cc, 4 in cc, cc.join());"
+                             "var sp = [1, 2, 3, 4, 5];"
+                             "r.push(sp.splice(1, 2, \"a\", \"b\", \"c\").join(), sp.join(), sp.splice(-2).join(), sp.join());"
+                             "var sl2 = [1, , 3].slice(0);"
+                             "r.push(1 in sl2, sl2.length);"
+                             "var sh = [, 1, , 2];"
+                             "r.push(sh.shift(), sh.length, 1 in sh, sh.join());"
+                             "var us = [1, , 3];"
+                             "us.unshift(0);"
+                             "r.push(us.length, 2 in us, us.join());"
+                             "var sparse = [];"
+                             "sparse[1000000] = 1;"
+                             "var cnt = 0;"
+                             "sparse.forEach(function() { cnt++; });"
+                             "r.push(sparse.indexOf(1), sparse.map(function(x) { return x + 1; })[1000000], sparse.filter(function() { return true; }).length, cnt, sparse.push(2), sparse.slice(999999).join());"
+                             "r.join(\"|\")";
+        CHECK("Array builtins on fast mode arrays", evalScript(ctx, es, script, "ArrayFastPaths.js") == "TypeError|TypeError|TypeError|TypeError|TypeError|1,2,3|2,3|1,2,3,4|TypeError|3|1|2,3|TypeError|2,3|3,4|TypeError|1,2|2|2|2,4,,|4|false|2|1,2,30|1,2,30,99|1,5|3,4,5|1,s,3|100001|3|1|a,1,2,1.5,true,3.5|6|false|false|1,,3,4,,6|2,3|1,a,b,c,4,5|4,5|1,a,b,c|false|3||3|false|1,,2|4|false|0,1,,3|1000000|2|1|1|1000002|,1,2");
+    }
+
+    {
+        // an indexed property of a prototype takes every array of its VMInstance out of fast mode, so this runs in a new one.
+        // elements of the prototypes show through holes
+        Escargot::VMInstanceRef* protoVM = Escargot::VMInstanceRef::create();
+        Escargot::ContextRef* protoContext = Escargot::ContextRef::create(protoVM);
+        Escargot::ExecutionStateRef* protoState = Escargot::ExecutionStateRef::create(protoContext);
+        const char* script = "var before = [0, , 2, , 4];"
+                             "Array.prototype[1] = \"p\";"
+                             "Object.prototype[3] = \"q\";"
+                             "var a = [0, , 2, , 4];"
+                             "var cnt = 0;"
+                             "a.forEach(function() { cnt++; });"
+                             "var s = [, 1];"
+                             "var r = [before[1], a[1], a[3], a.indexOf(\"p\"), a.includes(\"q\"), a.lastIndexOf(\"q\"), a.join(), a.map(function(v) { return v; }).join(), a.filter(function() { return true; }).length, a.slice(0, 4).join(), [, , ].concat([]).join(), cnt, s.shift(), s.join(), s.length];"
+                             "var u = [, 5];"
+                             "u.unshift(1);"
+                             "r.push(u.join(), u.hasOwnProperty(1), [0, , 2].sort().join());"
+                             "r.join(\"|\")";
+        CHECK("Array builtins with prototype elements", evalScript(protoContext, protoState, script, "ArrayPrototypeElements.js") == "p|p|q|1|true|3|0,p,2,q,4|0,p,2,q,4|5|0,p,2,q|,p|5||1|1|1,p,5|false|0,2,p");
+        protoState->destroy();
+        protoContext->destroy();
+        protoVM->destroy();
+    }
+
+    {
+        // each pattern shape the RegExp JIT accepts runs on its inputs before and after ESCARGOT_REGEXP_JIT_HOT_COUNT executions,
+        // so results of the Yarr interpreter are compared with results of compiled code. global and sticky ones check lastIndex
+        const char* script = "function describe(re, input) {"
+                             "    re.lastIndex = 0;"
+                             "    var out = [];"
+                             "    for (var n = 0; n < 8; n++) {"
+                             "        var m = re.exec(input);"
+                             "        if (!m) break;"
+                             "        out.push(m.index + \":\" + m.join(\"/\") + \"@\" + re.lastIndex);"
+                             "        if (!re.global && !re.sticky) break;"
+                             "        if (m[0] === \"\") re.lastIndex++;"
+                             "    }"
+                             "    out.push(re.test(input), re.lastIndex);"
+                             "    return out.join(\",\");"
+                             "}"
+                             "var cases = ["
+                             "    [/^abc/, [\"abc\", \"abcd\", \"xabc\", \"ab\"]],"
+                             "    [/abc$/, [\"abc\", \"xabc\", \"abcx\", \"\"]],"
+                             "    [/^\\d+$/, [\"123\", \"12a\", \"\", \"0\"]],"
+                             "    [/^b/m, [\"a\\nb\", \"b\", \"ab\"]],"
+                             "    [/a$/m, [\"a\\nb\", \"ba\\n\", \"b\"]],"
+                             "    [/[a-z]+/, [\"ABCdef12\", \"123\", \"xyz\"]],"
+                             "    [/[^0-9]+/, [\"12ab34\", \"1234\", \"a\"]],"
+                             "    [/\\w+\\s*\\d{3}/, [\"abc 123\", \"abc12\", \"__  9999\"]],"
+                             "    [/[\\u00e0-\\u00ff]+/, [\"caf\\u00e9s\", \"cafe\"]],"
+                             "    [/[\\u3040-\\u30ff]+x/, [\"\\u3042\\u3044x\", \"\\u3042\"]],"
+                             "    [/[A-Z]+/i, [\"abcDEF\", \"123\"]],"
+                             "    [/abc/i, [\"xAbC\", \"ab\"]],"
+                             "    [/a{3}/, [\"aaaa\", \"aa\"]],"
+                             "    [/\\d{2,4}x/, [\"1x12x123456x\", \"12345x\"]],"
+                             "    [/a*b/, [\"aaab\", \"b\", \"aaa\"]],"
+                             "    [/x?y/, [\"xy\", \"y\", \"x\"]],"
+                             "    [/\\d+\\.\\d*/, [\"3.14\", \"10.\", \".5\"]],"
+                             "    [/(\\d+)-(\\d+)/, [\"tel 12-345\", \"12-\", \"1-2-3\"]],"
+                             "    [/^(\\w+)\\s(\\w+)$/, [\"hello world\", \"hello  world\"]],"
+                             "    [/\\d+/g, [\"a1b22c333\", \"none\", \"4\"]],"
+                             "    [/[a-c]/g, [\"abcabc\", \"xyz\"]],"
+                             "    [/\\d+/y, [\"12 34\", \"a12\", \"5\"]],"
+                             "    [/\\w/y, [\"ab c\", \" a\"]],"
+                             "    [/./g, [\"a\\ud83d\\ude00b\", \"\\ud83d\\ude00\"]],"
+                             "    [/[^a]/g, [\"a\\ud83d\\ude00a\\ud834\\udd1e\", \"aaa\"]],"
+                             "    [/\\ud83d/, [\"x\\ud83d\\ude00\", \"x\"]],"
+                             "    [/[\\ud800-\\udbff][\\udc00-\\udfff]/g, [\"\\ud83d\\ude00-\\ud834\\udd1e\", \"\\ud83d\"]],"
+                             "    [/\\s+$/, [\"tail \\u3000\", \"none\"]]"
+                             "];"
+                             "var ok = [];"
+                             "for (var c = 0; c < cases.length; c++) {"
+                             "    var re = cases[c][0], inputs = cases[c][1];"
+                             "    var cold = [];"
+                             "    for (var i = 0; i < inputs.length; i++) cold.push(describe(re, inputs[i]));"
+                             "    for (var k = 0; k < 150; k++) { for (var i = 0; i < inputs.length; i++) describe(re, inputs[i]); }"
+                             "    var hot = [];"
+                             "    for (var i = 0; i < inputs.length; i++) hot.push(describe(re, inputs[i]));"
+                             "    if (cold.join(\"|\") !== hot.join(\"|\")) ok.push(re.source);"
+                             "}"
+                             "ok.length ? \"mismatch \" + ok.join(\" \") : \"true\"";
+        CHECK("RegExp JIT matches the interpreter", evalScript(ctx, es, script, "RegExpJIT.js") == "true");
+    }
+
+    {
+        // throws handled in the same activation mixed with finally, with and native callers
+        const char* script = "function run() {"
+                             "var log = [];"
+                             "function f1() { try { try { throw 1; } finally { log.push('f'); } } catch (e) { log.push('c' + e); } }"
+                             "f1();"
+                             "function f2() { try { throw 1; } catch (e) { try { throw e + 1; } catch (e2) { log.push('n' + e2); } } }"
+                             "f2();"
+                             "function f3() { try { try { throw 'a'; } catch (e) { throw e + 'b'; } } catch (e) { log.push(e); } }"
+                             "f3();"
+                             "function f4() { try { throw 1; } finally { return 'r'; } }"
+                             "log.push(f4());"
+                             "function f5() { try { try { throw 1; } finally { throw 2; } } catch (e) { log.push('o' + e); } }"
+                             "f5();"
+                             "function f6() { try { [1, 2, 3].map(function (x) { if (x == 2) { throw 'm' + x; } return x; }); } catch (e) { log.push(e); } }"
+                             "f6();"
+                             "function f7() { var o = { get p() { try { throw 'g'; } catch (e) { throw e + 'x'; } } }; try { o.p; } catch (e) { log.push(e); } }"
+                             "f7();"
+                             "function f8() { var o = { v: 1 }; try { with (o) { throw v; } } catch (e) { log.push('w' + e); } }"
+                             "f8();"
+                             "function f9() { try { [1].forEach(function () { try { throw 'i'; } finally { log.push('if'); } }); } catch (e) { log.push(e); } finally { log.push('of'); } }"
+                             "f9();"
+                             "function f10() { for (var i = 0; i < 3; i++) { try { if (i == 1) { throw i; } log.push('l' + i); } catch (e) { log.push('k' + e); continue; } finally { log.push('z' + i); } } }"
+                             "f10();"
+                             "function f11() { try { null.x; } catch (e) { try { throw e instanceof TypeError; } catch (b) { log.push(b); } } }"
+                             "f11();"
+                             "function f12() { try { JSON.parse('{', function () {}); } catch (e) { try { throw e.name; } catch (n) { log.push(n); } } }"
+                             "f12();"
+                             "return log.join();"
+                             "}"
+                             "var first = run();"
+                             "var same = true;"
+                             "for (var k = 0; k < 1100; k++) { if (run() !== first) { same = false; } }"
+                             "first + ':' + same;";
+        CHECK("throw, catch and finally across nested try and native callers", evalScript(ctx, es, script, "ThrowCatchFinally.js") == "f,c1,n2,ab,r,o2,m2,gx,w1,if,i,of,l0,z0,k1,z1,l2,z2,true,SyntaxError:true");
+    }
+
+    {
+        // recursion fills the interpreter frame stack and then the native stack, directly and through a native callback
+        const char* script = "function r(n) { return r(n + 1) + 1; }"
+                             "function viaMap() { return [1].map(viaMap); }"
+                             "function sum(n) { return n == 0 ? 0 : n + sum(n - 1); }"
+                             "var out = [];"
+                             "for (var k = 0; k < 3; k++) {"
+                             "try { r(0); } catch (e) { out.push(e instanceof RangeError); }"
+                             "try { viaMap(); } catch (e) { out.push(e instanceof RangeError); }"
+                             "out.push(sum(1000));"
+                             "}"
+                             "out.join();";
+        CHECK("recursion past the interpreter frame stack throws RangeError", evalScript(ctx, es, script, "FrameStackOverflow.js") == "true,true,500500,true,true,500500,true,true,500500");
+    }
+
+    {
+        // exceptions unwind frames called without recursion, also when natives call back into the interpreter
+        const char* script = "var log = [];"
+                             "function d3(x) { if (x > 2) { throw new TypeError('t' + x); } return x; }"
+                             "function d2(x) { try { return d3(x + 1) + 1; } finally { log.push('f'); } }"
+                             "function d1(x) { return d2(x + 1) * 2; }"
+                             "function outer(x) { try { return d1(x); } catch (e) { return e.name + ':' + e.message; } }"
+                             "function cb(x) { return d1(x - 3); }"
+                             "function viaCallback() { try { return [1, 2, 3].map(cb).join('/'); } catch (e) { return 'map:' + e.message; } }"
+                             "var o = { get g() { return d1(this.v); }, v: 0 };"
+                             "function viaGetter(v) { o.v = v; try { return o.g; } catch (e) { return 'get:' + e.message; } }"
+                             "var n = { valueOf: function () { return d1(5); } };"
+                             "function viaValueOf() { try { return n + 1; } catch (e) { return 'valueOf:' + e.message; } }"
+                             "function viaSort() { try { return [3, 1, 2].sort(function (a, b) { return d1(3); }).join(''); } catch (e) { return 'sort:' + e.message; } }"
+                             "function run() {"
+                             "log = [];"
+                             "var r = [outer(1), outer(-1), viaCallback(), viaGetter(-1), viaGetter(4), viaValueOf(), viaSort()];"
+                             "return r.join() + '|' + log.length;"
+                             "}"
+                             "var first = run();"
+                             "var same = true;"
+                             "for (var k = 0; k < 1100; k++) { if (run() !== first) { same = false; } }"
+                             "first + ':' + same;";
+        CHECK("exceptions across frames called without recursion and native callers", evalScript(ctx, es, script, "InlineFrameExceptions.js") == "TypeError:t3,4,2/4/6,4,get:t6,valueOf:t7,sort:t5|9:true");
+    }
+
+    {
+        // every frame a throw unwinds is in the stack trace, also frames called without recursion and callers of a native
+        const char* script = "function a() { throw new Error('deep'); }\n"
+                             "function b() { return a() + 1; }\n"
+                             "function c() { return [1].map(b)[0] + 1; }\n"
+                             "function d() { return c() + 1; }\n"
+                             "d();\n";
+        const char* filename = "StackTrace.js";
+
+        Escargot::ScriptRef* scriptRef = ctx->scriptParser()->parse(Escargot::StringRef::fromASCII(script, strlen(script)), Escargot::StringRef::fromASCII(filename, strlen(filename))).m_script;
+        Escargot::SandBoxRef* sb = Escargot::SandBoxRef::create(ctx);
+        auto sandBoxResult = sb->run([&](Escargot::ExecutionStateRef* state) -> Escargot::ValueRef* {
+            return scriptRef->execute(state);
+        });
+        sb->destroy();
+
+        std::string lines;
+        bool fileNameMatches = true;
+        for (size_t i = 0; i < sandBoxResult.stackTraceData.size(); i++) {
+            lines += std::to_string(sandBoxResult.stackTraceData[i].loc.line) + ",";
+            fileNameMatches = fileNameMatches && sandBoxResult.stackTraceData[i].fileName->toStdUTF8String() == filename;
+        }
+        CHECK("Stack trace error", sandBoxResult.msgStr->toStdUTF8String() == "Error: deep");
+        CHECK("Stack trace across frames", lines == "1,2,3,4,5," && fileNameMatches);
+    }
+
+    {
+        // arguments.length and arguments[key] are read without the object until arguments escapes.
+        // mapped and unmapped parameters, keys which are no index, and uses in catch, with and arrow functions
+        const char* script = "function mapped(a, b) { a = 10; arguments[1] = 20; return arguments[0] + ',' + b + ',' + arguments.length; }"
+                             "function unmapped(a, b) { 'use strict'; a = 10; arguments[1] = 20; return arguments[0] + ',' + b + ',' + arguments.length; }"
+                             "function missing(a, b) { b = 5; return arguments[1] + ',' + arguments.length; }"
+                             "function keys(a) { return [arguments[-1], arguments[3], arguments['0'], arguments[0.5], arguments['length'], arguments[1e10], typeof arguments['callee'], arguments[NaN]].join(); }"
+                             "function escapes(a) { var first = arguments[0]; var args = arguments; args[0] = 7; return first + ',' + a + ',' + arguments[0] + ',' + (args === arguments); }"
+                             "function escapesStrict(a) { 'use strict'; var first = arguments[0]; var args = arguments; args[0] = 7; return first + ',' + a + ',' + arguments[0]; }"
+                             "function escapesToCall(a) { var n = arguments.length; return n + ':' + Array.prototype.slice.call(arguments, 1).join('/'); }"
+                             "function inCatch(a) { try { throw 1; } catch (e) { return arguments[0] + e + arguments.length; } }"
+                             "function catchNamed(a) { try { throw [7]; } catch (arguments) { return arguments[0] + ',' + arguments.length; } }"
+                             "function inWith(a) { with ({ x: 1 }) { return arguments[0] + x + ',' + arguments.length; } }"
+                             "function withShadow(a) { with ({ arguments: [9, 8] }) { return arguments[0] + ',' + arguments.length; } }"
+                             "function arrow(a) { var f = () => arguments[0] + ',' + arguments.length; return f(100); }"
+                             "function arrowAssign(a) { var f = () => { a = 'changed'; return arguments[0]; }; return f(); }"
+                             "function run() {"
+                             "return [mapped(1, 2), unmapped(1, 2), missing(1), keys(3, 4), escapes(1), escapesStrict(1), escapesToCall(1, 2, 3), inCatch(5, 6), catchNamed(1), inWith(2), withShadow(1), arrow(3, 4), arrowAssign('x')].join(' ');"
+                             "}"
+                             "var first = run();"
+                             "var same = true;"
+                             "for (var k = 0; k < 1100; k++) { if (run() !== first) { same = false; } }"
+                             "first + ':' + same;";
+        CHECK("arguments read without the arguments object", evalScript(ctx, es, script, "ArgumentsWithoutObject.js") == "10,20,2 1,2,2 undefined,1 ,,3,,2,,function, 1,7,7,true 1,1,7 3:2/3 8 7,1 3,1 9,2 3,2 changed:true");
+    }
+
+    {
+        // for-in over keys of the enumeration cache, with properties changed during the loop,
+        // prototypes swapped between loops, shadowed keys and non-enumerable overrides
+        const char* script = "function keys(o) { var r = []; for (var k in o) { r.push(k); } return r.join(''); }"
+                             "function make() { var o = {}; o.a = 1; o.b = 2; o.c = 3; return o; }"
+                             "var out = [];"
+                             "out.push(keys(make()), keys(make()));"
+                             "function deleting() { var o = make(); var r = []; for (var k in o) { r.push(k); if (k == 'a') { delete o.b; } } return r.join(''); }"
+                             "out.push(deleting(), deleting());"
+                             "function adding() { var o = make(); var r = []; for (var k in o) { r.push(k); if (k == 'a') { o.d = 4; } } return r.slice(0, 3).join('') + (r.length >= 3); }"
+                             "out.push(adding(), adding());"
+                             "function deleteAndReadd() { var o = make(); var r = []; for (var k in o) { r.push(k); if (k == 'a') { delete o.c; o.c = 5; } } return r.join('').indexOf('ab') == 0 && r.length <= 3; }"
+                             "out.push(deleteAndReadd());"
+                             "var p1 = { x: 1 }, p2 = { y: 2 };"
+                             "function withProto(p) { var o = Object.create(p); o.a = 1; return keys(o); }"
+                             "out.push(withProto(p1), withProto(p2), withProto(p1), withProto(p2));"
+                             "function swapped() { var o = Object.create(p1); o.a = 1; var first = keys(o); o.__proto__ = p2; return first + '/' + keys(o); }"
+                             "out.push(swapped(), swapped());"
+                             "var proto = { a: 'p', s: 'p' };"
+                             "function shadow() { var o = Object.create(proto); o.s = 'own'; o.t = 1; var r = []; for (var k in o) { r.push(k + '=' + o[k]); } return r.join(','); }"
+                             "out.push(shadow(), shadow());"
+                             "var enumProto = { h: 1, v: 2 };"
+                             "function hidden() { var o = Object.create(enumProto); Object.defineProperty(o, 'h', { value: 3, enumerable: false }); o.w = 1; return keys(o); }"
+                             "out.push(hidden(), hidden());"
+                             "function protoChanged() { var o = Object.create(enumProto); o.w = 1; return keys(o); }"
+                             "out.push(protoChanged());"
+                             "enumProto.z = 9;"
+                             "out.push(protoChanged());"
+                             "delete enumProto.v;"
+                             "out.push(protoChanged());"
+                             "function arrayKeys() { var a = [1, 2, 3]; var r = []; for (var k in a) { r.push(k); if (k == '0') { a.length = 1; } } return r.join(''); }"
+                             "out.push(arrayKeys(), arrayKeys());"
+                             "function reenter() { var o = make(); var r = []; for (var k in o) { r.push(k); if (k == 'a') { delete o.c; } } for (var k2 in o) { r.push(k2); } for (var k3 in make()) { r.push(k3); } return r.join(''); }"
+                             "out.push(reenter(), reenter());"
+                             "out.join(' ');";
+        CHECK("for-in over cached keys", evalScript(ctx, es, script, "ForInCache.js") == "abc abc ac ac abctrue abctrue true ax ay ax ay ax/ay ax/ay s=own,t=1,a=p s=own,t=1,a=p wv wv whv whvz whz 0 0 abababc abababc");
+    }
+
+    {
+        // compare + JumpIfFalse, Increment/Decrement + Jump and get + call pairs are fused unless control flow lands between them.
+        // the compare result is read after the jump, and && / || chains, ?: and continue jump into the middle of such pairs
+        const char* script = "function compareKept(a, b) { var t = a < b; if (t) { return 'y' + t; } return 'n' + t; }"
+                             "function compareAssign(a, b) { var c; if ((c = a >= b)) { c = c + 'x'; } return c; }"
+                             "function strict(a, b) { var r = a === b; while (r) { r = false; a = 'loop'; } return a + r + (a !== b); }"
+                             "function chain(a, b, c, d) { var r = ''; if (a < b && c > d || a == d) { r += 'T'; } else { r += 'F'; } if (a <= b || c != d && b >= c) { r += 'T'; } else { r += 'F'; } return r; }"
+                             "function chainValue(a, b, c) { var v = a < b && b < c; var w = a > b || b == c; var x = (a < b) && c; return [v, w, x].join(); }"
+                             "function conditional(a, b, c) { if ((a ? b : c) < 5) { return 'lt'; } return 'ge'; }"
+                             "function doWhile(n) { var i = 0, s = 0; do { s += i; i++; } while (i < n); return s; }"
+                             "function whileContinue(n) { var i = 0, s = 0; while (i < n) { i++; if (i % 3 == 0) { continue; } s += i; } return s; }"
+                             "function forContinue() { var s = 0; for (var i = 0; i < 20; i++) { if (i % 2) { continue; } s += i; } for (var j = 20; j > 0; j--) { if (j == 5) { continue; } s -= j; } return s + ':' + i + ':' + j; }"
+                             "function labeled() { var s = ''; outer: for (var i = 0; i < 4; i++) { for (var j = 0; j < 4; j++) { if (j > i) { continue outer; } if (i == 3) { break outer; } s += i + '' + j + ' '; } } return s + i; }"
+                             "function incConvert() { var s = ''; for (var k = '1'; k < 4; k++) { s += typeof k + k; } var o = { valueOf: function () { return 7; } }; for (var m = o; m < 9; m++) { s += m; } return s; }"
+                             "function decNaN() { var n = 0; for (var u = undefined; n < 2; u--, n++) { } return u; }"
+                             "function methods() { var o = { n: 0, inc: function () { return ++this.n; } }; for (var i = 0; i < 5; i++) { o.inc(); } return o.n + String(o.inc()); }"
+                             "function run() { return [compareKept(1, 2), compareKept(2, 1), compareAssign(3, 2), compareAssign(1, 2), strict(1, 1), strict(1, '1'), chain(1, 2, 4, 3), chain(3, 2, 1, 3), chain(2, 2, 2, 2), chainValue(1, 2, 3), chainValue(3, 2, 2), conditional(1, 2, 9), conditional(0, 2, 9), doWhile(0), doWhile(5), whileContinue(10), forContinue(), labeled(), incConvert(), decNaN(), methods()].join(' '); }"
+                             "var first = run();"
+                             "var same = true;"
+                             "for (var k = 0; k < 1100; k++) { if (run() !== first) { same = false; } }"
+                             "first + ':' + same;";
+        CHECK("ByteCode pairs fused into superinstructions", evalScript(ctx, es, script, "FusedByteCodes.js") == "ytrue nfalse truex false loopfalsetrue 2 TT TT TT true,false,3 false,true,false lt ge 0 10 37 -115:20:0 00 10 11 20 21 22 3 string1number2number378 NaN 56:true");
+    }
+
+    {
+        // keys the replacer deletes are skipped and keys it adds are not visited, toJSON is looked up again after Object.prototype changes
+        // and getters may change the structure of the object being written. typed arrays are written as arrays
+        const char* script = "var out = [];"
+                             "var order = { a: 1, b: 2, c: 3, d: 4 };"
+                             "out.push(JSON.stringify(order, function (k, v) { if (k == 'a') { delete this.c; this.b = 'B'; } return v; }));"
+                             "out.push(JSON.stringify({ a: 1, b: 2 }, function (k, v) { if (k == 'a') { this.z = 9; } return v; }));"
+                             "out.push(JSON.stringify({ 1: 'x', 2: 'y', a: 'z' }, [2, 'a', 1, 2, '1', new Number(2), new String('a')]));"
+                             "out.push(JSON.stringify({ 0: 1, 1: 2, 10: 3, x: 4 }));"
+                             "out.push(JSON.stringify([1, [2, { a: 3 }]], null, 2).split('\\n').join('|'));"
+                             "out.push(JSON.stringify({ a: [1] }, null, 'ab').split('\\n').join('|'));"
+                             "out.push(JSON.stringify({ a: 1 }, null, '0123456789AB').split('\\n').join('|'));"
+                             "out.push(JSON.stringify({ a: 1 }, null, 20) === JSON.stringify({ a: 1 }, null, 10));"
+                             "out.push(JSON.stringify({ a: [] , b: {} }, null, new Number(1)).split('\\n').join('|'));"
+                             "function Point(x) { this.x = x; }"
+                             "Point.prototype.toJSON = function (k) { return 'P' + this.x + k; };"
+                             "out.push(JSON.stringify({ own: { toJSON: function (k) { return k + '!'; } }, p: new Point(5), q: [new Point(6)] }));"
+                             "var plain = { a: { b: 1 } };"
+                             "out.push(JSON.stringify(plain));"
+                             "Object.prototype.toJSON = function (k) { return 'T' + k; };"
+                             "out.push(JSON.stringify(plain));"
+                             "delete Object.prototype.toJSON;"
+                             "out.push(JSON.stringify(plain));"
+                             "var holder = { a: 1, get b() { delete this.c; this.e = 5; return 2; }, c: 3, d: 4 };"
+                             "out.push(JSON.stringify(holder));"
+                             "out.push(JSON.stringify({ get a() { this.a2 = 1; return 1; }, b: { get c() { delete this.d; return 3; }, d: 4 } }));"
+                             "function cycle(o) { try { JSON.stringify(o); return 'no'; } catch (e) { return e instanceof TypeError; } }"
+                             "var ca = []; ca.push(ca);"
+                             "var co = {}; co.self = co;"
+                             "var mixed = { list: [1, {}] }; mixed.list[1].back = mixed.list;"
+                             "out.push(cycle(ca), cycle(co), cycle(mixed));"
+                             "var shared = { v: 1 };"
+                             "out.push(JSON.stringify([shared, shared, { s: shared }]));"
+                             "out.push(JSON.stringify({ '\\u0001': '\\b\\f\\n\\r\\t\"\\\\/', k: '\\u001f~' }));"
+                             "out.push(JSON.stringify('\\u4e00\\u00e9a') === '\"\\u4e00\\u00e9a\"');"
+                             "var lone = 'x\\ud800y\\udc00z\\ud83d\\ude00';"
+                             "out.push(JSON.parse(JSON.stringify(lone)) === lone, JSON.parse(JSON.stringify({ k: lone })).k === lone);"
+                             "out.push(JSON.stringify([new Number(3), new String('s'), new Boolean(false), Object(1.5)]));"
+                             "out.push(JSON.stringify({ n: NaN, i: -Infinity, u: undefined, f: function () { }, h: [undefined, function () { }] }));"
+                             "out.push(JSON.stringify([1, , 3]));"
+                             "out.push(JSON.stringify({ i8: new Int8Array([1, -2]), u8: new Uint8Array([255, 256]), f32: new Float32Array([0.5]) }));"
+                             "out.join(' ');";
+        CHECK("JSON.stringify output", evalScript(ctx, es, script, "JSONStringify.js") == "{\"a\":1,\"b\":\"B\",\"d\":4} {\"a\":1,\"b\":2} {\"2\":\"y\",\"a\":\"z\",\"1\":\"x\"} {\"0\":1,\"1\":2,\"10\":3,\"x\":4} [|  1,|  [|    2,|    {|      \"a\": 3|    }|  ]|] {|ab\"a\": [|abab1|ab]|} {|0123456789\"a\": 1|} true {| \"a\": [],| \"b\": {}|} {\"own\":\"own!\",\"p\":\"P5p\",\"q\":[\"P60\"]} {\"a\":{\"b\":1}} \"T\" {\"a\":{\"b\":1}} {\"a\":1,\"b\":2,\"d\":4} {\"a\":1,\"b\":{\"c\":3}} true true true [{\"v\":1},{\"v\":1},{\"s\":{\"v\":1}}] {\"\\u0001\":\"\\b\\f\\n\\r\\t\\\"\\\\/\",\"k\":\"\\u001f~\"} true true true [3,\"s\",false,1.5] {\"n\":null,\"i\":null,\"h\":[null,null]} [1,null,3] {\"i8\":[1,-2],\"u8\":[255,0],\"f32\":[0.5]}");
+    }
+
+    {
+        // keys are looked up in a small cache of recent keys; "a" and "!" (and "z" and ":") share a slot of it.
+        // nesting is parsed without recursion, and the reviver does not visit keys it has deleted
+        const char* script = "var out = [];"
+                             "function keys(o) { return Object.keys(o).join(','); }"
+                             "var dup = JSON.parse('{\"a\":1,\"b\":2,\"a\":3}');"
+                             "out.push(keys(dup) + '=' + dup.a);"
+                             "var proto = JSON.parse('{\"__proto__\":{\"x\":1},\"y\":2}');"
+                             "out.push(Object.getPrototypeOf(proto) === Object.prototype, proto.hasOwnProperty('__proto__'), proto.x === undefined, keys(proto));"
+                             "var idx = JSON.parse('{\"0\":\"a\",\"10\":\"b\",\"1\":\"c\"}');"
+                             "out.push(idx[0] + idx[10] + idx['1'] + idx.length);"
+                             "var empty = JSON.parse('{\"\":1,\"e\":{\"\":2}}');"
+                             "out.push(empty[''] + empty.e[''] + ':' + keys(empty).length);"
+                             "var collide = JSON.parse('[{\"a\":1,\"!\":2},{\"!\":3,\"a\":4},{\"z\":5,\":\":6,\"a\":7}]');"
+                             "out.push(collide.map(function (o) { return keys(o) + '=' + o.a; }).join(';'));"
+                             "var many = [];"
+                             "for (var i = 0; i < 200; i++) { many.push('\"k' + i + '\":' + i); }"
+                             "var big = JSON.parse('{' + many.join(',') + ',\"k7\":-7}');"
+                             "out.push(Object.keys(big).length + ':' + big.k0 + ':' + big.k7 + ':' + big.k199);"
+                             "var depth = 100000;"
+                             "var deep = JSON.parse(Array(depth + 1).join('[') + Array(depth + 1).join(']'));"
+                             "var d = 0;"
+                             "for (var cur = deep; cur.length; cur = cur[0]) { d++; }"
+                             "out.push(d);"
+                             "var deepObject = JSON.parse(Array(depth + 1).join('{\"n\":') + 'null' + Array(depth + 1).join('}'));"
+                             "d = 0;"
+                             "for (cur = deepObject; cur; cur = cur.n) { d++; }"
+                             "out.push(d);"
+                             "var seen = [];"
+                             "var revived = JSON.parse('{\"a\":1,\"b\":2,\"c\":{\"d\":3}}', function (k, v) { seen.push(k); if (k == 'a') { delete this.b; this.z = 9; } if (k == 'd') { return undefined; } return v; });"
+                             "out.push(seen.join(','), keys(revived), '{' + keys(revived.c) + '}', revived.z);"
+                             "var arrRevived = JSON.parse('[1,2,3]', function (k, v) { if (k === '0') { this.length = 2; } return v; });"
+                             "out.push(arrRevived.length + ':' + arrRevived.join(','));"
+                             "var wide = JSON.parse('{\"\\u4e00\":\"\\u4e01x\",\"a\":\"\\ud800\",\"\\u4e00b\":[1]}');"
+                             "out.push(wide['\\u4e00'] === '\\u4e01x', wide.a.charCodeAt(0), wide['\\u4e00b'][0], Object.keys(wide).length);"
+                             "var escaped = JSON.parse('{\"\\\\u0061\":\"\\\\u4e00\",\"b\\\\n\":\"\\\\ud83d\\\\ude00\"}');"
+                             "out.push(escaped.a === '\\u4e00', escaped['b\\n'].length);"
+                             "var latin1 = JSON.parse('{\"\\u00e9\":\"\\u00ff\"}');"
+                             "out.push(latin1['\\u00e9'] === '\\u00ff');"
+                             "var mixedKeys = JSON.parse('[{\"\\u4e00\":1,\"k\":2},{\"k\":3,\"\\u4e00\":4}]');"
+                             "out.push(mixedKeys[1]['\\u4e00'] + mixedKeys[1].k);"
+                             "out.push(JSON.parse('[1e3,-0,0.1,9007199254740993,-2147483649]').join());"
+                             "function fails(s) { try { JSON.parse(s); return 'no'; } catch (e) { return e instanceof SyntaxError; } }"
+                             "out.push(fails('{\"a\":1,}'), fails('[1'), fails(Array(1001).join('[')));"
+                             "out.join(' ');";
+        CHECK("JSON.parse output", evalScript(ctx, es, script, "JSONParse.js") == "a,b=3 true true true __proto__,y abcundefined 3:2 a,!=1;!,a=4;z,:,a=7 200:0:-7:199 99999 100000 a,d,c, a,c,z {} 9 2:1,2 true 55296 1 3 true 2 true 7 1000,0,0.1,9007199254740992,-2147483649 true true true");
+    }
+
+    {
+        // functions read and write upper variables through the display of their closure.
+        // with deep nesting, catch and with scopes, named function expressions, arrow functions and eval in a middle function
+        const char* script = "function deep(a) { var b = a + 1; return function (c) { var d = b + c; return function (e) { var f = d + e; return function (g) { a++; b++; return [a, b, d, f, g].join('.'); }; }; }; }"
+                             "function inCatch(x) { var fs = []; try { throw 'E'; } catch (err) { var local = x; fs.push(function () { return err + local + x; }); try { throw 'F'; } catch (err2) { fs.push(function () { return err + err2 + x++; }); } } return fs[0]() + fs[1]() + fs[0](); }"
+                             "function inWith(x) { var o = { w: 'W' }; var r; with (o) { r = function () { return w + x; }; } o.w = 'V'; x = 'Y'; return r(); }"
+                             "function withShadow() { var w = 'outer', o = { w: 'inner' }; with (o) { var g = function () { return w; }; } var first = g(); delete o.w; return first + '/' + g(); }"
+                             "var named = function fact(n) { return n <= 1 ? 1 : n * fact(n - 1); };"
+                             "function namedInner() { var count = 0; var f = function self(n) { count++; if (n > 0) { return self(n - 1); } return typeof self + count; }; return f(3); }"
+                             "function namedReassign() { var f = function g() { g = 5; return typeof g; }; return f(); }"
+                             "function arrows() { var o = { v: 'this', m: function () { var a1 = arguments[0]; return () => () => this.v + arguments[0] + arguments.length + a1; } }; return o.m('A', 'B')()(); }"
+                             "function arrowNested(x) { return (() => { var y = x * 2; return () => () => x + y + this.k; })()()(); }"
+                             "function evalMiddle(x) { var y = 'y'; return function (code) { eval(code); return function () { return x + y; }; }; }"
+                             "function evalLocal() { var v = 'outer'; return function () { var v2 = 'mid'; eval('var v = \\'shadow\\''); return function () { return v + v2; }; }; }"
+                             "function laterWrites() { var a = 1; var f = function () { return function () { return a; }; }; var g = f(); a = 2; var r = g(); a = 'three'; return r + g(); }"
+                             "function writesThroughClosure() { var n = 0; var inc = function () { return function () { n++; }; }(); inc(); inc(); var read = function () { return n; }; inc(); return read(); }"
+                             "function loopCaptures() { var fs = []; for (var i = 0; i < 3; i++) { fs.push(function (j) { return function () { return i + ':' + j; }; }(i)); } i = 9; return fs.map(function (f) { return f(); }).join(','); }"
+                             "function run() {"
+                             "var r = [];"
+                             "var inner = deep(1)(10)(100);"
+                             "r.push(inner(1000), inner(1000));"
+                             "r.push(inCatch(1), inWith('X'), withShadow());"
+                             "r.push(named(5), namedInner(), namedReassign());"
+                             "r.push(arrows(), arrowNested.call({ k: 'K' }, 3));"
+                             "r.push(evalMiddle('X')('var y = \\'E\\'')(), evalMiddle('X')('x = \\'Z\\'')(), evalMiddle('X')('')());"
+                             "r.push(evalLocal()()());"
+                             "r.push(laterWrites(), writesThroughClosure(), loopCaptures());"
+                             "return r.join(' ');"
+                             "}"
+                             "var first = run();"
+                             "var same = true;"
+                             "for (var k = 0; k < 1100; k++) { if (run() !== first) { same = false; } }"
+                             "first + ':' + same;";
+        CHECK("upper variables through the closure display", evalScript(ctx, es, script, "ClosureDisplay.js") == "2.3.12.112.1000 3.4.12.112.1000 E11EF1E12 VY inner/outer 120 function4 function thisA2A 9K XE Zy Xy shadowmid 2three 3 9:0,9:1,9:2:true");
+    }
+
+    {
+        // structures of one transition chain share a property table, so objects which branch from it must keep their own order,
+        // lookups and deletes; also past the size that builds a name index, after remove and re-add, and with fast access structures
+        const char* script = "function keys(o) { return Object.keys(o).join(''); }"
+                             "function values(o) { var r = []; for (var k in o) { r.push(o[k]); } return r.join(','); }"
+                             "function base(n) { var o = {}; for (var i = 0; i < n; i++) { o['p' + i] = i; } return o; }"
+                             "function branch() { var x = { a: 1, b: 2 }; x.c = 3; var y = { a: 4, b: 5 }; y.d = 6; var z = { a: 7, b: 8 }; z.c = 9; z.e = 10; return [keys(x), keys(y), keys(z), values(y), 'c' in y, 'd' in x, y.c, z.c]; }"
+                             "function branchDelete() { var x = { a: 1, b: 2, c: 3 }; var y = { a: 4, b: 5, c: 6 }; delete x.b; x.b = 7; y.d = 8; delete y.a; return [keys(x), values(x), keys(y), values(y), x.d, y.a]; }"
+                             "function wide() { var x = base(20); var y = base(20); x.q = 'x'; y.r = 'y'; y.q = 'yq'; var s = 0; for (var i = 0; i < 20; i++) { s += x['p' + i] + y['p' + i]; } return [keys(x).slice(-6), keys(y).slice(-6), x.r, y.q, s, 'p19' in x, 'p20' in x]; }"
+                             "function manyChildren() { var r = []; for (var i = 0; i < 12; i++) { var o = { a: 0 }; o['c' + i] = i; o.z = i; r.push(o); } var s = ''; for (var j = 0; j < 12; j++) { s += keys(r[j]) + '=' + r[j]['c' + j] + r[j].z + ('c' + (j + 1) in r[j]) + ' '; } return s; }"
+                             "function fastAccess() { var x = base(100); var y = base(100); x.extra = 'e'; delete x.p50; x.p50 = 'again'; delete y.p99; return [Object.keys(x).length, x.p49, x.p50, x.p51, keys(x).slice(-9), Object.keys(y).length, y.p98, y.p99, 'extra' in y]; }"
+                             "function redefine() { var x = { a: 1, b: 2, c: 3 }; var y = { a: 4, b: 5, c: 6 }; Object.defineProperty(x, 'b', { enumerable: false }); y.d = 7; x.e = 8; delete x.a; return [keys(x), x.b, keys(y), values(y), Object.getOwnPropertyNames(x).join('')]; }"
+                             "function accessors() { var x = { a: 1 }; var y = { a: 2 }; Object.defineProperty(x, 'g', { get: function () { return 'gx'; }, enumerable: true, configurable: true }); y.g = 'gy'; delete x.g; x.g = 'data'; return [keys(x), x.g, keys(y), y.g]; }"
+                             "function run() { return [branch(), branchDelete(), wide(), manyChildren(), fastAccess(), redefine(), accessors()].join(' '); }"
+                             "var first = run();"
+                             "var same = true;"
+                             "for (var k = 0; k < 1100; k++) { if (run() !== first) { same = false; } }"
+                             "first + ':' + same;";
+        CHECK("objects branching from shared property tables", evalScript(ctx, es, script, "StructureSharing.js") == "abc,abd,abce,4,5,6,false,false,,9 acb,1,3,7,bcd,5,6,8,, 18p19q,8p19rq,,yq,380,true,false ac0z=00false ac1z=11false ac2z=22false ac3z=33false ac4z=44false ac5z=55false ac6z=66false ac7z=77false ac8z=88false ac9z=99false ac10z=1010false ac11z=1111false  101,49,again,51,9extrap50,99,98,,false ce,2,abcd,4,5,6,7,bce ag,data,ag,gy:true");
+    }
+
+    {
+        // one get site goes from monomorphic to polymorphic and back to a prototype chain hit, and getters and setters
+        // are installed on prototypes after the get, missing and add property caches are warm
+        const char* script = "function getX(o) { return o.x; }"
+                             "function getM(o) { return o.m; }"
+                             "function setY(o, v) { o.y = v; return o; }"
+                             "function shapes() { return [{ x: 1 }, { a: 0, x: 2 }, { b: 0, x: 3 }, { c: 0, x: 4 }, { d: 0, x: 5 }, { e: 0, x: 6 }]; }"
+                             "function states() {"
+                             "var r = [], i, s = 0;"
+                             "for (i = 0; i < 20; i++) { s += getX({ x: i }); }"
+                             "r.push(s);"
+                             "var list = shapes();"
+                             "for (i = 0, s = 0; i < 30; i++) { s += getX(list[i % list.length]); }"
+                             "r.push(s);"
+                             "var proto = { x: 'p' };"
+                             "var gp = { x: 'gp' };"
+                             "var child = Object.create(proto);"
+                             "for (i = 0, s = ''; i < 10; i++) { s += getX(child); }"
+                             "r.push(s);"
+                             "proto.x = 'q';"
+                             "r.push(getX(child));"
+                             "delete proto.x;"
+                             "r.push(getX(child));"
+                             "proto.__proto__ = gp;"
+                             "r.push(getX(child));"
+                             "Object.defineProperty(gp, 'x', { get: function () { return 'getter' + (this === child); }, configurable: true });"
+                             "r.push(getX(child));"
+                             "Object.defineProperty(child, 'x', { value: 'own' });"
+                             "r.push(getX(child), getX(list[0]));"
+                             "return r.join(',');"
+                             "}"
+                             "function missing() {"
+                             "var r = [], i, o = { a: 1 };"
+                             "for (i = 0; i < 10; i++) { r.push(getM(o)); }"
+                             "Object.defineProperty(Object.prototype, 'm', { get: function () { return 'late'; }, configurable: true });"
+                             "r.push(getM(o));"
+                             "delete Object.prototype.m;"
+                             "r.push(getM(o));"
+                             "return r.slice(8).join(',');"
+                             "}"
+                             "function setters() {"
+                             "var r = [], i;"
+                             "var P = { base: 1 };"
+                             "for (i = 0; i < 10; i++) { r.push(Object.keys(setY(Object.create(P), i)).join('')); }"
+                             "var log = [];"
+                             "Object.defineProperty(P, 'y', { set: function (v) { log.push(v); }, get: function () { return 'py'; }, configurable: true });"
+                             "var o = setY(Object.create(P), 'a');"
+                             "r.push(o.hasOwnProperty('y'), o.y, log.join(''));"
+                             "Object.defineProperty(P, 'y', { value: 'ro', writable: false, configurable: true });"
+                             "o = setY(Object.create(P), 'b');"
+                             "r.push(o.hasOwnProperty('y'), o.y);"
+                             "delete P.y;"
+                             "o = setY(Object.create(P), 'c');"
+                             "r.push(o.hasOwnProperty('y'), o.y);"
+                             "var Q = Object.create(P);"
+                             "var q = Object.create(Q);"
+                             "for (i = 0; i < 10; i++) { setY(Object.create(Q), i); }"
+                             "Object.defineProperty(P, 'y', { set: function (v) { log.push('deep' + v); }, configurable: true });"
+                             "setY(q, 'd');"
+                             "r.push(q.hasOwnProperty('y'), log.join(''));"
+                             "return r.slice(9).join(',');"
+                             "}"
+                             "function run() { return [states(), missing(), setters()].join(' '); }"
+                             "var first = run();"
+                             "var same = true;"
+                             "for (var k = 0; k < 1100; k++) { if (run() !== first) { same = false; } }"
+                             "first + ':' + same;";
+        CHECK("inline caches through monomorphic, polymorphic and prototype states", evalScript(ctx, es, script, "InlineCacheStates.js") == "190,105,pppppppppp,q,,gp,gettertrue,own,1 ,,late, y,false,py,a,false,ro,true,c,false,adeepd:true");
+    }
+
+    {
+        // sources with many nodes fill several AST arena chunks, and string literals are reachable only through them until ByteCode is made.
+        // functions are parsed again lazily after gc, some parses fail with SyntaxError, and eval parses code inside eval code
+        const char* script = "function literals(n, tag) { var parts = []; for (var i = 0; i < n; i++) { parts.push('\\'' + tag + i + '\\''); } return '[' + parts.join(',') + ']'; }"
+                             "var big = eval(literals(20000, 'lit'));"
+                             "gc();"
+                             "var ok = big.length == 20000 && big[0] == 'lit0' && big[12345] == 'lit12345' && big[19999] == 'lit19999';"
+                             "var src = 'var fs = [];';"
+                             "for (var i = 0; i < 300; i++) { src += 'fs.push(function (x) { var s = \\'f' + i + '\\' + x; var o = { k: ' + i + ', s: s, list: ' + literals(20, 'e' + i + '_') + ' }; return o.s + o.list[' + (i % 20) + '] + o.k; });'; }"
+                             "src += 'fs;';"
+                             "var fs = eval(src);"
+                             "gc();"
+                             "var sum = '';"
+                             "for (i = 0; i < fs.length; i += 37) { sum += fs[i]('x') + ' '; }"
+                             "gc();"
+                             "var again = fs[299]('y') + fs[0]('z');"
+                             "var errors = 0;"
+                             "for (i = 0; i < 30; i++) { try { eval(literals(2000, 'bad') + ' + ;'); } catch (e) { if (e instanceof SyntaxError) { errors++; } } }"
+                             "gc();"
+                             "var made = new Function('a', 'b', 'return ' + literals(5000, 'fn') + '[a] + b;');"
+                             "gc();"
+                             "var nested = eval('eval(\\'' + literals(3000, 'in').replace(/'/g, '\\\\\\'') + '\\').length + ' + literals(3000, 'out') + '[2999]');"
+                             "ok + ' ' + sum + again + ' ' + errors + ' ' + made(4999, '!') + ' ' + nested;";
+        CHECK("values referenced from AST nodes survive gc", evalScript(ctx, es, script, "ASTArena.js") == "true f0xe0_00 f37xe37_1737 f74xe74_1474 f111xe111_11111 f148xe148_8148 f185xe185_5185 f222xe222_2222 f259xe259_19259 f296xe296_16296 f299ye299_19299f0ze0_00 30 fn4999! 3000out2999");
+    }
+
+    {
+        // constructors reserve storage for as many properties as earlier receivers got; objects grow past that and past the
+        // size of their buffer, with delete and re-add, while gc runs in between
+        const char* script = "function Point(n) { this.x = 'x' + n; this.y = { n: n }; }"
+                             "function Grows(n) { for (var i = 0; i < n; i++) { this['g' + i] = { v: i }; } }"
+                             "function check(o, n) { for (var i = 0; i < n; i++) { if (!o['g' + i] || o['g' + i].v !== i) { return 'bad' + i; } } return n; }"
+                             "function run() {"
+                             "var r = [], i, j;"
+                             "var points = [];"
+                             "for (i = 0; i < 50; i++) { points.push(new Point(i)); }"
+                             "for (i = 0; i < 50; i += 2) { for (j = 0; j < 70; j++) { points[i]['p' + j] = 'v' + i + '_' + j; } }"
+                             "gc();"
+                             "var ok = true;"
+                             "for (i = 0; i < 50; i++) { if (points[i].x !== 'x' + i || points[i].y.n !== i || (i % 2 == 0 && points[i].p69 !== 'v' + i + '_69') || (i % 2 && 'p0' in points[i])) { ok = false; } }"
+                             "r.push(ok);"
+                             "var grown = [];"
+                             "for (i = 0; i < 5; i++) { grown.push(new Grows(3)); }"
+                             "for (i = 0; i < 5; i++) { grown.push(new Grows(100)); gc(); }"
+                             "for (i = 0; i < 5; i++) { grown.push(new Grows(2)); }"
+                             "var s = '';"
+                             "for (i = 0; i < grown.length; i++) { s += check(grown[i], i < 5 ? 3 : (i < 10 ? 100 : 2)) + ','; }"
+                             "r.push(s);"
+                             "var lit = { a: 1, b: 2 };"
+                             "for (i = 0; i < 40; i++) { lit['k' + i] = [i]; if (i % 7 == 0) { delete lit.a; lit.a = i; } if (i % 10 == 0) { gc(); } }"
+                             "r.push(lit.a, lit.b, lit.k39[0], Object.keys(lit).length);"
+                             "var arr = [1, 2, 3];"
+                             "for (i = 0; i < 30; i++) { arr['n' + i] = { i: i }; }"
+                             "gc();"
+                             "r.push(arr.length, arr.n0.i + arr.n29.i, arr[2]);"
+                             "var many = [];"
+                             "for (i = 0; i < 2000; i++) { var o = {}; for (j = 0; j < (i % 13) + 1; j++) { o['q' + j] = i * 100 + j; } many.push(o); }"
+                             "gc();"
+                             "var sum = 0;"
+                             "for (i = 0; i < many.length; i++) { sum += many[i]['q' + (i % 13)] - i * 100; }"
+                             "r.push(sum);"
+                             "return r.join(' ');"
+                             "}"
+                             "var first = run();"
+                             "var same = true;"
+                             "for (var k = 0; k < 30; k++) { if (run() !== first) { same = false; } }"
+                             "first + ':' + same;";
+        CHECK("property storage growing past its reserved slack", evalScript(ctx, es, script, "PropertySlack.js") == "true 3,3,3,3,3,100,100,100,100,100,2,2,2,2,2, 35 2 39 42 3 29 3 11989:true");
+    }
+
     es->destroy();
     ctx->destroy();
     vm->destroy();
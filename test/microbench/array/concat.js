@@ -0,0 +1,10 @@
+var result = 0;
+var a = [];
+var b = [];
+for (var j = 0; j < 500; j++) {
+    a.push(j);
+    b.push("s" + j);
+}
+for (var i = 0; i < 50000; i++) {
+    result += a.concat(b, i, a).length;
+}
@@ -0,0 +1,8 @@
+var result = 0;
+var arr = [];
+for (var j = 0; j < 1000; j++) {
+    arr.push(j);
+}
+for (var i = 0; i < 5000; i++) {
+    result += arr.filter(function (v) { return v & 1; }).length;
+}
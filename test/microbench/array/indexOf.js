@@ -0,0 +1,11 @@
+var result = 0;
+var ints = [];
+var strings = [];
+for (var j = 0; j < 1000; j++) {
+    ints.push(j);
+    strings.push("s" + j);
+}
+for (var i = 0; i < 50000; i++) {
+    result += ints.indexOf(i % 1000);
+    result += strings.indexOf(strings[i % 1000]);
+}
@@ -0,0 +1,8 @@
+var result = 0;
+for (var i = 0; i < 200; i++) {
+    var arr = [];
+    for (var j = 0; j < 10000; j++) {
+        arr.push(j, j + 1);
+    }
+    result += arr.length;
+}
@@ -0,0 +1,10 @@
+var result = 0;
+for (var i = 0; i < 200; i++) {
+    var arr = [];
+    for (var j = 0; j < 2000; j++) {
+        arr.push(j);
+    }
+    while (arr.length) {
+        result += arr.shift();
+    }
+}
@@ -0,0 +1,8 @@
+var result = 0;
+var arr = [];
+for (var j = 0; j < 1000; j++) {
+    arr.push(j * 0.5);
+}
+for (var i = 0; i < 50000; i++) {
+    result += arr.slice(i % 100, 900).length;
+}
@@ -0,0 +1,10 @@
+var result = 0;
+var arr = [];
+for (var j = 0; j < 1000; j++) {
+    arr.push(j);
+}
+for (var i = 0; i < 200000; i++) {
+    var removed = arr.splice(i % 1000, 2, i, i + 1, i + 2);
+    arr.splice(0, 1);
+    result += removed.length;
+}
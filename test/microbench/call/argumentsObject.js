@@ -0,0 +1,28 @@
+function sum() {
+    var s = 0;
+    for (var i = 0; i < arguments.length; i++)
+        s += arguments[i];
+    return s;
+}
+
+function pick(a, b) {
+    a = a + 1;
+    return arguments[0] + arguments[1] + arguments.length;
+}
+
+function strictMax() {
+    "use strict";
+    var m = -Infinity;
+    for (var i = 0; i < arguments.length; i++) {
+        if (arguments[i] > m)
+            m = arguments[i];
+    }
+    return m;
+}
+
+var result = 0;
+for (var i = 0; i < 300000; i++) {
+    result += sum(i, 1, 2, 3);
+    result += pick(i, 2);
+    result += strictMax(3, i & 7, 5);
+}
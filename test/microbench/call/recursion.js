@@ -0,0 +1,34 @@
+function fib(n) {
+    if (n < 2) {
+        return n;
+    }
+    return fib(n - 1) + fib(n - 2);
+}
+
+function Node(value, next) {
+    this.value = value;
+    this.next = next;
+}
+
+Node.prototype.sum = function() {
+    if (this.next === null) {
+        return this.value;
+    }
+    return this.value + this.next.sum();
+};
+
+function depth(n) {
+    return n === 0 ? 0 : 1 + depth(n - 1);
+}
+
+var result = fib(27);
+
+var list = null;
+for (var i = 0; i < 2000; i++) {
+    list = new Node(i, list);
+}
+for (var i = 0; i < 200; i++) {
+    result += list.sum();
+}
+
+result += depth(5000);
@@ -0,0 +1,25 @@
+function add(a, b) {
+    return a + b;
+}
+
+function Vector(x, y) {
+    this.x = x;
+    this.y = y;
+}
+
+Vector.prototype.dot = function(other) {
+    return this.x * other.x + this.y * other.y;
+};
+
+function clamp(value, min, max) {
+    "use strict";
+    return value < min ? min : (value > max ? max : value);
+}
+
+var v = new Vector(3, 4);
+var w = new Vector(1, 2);
+var result = 0;
+for (var i = 0; i < 1000000; i++) {
+    result = add(result, clamp(i & 255, 16, 240));
+    result += v.dot(w);
+}
@@ -0,0 +1,41 @@
+var Module = (function() {
+    var count = 0;
+    var scale = 3;
+
+    function Counter() {
+        var step = 1;
+        return {
+            add: function(n) {
+                return (function() {
+                    count += n * scale + step;
+                    return count;
+                })();
+            },
+            read: function() {
+                return count;
+            }
+        };
+    }
+
+    return { Counter: Counter };
+})();
+
+function each(array, callback) {
+    for (var i = 0; i < array.length; i++) {
+        callback(array[i], i);
+    }
+}
+
+var counter = Module.Counter();
+var values = [];
+for (var i = 0; i < 100; i++) {
+    values.push(i);
+}
+
+var total = 0;
+for (var j = 0; j < 10000; j++) {
+    each(values, function(value, index) {
+        total += counter.add(value & 7) & index;
+    });
+}
+total += counter.read();
@@ -0,0 +1,36 @@
+function parseDigit(ch) {
+    try {
+        if (ch < "0" || ch > "9") {
+            throw new Error("not a digit: " + ch);
+        }
+        return ch.charCodeAt(0) - 48;
+    } catch (e) {
+        return -1;
+    }
+}
+
+function validate(value) {
+    try {
+        if (typeof value !== "number") {
+            throw "type";
+        }
+        if (value < 0) {
+            throw "range";
+        }
+        return true;
+    } catch (e) {
+        return false;
+    } finally {
+        value = null;
+    }
+}
+
+var input = "12a45b78c9";
+var values = [1, -1, "x", 3, null, 5];
+var result = 0;
+for (var i = 0; i < 200000; i++) {
+    result += parseDigit(input[i % input.length]);
+    if (validate(values[i % values.length])) {
+        result++;
+    }
+}
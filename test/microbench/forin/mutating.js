@@ -0,0 +1,11 @@
+var result = 0;
+for (var i = 0; i < 200; i++) {
+    var o = {};
+    for (var j = 0; j < 500; j++) {
+        o["key" + j] = j;
+    }
+    for (var k in o) {
+        delete o["key" + (o[k] + 1)];
+        result += o[k];
+    }
+}
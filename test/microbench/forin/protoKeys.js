@@ -0,0 +1,19 @@
+var result = 0;
+function Base() {}
+Base.prototype.kind = "base";
+Base.prototype.describe = "described";
+var objects = [];
+for (var j = 0; j < 1000; j++) {
+    var o = new Base();
+    o.id = j;
+    o.kind = "item";
+    o.value = j * 3;
+    objects.push(o);
+}
+for (var i = 0; i < 200; i++) {
+    for (var j = 0; j < objects.length; j++) {
+        for (var k in objects[j]) {
+            result += k.length;
+        }
+    }
+}
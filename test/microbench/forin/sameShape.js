@@ -0,0 +1,12 @@
+var result = 0;
+var objects = [];
+for (var j = 0; j < 1000; j++) {
+    objects.push({ id: j, name: "item" + j, price: j * 2, count: j % 7, enabled: true });
+}
+for (var i = 0; i < 200; i++) {
+    for (var j = 0; j < objects.length; j++) {
+        for (var k in objects[j]) {
+            result += k.length;
+        }
+    }
+}
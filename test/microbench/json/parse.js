@@ -0,0 +1,9 @@
+var records = [];
+for (var j = 0; j < 2000; j++) {
+    records.push({ id: j, name: "item" + j, price: j * 1.5, tags: ["a", "b", "c"], enabled: j % 2 == 0, owner: { name: "owner" + (j % 10), level: j % 3 } });
+}
+var text = JSON.stringify(records);
+var result = 0;
+for (var i = 0; i < 30; i++) {
+    result += JSON.parse(text).length;
+}
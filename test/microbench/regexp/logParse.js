@@ -0,0 +1,21 @@
+var lines = [];
+for (var j = 0; j < 500; j++) {
+    lines.push("2018-03-" + (10 + j % 20) + " 12:" + (10 + j % 50) + ":07 worker" + (j % 8) + " status=" + (j % 3 ? "ok" : "error") + " elapsed=" + (j * 7 % 1000) + "ms");
+}
+var datePattern = /(\d+)-(\d+)-(\d+) (\d+):(\d+)/;
+var fieldPattern = /(\w+)=([^ ]*)/g;
+var result = 0;
+for (var i = 0; i < 40; i++) {
+    for (var j = 0; j < lines.length; j++) {
+        var line = lines[j];
+        result += datePattern.exec(line)[3].length;
+        fieldPattern.lastIndex = 0;
+        var m;
+        while ((m = fieldPattern.exec(line)) !== null) {
+            result += m[2].length;
+        }
+        if (/^\d+-\d+-\d+ /.test(line)) {
+            result++;
+        }
+    }
+}
@@ -55,10 +55,10 @@ elif [[ $1 == escargot*.interp* ]]; then
   make $ARCH.interpreter.$MODE -j8
   cmd="$REPO_BASE/out/linux/$ARCH/interpreter/$MODE/escargot"
   tc="escargot.$ARCH.interp"
-#elif [[ $1 == escargot*.jit ]]; then
-#  make $ARCH.jit.release -j8
-#  cmd="$REPO_BASE/out/linux/$ARCH/jit/release/escargot"
-#  tc="escargot.$ARCH.jit"
+elif [[ $1 == escargot*.jit ]]; then
+  make $ARCH.jit.release -j8
+  cmd="$REPO_BASE/out/linux/$ARCH/jit/release/escargot"
+  tc="escargot.$ARCH.jit"
 else
   echo "choose one between ([escargot|jsc|v8](32)?.(full)?.[interp|jit|base])|duk"
   exit 1
@@ -0,0 +1,48 @@
+#!/bin/bash
+
+# Runs micro benchmarks of builtins and reports the time of each one.
+# usage: tools/measure_microbench.sh [x64|x86] [suite ...]
+# every suite under test/microbench is used when no suite is given
+
+echo "======================================================="
+REPO_BASE=`pwd`
+if [[ -z "$MODE" ]]; then
+    MODE="release"
+fi
+if [[ -z "$REPEAT" ]]; then
+    REPEAT=5
+fi
+ARCH="x64"
+if [[ $1 == *"32"* ]] || [[ $1 == x86 ]]; then
+  ARCH="x86"
+fi
+if [[ $1 == x64 ]] || [[ $1 == x86 ]] || [[ $1 == *"32"* ]]; then
+  shift
+fi
+
+make $ARCH.interpreter.$MODE -j8
+cmd="$REPO_BASE/out/linux/$ARCH/interpreter/$MODE/escargot"
+
+MICROBENCH_BASE="test/microbench"
+suites=("$@")
+if [[ ${#suites[@]} == 0 ]]; then
+  for s in $MICROBENCH_BASE/*/; do
+    suites+=(`basename $s`)
+  done
+fi
+
+echo "== BINARY PATH: "$cmd
+echo "== REPEAT: "$REPEAT
+echo "======================================================="
+
+for suite in "${suites[@]}"; do
+  for script in $MICROBENCH_BASE/$suite/*.js; do
+    start=`date +%s%N`
+    for (( i = 0; i < $REPEAT; i++ )); do
+      $cmd $script > /dev/null || { echo "Cannot run $script"; exit 1; }
+    done
+    end=`date +%s%N`
+    awk -v name=$suite/`basename $script .js` -v ns=$(( (end - start) / REPEAT )) \
+      'BEGIN { printf("%-28s %10.2f ms\n", name, ns / 1000000) }'
+  done
+done
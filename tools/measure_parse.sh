@@ -0,0 +1,62 @@
+#!/bin/bash
+
+# Measures parser throughput of escargot over large real world scripts.
+# usage: tools/measure_parse.sh [x64|x86] [script.js ...]
+# scripts of octane are used when no script is given
+
+echo "======================================================="
+REPO_BASE=`pwd`
+if [[ -z "$MODE" ]]; then
+    MODE="release"
+fi
+if [[ -z "$REPEAT" ]]; then
+    REPEAT=10
+fi
+ARCH="x64"
+if [[ $1 == *"32"* ]] || [[ $1 == x86 ]]; then
+  ARCH="x86"
+fi
+if [[ $1 == x64 ]] || [[ $1 == x86 ]] || [[ $1 == *"32"* ]]; then
+  shift
+fi
+
+make $ARCH.interpreter.$MODE -j8
+cmd="$REPO_BASE/out/linux/$ARCH/interpreter/$MODE/escargot"
+
+OCTANE_BASE="test/octane"
+scripts=("$@")
+if [[ ${#scripts[@]} == 0 ]]; then
+  git submodule init test/octane
+  git submodule update test/octane
+  for s in "typescript-compiler.js" "typescript-input.js" "mandreel.js" "pdfjs.js" "gbemu-part1.js" "gbemu-part2.js" "zlib-data.js" "box2d.js" "code-load.js"; do
+    scripts+=("$OCTANE_BASE/$s")
+  done
+fi
+
+echo "== BINARY PATH: "$cmd
+echo "== REPEAT: "$REPEAT
+echo "======================================================="
+
+total_bytes=0
+total_time=0
+for script in "${scripts[@]}"; do
+  if [[ ! -f $script ]]; then
+    echo "Cannot open file $script"
+    exit 1
+  fi
+  bytes=`stat -c %s $script`
+  start=`date +%s%N`
+  for (( i = 0; i < $REPEAT; i++ )); do
+    $cmd --parse-only $script > /dev/null || { echo "Cannot parse $script"; exit 1; }
+  done
+  end=`date +%s%N`
+  elapsed=$(( (end - start) / REPEAT ))
+  maxrss=`/usr/bin/time -f "%M" $cmd --parse-only $script 2>&1 > /dev/null | tail -1`
+  total_bytes=$(( total_bytes + bytes ))
+  total_time=$(( total_time + elapsed ))
+  awk -v name=`basename $script` -v bytes=$bytes -v ns=$elapsed -v rss=$maxrss \
+    'BEGIN { printf("%-28s %10d bytes %10.2f ms %8.2f MB/s MaxRSS: %d KB\n", name, bytes, ns / 1000000, bytes / 1048576 / (ns / 1000000000), rss) }'
+done
+echo "======================================================="
+awk -v bytes=$total_bytes -v ns=$total_time \
+  'BEGIN { printf("total %d bytes %.2f ms %.2f MB/s\n", bytes, ns / 1000000, bytes / 1048576 / (ns / 1000000000)) }'
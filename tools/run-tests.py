@@ -136,8 +136,7 @@ def run_test262(engine, arch):
         env={'TZ': 'US/Pacific'})
 
 
-@runner('test262-master')
-def run_test262_master(engine, arch):
+def run_test262_harness(engine, tests):
     TEST262_HARNESS_OVERRIDE_DIR = join(PROJECT_SOURCE_DIR, 'test')
     TEST262_HARNESS_DIR = join(PROJECT_SOURCE_DIR, 'test', 'test262-harness-py')
 
@@ -147,7 +146,23 @@ def run_test262_master(engine, arch):
     run(['python', join(TEST262_HARNESS_DIR, 'src', 'test262.py'),
          '--command', engine,
          '--tests', join(PROJECT_SOURCE_DIR, 'test', 'test262-master'),
-         '--full-summary'])
+         '--full-summary'] + tests)
+
+
+@runner('test262-master')
+def run_test262_master(engine, arch):
+    run_test262_harness(engine, [])
+
+
+# RegExp and the String methods which match through it, e.g. for checking the RegExp JIT
+@runner('test262-regexp')
+def run_test262_regexp(engine, arch):
+    run_test262_harness(engine, ['built-ins/RegExp/',
+                                 'built-ins/String/prototype/match/',
+                                 'built-ins/String/prototype/replace/',
+                                 'built-ins/String/prototype/search/',
+                                 'built-ins/String/prototype/split/',
+                                 'annexB/built-ins/RegExp/'])
 
 
 @runner('spidermonkey', default=True)